@@ -28,11 +28,14 @@
 #pragma once
 
 #include <Arduino.h>
+#include <airtimeBudget.h>
 #include <transmitterAbs.h>
 
 class RTSTransmitter : public TransmitterAbstract
 {
   public:
+  RTSTransmitter(AirtimeBudget* airtime);
+
   void init();
   bool sendUpCmd(const unsigned long remoteId, const unsigned int rollingCode);
   bool sendStopCmd(const unsigned long remoteId, const unsigned int rollingCode);
@@ -44,10 +47,11 @@ class RTSTransmitter : public TransmitterAbstract
   size_t getBytesFrameSize();
 
   private:
+  AirtimeBudget* m_airtime;
   byte m_frame[7];
 
   void buildFrame(const unsigned long remoteId, const unsigned int rollingCode, const byte action);
+  void transmit(const unsigned long remoteId);
   void sendCommand(); // Will call sendCommand(sync)
   void sendCommand(const byte sync);
-  void debugBuildedFrame(const int base);
 };
\ No newline at end of file
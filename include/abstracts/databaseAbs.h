@@ -27,8 +27,13 @@
  */
 #pragma once
 
+#include <change.h>
 #include <remote.h>
 #include <networks.h>
+#include <macro.h>
+#include <scene.h>
+#include <schedule.h>
+#include <position.h>
 #include <systemInfos.h>
 
 class DatabaseAbstract
@@ -38,9 +43,13 @@ class DatabaseAbstract
 
   virtual SystemInfos getSystemInfos() = 0;
 
-  virtual NetworkConfiguration getNetworkConfiguration() = 0;
-  virtual bool setNetworkConfiguration(const NetworkConfiguration& networkConfig) = 0;
-  virtual void resetNetworkConfiguration() = 0;
+  virtual unsigned char getNetworkConfigurations(NetworkConfiguration networkConfigs[]) = 0;
+  virtual bool setNetworkConfigurations(
+      const NetworkConfiguration networkConfigs[], const unsigned char size)
+      = 0;
+  virtual void resetNetworkConfigurations() = 0;
+  virtual bool getNetworkHints(NetworkHints& hints) = 0;
+  virtual bool setNetworkHints(const NetworkHints& hints) = 0;
 
   // CRUD methods for remote
   virtual Remote createRemote(const char* name) = 0;
@@ -49,6 +58,42 @@ class DatabaseAbstract
   virtual bool updateRemote(const Remote& remote) = 0;
   virtual bool deleteRemote(const unsigned long& id) = 0;
 
+  // Travel times of the remotes
+  virtual bool getCalibration(const unsigned long& id, Calibration& calibration) = 0;
+  virtual bool setCalibration(const unsigned long& id, const Calibration& calibration) = 0;
+
+  // Highest nonce of the signed UDP commands that may have been accepted for a remote
+  virtual bool getNonceMark(const unsigned long& id, unsigned long& mark) = 0;
+  virtual bool setNonceMark(const unsigned long& id, const unsigned long mark) = 0;
+
+  // Schedules of the remotes
+  virtual void getAllSchedules(Schedule schedules[]) = 0;
+  virtual Schedule createSchedule(const Schedule& schedule) = 0;
+  virtual bool deleteSchedule(const unsigned char id) = 0;
+
+  // Groups of remotes and scenes
+  virtual void getAllGroups(Group groups[]) = 0;
+  virtual Group getGroup(const unsigned char id) = 0;
+  virtual Group createGroup(const Group& group) = 0;
+  virtual bool deleteGroup(const unsigned char id) = 0;
+  virtual void getAllScenes(Scene scenes[]) = 0;
+  virtual Scene getScene(const unsigned char id) = 0;
+  virtual Scene createScene(const Scene& scene) = 0;
+  virtual bool deleteScene(const unsigned char id) = 0;
+
+  // Macros
+  virtual void getAllMacros(Macro macros[]) = 0;
+  virtual Macro getMacro(const unsigned char id) = 0;
+  virtual Macro createMacro(const Macro& macro) = 0;
+  virtual bool deleteMacro(const unsigned char id) = 0;
+
+  // Writes between beginBatch() and endBatch() are committed once, by endBatch().
+  virtual void beginBatch() = 0;
+  virtual bool endBatch() = 0;
+
+  // Change feed of remotes
+  virtual void getChangesSince(const unsigned long& sequence, ChangeFeed& feed) = 0;
+
   private:
   virtual bool migrate() = 0;
 };
\ No newline at end of file
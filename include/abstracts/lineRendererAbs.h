@@ -0,0 +1,48 @@
+/**
+ * @file lineRendererAbs.h
+ * @author Laurette Alexandre
+ * @brief Header of the abstraction of the texts rendered line by line.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Position of a rendering, line by line. Starts zeroed.
+ */
+struct RenderCursor
+{
+  unsigned char section;
+  unsigned short item;
+  unsigned char line;
+  uint32_t next; // Ring buffers: sequence of the next entry to render.
+  uint32_t end; // Ring buffers: sequence following the newest entry when the rendering started.
+};
+
+class LineRendererAbstract
+{
+  public:
+  virtual size_t renderLine(RenderCursor& cursor, char* buffer, const size_t size) = 0;
+};
\ No newline at end of file
@@ -0,0 +1,39 @@
+/**
+ * @file mqttClientAbs.h
+ * @author Laurette Alexandre
+ * @brief Header of the MQTT client abstraction.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+class MqttClientAbstract
+{
+  public:
+  virtual void beginConnect(const char* clientId, const char* willTopic, const char* willPayload)
+      = 0;
+  virtual bool isConnected() = 0;
+  virtual bool subscribe(const char* topic) = 0;
+  // False when the message can't be sent right now (disconnected, buffers full).
+  virtual bool publish(const char* topic, const char* payload, const bool retain) = 0;
+};
\ No newline at end of file
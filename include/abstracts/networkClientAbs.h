@@ -29,12 +29,22 @@
 
 #include <networks.h>
 
+// Status of an asynchronous scan, a positive value is the number of networks found.
+const int NETWORK_SCAN_RUNNING = -1;
+const int NETWORK_SCAN_FAILED = -2;
+
 class NetworkClientAbstract
 {
   public:
-  virtual bool connect(const NetworkConfiguration& conf) = 0;
-  virtual bool connect(const char* ssid, const char* password) = 0;
+  virtual bool beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints = NULL) = 0;
+  virtual bool getConnectionHints(NetworkHints& hints) = 0;
+  virtual void disconnect() = 0;
   virtual String getIP() = 0;
   virtual bool isConnected() = 0;
-  virtual void getNetworks(Network networks[]) = 0;
+
+  // Asynchronous scan of the networks
+  virtual bool startScan() = 0;
+  virtual int getScanStatus() = 0;
+  virtual bool getScanResult(const int index, Network& network) = 0;
+  virtual void deleteScanResults() = 0;
 };
\ No newline at end of file
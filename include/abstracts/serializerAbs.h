@@ -28,8 +28,15 @@
 #pragma once
 
 #include <Arduino.h>
+#include <change.h>
+#include <boot.h>
+#include <admission.h>
 #include <remote.h>
 #include <networks.h>
+#include <schedule.h>
+#include <position.h>
+#include <scene.h>
+#include <macro.h>
 #include <systemInfos.h>
 
 class SerializerAbstract
@@ -37,7 +44,21 @@ class SerializerAbstract
   public:
   virtual String serializeRemote(const Remote& remote) = 0;
   virtual String serializeRemotes(const Remote remotes[], int size) = 0;
-  virtual String serializeNetworkConfig(const NetworkConfiguration& networkConfig) = 0;
+  virtual String serializeNetworkConfigs(const NetworkConfiguration networkConfigs[], int size) = 0;
   virtual String serializeNetworks(const Network networks[], int size) = 0;
   virtual String serializeSystemInfos(const SystemInfos& infos) = 0;
+  virtual String serializeChangeFeed(const ChangeFeed& feed) = 0;
+  virtual String serializeAdmissionMetrics(const AdmissionMetrics& metrics) = 0;
+  virtual String serializeBootProfile(const BootProfile& profile) = 0;
+  virtual String serializeSwitchoverStatus(const SwitchoverStatus& status) = 0;
+  virtual String serializeSchedule(const Schedule& schedule) = 0;
+  virtual String serializeSchedules(const Schedule schedules[], int size) = 0;
+  virtual String serializeRemotePosition(const RemotePosition& position) = 0;
+  virtual String serializeGroup(const Group& group) = 0;
+  virtual String serializeGroups(const Group groups[], int size) = 0;
+  virtual String serializeScene(const Scene& scene) = 0;
+  virtual String serializeScenes(const Scene scenes[], int size) = 0;
+  virtual String serializeSceneReport(const SceneReport& report) = 0;
+  virtual String serializeMacro(const Macro& macro) = 0;
+  virtual String serializeMacros(const Macro macros[], int size) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * @file admissionController.h
+ * @author Laurette Alexandre
+ * @brief Header of the admission control of the web server requests.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <admission.h>
+
+/**
+ * @brief Decide if a new request can be served with the memory left.
+ * Each priority has its own thresholds of free heap, largest free block and active requests.
+ * Static assets are shed first, remote actions last.
+ */
+class AdmissionController
+{
+  public:
+  AdmissionController();
+
+  static AdmissionPriority classify(const char* url, const unsigned char method);
+
+  bool admit(const AdmissionPriority priority, const uint32_t freeHeap,
+      const uint32_t maxFreeBlock);
+  void release(const AdmissionPriority priority);
+  void setThresholds(const AdmissionPriority priority, const AdmissionThresholds& thresholds);
+  AdmissionMetrics getMetrics();
+
+  private:
+  AdmissionMetrics m_metrics;
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * @file airtimeBudget.h
+ * @author Laurette Alexandre
+ * @brief Header of the airtime accounting of the radio.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+
+/**
+ * @brief Airtime of the radio, in total and per remote, over a sliding window.
+ * The window is made of AIRTIME_WINDOW_BUCKETS buckets of AIRTIME_BUCKET_DURATION: the oldest
+ * bucket is forgotten as a whole once the window has moved past it. Recording never allocates.
+ */
+class AirtimeBudget
+{
+  public:
+  void record(const unsigned long remoteId, const unsigned long duration, const unsigned long now);
+  unsigned long getUsed(const unsigned long now);
+  unsigned long getUsed(const unsigned long remoteId, const unsigned long now);
+  bool canSend(const unsigned long remoteId, const unsigned long now);
+
+  private:
+  struct RemoteAirtime
+  {
+    unsigned long remoteId; // 0 if the place is free.
+    unsigned long buckets[AIRTIME_WINDOW_BUCKETS]; // In milliseconds
+  };
+
+  unsigned long m_buckets[AIRTIME_WINDOW_BUCKETS] = {}; // In milliseconds
+  RemoteAirtime m_remotes[MAX_REMOTES] = {};
+  unsigned char m_current = 0;
+  unsigned long m_bucketStart = 0;
+
+  void advance(const unsigned long now);
+  RemoteAirtime* findRemote(const unsigned long remoteId, const bool create);
+};
\ No newline at end of file
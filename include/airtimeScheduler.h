@@ -0,0 +1,64 @@
+/**
+ * @file airtimeScheduler.h
+ * @author Laurette Alexandre
+ * @brief Header of the scheduler of the commands within the airtime budget.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <result.h>
+#include <controller.h>
+#include <airtimeBudget.h>
+
+/**
+ * @brief Send the commands that can wait, like the ones of the schedules, within the airtime
+ * budget. A command beyond the budget waits in a queue and is sent by loop() once the window
+ * has room again, one per call. A STOP is never delayed.
+ */
+class AirtimeScheduler
+{
+  public:
+  AirtimeScheduler(Controller* controller, AirtimeBudget* budget);
+
+  Result operateRemote(const unsigned long remoteId, const char* action, const unsigned long now);
+  void loop(const unsigned long now);
+  unsigned short getQueueSize();
+
+  private:
+  struct DelayedCommand
+  {
+    unsigned long remoteId; // 0 if the place is free.
+    char action[6];
+    unsigned long queuedAt;
+  };
+
+  Controller* m_controller;
+  AirtimeBudget* m_budget;
+  DelayedCommand m_queue[AIRTIME_QUEUE_SIZE] = {};
+
+  DelayedCommand* findPlace(const unsigned long remoteId);
+};
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * @file bootSequence.h
+ * @author Laurette Alexandre
+ * @brief Header of the staged boot sequence.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <boot.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+#include <accessPointAbs.h>
+#include <networkClientAbs.h>
+
+/**
+ * @brief Boot of the device, phase by phase.
+ * The transmitter, the database, the filesystem and the web server are brought up in setup().
+ * The network is then brought up from loop(): connection to the configured WiFi, access point
+ * on failure or without configuration, then a first scan of the networks. Each phase is timed.
+ */
+class BootSequence
+{
+  public:
+  BootSequence(NetworkConnector* networkConnector, NetworkClientAbstract* networkClient,
+      AccessPointAbstract* accessPoint, NetworkScanner* networkScanner);
+
+  void beginPhase(const BootPhase phase, const unsigned long now);
+  void endPhase(const BootPhase phase, const unsigned long now);
+  void startNetwork(const unsigned long now);
+  void loop(const unsigned long now);
+  void recordCommand(const unsigned long now);
+
+  BootPhase getPhase();
+  BootProfile getProfile();
+
+  private:
+  NetworkConnector* m_networkConnector;
+  NetworkClientAbstract* m_networkClient;
+  AccessPointAbstract* m_accessPoint;
+  NetworkScanner* m_networkScanner;
+  BootProfile m_profile;
+  unsigned long m_phaseStartedAt = 0;
+
+  void loopConnect(const unsigned long now);
+  void startAccessPoint(const unsigned long now);
+  void startScan(const unsigned long now);
+};
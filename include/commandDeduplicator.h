@@ -0,0 +1,73 @@
+/**
+ * @file commandDeduplicator.h
+ * @author Laurette Alexandre
+ * @brief Header of the deduplication of the remote commands.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <result.h>
+#include <eventBus.h>
+
+/**
+ * @brief Recognize the duplicates of the remote actions, to answer them from the result of the
+ * first one without a new transmission: each would burn a rolling code, the airtime of a frame
+ * and an EEPROM commit.
+ * The last COMMAND_DEDUPE_SIZE results are kept, the least recently used one is replaced. The
+ * commands of the other clients are followed on the event bus: once another action is sent to
+ * a remote, the same action again is not a duplicate anymore.
+ */
+class CommandDeduplicator
+{
+  public:
+  CommandDeduplicator(EventBus* eventBus);
+
+  bool find(const unsigned long remoteId, const char* action, const char* key,
+      const unsigned long now, Result& result);
+  void remember(const unsigned long remoteId, const char* action, const char* key,
+      const Result& result, const unsigned long now);
+
+  private:
+  struct Entry
+  {
+    unsigned long remoteId; // 0 if the place is free.
+    unsigned long keyHash; // 0 without key.
+    char action[6];
+    ResultCode code;
+    unsigned long sentAt;
+    unsigned long usedAt;
+    bool isLatest; // Last command sent to the remote.
+  };
+
+  EventBus* m_eventBus;
+  unsigned long m_lastSequence = 0;
+  Entry m_entries[COMMAND_DEDUPE_SIZE] = {};
+
+  void collectEvents();
+  void markSent(const unsigned long remoteId, const char* action);
+};
\ No newline at end of file
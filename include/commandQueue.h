@@ -0,0 +1,91 @@
+/**
+ * @file commandQueue.h
+ * @author Laurette Alexandre
+ * @brief Header of the queue of the remote actions received by HTTP.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <functional>
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <result.h>
+#include <controller.h>
+#include <commandDeduplicator.h>
+
+// Work queued by a request handler, e.g. a write to the database. Given the time it runs at.
+typedef std::function<Result(const unsigned long now)> CommandJob;
+
+/**
+ * @brief Remote actions and jobs received by the web server, operated later from loop(): a
+ * transmission blocks for more than 100 ms and an EEPROM commit for tens of milliseconds,
+ * too long for a callback of the TCP stack.
+ * Each command gets a ticket. Its request polls isDone() and takes its result once operated.
+ * Duplicates of remote actions are answered by the deduplicator, when the command is operated.
+ */
+class CommandQueue
+{
+  public:
+  CommandQueue(Controller* controller, CommandDeduplicator* deduplicator);
+
+  unsigned long push(
+      const unsigned long remoteId, const char* action, const char* key, const unsigned long now);
+  unsigned long push(CommandJob job, const unsigned long now);
+  bool runNext(const unsigned long now);
+  bool hasPending();
+  bool isDone(const unsigned long ticket);
+  bool take(const unsigned long ticket, Result& result);
+
+  private:
+  enum CommandState : unsigned char
+  {
+    COMMAND_FREE,
+    COMMAND_PENDING,
+    COMMAND_DONE,
+  };
+
+  struct Command
+  {
+    unsigned long ticket;
+    CommandState state;
+    unsigned long remoteId;
+    char action[6];
+    String key;
+    CommandJob job; // Run instead of the action when set.
+    unsigned long queuedAt; // Then the time it was operated.
+    ResultCode code;
+    bool isSuccess;
+    String data;
+  };
+
+  Controller* m_controller;
+  CommandDeduplicator* m_deduplicator;
+  Command m_commands[COMMAND_QUEUE_SIZE] = {};
+  unsigned long m_lastTicket = 0;
+
+  Command* reserve(const unsigned long now);
+  Command* findCommand(const unsigned long ticket);
+};
\ No newline at end of file
@@ -33,12 +33,185 @@ const char AP_SSID[] = "SomfyController Fallback Hotspot";
 const char AP_PASSWORD[] = "5cKErSRCyQzy";
 
 const int SERVER_PORT = 80;
+// Commands of the remotes by UDP, see udpCommandHandler.h for the format of the packets.
+const unsigned short UDP_COMMAND_PORT = 8266;
+// Shared key signing the UDP commands (HMAC-SHA256). Empty to accept unsigned commands.
+const char UDP_COMMAND_KEY[] = "";
+// Nonces of the last UDP commands remembered to ack their retransmissions without sending them
+// again, without key. With a key, the last nonce of each remote is kept instead.
+const unsigned short UDP_DEDUPE_SIZE = 16;
+// Nonces of the signed UDP commands reserved for a remote by each write of the EEPROM. Replays
+// across restarts are refused up to the mark saved, the clients skip at most this many nonces.
+const unsigned short UDP_NONCE_BLOCK = 64;
+// Results of the last HTTP actions, to answer their duplicates without sending them again. The
+// same action to a remote within the window is a duplicate, unless another command was sent to
+// the remote meanwhile. A request with an idempotency key is a duplicate of the one with the
+// same key only.
+const unsigned short COMMAND_DEDUPE_SIZE = 8;
+const unsigned long DUPLICATE_COMMAND_WINDOW = 1000; // In milliseconds
+const unsigned long IDEMPOTENCY_KEY_WINDOW = 60000; // In milliseconds
 
 const unsigned short MAX_NETWORK_SCAN = 15;
+// Number of WiFi networks kept in the database. The strongest visible one is joined.
+// Warning: Each one takes 97 bytes in the database.
+const unsigned short MAX_NETWORK_CONFIGURATIONS = 4;
+// Time given to the connection to the WiFi at boot before falling back to the access point.
+const unsigned short WIFI_CONNECT_TIMEOUT = 15000;
+// Time given to a connection using the access point and channel of the last connection, before
+// connecting again with a full scan.
+const unsigned short WIFI_HINTED_CONNECT_TIMEOUT = 4000;
+// Reuse the IP address of the last connection instead of asking the DHCP server.
+// Only safe if the router keeps the lease for this device (static lease).
+const bool WIFI_REUSE_IP = false;
+// Reconnections after a loss of the WiFi are spaced from 1 second up to 1 minute. Each delay
+// is drawn between its half and its whole, so devices rebooted together do not retry together.
+const unsigned short WIFI_RECONNECT_MIN_DELAY = 1000;
+const unsigned short WIFI_RECONNECT_MAX_DELAY = 60000;
+// The fallback access point is started after 2 minutes without WiFi.
+const unsigned long WIFI_OUTAGE_AP_DELAY = 120000;
+// Time given to a new WiFi configuration to connect before going back to the previous one.
+const unsigned short WIFI_SWITCHOVER_TIMEOUT = 20000;
+// Results of the scan of the networks are kept 30 seconds. A scan taking more than 10 seconds
+// is abandoned.
+const unsigned short NETWORK_SCAN_TTL = 30000;
+const unsigned short NETWORK_SCAN_TIMEOUT = 10000;
 
 // Only 16 chars for the name.
 // Warning: Increase with value will take more space in the database.
 // If some remotes exists. These will be erase.
 const unsigned short MAX_REMOTE_NAME_LENGTH = 17;  // 16 chars + 1 (\0)
 const unsigned short MAX_REMOTES = 16;
-const unsigned long REMOTE_BASE_ADDRESS = 0x100000;
\ No newline at end of file
+const unsigned long REMOTE_BASE_ADDRESS = 0x100000;
+
+// Schedules of the remotes, kept in the database.
+const unsigned short MAX_SCHEDULES = 32;
+// Local time zone, as a POSIX TZ string (Central European Time by default), and the NTP
+// server giving the time. Schedules only run once the time is known.
+const char TIME_ZONE[] = "CET-1CEST,M3.5.0,M10.5.0/3";
+const char NTP_SERVER[] = "pool.ntp.org";
+// Location of the sunrise and the sunset, in degrees (north and east are positive).
+const float LOCATION_LATITUDE = 48.8566;
+const float LOCATION_LONGITUDE = 2.3522;
+// A schedule on the sunrise or the sunset runs at most 12 hours before or after it.
+const short MAX_SUN_OFFSET_MINUTES = 720;
+// A schedule more than 1 minute late is skipped, the device was probably busy or the clock
+// jumped. After a jump of the clock of more than 1 hour, the schedules are planned again.
+const unsigned short SCHEDULE_MAX_LATENESS = 60; // In seconds
+const unsigned short SCHEDULE_MAX_CATCH_UP = 3600; // In seconds
+
+// Groups of remotes and scenes, kept in the database. A scene is a list of remotes with an
+// action each, and a delay before each of them. The transmissions of a scene or a group are
+// spaced by SCENE_STAGGER_GAP at least, so the receivers get each frame clearly.
+const unsigned short MAX_GROUPS = 8;
+const unsigned short MAX_SCENES = 8;
+const unsigned short MAX_SCENE_STEPS = MAX_REMOTES;
+const unsigned short SCENE_STAGGER_GAP = 50; // In milliseconds
+const unsigned short SCENE_MAX_DELAY = 60000; // In milliseconds
+// The rolling codes of a run are committed together, unless a step waits longer than this.
+const unsigned short SCENE_MAX_BATCH_DELAY = 2000; // In milliseconds
+
+// Macros, kept in the database: a sequence of actions and waits played on one remote, e.g.
+// DOWN, wait 1200 ms, STOP to tilt a blind. A STOP to the remote cancels its macro.
+const unsigned short MAX_MACROS = 8;
+const unsigned short MAX_MACRO_STEPS = 8;
+const unsigned short MACRO_MAX_WAIT = 60000; // In milliseconds
+const unsigned short MAX_RUNNING_MACROS = 4;
+
+// Airtime of the radio, counted over a sliding window of AIRTIME_WINDOW_BUCKETS buckets. The
+// 433 MHz band allows a duty cycle of 10 % and a command takes about 350 ms on air. Once the
+// budget is spent, the scheduled commands wait for airtime. The STOP and the commands of the
+// users are always sent, they are counted all the same.
+const unsigned short AIRTIME_WINDOW_BUCKETS = 6;
+const unsigned long AIRTIME_BUCKET_DURATION = 600000; // In milliseconds, a window of 1 hour
+const unsigned long AIRTIME_BUDGET = 360000; // In milliseconds per window
+// A single remote can't take more than a quarter of the budget for its scheduled commands.
+const unsigned long AIRTIME_REMOTE_BUDGET = 90000; // In milliseconds per window
+const unsigned short AIRTIME_COMMAND_ESTIMATE = 350; // In milliseconds
+// Scheduled commands waiting for airtime. A newer command of a remote replaces its waiting one.
+const unsigned short AIRTIME_QUEUE_SIZE = 8;
+
+// Travel times of the remotes, measured by the user, for the estimated positions. A remote
+// moved to a position is stopped by the controller once its travel time is elapsed.
+const unsigned long MIN_TRAVEL_TIME = 1000; // In milliseconds
+const unsigned long MAX_TRAVEL_TIME = 120000; // In milliseconds
+
+// Number of remote changes kept in RAM for the change feed.
+// Clients further behind than this will have to resync the whole list.
+const unsigned short MAX_CHANGES = 16;
+// The sequences of the changes start from a random base at each boot, below this value: a
+// sequence known from a previous boot is out of the log, its client has to resync.
+const unsigned long CHANGE_SEQUENCE_MAX_BASE = 0x40000000;
+
+// Events pushed to the subscribers of GET /api/v1/events. A subscriber further behind than
+// EVENT_BUFFER_SIZE events is dropped, its browser reconnects and is told to resync.
+// Warning: Each subscriber keeps a frame of EVENT_FRAME_LENGTH bytes in RAM.
+const unsigned short EVENT_BUFFER_SIZE = 16;
+const unsigned short MAX_EVENT_SUBSCRIBERS = 4;
+const unsigned short EVENT_FRAME_LENGTH = 160;
+// A comment is sent to idle subscribers, so the dead connections get closed.
+const unsigned short EVENT_HEARTBEAT_INTERVAL = 15000;
+
+// MQTT bridge, disabled while MQTT_HOST is empty. Commands are received on
+// <MQTT_BASE_TOPIC>/<chip id>/remotes/<remote id>/set, the states are retained on .../state and
+// the remotes are announced to Home Assistant as covers under MQTT_DISCOVERY_PREFIX.
+const char MQTT_HOST[] = "";
+const unsigned short MQTT_PORT = 1883;
+const char MQTT_USER[] = "";
+const char MQTT_PASSWORD[] = "";
+const char MQTT_BASE_TOPIC[] = "somfy";
+const char MQTT_DISCOVERY_PREFIX[] = "homeassistant";
+// Reconnections to the broker are spaced from 1 second up to 1 minute, like the WiFi ones.
+const unsigned short MQTT_RECONNECT_MIN_DELAY = 1000;
+const unsigned short MQTT_RECONNECT_MAX_DELAY = 60000;
+// Commands received and not operated yet. Commands beyond are dropped.
+const unsigned short MQTT_INBOX_SIZE = 16;
+// Publishes sent per loop() at most, the others wait for the next loop().
+const unsigned short MQTT_PUBLISH_BATCH = 8;
+const unsigned short MQTT_TOPIC_LENGTH = 64;
+// Longest message published, the discovery documents.
+const unsigned short MQTT_DOCUMENT_LENGTH = 512;
+
+// Tasks run from loop() by the task scheduler: the subsystems and the queued remote actions.
+const unsigned short MAX_TASKS = 16;
+// Remote actions and writes received by HTTP and not operated yet. Requests beyond get a 503.
+const unsigned short COMMAND_QUEUE_SIZE = 8;
+// A result not taken by its request within this time is forgotten, the client has left.
+const unsigned short COMMAND_RESULT_TTL = 10000; // In milliseconds
+
+// Size of the router tables. Increase them when adding endpoints.
+const unsigned short MAX_ROUTE_NODES = 48;
+const unsigned short MAX_ROUTES = 48;
+const unsigned short MAX_ROUTE_PARAMS = 2;
+
+// Static assets served from the manifest built by scripts/build_assets.py.
+const unsigned short MAX_ASSETS = 8;
+const unsigned short MAX_ASSET_PATH_LENGTH = 48;
+
+// Admission control of the web server. Below these limits, new requests get a 503.
+// Static assets are shed first, remote actions last. The active requests are counted per
+// priority: the event stream and the API requests do not hold back the assets of the page.
+const unsigned short ADMISSION_RETRY_AFTER = 2; // In seconds
+const unsigned short STATIC_MIN_FREE_HEAP = 12288;
+const unsigned short STATIC_MIN_FREE_BLOCK = 6144;
+const unsigned short STATIC_MAX_ACTIVE_REQUESTS = 2;
+const unsigned short API_MIN_FREE_HEAP = 8192;
+const unsigned short API_MIN_FREE_BLOCK = 4096;
+const unsigned short API_MAX_ACTIVE_REQUESTS = 4;
+const unsigned short ACTION_MIN_FREE_HEAP = 4096;
+const unsigned short ACTION_MIN_FREE_BLOCK = 2048;
+const unsigned short ACTION_MAX_ACTIVE_REQUESTS = 6;
+
+// Metrics. Latency histograms are kept for the first METRICS_MAX_ROUTES routes reached.
+const unsigned short METRICS_MAX_ROUTES = 16;
+const unsigned short METRICS_LATENCY_BUCKETS = 10; // The last one is +Inf.
+
+// Longest line of the texts streamed line by line (metrics, traces).
+const unsigned short RENDER_LINE_LENGTH = 160;
+
+// Number of trace spans kept when built with -D SOMFY_TRACE.
+const unsigned short TRACE_BUFFER_SIZE = 64;
+
+// Deferred logs kept in RAM until they are flushed to Serial, up to 3 numeric arguments each.
+const unsigned short DEFERRED_LOG_SIZE = 32;
+const unsigned short DEFERRED_LOG_MAX_ARGS = 3;
+const unsigned short DEFERRED_LOG_FLUSH_BATCH = 4; // Records written per loop() at most.
\ No newline at end of file
@@ -32,12 +32,15 @@
 #include <serializerAbs.h>
 #include <transmitterAbs.h>
 #include <networkClientAbs.h>
+#include <eventPublisherAbs.h>
+#include <networkSwitchoverAbs.h>
 
 class Controller
 {
   public:
   Controller(DatabaseAbstract* database, NetworkClientAbstract* networkClient, SerializerAbstract* serializer,
-      TransmitterAbstract* transmitter);
+      TransmitterAbstract* transmitter, NetworkSwitchoverAbstract* networkSwitchover,
+      EventPublisherAbstract* eventPublisher);
 
   Result fetchSystemInfos();
 
@@ -46,14 +49,54 @@ class Controller
   Result createRemote(const char* name);
   Result deleteRemote(const unsigned long id);
   Result updateRemote(const unsigned long id, const char* name, const unsigned int rollingCode);
+  Result checkCommand(const unsigned long id, const char* action);
   Result operateRemote(const unsigned long id, const char* action);
+  Result fetchRemoteChanges(const unsigned long since);
+  Result calibrateRemote(
+      const unsigned long id, const unsigned long upTime, const unsigned long downTime);
+
+  Result fetchAllSchedules();
+  Result createSchedule(const unsigned long remoteId, const char* action, const char* event,
+      const int minutes, const unsigned char days);
+  Result deleteSchedule(const unsigned long id);
+
+  Result fetchAllGroups();
+  Result createGroup(const char* name, const unsigned long remoteIds[], const unsigned char size);
+  Result deleteGroup(const unsigned long id);
+
+  Result fetchAllScenes();
+  Result createScene(const char* name, const unsigned long remoteIds[], const char* actions[],
+      const unsigned long delays[], const unsigned char size);
+  Result deleteScene(const unsigned long id);
+
+  Result fetchAllMacros();
+  Result createMacro(const char* name, const char* actions[], const unsigned long waits[],
+      const unsigned char size);
+  Result deleteMacro(const unsigned long id);
 
   Result fetchNetworkConfiguration();
   Result updateNetworkConfiguration(const char* ssid, const char* password);
+  Result updateNetworkConfigurations(
+      const char* ssids[], const char* passwords[], const unsigned char size);
+  Result fetchNetworkSwitchover();
 
   private:
+  // The actions of a remote, in the order of their names in controller.cpp.
+  enum RemoteAction : unsigned char
+  {
+    REMOTE_ACTION_UP,
+    REMOTE_ACTION_STOP,
+    REMOTE_ACTION_DOWN,
+    REMOTE_ACTION_PAIR,
+    REMOTE_ACTION_RESET,
+  };
+
   DatabaseAbstract* m_database;
   NetworkClientAbstract* m_networkClient;
   SerializerAbstract* m_serializer;
   TransmitterAbstract* m_transmitter;
+  NetworkSwitchoverAbstract* m_networkSwitchover;
+  EventPublisherAbstract* m_eventPublisher;
+
+  Result parseCommand(const unsigned long id, const char* action, RemoteAction& command);
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file deferredLog.h
+ * @author Laurette Alexandre
+ * @brief Header of the deferred logs, formatted out of the hot paths.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <lineRendererAbs.h>
+
+#define DEFERRED_LOG_LEVEL_NONE 0
+#define DEFERRED_LOG_LEVEL_ERROR 1
+#define DEFERRED_LOG_LEVEL_WARN 2
+#define DEFERRED_LOG_LEVEL_INFO 3
+#define DEFERRED_LOG_LEVEL_DEBUG 4
+
+// Calls above this level are removed at compile time. Ex: -D DEFERRED_LOG_LEVEL=4
+#ifndef DEFERRED_LOG_LEVEL
+#define DEFERRED_LOG_LEVEL DEFERRED_LOG_LEVEL_INFO
+#endif
+
+struct LogRecord
+{
+  uint32_t timestamp; // In milliseconds
+  PGM_P format; // A printf format in flash. Only numeric arguments, as %lu or %ld.
+  unsigned long args[DEFERRED_LOG_MAX_ARGS];
+  unsigned char level;
+};
+
+/**
+ * @brief Ring buffer of logs. A call only copies the format pointer and its raw arguments, the
+ * text is built later when the logs are flushed to Serial from the main loop or rendered by the
+ * API. The oldest records are overwritten when the buffer is full.
+ * There is a single writer at a time: web server callbacks and the main loop never preempt each
+ * other on the ESP8266. Interrupts must not log.
+ */
+class DeferredLog : public LineRendererAbstract
+{
+  public:
+  template <typename... Args>
+  void record(const unsigned char level, PGM_P format, Args... args)
+  {
+    static_assert(sizeof...(Args) <= DEFERRED_LOG_MAX_ARGS, "Too many arguments for a log.");
+    const unsigned long values[DEFERRED_LOG_MAX_ARGS + 1] = { (unsigned long)args..., 0 };
+    this->push(level, format, values);
+  }
+
+  unsigned short flush(Print& output, const unsigned short maxRecords);
+  unsigned long getDropped();
+
+  size_t renderLine(RenderCursor& cursor, char* buffer, const size_t size);
+
+  private:
+  LogRecord m_records[DEFERRED_LOG_SIZE];
+  uint32_t m_head = 0; // Sequence of the next record.
+  uint32_t m_flushed = 0; // Sequence of the next record to flush.
+  unsigned long m_dropped = 0; // Records overwritten before being flushed.
+
+  void push(const unsigned char level, PGM_P format, const unsigned long* values);
+  size_t formatRecord(const LogRecord& record, char* buffer, const size_t size);
+};
+
+extern DeferredLog deferredLog;
+
+// The records are written without lock: call these only from loop() or from the callbacks of the
+// web server and of the network clients, which run one after the other on the single core.
+// Never from an interrupt handler.
+#if DEFERRED_LOG_LEVEL >= DEFERRED_LOG_LEVEL_ERROR
+#define DLOG_ERROR(format, ...)                                                                    \
+  deferredLog.record(DEFERRED_LOG_LEVEL_ERROR, PSTR(format), ##__VA_ARGS__)
+#else
+#define DLOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if DEFERRED_LOG_LEVEL >= DEFERRED_LOG_LEVEL_WARN
+#define DLOG_WARN(format, ...)                                                                     \
+  deferredLog.record(DEFERRED_LOG_LEVEL_WARN, PSTR(format), ##__VA_ARGS__)
+#else
+#define DLOG_WARN(format, ...) do {} while (0)
+#endif
+
+#if DEFERRED_LOG_LEVEL >= DEFERRED_LOG_LEVEL_INFO
+#define DLOG_INFO(format, ...)                                                                     \
+  deferredLog.record(DEFERRED_LOG_LEVEL_INFO, PSTR(format), ##__VA_ARGS__)
+#else
+#define DLOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if DEFERRED_LOG_LEVEL >= DEFERRED_LOG_LEVEL_DEBUG
+#define DLOG_DEBUG(format, ...)                                                                    \
+  deferredLog.record(DEFERRED_LOG_LEVEL_DEBUG, PSTR(format), ##__VA_ARGS__)
+#else
+#define DLOG_DEBUG(format, ...) do {} while (0)
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * @file boot.h
+ * @author Laurette Alexandre
+ * @brief Header for the Boot Profile DTO.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+enum BootPhase : unsigned char
+{
+  BOOT_TRANSMITTER,
+  BOOT_DATABASE,
+  BOOT_FILESYSTEM,
+  BOOT_SERVER,
+  BOOT_WIFI_CONNECT,
+  BOOT_ACCESS_POINT,
+  BOOT_WIFI_SCAN,
+  BOOT_DONE,
+  BOOT_PHASES = BOOT_DONE // Number of timed phases.
+};
+
+struct BootProfile
+{
+  BootPhase phase; // The current phase.
+  unsigned long durations[BOOT_PHASES]; // In milliseconds, 0 if skipped or not done.
+  unsigned long serverReadyAt; // Milliseconds since power on.
+  unsigned long networkReadyAt; // Milliseconds since power on, 0 if not ready yet.
+  unsigned long firstCommandAt; // Milliseconds since power on, 0 if no command sent yet.
+};
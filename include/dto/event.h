@@ -0,0 +1,24 @@
+#pragma once
+
+#include <config.h>
+
+enum EventType : unsigned char
+{
+  EVENT_REMOTE_CREATED,
+  EVENT_REMOTE_RENAMED,
+  EVENT_REMOTE_DELETED,
+  EVENT_COMMAND_QUEUED,
+  EVENT_COMMAND_TRANSMITTED,
+  EVENT_COMMAND_FAILED,
+  EVENT_ROLLING_CODE_RESET,
+};
+
+struct Event
+{
+  unsigned long sequence;
+  EventType type;
+  unsigned long remoteId;
+  unsigned int rollingCode;
+  char name[MAX_REMOTE_NAME_LENGTH];
+  char action[6]; // Commands only, empty otherwise.
+};
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <config.h>
+
+struct MacroStep
+{
+  unsigned short wait; // In milliseconds, from this action to the next one.
+  unsigned char action; // As for the schedules: SCHEDULE_UP, SCHEDULE_STOP or SCHEDULE_DOWN.
+};
+
+// Empty places have the id 0.
+struct Macro
+{
+  unsigned char id;
+  char name[MAX_REMOTE_NAME_LENGTH];
+  unsigned char size;
+  MacroStep steps[MAX_MACRO_STEPS];
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+// State of a cover, as published to Home Assistant.
+enum CoverState : unsigned char
+{
+  COVER_UNKNOWN, // Never operated since the boot, nothing is published.
+  COVER_OPEN,
+  COVER_CLOSED,
+  COVER_STOPPED,
+};
+
+// Command received by MQTT, waiting for loop() to operate the remote.
+struct MqttCommand
+{
+  unsigned long remoteId;
+  char action[6];
+};
\ No newline at end of file
@@ -37,4 +37,33 @@ struct NetworkConfiguration
 {
   char ssid[33];
   char password[64];
+};
+
+// Access point and addresses of the last successful connection. Given back to the WiFi
+// stack, they skip the scan of all channels when connecting again.
+struct NetworkHints
+{
+  char ssid[33]; // The network these hints belong to.
+  unsigned char bssid[6];
+  unsigned char channel;
+  unsigned long ip; // 0 to get an address by DHCP.
+  unsigned long gateway;
+  unsigned long subnet;
+  unsigned long dns;
+};
+
+enum SwitchoverState : unsigned char
+{
+  SWITCHOVER_IDLE, // No change of configuration asked since boot.
+  SWITCHOVER_PENDING, // Asked, started by the next loop.
+  SWITCHOVER_CONNECTING,
+  SWITCHOVER_SUCCEEDED, // Connected to the new configuration, saved.
+  SWITCHOVER_ROLLED_BACK // The new configuration failed, the previous one is kept.
+};
+
+struct SwitchoverStatus
+{
+  SwitchoverState state;
+  unsigned long duration; // In milliseconds, from the start to the connection or the rollback.
+  char ssid[33]; // The network joined, empty if none.
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+// Position unknown: never fully opened or closed since the boot.
+const unsigned short POSITION_UNKNOWN = 0xFFFF;
+// Positions are kept in hundredths of percent, 0 is closed and POSITION_OPEN is open.
+const unsigned short POSITION_OPEN = 10000;
+
+enum Motion : unsigned char
+{
+  MOTION_IDLE,
+  MOTION_UP,
+  MOTION_DOWN,
+};
+
+// Travel times of a remote, from closed to open and back, in milliseconds. 0 if not calibrated.
+struct Calibration
+{
+  unsigned long upTime;
+  unsigned long downTime;
+};
+
+// Estimated position of a remote, in percent. -1 when unknown.
+struct RemotePosition
+{
+  unsigned long remoteId;
+  short position;
+  short target; // -1 without target.
+  Motion motion;
+  Calibration calibration;
+};
\ No newline at end of file
@@ -29,9 +29,75 @@
 
 #include <Arduino.h>
 
+// Every outcome of the controller. Messages are stored in flash (see result.cpp).
+// The values are sent as is in the UDP acks: add new codes at the end only, before RESULT_CODES.
+enum ResultCode : unsigned char
+{
+  RESULT_OK,
+  RESULT_REMOTE_ID_MISSING,
+  RESULT_REMOTE_NOT_FOUND,
+  RESULT_REMOTE_NAME_MISSING,
+  RESULT_REMOTE_NAME_EMPTY,
+  RESULT_REMOTE_NAME_TOO_LONG,
+  RESULT_REMOTE_UPDATE_FAILED,
+  RESULT_REMOTE_DELETED,
+  RESULT_NO_SPACE_LEFT,
+  RESULT_ACTION_MISSING,
+  RESULT_ACTION_INVALID,
+  RESULT_COMMAND_UP_SENT,
+  RESULT_COMMAND_STOP_SENT,
+  RESULT_COMMAND_DOWN_SENT,
+  RESULT_COMMAND_PAIR_SENT,
+  RESULT_ROLLING_CODE_RESET,
+  RESULT_SSID_MISSING,
+  RESULT_SSID_EMPTY,
+  RESULT_NETWORK_CONFIGURATION_UPDATE_FAILED,
+  RESULT_TOO_MANY_NETWORKS,
+  RESULT_NETWORK_SWITCHOVER_STARTED,
+  RESULT_NETWORK_SWITCHOVER_RUNNING,
+  RESULT_PACKET_INVALID,
+  RESULT_PACKET_UNAUTHORIZED,
+  RESULT_TOO_MANY_SUBSCRIBERS,
+  RESULT_SCHEDULE_INVALID,
+  RESULT_SCHEDULE_NOT_FOUND,
+  RESULT_SCHEDULE_DELETED,
+  RESULT_TOO_MANY_SCHEDULES,
+  RESULT_CALIBRATION_INVALID,
+  RESULT_REMOTE_CALIBRATED,
+  RESULT_REMOTE_NOT_CALIBRATED,
+  RESULT_POSITION_INVALID,
+  RESULT_POSITION_UNKNOWN,
+  RESULT_MOVING_TO_POSITION,
+  RESULT_GROUP_INVALID,
+  RESULT_GROUP_NOT_FOUND,
+  RESULT_GROUP_DELETED,
+  RESULT_TOO_MANY_GROUPS,
+  RESULT_SCENE_INVALID,
+  RESULT_SCENE_NOT_FOUND,
+  RESULT_SCENE_DELETED,
+  RESULT_TOO_MANY_SCENES,
+  RESULT_SCENE_RUNNING,
+  RESULT_MACRO_INVALID,
+  RESULT_MACRO_NOT_FOUND,
+  RESULT_MACRO_DELETED,
+  RESULT_TOO_MANY_MACROS,
+  RESULT_MACRO_STARTED,
+  RESULT_TOO_MANY_RUNNING_MACROS,
+  RESULT_COMMAND_DELAYED,
+  RESULT_AIRTIME_EXHAUSTED,
+  RESULT_TOO_MANY_PENDING_COMMANDS,
+  RESULT_PACKET_REPLAYED,
+  RESULT_CODES // Number of codes.
+};
+
 struct Result
 {
-  String data = "";
-  String error = "";
+  String data; // Serialized payload, moved from the serializer.
+  ResultCode code = RESULT_OK;
   bool isSuccess = false;
 };
+
+const __FlashStringHelper* getResultMessage(const ResultCode code);
+size_t getResultBodyLength(const ResultCode code);
+size_t readResultBody(
+    const ResultCode code, uint8_t* buffer, const size_t maxLen, const size_t index);
\ No newline at end of file
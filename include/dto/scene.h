@@ -0,0 +1,46 @@
+#pragma once
+
+#include <config.h>
+
+// Remotes operated together. Empty places have the id 0.
+struct Group
+{
+  unsigned char id;
+  char name[MAX_REMOTE_NAME_LENGTH];
+  unsigned char size;
+  unsigned long remoteIds[MAX_REMOTES];
+};
+
+struct SceneStep
+{
+  unsigned long remoteId;
+  unsigned short delay; // In milliseconds, after the previous step.
+  unsigned char action; // As for the schedules: SCHEDULE_UP, SCHEDULE_STOP or SCHEDULE_DOWN.
+};
+
+// Empty places have the id 0.
+struct Scene
+{
+  unsigned char id;
+  char name[MAX_REMOTE_NAME_LENGTH];
+  unsigned char size;
+  SceneStep steps[MAX_SCENE_STEPS];
+};
+
+struct SceneStepReport
+{
+  unsigned long remoteId;
+  unsigned long sentAt; // In milliseconds, since the start of the run.
+  unsigned char code; // ResultCode of the command.
+};
+
+// Outcome of the last run of a scene or a group.
+struct SceneReport
+{
+  unsigned long runId;
+  unsigned char sceneId; // 0 for a group.
+  unsigned char groupId; // 0 for a scene.
+  unsigned char size;
+  unsigned long duration; // In milliseconds, from the start to the last transmission.
+  SceneStepReport steps[MAX_SCENE_STEPS];
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+enum ScheduleEvent : unsigned char
+{
+  SCHEDULE_AT_TIME, // minutes after midnight, local time.
+  SCHEDULE_AT_SUNRISE, // minutes from the sunrise, negative before.
+  SCHEDULE_AT_SUNSET, // minutes from the sunset, negative before.
+};
+
+enum ScheduleAction : unsigned char
+{
+  SCHEDULE_UP,
+  SCHEDULE_STOP,
+  SCHEDULE_DOWN,
+};
+
+// Warning: Stored as is in the database, 8 bytes each.
+struct Schedule
+{
+  unsigned long remoteId;
+  signed short minutes : 12;
+  unsigned short event : 2; // ScheduleEvent
+  unsigned short action : 2; // ScheduleAction
+  unsigned char id; // 0 for an empty schedule.
+  unsigned char days; // Bit 0 for Sunday up to bit 6 for Saturday.
+};
\ No newline at end of file
@@ -27,9 +27,16 @@
  */
 #pragma once
 
+#include <change.h>
 #include <networks.h>
 #include <remote.h>
+#include <macro.h>
+#include <scene.h>
+#include <schedule.h>
+#include <position.h>
 #include <systemInfos.h>
+#include <changeLog.h>
+#include <remoteTable.h>
 #include <databaseAbs.h>
 
 class EEPROMDatabase : public DatabaseAbstract
@@ -40,9 +47,12 @@ class EEPROMDatabase : public DatabaseAbstract
 
   SystemInfos getSystemInfos();
 
-  NetworkConfiguration getNetworkConfiguration();
-  bool setNetworkConfiguration(const NetworkConfiguration& networkConfig);
-  void resetNetworkConfiguration();
+  unsigned char getNetworkConfigurations(NetworkConfiguration networkConfigs[]);
+  bool setNetworkConfigurations(
+      const NetworkConfiguration networkConfigs[], const unsigned char size);
+  void resetNetworkConfigurations();
+  bool getNetworkHints(NetworkHints& hints);
+  bool setNetworkHints(const NetworkHints& hints);
 
   // CRUD
   Remote createRemote(const char* name);
@@ -51,12 +61,76 @@ class EEPROMDatabase : public DatabaseAbstract
   bool updateRemote(const Remote& remote);
   bool deleteRemote(const unsigned long& id);
 
+  bool getCalibration(const unsigned long& id, Calibration& calibration);
+  bool setCalibration(const unsigned long& id, const Calibration& calibration);
+
+  bool getNonceMark(const unsigned long& id, unsigned long& mark);
+  bool setNonceMark(const unsigned long& id, const unsigned long mark);
+
+  void getAllSchedules(Schedule schedules[]);
+  Schedule createSchedule(const Schedule& schedule);
+  bool deleteSchedule(const unsigned char id);
+
+  void getAllGroups(Group groups[]);
+  Group getGroup(const unsigned char id);
+  Group createGroup(const Group& group);
+  bool deleteGroup(const unsigned char id);
+  void getAllScenes(Scene scenes[]);
+  Scene getScene(const unsigned char id);
+  Scene createScene(const Scene& scene);
+  bool deleteScene(const unsigned char id);
+  void getAllMacros(Macro macros[]);
+  Macro getMacro(const unsigned char id);
+  Macro createMacro(const Macro& macro);
+  bool deleteMacro(const unsigned char id);
+
+  void beginBatch();
+  bool endBatch();
+
+  void getChangesSince(const unsigned long& sequence, ChangeFeed& feed);
+
   private:
+  struct StoredNetworkHints
+  {
+    unsigned long magic; // NETWORK_HINTS_MAGIC when hints have been saved.
+    NetworkHints hints;
+  };
+
+  struct StoredNonceMark
+  {
+    unsigned long remoteId; // The remote of the place when the mark was written, 0 if none.
+    unsigned long mark;
+  };
+
+  ChangeLog m_changeLog;
+  // The remotes are read from here, the EEPROM is only written.
+  RemoteTable m_remoteTable;
+
   int m_lastSystemInfosAddressStart = 0;
   int m_networkConfigAddressStart = sizeof(SystemInfos);
   int m_remotesAddressStart = sizeof(SystemInfos) + sizeof(NetworkConfiguration);
+  // Added after the remotes to keep the layout of the existing databases.
+  int m_networkHintsAddressStart = m_remotesAddressStart + sizeof(Remote) * MAX_REMOTES;
+  // The first network is kept at m_networkConfigAddressStart, the others come after the hints.
+  int m_networkConfigsAddressStart = m_networkHintsAddressStart + sizeof(StoredNetworkHints);
+  // Schedules after the last network.
+  int m_schedulesAddressStart = m_networkConfigsAddressStart
+      + (MAX_NETWORK_CONFIGURATIONS - 1) * sizeof(NetworkConfiguration);
+  // Calibrations at the index of their remote.
+  int m_calibrationsAddressStart = m_schedulesAddressStart + MAX_SCHEDULES * sizeof(Schedule);
+  int m_groupsAddressStart = m_calibrationsAddressStart + MAX_REMOTES * sizeof(Calibration);
+  int m_scenesAddressStart = m_groupsAddressStart + MAX_GROUPS * sizeof(Group);
+  int m_macrosAddressStart = m_scenesAddressStart + MAX_SCENES * sizeof(Scene);
+  // Nonce marks at the index of their remote.
+  int m_nonceMarksAddressStart = m_macrosAddressStart + MAX_MACROS * sizeof(Macro);
+  bool m_isBatching = false;
+  bool m_isBatchDirty = false;
 
   bool migrate();
   bool stringIsAscii(const char* data);
+  bool versionIsValid(const char* version, const size_t size);
   int getRemoteIndex(const unsigned long& id);
+  void loadRemotes();
+  int getNetworkConfigAddress(const unsigned char index);
+  bool commit();
 };
\ No newline at end of file
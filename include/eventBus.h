@@ -0,0 +1,80 @@
+/**
+ * @file eventBus.h
+ * @author Laurette Alexandre
+ * @brief Fan out of the events to the subscribers of the event stream
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <remote.h>
+#include <eventPublisherAbs.h>
+
+/**
+ * @brief Fan out the events of the controller to the subscribers of the event stream, and to the
+ * readers inside the firmware (readEvent()).
+ * Events are kept once in a ring, each subscriber only has its position in it. Publishing never
+ * waits for a subscriber: the ones falling behind the ring are dropped.
+ */
+class EventBus : public EventPublisherAbstract
+{
+  public:
+  void publish(const EventType type, const Remote& remote, const char* action = nullptr);
+
+  short subscribe(const unsigned long lastEventId, const unsigned long now);
+  void unsubscribe(const short subscriber);
+  size_t read(const short subscriber, uint8_t* buffer, const size_t maxLength,
+      const unsigned long now);
+  bool isDropped(const short subscriber);
+
+  bool readEvent(unsigned long& sequence, Event& event);
+  bool hasMissed(const unsigned long sequence);
+
+  unsigned char getSubscriberCount();
+  unsigned long getLastSequence();
+
+  private:
+  struct Subscriber
+  {
+    bool isActive;
+    bool isDropped;
+    bool needsResync;
+    unsigned long nextSequence;
+    unsigned long lastWriteAt;
+    char frame[EVENT_FRAME_LENGTH];
+    size_t frameLength;
+    size_t frameOffset;
+  };
+
+  Event m_events[EVENT_BUFFER_SIZE];
+  unsigned long m_lastSequence = 0;
+  Subscriber m_subscribers[MAX_EVENT_SUBSCRIBERS] = {};
+
+  unsigned long getFirstSequence();
+  size_t renderFrame(Subscriber& subscriber, const unsigned long now);
+  size_t renderEvent(const Event& event, char* buffer, const size_t size);
+};
\ No newline at end of file
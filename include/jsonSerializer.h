@@ -30,8 +30,15 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
+#include <change.h>
+#include <boot.h>
+#include <admission.h>
 #include <remote.h>
 #include <networks.h>
+#include <schedule.h>
+#include <position.h>
+#include <scene.h>
+#include <macro.h>
 #include <systemInfos.h>
 #include <serializerAbs.h>
 
@@ -40,10 +47,28 @@ class JSONSerializer : public SerializerAbstract
   public:
   String serializeRemote(const Remote& remote);
   String serializeRemotes(const Remote remotes[], int size);
-  String serializeNetworkConfig(const NetworkConfiguration& networkConfig);
+  String serializeNetworkConfigs(const NetworkConfiguration networkConfigs[], int size);
   String serializeNetworks(const Network networks[], int size);
   String serializeSystemInfos(const SystemInfos& infos);
+  String serializeChangeFeed(const ChangeFeed& feed);
+  String serializeAdmissionMetrics(const AdmissionMetrics& metrics);
+  String serializeBootProfile(const BootProfile& profile);
+  String serializeSwitchoverStatus(const SwitchoverStatus& status);
+  String serializeSchedule(const Schedule& schedule);
+  String serializeSchedules(const Schedule schedules[], int size);
+  String serializeRemotePosition(const RemotePosition& position);
+  String serializeGroup(const Group& group);
+  String serializeGroups(const Group groups[], int size);
+  String serializeScene(const Scene& scene);
+  String serializeScenes(const Scene scenes[], int size);
+  String serializeSceneReport(const SceneReport& report);
+  String serializeMacro(const Macro& macro);
+  String serializeMacros(const Macro macros[], int size);
 
   private:
   void serializeRemote(JsonObject object, const Remote& remote);
+  void serializeSchedule(JsonObject object, const Schedule& schedule);
+  void serializeGroup(JsonObject object, const Group& group);
+  void serializeScene(JsonObject object, const Scene& scene);
+  void serializeMacro(JsonObject object, const Macro& macro);
 };
\ No newline at end of file
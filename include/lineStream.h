@@ -0,0 +1,52 @@
+/**
+ * @file lineStream.h
+ * @author Laurette Alexandre
+ * @brief Header of the stream copying rendered lines into response buffers.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <lineRendererAbs.h>
+
+/**
+ * @brief Copy the lines of a renderer into the buffers of a chunked response.
+ * Only one line is kept in memory.
+ */
+class LineStream
+{
+  public:
+  LineStream(LineRendererAbstract* renderer);
+
+  size_t read(uint8_t* buffer, const size_t maxLength);
+
+  private:
+  LineRendererAbstract* m_renderer;
+  RenderCursor m_cursor = { 0, 0, 0 };
+  char m_line[RENDER_LINE_LENGTH];
+  size_t m_lineLength = 0;
+  size_t m_lineOffset = 0;
+};
\ No newline at end of file
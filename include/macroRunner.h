@@ -0,0 +1,75 @@
+/**
+ * @file macroRunner.h
+ * @author Laurette Alexandre
+ * @brief Header of the runner of the macros.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <macro.h>
+#include <result.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <databaseAbs.h>
+
+/**
+ * @brief Play the macros on their remotes, from the main loop.
+ * The first action is sent by run(), each next one once the wait of the previous one is
+ * elapsed, counted from the start of its transmission: the motor moves from the first frame.
+ * A remote runs one macro at most, a new one replaces it. The commands are followed on the
+ * event bus: a STOP to the remote, sent by any client, cancels its macro.
+ */
+class MacroRunner
+{
+  public:
+  MacroRunner(Controller* controller, DatabaseAbstract* database, EventBus* eventBus);
+
+  Result run(const unsigned long remoteId, const unsigned long macroId, const unsigned long now);
+  void loop(const unsigned long now);
+  bool cancel(const unsigned long remoteId);
+  bool isRunning(const unsigned long remoteId);
+
+  private:
+  struct Run
+  {
+    unsigned long remoteId; // 0 if the place is free.
+    Macro macro;
+    unsigned char next;
+    unsigned long dueAt;
+  };
+
+  Controller* m_controller;
+  DatabaseAbstract* m_database;
+  EventBus* m_eventBus;
+  unsigned long m_lastSequence = 0;
+  Run m_runs[MAX_RUNNING_MACROS] = {};
+
+  void collectEvents(unsigned long ownRemoteId = 0, const char* ownAction = nullptr);
+  Result play(Run& run, const unsigned long now);
+  Run* findRun(const unsigned long remoteId);
+};
\ No newline at end of file
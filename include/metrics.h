@@ -0,0 +1,128 @@
+/**
+ * @file metrics.h
+ * @author Laurette Alexandre
+ * @brief Header of the registry of the operational metrics.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <admission.h>
+#include <lineRendererAbs.h>
+
+/**
+ * @brief Counters and latency histograms of the device.
+ * Everything lives in fixed size tables, recording a value never allocates. Metrics are
+ * rendered in the Prometheus text format, one line at a time.
+ */
+class MetricsRegistry : public LineRendererAbstract
+{
+  public:
+  MetricsRegistry();
+
+  void observeRouteLatency(const short route, const char* path, const unsigned char methods,
+      const unsigned long duration);
+  void recordEepromCommit(const unsigned long duration);
+  void recordTransmission(const unsigned long remoteId, const unsigned long duration);
+  void recordWifiConnect(const bool hinted, const unsigned long duration);
+  void recordWifiHintMiss();
+  void recordWifiDisconnect();
+  void recordWifiReconnectAttempt();
+  void recordWifiOutage(const unsigned long duration);
+  void recordSuppressedCommand(const bool isKeyed);
+  void recordAdmission(const AdmissionPriority priority, const bool isAdmitted);
+  void observeAirtime(const unsigned long used, const unsigned short queued);
+  void recordAirtimeDelay(const unsigned long duration);
+  void recordTask(const unsigned char task, const char* name, const unsigned long duration,
+      const unsigned long latency);
+
+  size_t renderLine(RenderCursor& cursor, char* buffer, const size_t size);
+
+  private:
+  struct LatencyHistogram
+  {
+    short route; // -1 if the slot is free.
+    const char* path;
+    unsigned char methods;
+    unsigned long buckets[METRICS_LATENCY_BUCKETS];
+    uint64_t sum; // In microseconds
+  };
+
+  struct RemoteTransmissions
+  {
+    unsigned long remoteId;
+    unsigned long count;
+    uint64_t duration; // In microseconds
+  };
+
+  struct TaskRuns
+  {
+    const char* name; // nullptr if the slot is free.
+    unsigned long count;
+    uint64_t duration; // In microseconds
+    unsigned long maxDuration; // In microseconds
+    uint64_t latency; // In microseconds
+  };
+
+  LatencyHistogram m_routes[METRICS_MAX_ROUTES];
+  TaskRuns m_tasks[MAX_TASKS] = {};
+  RemoteTransmissions m_transmissions[MAX_REMOTES];
+  unsigned char m_transmissionsSize = 0;
+  unsigned long m_eepromCommits = 0;
+  uint64_t m_eepromCommitDuration = 0; // In microseconds
+  uint64_t m_radioBusyDuration = 0; // In microseconds
+  // Index 0 without hints, 1 with hints.
+  unsigned long m_wifiConnects[2] = { 0, 0 };
+  uint64_t m_wifiConnectDuration[2] = { 0, 0 }; // In microseconds
+  unsigned long m_wifiHintMisses = 0;
+  unsigned long m_wifiDisconnects = 0;
+  unsigned long m_wifiReconnectAttempts = 0;
+  uint64_t m_wifiOutageDuration = 0; // In microseconds
+  // Index 0 within the duplicate window, 1 by idempotency key.
+  unsigned long m_suppressedCommands[2] = { 0, 0 };
+  unsigned long m_admittedRequests[ADMISSION_PRIORITIES] = {};
+  unsigned long m_shedRequests[ADMISSION_PRIORITIES] = {};
+  unsigned long m_airtimeUsed = 0; // In milliseconds, in the current window
+  unsigned short m_airtimeQueued = 0;
+  unsigned long m_airtimeDelays = 0;
+  uint64_t m_airtimeDelayDuration = 0; // In microseconds
+
+  size_t renderSection(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderValue(RenderCursor& cursor, char* buffer, const size_t size, const char* name,
+      const char* type, const char* value);
+  size_t renderWifiConnects(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderSuppressedCommands(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderAdmissions(RenderCursor& cursor, char* buffer, const size_t size,
+      const char* name, const unsigned long counts[]);
+  size_t renderTransmissions(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderRemoteAirtime(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderRouteLatencies(RenderCursor& cursor, char* buffer, const size_t size);
+  size_t renderTasks(RenderCursor& cursor, char* buffer, const size_t size, const char* name,
+      const char* type, const unsigned char series);
+  size_t nextSection(RenderCursor& cursor);
+};
+
+extern MetricsRegistry metrics;
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file mqttBridge.h
+ * @author Laurette Alexandre
+ * @brief Bridge between the controller and a MQTT broker
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <mqtt.h>
+#include <event.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <databaseAbs.h>
+#include <mqttClientAbs.h>
+
+/**
+ * @brief Bridge between the controller and a MQTT broker.
+ * Commands received on the command topics are queued and operated from loop(). The events of
+ * the controller are folded per remote, so a burst of commands gives one state per remote,
+ * and published by batches of MQTT_PUBLISH_BATCH. The connection to the broker is retried with
+ * an exponential and randomised backoff.
+ */
+class MqttBridge
+{
+  public:
+  MqttBridge(Controller* controller, DatabaseAbstract* database, EventBus* eventBus,
+      MqttClientAbstract* client);
+
+  void begin(const char* nodeId);
+  void loop(const unsigned long now);
+  bool receive(const char* topic, const char* payload, const size_t length);
+
+  bool isConnected();
+  unsigned char getAttempts();
+
+  private:
+  // What is left to publish for a remote.
+  static const unsigned char PENDING_DISCOVERY = 1;
+  static const unsigned char PENDING_STATE = 2;
+  static const unsigned char PENDING_REMOVAL = 4;
+
+  struct RemoteState
+  {
+    unsigned long id; // 0 if the place is free.
+    CoverState state;
+    unsigned char pending;
+  };
+
+  Controller* m_controller;
+  DatabaseAbstract* m_database;
+  EventBus* m_eventBus;
+  MqttClientAbstract* m_client;
+
+  char m_nodeId[16] = "";
+  // <MQTT_BASE_TOPIC>/<node id>, short enough for the topics of the remotes to fit.
+  char m_baseTopic[MQTT_TOPIC_LENGTH / 2] = "";
+  bool m_isStarted = false;
+  bool m_isConnected = false;
+  unsigned char m_attempts = 0;
+  unsigned long m_nextAttemptAt = 0;
+
+  // Written by receive() from the network stack, read by loop().
+  MqttCommand m_inbox[MQTT_INBOX_SIZE];
+  volatile unsigned short m_inboxHead = 0;
+  volatile unsigned short m_inboxTail = 0;
+
+  unsigned long m_lastSequence = 0;
+  RemoteState m_remotes[MAX_REMOTES] = {};
+  bool m_needsSubscribe = false;
+  bool m_needsOnline = false;
+  bool m_needsSync = false;
+
+  void operateNextCommand();
+  void collectEvents();
+  RemoteState* findRemote(const unsigned long id);
+  void connected();
+  void reconnect(const unsigned long now);
+  unsigned long nextDelay();
+  void sync();
+  void flush();
+  bool publishRemote(RemoteState& remote, unsigned short& budget);
+  bool publishDiscovery(const unsigned long id);
+  void buildRemoteTopic(char* topic, const unsigned long id, const char* suffix);
+  void buildDiscoveryTopic(char* topic, const unsigned long id);
+};
\ No newline at end of file
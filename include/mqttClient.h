@@ -0,0 +1,60 @@
+/**
+ * @file mqttClient.h
+ * @author Laurette Alexandre
+ * @brief MQTT client on top of AsyncMqttClient
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <functional>
+
+#include <AsyncMqttClient.h>
+
+#include <config.h>
+#include <mqttClientAbs.h>
+
+// Called from the network stack for each message received.
+typedef std::function<void(const char* topic, const char* payload, const size_t length)>
+    MqttMessageHandler;
+
+class MqttClient : public MqttClientAbstract
+{
+  public:
+  MqttClient(const char* host, const unsigned short port, const char* user, const char* password);
+
+  void onMessage(MqttMessageHandler handler);
+
+  void beginConnect(const char* clientId, const char* willTopic, const char* willPayload);
+  bool isConnected();
+  bool subscribe(const char* topic);
+  bool publish(const char* topic, const char* payload, const bool retain);
+
+  private:
+  AsyncMqttClient m_client;
+  MqttMessageHandler m_handler;
+  // Kept by AsyncMqttClient as pointers, they must outlive the connection.
+  char m_clientId[MQTT_TOPIC_LENGTH] = "";
+  char m_willTopic[MQTT_TOPIC_LENGTH] = "";
+  char m_willPayload[16] = "";
+};
\ No newline at end of file
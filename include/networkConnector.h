@@ -0,0 +1,75 @@
+/**
+ * @file networkConnector.h
+ * @author Laurette Alexandre
+ * @brief Connection to the best known WiFi network
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <config.h>
+#include <networks.h>
+#include <databaseAbs.h>
+#include <networkScanner.h>
+#include <networkClientAbs.h>
+
+/**
+ * @brief Start the connection to the best known network.
+ * The network of the saved hints is joined first, without scanning. Otherwise, with several
+ * known networks, the strongest visible one in the scan cache is joined, once a fresh scan is
+ * available.
+ */
+class NetworkConnector
+{
+  public:
+  NetworkConnector(DatabaseAbstract* database, NetworkClientAbstract* networkClient,
+      NetworkScanner* networkScanner);
+
+  unsigned char loadConfigurations();
+  bool connect(const unsigned long now, const bool withHints);
+  bool connect(const unsigned long now, const NetworkConfiguration networkConfigs[],
+      const unsigned char size);
+  bool loop(const unsigned long now);
+  void saveHints();
+
+  bool isSelecting();
+  bool isHinted();
+  unsigned long getStartedAt();
+  const char* getSsid();
+  bool isConnectedToConfiguration();
+
+  private:
+  DatabaseAbstract* m_database;
+  NetworkClientAbstract* m_networkClient;
+  NetworkScanner* m_networkScanner;
+  NetworkConfiguration m_networkConfigs[MAX_NETWORK_CONFIGURATIONS];
+  unsigned char m_size = 0;
+  short m_index = -1; // The configuration being joined, -1 if none.
+  bool m_isSelecting = false;
+  bool m_isHinted = false;
+  unsigned long m_startedAt = 0;
+
+  short findConfiguration(const char* ssid);
+  bool connectAmongConfigurations(const unsigned long now);
+  bool connectStrongest();
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file networkScanner.h
+ * @author Laurette Alexandre
+ * @brief Header of the cache of the networks found by asynchronous scans.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <networks.h>
+#include <networkClientAbs.h>
+
+#include <config.h>
+
+/**
+ * @brief Keep the networks found by the last asynchronous scan.
+ * Networks are deduplicated by SSID (the strongest signal is kept) and sorted by RSSI. Cached
+ * results are served right away, a new scan is started when they are older than the TTL.
+ */
+class NetworkScanner
+{
+  public:
+  NetworkScanner(NetworkClientAbstract* networkClient);
+
+  bool refresh(const unsigned long now);
+  bool refreshIfStale(const unsigned long now);
+  void loop(const unsigned long now);
+
+  const Network* getNetworks();
+  unsigned char getSize();
+  bool hasResults();
+  bool isScanning();
+  unsigned long getAge(const unsigned long now);
+  short selectNetwork(const NetworkConfiguration networkConfigs[], const unsigned char size);
+
+  private:
+  NetworkClientAbstract* m_networkClient;
+  Network m_networks[MAX_NETWORK_SCAN];
+  unsigned char m_size = 0;
+  bool m_hasResults = false;
+  bool m_isScanning = false;
+  unsigned long m_scanStartedAt = 0;
+  unsigned long m_scannedAt = 0;
+
+  void addNetwork(const Network& network);
+};
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * @file networkSwitchover.h
+ * @author Laurette Alexandre
+ * @brief Live switchover to a new WiFi configuration
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <networks.h>
+#include <config.h>
+#include <databaseAbs.h>
+#include <accessPointAbs.h>
+#include <networkConnector.h>
+#include <networkClientAbs.h>
+#include <networkSwitchoverAbs.h>
+
+/**
+ * @brief Apply a new WiFi configuration without rebooting.
+ * The new networks are tried first, the access point being kept up (or started) meanwhile so
+ * the device stays reachable. They are only saved once connected, otherwise the connection
+ * falls back to the saved ones.
+ */
+class NetworkSwitchover : public NetworkSwitchoverAbstract
+{
+  public:
+  NetworkSwitchover(DatabaseAbstract* database, NetworkConnector* networkConnector,
+      NetworkClientAbstract* networkClient, AccessPointAbstract* accessPoint);
+
+  bool begin(const NetworkConfiguration networkConfigs[], const unsigned char size);
+  void loop(const unsigned long now);
+
+  bool isRunning();
+  SwitchoverStatus getStatus();
+
+  private:
+  DatabaseAbstract* m_database;
+  NetworkConnector* m_networkConnector;
+  NetworkClientAbstract* m_networkClient;
+  AccessPointAbstract* m_accessPoint;
+  NetworkConfiguration m_networkConfigs[MAX_NETWORK_CONFIGURATIONS];
+  unsigned char m_size = 0;
+  SwitchoverStatus m_status = { SWITCHOVER_IDLE, 0, "" };
+  unsigned long m_startedAt = 0;
+  bool m_hasStartedAccessPoint = false;
+
+  void start(const unsigned long now);
+  void succeed(const unsigned long now);
+  void rollBack(const unsigned long now);
+};
\ No newline at end of file
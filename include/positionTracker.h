@@ -0,0 +1,85 @@
+/**
+ * @file positionTracker.h
+ * @author Laurette Alexandre
+ * @brief Header for the estimated positions of the remotes.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <result.h>
+#include <position.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <databaseAbs.h>
+
+/**
+ * @brief Estimated positions of the remotes, from their travel times.
+ * The commands sent by any client are followed on the event bus: a remote moves at a constant
+ * speed from the time of its UP or DOWN command until its STOP, or until its travel time is
+ * elapsed. moveTo() sends UP or DOWN, and loop() sends the STOP once the remote is estimated at
+ * the position, so the stop does not depend on the network delays of a client. The positions
+ * are unknown at boot, until a remote is fully opened or closed.
+ */
+class PositionTracker
+{
+  public:
+  PositionTracker(Controller* controller, DatabaseAbstract* database, EventBus* eventBus);
+
+  void loop(const unsigned long now);
+  Result moveTo(const unsigned long remoteId, const int position, const unsigned long now);
+  bool getPosition(const unsigned long remoteId, const unsigned long now, RemotePosition& position);
+
+  private:
+  struct Travel
+  {
+    unsigned long remoteId; // 0 if the place is free.
+    unsigned short position; // At the start of the motion, in hundredths of percent.
+    Motion motion;
+    unsigned long startedAt;
+    unsigned long duration; // Of a full travel in the direction of the motion.
+    bool hasStop;
+    unsigned long stopAt;
+    unsigned short target;
+    // Command sent by the tracker, already taken into account when its event is read.
+    bool isEchoPending;
+    Motion echo; // MOTION_IDLE for a STOP.
+  };
+
+  Controller* m_controller;
+  DatabaseAbstract* m_database;
+  EventBus* m_eventBus;
+  unsigned long m_lastSequence = 0;
+  Travel m_travels[MAX_REMOTES] = {};
+
+  void collectEvents(const unsigned long now);
+  void start(Travel& travel, const Motion motion, const unsigned long now);
+  void settle(Travel& travel, const unsigned long now);
+  bool isEcho(Travel& travel, const char* action);
+  unsigned short getPositionAt(const Travel& travel, const unsigned long now);
+  Travel* findTravel(const unsigned long remoteId, const bool create);
+};
\ No newline at end of file
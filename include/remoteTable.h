@@ -0,0 +1,61 @@
+/**
+ * @file remoteTable.h
+ * @author Laurette Alexandre
+ * @brief Header of the table of the remotes in RAM, read without locks.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include <config.h>
+#include <remote.h>
+
+/**
+ * @brief Copy in RAM of the remotes of the database, read from the network callbacks while the
+ * main loop writes it.
+ * Each place is a latch: a sequence and two copies of its remote. The single writer updates a
+ * copy while the readers take the other one, chosen by the parity of the sequence. A reader
+ * never waits for the writer, even stopped in the middle of a write: it only reads again if the
+ * writer has moved on meanwhile. No reader gets a remote half written.
+ */
+class RemoteTable
+{
+  public:
+  void write(const unsigned char index, const Remote& remote);
+  void read(const unsigned char index, Remote& remote) const;
+  int find(const unsigned long id) const;
+
+  private:
+  static const unsigned char REMOTE_WORDS = (sizeof(Remote) + 3) / 4;
+
+  struct Place
+  {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> copies[2][REMOTE_WORDS];
+  };
+
+  Place m_places[MAX_REMOTES] = {};
+};
\ No newline at end of file
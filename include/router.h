@@ -0,0 +1,95 @@
+/**
+ * @file router.h
+ * @author Laurette Alexandre
+ * @brief Header of the HTTP path router.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <config.h>
+
+class AsyncWebServerRequest;
+
+struct RouteParams
+{
+  unsigned long values[MAX_ROUTE_PARAMS];
+  unsigned char size;
+};
+
+typedef void (*RouteHandler)(AsyncWebServerRequest* request, const RouteParams& params);
+
+/**
+ * @brief Static trie of the API paths.
+ * Paths are registered once at setup, like "/api/v1/remotes/{id}/action". A "{...}" segment is
+ * an integer parameter. Literal segments take precedence over parameters, there is no
+ * backtracking. Nothing is allocated: nodes and routes live in fixed size tables.
+ */
+class Router
+{
+  public:
+  bool on(const char* path, const unsigned char methods, RouteHandler handler,
+      const char* header = nullptr);
+  RouteHandler match(const char* url, const unsigned char method, RouteParams& params);
+  short matchRoute(const char* url, const unsigned char method, RouteParams& params);
+
+  RouteHandler getHandler(const short route);
+  const char* getPath(const short route);
+  unsigned char getMethods(const short route);
+  const char* getHeader(const short route);
+
+  private:
+  // 9 digits always fit in an unsigned long.
+  static const unsigned char MAX_PARAM_DIGITS = 9;
+
+  struct Node
+  {
+    const char* segment; // Points into the registered path. Never copied.
+    unsigned char length;
+    bool isParam;
+    short firstChild;
+    short nextSibling;
+    short firstRoute;
+  };
+
+  struct Route
+  {
+    const char* path; // The registered path. Never copied.
+    unsigned char methods;
+    RouteHandler handler;
+    const char* header; // Request header read by the handler, nullptr if none. Never copied.
+    short next;
+  };
+
+  Node m_nodes[MAX_ROUTE_NODES] = { { "", 0, false, -1, -1, -1 } };
+  Route m_routes[MAX_ROUTES];
+  short m_nodesCount = 1; // The root node.
+  short m_routesCount = 0;
+  unsigned char m_longestSegment = MAX_PARAM_DIGITS; // Of the literals, and of the parameters.
+
+  short findChild(const short parent, const char* segment, const unsigned char length,
+      const bool isParam);
+  short addChild(const short parent, const char* segment, const unsigned char length,
+      const bool isParam);
+  bool parseParam(const char* segment, const size_t length, unsigned long& value);
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file sceneRunner.h
+ * @author Laurette Alexandre
+ * @brief Header of the runner of scenes and groups.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <scene.h>
+#include <result.h>
+#include <controller.h>
+#include <databaseAbs.h>
+
+/**
+ * @brief Run the scenes and the groups, one at a time, without blocking the main loop.
+ * A step is sent once its delay is elapsed, counted from the end of the previous transmission,
+ * and never less than SCENE_STAGGER_GAP after it. The rolling codes of a run are kept in a
+ * database batch and committed once, at its end.
+ */
+class SceneRunner
+{
+  public:
+  SceneRunner(Controller* controller, DatabaseAbstract* database);
+
+  Result runScene(const unsigned long id, const unsigned long now);
+  Result runGroup(const unsigned long id, const char* action, const unsigned long now);
+  bool loop(const unsigned long now);
+  bool isRunning();
+  unsigned long getRunId();
+  bool isFinished(const unsigned long runId);
+  const SceneReport& getReport();
+
+  private:
+  Controller* m_controller;
+  DatabaseAbstract* m_database;
+  Scene m_scene = {};
+  SceneReport m_report = {};
+  bool m_isRunning = false;
+  bool m_isBatching = false;
+  // The next step is planned at the first loop after a transmission, once it is over.
+  bool m_isPlanPending = false;
+  unsigned char m_next = 0;
+  unsigned long m_startedAt = 0;
+  unsigned long m_dueAt = 0;
+  unsigned long m_lastRunId = 0;
+
+  void start(const unsigned long now);
+  void finish(const unsigned long now);
+};
\ No newline at end of file
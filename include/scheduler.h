@@ -0,0 +1,66 @@
+/**
+ * @file scheduler.h
+ * @author Laurette Alexandre
+ * @brief Runs the schedules of the remotes
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <time.h>
+
+#include <config.h>
+#include <schedule.h>
+#include <timerWheel.h>
+#include <airtimeScheduler.h>
+#include <databaseAbs.h>
+
+/**
+ * @brief Operate the remotes at the times of their schedules.
+ * The next run of each schedule is kept in a timer wheel: loop() only moves the wheel to the
+ * current second, the schedules are not checked one by one. Once run, a schedule is planned
+ * again for its next day. The commands go through the airtime scheduler, they can wait for
+ * airtime.
+ */
+class Scheduler
+{
+  public:
+  Scheduler(DatabaseAbstract* database, AirtimeScheduler* airtimeScheduler);
+
+  void reload();
+  bool loop(const time_t now);
+  time_t getNextRun(const unsigned char id);
+
+  private:
+  DatabaseAbstract* m_database;
+  AirtimeScheduler* m_airtimeScheduler;
+  Schedule m_schedules[MAX_SCHEDULES];
+  TimerNode m_timers[MAX_SCHEDULES];
+  time_t m_nextRuns[MAX_SCHEDULES];
+  TimerWheel m_wheel;
+  bool m_isStarted = false;
+
+  void start(const time_t now);
+  void plan(const unsigned short index, const time_t after);
+  time_t computeNextRun(const Schedule& schedule, const time_t after);
+};
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+ * @file staticAssetHandler.h
+ * @author Laurette Alexandre
+ * @brief Header of the web server handler for pre-compressed static assets.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <FS.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+
+/**
+ * @brief Serve the gzip assets built by scripts/build_assets.py.
+ * The list of assets and their ETag is read once from the manifest. Hashed assets are cached
+ * forever by the browsers, pages are revalidated with their ETag (304 when unchanged).
+ */
+class StaticAssetHandler : public AsyncWebHandler
+{
+  public:
+  StaticAssetHandler(FS& fs);
+
+  bool load();
+  bool loadManifest(Stream& manifest);
+  bool addAsset(const char* line);
+  int findAsset(const char* url);
+
+  bool canHandle(AsyncWebServerRequest* request);
+  void handleRequest(AsyncWebServerRequest* request);
+
+  private:
+  struct Asset
+  {
+    char path[MAX_ASSET_PATH_LENGTH];
+    char etag[11]; // 8 hexadecimal chars between quotes.
+    bool immutable;
+  };
+
+  FS& m_fs;
+  Asset m_assets[MAX_ASSETS];
+  unsigned char m_assetsCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * @file taskScheduler.h
+ * @author Laurette Alexandre
+ * @brief Header of the cooperative scheduler of the tasks run from loop().
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+
+typedef void (*TaskFunction)(const unsigned long now);
+
+// Period of a task only run once woken up by wake().
+const unsigned long TASK_ON_WAKE = 0xFFFFFFFF;
+
+/**
+ * @brief Run the tasks of the device from loop(), one after the other: a task is a function
+ * doing a short step of its work and returning, the state is kept by its object.
+ * A task runs at each loop (period 0), every period, or once woken up by wake(), e.g. when
+ * work is queued for it. The run time and the time waited in the queue are recorded in the
+ * metrics for each task.
+ */
+class TaskScheduler
+{
+  public:
+  short add(const char* name, TaskFunction function, const unsigned long period);
+  void wake(const short task, const unsigned long now);
+  void loop(const unsigned long now);
+  unsigned char getSize();
+
+  private:
+  struct Task
+  {
+    const char* name; // Must stay valid forever (a literal).
+    TaskFunction function;
+    unsigned long period;
+    unsigned long dueAt;
+    bool isQueued;
+    bool isStarted; // A periodic task is due at once, its first run is never late.
+  };
+
+  Task m_tasks[MAX_TASKS] = {};
+  unsigned char m_size = 0;
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @file timerWheel.h
+ * @author Laurette Alexandre
+ * @brief Hierarchical timer wheel
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+// No timer, or end of a list of timers.
+const unsigned short TIMER_NONE = 0xFFFF;
+
+struct TimerNode
+{
+  unsigned long expires; // In seconds
+  unsigned short next;
+};
+
+/**
+ * @brief Hierarchical timer wheel, with a resolution of one second.
+ * Timers are kept in slots by expiry: the first level has a slot per second for the next 32
+ * seconds, each next level covers 32 times more. Advancing the time only visits the slot of the
+ * current second, and moves a slot of a higher level down when the lower level wraps, so the
+ * cost does not depend on the number of timers. Timers further than the last level (about 12
+ * days) are moved down later. The nodes are given by the owner of the timers, one per timer.
+ */
+class TimerWheel
+{
+  public:
+  TimerWheel(TimerNode* nodes, const unsigned short capacity);
+
+  void reset(const unsigned long now);
+  void schedule(const unsigned short timer, const unsigned long expires);
+  void advance(const unsigned long now);
+  int popExpired();
+
+  unsigned long getTime();
+
+  private:
+  static const unsigned char LEVELS = 4;
+  static const unsigned char SLOT_BITS = 5;
+  static const unsigned char SLOTS = 1 << SLOT_BITS;
+
+  TimerNode* m_nodes;
+  unsigned short m_capacity;
+  unsigned long m_time = 0;
+  unsigned short m_slots[LEVELS][SLOTS];
+  unsigned short m_expiredHead = TIMER_NONE;
+  unsigned short m_expiredTail = TIMER_NONE;
+
+  void place(const unsigned short timer);
+  void cascade(const unsigned char level, const unsigned char slot);
+  void appendExpired(const unsigned short timer);
+};
\ No newline at end of file
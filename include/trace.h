@@ -0,0 +1,91 @@
+/**
+ * @file trace.h
+ * @author Laurette Alexandre
+ * @brief Header of the trace spans of the hot paths.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <lineRendererAbs.h>
+
+struct TraceEvent
+{
+  const char* name; // A literal. Never copied.
+  uint32_t start; // In CPU cycles
+  uint32_t duration; // In CPU cycles
+};
+
+/**
+ * @brief Ring buffer of the last spans, rendered in the Chrome trace event format.
+ * Timestamps come from the cycle counter, they wrap every 53 seconds at 80MHz.
+ */
+class TraceBuffer : public LineRendererAbstract
+{
+  public:
+  void record(const char* name, const uint32_t start, const uint32_t end);
+  void clear();
+  unsigned short getSize();
+
+  size_t renderLine(RenderCursor& cursor, char* buffer, const size_t size);
+
+  private:
+  TraceEvent m_events[TRACE_BUFFER_SIZE];
+  uint32_t m_recorded = 0; // Sequence of the next span.
+  unsigned short m_size = 0;
+};
+
+#ifdef SOMFY_TRACE
+
+extern TraceBuffer traces;
+
+/**
+ * @brief Record the time spent in its scope.
+ */
+class TraceSpan
+{
+  public:
+  TraceSpan(const char* name)
+      : m_name(name)
+      , m_start(ESP.getCycleCount())
+  {
+  }
+  ~TraceSpan() { traces.record(this->m_name, this->m_start, ESP.getCycleCount()); }
+
+  private:
+  const char* m_name;
+  uint32_t m_start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+#else
+
+#define TRACE_SPAN(name)
+
+#endif // SOMFY_TRACE
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * @file udpCommandHandler.h
+ * @author Laurette Alexandre
+ * @brief Compact UDP protocol to operate the remotes
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <result.h>
+#include <controller.h>
+#include <databaseAbs.h>
+
+// Format of the UDP packets, numbers in big endian.
+//
+// Command:
+//   0      'S'
+//   1      Flags: UDP_FLAG_NONCE, UDP_FLAG_HMAC
+//   2..5   Remote id
+//   6      Action: UDP_ACTION_UP, UDP_ACTION_STOP, UDP_ACTION_DOWN, UDP_ACTION_PAIR,
+//          UDP_ACTION_RESET
+//   7..10  Nonce, if UDP_FLAG_NONCE. Retransmissions keep the same one.
+//          Required when UDP_COMMAND_KEY is set, and greater than the nonce of the last command
+//          accepted for the remote: a counter of the client, for instance. After a restart of
+//          the device, greater than the mark saved for the remote (see below).
+//   +8     HMAC-SHA256 of all the previous bytes, truncated to 8 bytes, if UDP_FLAG_HMAC.
+//          Required when UDP_COMMAND_KEY is set.
+//
+// Ack:
+//   0      'S'
+//   1      Flags of the command | UDP_FLAG_ACK
+//   2..5   Remote id
+//   6      Result code, see result.h
+//   7..10  Nonce, if UDP_FLAG_NONCE. With RESULT_PACKET_REPLAYED, the nonce of the last command
+//          accepted for the remote instead, the client goes on from there.
+const unsigned char UDP_MAGIC = 'S';
+const unsigned char UDP_FLAG_NONCE = 0x01;
+const unsigned char UDP_FLAG_HMAC = 0x02;
+const unsigned char UDP_FLAG_ACK = 0x80;
+const unsigned char UDP_ACTION_UP = 1;
+const unsigned char UDP_ACTION_STOP = 2;
+const unsigned char UDP_ACTION_DOWN = 3;
+const unsigned char UDP_ACTION_PAIR = 4;
+const unsigned char UDP_ACTION_RESET = 5;
+const unsigned char UDP_HEADER_SIZE = 7;
+const unsigned char UDP_NONCE_SIZE = 4;
+const unsigned char UDP_HMAC_SIZE = 8;
+const unsigned char UDP_MAX_PACKET_SIZE = UDP_HEADER_SIZE + UDP_NONCE_SIZE + UDP_HMAC_SIZE;
+const unsigned char UDP_MAX_ACK_SIZE = UDP_HEADER_SIZE + UDP_NONCE_SIZE;
+
+/**
+ * @brief Decode the commands received by UDP, operate them through the controller like the
+ * HTTP endpoint does, and encode their ack.
+ * Without key, the last UDP_DEDUPE_SIZE nonces are remembered: a retransmitted command gets the
+ * same ack without being sent twice on the radio.
+ * With a key, the nonce is required and the last one accepted is kept for each remote, the remote
+ * id being signed while the source address is not. An older nonce is refused, so a signed packet
+ * cannot be replayed. To hold across restarts, a mark is saved in the database for each remote
+ * before a nonce above it is accepted: the nonce plus UDP_NONCE_BLOCK, so the flash is written
+ * once per block of commands. After a restart, the nonces up to the mark are refused, the ack of
+ * the first refused one gives the mark and the client goes on from there.
+ */
+class UdpCommandHandler
+{
+  public:
+  UdpCommandHandler(Controller* controller, DatabaseAbstract* database, const char* key);
+
+  Result handle(const uint8_t* packet, const size_t length, uint8_t ack[UDP_MAX_ACK_SIZE],
+      size_t& ackLength);
+  void sign(const uint8_t* data, const size_t length, uint8_t hmac[UDP_HMAC_SIZE]);
+
+  private:
+  struct HandledCommand
+  {
+    unsigned long remoteId;
+    unsigned long nonce;
+    ResultCode code;
+    bool isSuccess;
+  };
+
+  struct AcceptedNonce
+  {
+    unsigned long remoteId;
+    unsigned long nonce; // The last one accepted, or the mark read from the database.
+    ResultCode code;
+    bool isSent; // False for a mark read from the database, there is no command to ack again.
+    unsigned long reserved; // The mark saved in the database, never below the nonce.
+    unsigned long acceptedAt; // Order of acceptance, the oldest is replaced when full.
+  };
+
+  Controller* m_controller;
+  DatabaseAbstract* m_database;
+  const char* m_key;
+  HandledCommand m_handled[UDP_DEDUPE_SIZE];
+  unsigned char m_handledSize = 0;
+  unsigned char m_handledNext = 0;
+  AcceptedNonce m_accepted[MAX_REMOTES];
+  unsigned char m_acceptedSize = 0;
+  unsigned long m_acceptedCount = 0;
+
+  bool isAuthentic(const uint8_t* packet, const size_t signedLength, const bool isSigned);
+  Result operate(const unsigned long remoteId, const unsigned char action);
+  Result operateOnce(const unsigned long remoteId, const unsigned char action,
+      const bool hasNonce, const unsigned long nonce);
+  Result operateSigned(const unsigned long remoteId, const unsigned char action,
+      const bool hasNonce, unsigned long& nonce);
+  short findAccepted(const unsigned long remoteId);
+  short loadAccepted(const unsigned long remoteId);
+  short findHandled(const unsigned long remoteId, const unsigned long nonce);
+  void remember(const unsigned long remoteId, const unsigned long nonce, const Result& result);
+};
\ No newline at end of file
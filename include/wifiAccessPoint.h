@@ -28,10 +28,13 @@
 #pragma once
 
 #include <Arduino.h>
+#include <accessPointAbs.h>
 
-class WifiAccessPoint
+class WifiAccessPoint : public AccessPointAbstract
 {
   public:
   void startAccessPoint(const char* ssid, const char* password = NULL);
+  void stopAccessPoint();
+  bool isRunning();
   String getIP();
 };
\ No newline at end of file
@@ -33,9 +33,18 @@
 class WifiClient : public NetworkClientAbstract
 {
   public:
-  bool connect(const NetworkConfiguration& conf);
-  bool connect(const char* ssid, const char* password);
+  void init();
+  bool beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints = NULL);
+  bool getConnectionHints(NetworkHints& hints);
+  void disconnect();
   String getIP();
   bool isConnected();
-  void getNetworks(Network networks[]);
+  bool startScan();
+  int getScanStatus();
+  bool getScanResult(const int index, Network& network);
+  void deleteScanResults();
+
+  static void fillHints(NetworkHints& hints, const char* ssid, const unsigned char* bssid,
+      const unsigned char channel, const unsigned long ip, const unsigned long gateway,
+      const unsigned long subnet, const unsigned long dns);
 };
\ No newline at end of file
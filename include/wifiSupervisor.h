@@ -0,0 +1,75 @@
+/**
+ * @file wifiSupervisor.h
+ * @author Laurette Alexandre
+ * @brief Supervision of the WiFi connection once booted
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <accessPointAbs.h>
+#include <networkConnector.h>
+#include <networkClientAbs.h>
+
+enum LinkState : unsigned char
+{
+  LINK_IDLE, // Not started yet.
+  LINK_DISABLED, // No WiFi configuration, the access point is the only way in.
+  LINK_UP,
+  LINK_DOWN
+};
+
+/**
+ * @brief Watch the connection to the WiFi once the device has booted.
+ * On a loss, the connection to the best known network is attempted again with an exponential
+ * and randomised backoff. The
+ * fallback access point is only started after WIFI_OUTAGE_AP_DELAY without WiFi, and stopped
+ * once the connection is back.
+ */
+class WifiSupervisor
+{
+  public:
+  WifiSupervisor(NetworkConnector* networkConnector, NetworkClientAbstract* networkClient,
+      AccessPointAbstract* accessPoint);
+
+  void loop(const unsigned long now);
+  void reset();
+
+  LinkState getState();
+  unsigned char getAttempts();
+
+  private:
+  NetworkConnector* m_networkConnector;
+  NetworkClientAbstract* m_networkClient;
+  AccessPointAbstract* m_accessPoint;
+  LinkState m_state = LINK_IDLE;
+  unsigned char m_attempts = 0;
+  unsigned long m_outageStartedAt = 0;
+  unsigned long m_nextAttemptAt = 0;
+
+  void start(const unsigned long now);
+  void linkLost(const unsigned long now);
+  void linkRecovered(const unsigned long now);
+  void reconnect(const unsigned long now);
+  unsigned long nextDelay();
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+"""
+Build the filesystem image content from the `data` directory.
+
+- Files under `static/` are renamed with a content hash (`esprtsomfy.<hash>.js`) and the
+  references in the HTML pages are rewritten. They can be cached forever by the browsers.
+- Every file is stored gzip compressed only (`<name>.gz`).
+- `assets.manifest` lists the served paths with their ETag, one per line:
+  `<path> <etag> <immutable>`.
+
+Run by PlatformIO before each build (see `extra_scripts` in platformio.ini), or by hand:
+`python scripts/build_assets.py`.
+"""
+import gzip
+import hashlib
+import os
+import shutil
+
+SOURCE_DIR = "data"
+OUTPUT_DIR = os.path.join(".pio", "assets")
+HASHED_DIR = "static"
+MANIFEST = "assets.manifest"
+
+
+def content_hash(content):
+    return hashlib.sha256(content).hexdigest()[:8]
+
+
+def hashed_name(path, digest):
+    root, ext = os.path.splitext(path)
+    return "{}.{}{}".format(root, digest, ext)
+
+
+def write_gzip(path, content):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    # mtime=0 keeps the output (and the filesystem image) reproducible.
+    with open(path, "wb") as output:
+        with gzip.GzipFile(fileobj=output, mode="wb", compresslevel=9, mtime=0) as compressed:
+            compressed.write(content)
+
+
+def build(project_dir):
+    source_dir = os.path.join(project_dir, SOURCE_DIR)
+    output_dir = os.path.join(project_dir, OUTPUT_DIR)
+    shutil.rmtree(output_dir, ignore_errors=True)
+
+    files = []
+    for root, _, names in os.walk(source_dir):
+        for name in sorted(names):
+            full_path = os.path.join(root, name)
+            files.append(os.path.relpath(full_path, source_dir).replace(os.sep, "/"))
+
+    manifest = []
+    renames = {}
+    size_before = 0
+    size_after = 0
+
+    # Hashed assets first: pages reference them.
+    for path in sorted(files):
+        if not path.startswith(HASHED_DIR + "/"):
+            continue
+        with open(os.path.join(source_dir, path), "rb") as asset:
+            content = asset.read()
+        digest = content_hash(content)
+        renames[path] = hashed_name(path, digest)
+        manifest.append((renames[path], digest, 1))
+        write_gzip(os.path.join(output_dir, renames[path] + ".gz"), content)
+        size_before += len(content)
+        size_after += os.path.getsize(os.path.join(output_dir, renames[path] + ".gz"))
+
+    for path in sorted(files):
+        if path in renames:
+            continue
+        with open(os.path.join(source_dir, path), "rb") as page:
+            content = page.read()
+        if path.endswith(".html"):
+            for original, renamed in renames.items():
+                content = content.replace(original.encode(), renamed.encode())
+        manifest.append((path, content_hash(content), 0))
+        write_gzip(os.path.join(output_dir, path + ".gz"), content)
+        size_before += len(content)
+        size_after += os.path.getsize(os.path.join(output_dir, path + ".gz"))
+
+    with open(os.path.join(output_dir, MANIFEST), "w") as output:
+        for path, digest, immutable in manifest:
+            output.write("/{} {} {}\n".format(path, digest, immutable))
+
+    print("Assets: {} bytes -> {} bytes gzip ({} files)".format(size_before, size_after, len(manifest)))
+
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO)
+    build(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
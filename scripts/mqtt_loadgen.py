@@ -0,0 +1,392 @@
+"""
+Send commands to many remotes at once through the MQTT bridge and measure the time taken by
+their states to come back.
+
+The remotes are found from their Home Assistant discovery documents, retained on the broker.
+Each round sends one command to every remote, back to back, then waits for all their states.
+The script prints the command-to-state latency percentiles and the commands per second.
+
+Against a controller, through its broker:
+`python scripts/mqtt_loadgen.py --host 192.168.1.10 --node 1a2b3c --rounds 5`
+The default payload is STOP, so the covers do not move.
+
+With `--loopback`, a broker and the bridge are emulated on 127.0.0.1 by this script. That
+checks the generator and the topics without a device. The figures are then only those of the
+host, `--transmit-ms` emulates the time taken by a radio transmission.
+
+Only the Python standard library is used: the MQTT 3.1.1 client (and broker) below only know
+the QoS 0.
+"""
+import argparse
+import json
+import os
+import queue
+import socket
+import struct
+import threading
+import time
+
+REMOTE_BASE_ADDRESS = 0x100000
+
+CONNECT = 0x10
+CONNACK = 0x20
+PUBLISH = 0x30
+SUBSCRIBE = 0x80
+SUBACK = 0x90
+PINGREQ = 0xC0
+PINGRESP = 0xD0
+DISCONNECT = 0xE0
+
+
+# ----------------------------------------------------------------------------
+# MQTT 3.1.1 packets
+# ----------------------------------------------------------------------------
+
+
+def encode_string(value):
+    data = value.encode() if isinstance(value, str) else value
+    return struct.pack(">H", len(data)) + data
+
+
+def encode_packet(header, body=b""):
+    length = len(body)
+    encoded = bytearray()
+    while True:
+        byte = length % 128
+        length //= 128
+        encoded.append(byte | (0x80 if length else 0))
+        if not length:
+            break
+    return bytes([header]) + bytes(encoded) + body
+
+
+def read_exactly(sock, size):
+    data = b""
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError("connection closed")
+        data += chunk
+    return data
+
+
+def read_packet(sock):
+    """Return (header, body) of the next packet."""
+    header = read_exactly(sock, 1)[0]
+    length, shift = 0, 0
+    while True:
+        byte = read_exactly(sock, 1)[0]
+        length += (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    return header, read_exactly(sock, length)
+
+
+def decode_publish(header, body):
+    """Return (topic, payload, retain) of a PUBLISH of QoS 0."""
+    size = struct.unpack(">H", body[:2])[0]
+    return body[2 : 2 + size].decode(), body[2 + size :], bool(header & 0x01)
+
+
+def encode_publish(topic, payload, retain):
+    return encode_packet(PUBLISH | (0x01 if retain else 0), encode_string(topic) + payload)
+
+
+def topic_matches(topic_filter, topic):
+    filters = topic_filter.split("/")
+    levels = topic.split("/")
+    for index, level in enumerate(filters):
+        if level == "#":
+            return True
+        if index >= len(levels) or (level != "+" and level != levels[index]):
+            return False
+    return len(filters) == len(levels)
+
+
+class MqttClient:
+    def __init__(self, host, port, client_id, user="", password="", on_message=None):
+        self.sock = socket.create_connection((host, port), timeout=10)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.on_message = on_message
+        self.send_lock = threading.Lock()
+        self.suback = threading.Event()
+        self.packet_id = 0
+
+        flags = 0x02
+        payload = encode_string(client_id)
+        if user:
+            flags |= 0x80
+            payload += encode_string(user)
+            if password:
+                flags |= 0x40
+                payload += encode_string(password)
+        body = encode_string("MQTT") + struct.pack(">BBH", 4, flags, 60) + payload
+        self.sock.sendall(encode_packet(CONNECT, body))
+        header, body = read_packet(self.sock)
+        if header & 0xF0 != CONNACK or body[1] != 0:
+            raise ConnectionError("connection refused by the broker")
+        self.sock.settimeout(None)
+        threading.Thread(target=self.read_loop, daemon=True).start()
+
+    def read_loop(self):
+        try:
+            while True:
+                header, body = read_packet(self.sock)
+                if header & 0xF0 == PUBLISH and self.on_message:
+                    self.on_message(*decode_publish(header, body))
+                elif header & 0xF0 == SUBACK:
+                    self.suback.set()
+        except (ConnectionError, OSError):
+            pass
+
+    def subscribe(self, topic_filter):
+        self.packet_id += 1
+        self.suback.clear()
+        body = struct.pack(">H", self.packet_id) + encode_string(topic_filter) + b"\x00"
+        self.send(encode_packet(SUBSCRIBE | 0x02, body))
+        if not self.suback.wait(10):
+            raise TimeoutError("no SUBACK for " + topic_filter)
+
+    def publish(self, topic, payload, retain=False):
+        self.send(encode_publish(topic, payload.encode(), retain))
+
+    def send(self, packet):
+        with self.send_lock:
+            self.sock.sendall(packet)
+
+    def close(self):
+        try:
+            self.send(encode_packet(DISCONNECT))
+        finally:
+            self.sock.close()
+
+
+# ----------------------------------------------------------------------------
+# Load
+# ----------------------------------------------------------------------------
+
+
+def find_remotes(client, received, prefix, node, wait):
+    """Return the (command topic, state topic) of the remotes announced on the broker."""
+    client.subscribe("{}/cover/+/config".format(prefix))
+    time.sleep(wait)
+    expected = "somfy_{}_".format(node) if node else "somfy_"
+    remotes = []
+    for topic, payload in sorted(received.items()):
+        if not topic.startswith(prefix + "/") or not payload:
+            continue
+        document = json.loads(payload)
+        if document.get("unique_id", "").startswith(expected):
+            remotes.append((document["command_topic"], document["state_topic"]))
+    return remotes
+
+
+def percentile(values, ratio):
+    index = min(len(values) - 1, int(round(ratio * (len(values) - 1))))
+    return values[index]
+
+
+def run(args):
+    received = {}
+    states = queue.Queue()
+
+    def on_message(topic, payload, retain):
+        received[topic] = payload
+        # The retained states come from before, only the live ones answer the commands.
+        if not retain:
+            states.put((time.monotonic(), topic))
+
+    client = MqttClient(
+        args.host,
+        args.port,
+        "somfy-loadgen-{}".format(os.getpid()),
+        args.user,
+        args.password,
+        on_message,
+    )
+    remotes = find_remotes(client, received, args.discovery_prefix, args.node, args.wait)
+    if not remotes:
+        print("No remote announced on the broker.")
+        return
+    for _, state_topic in remotes:
+        client.subscribe(state_topic)
+    time.sleep(args.wait)
+    while not states.empty():
+        states.get()
+
+    latencies = []
+    failures = 0
+    started = time.monotonic()
+    for _ in range(args.rounds):
+        sent = {}
+        for command_topic, state_topic in remotes:
+            sent[state_topic] = time.monotonic()
+            client.publish(command_topic, args.payload)
+        deadline = time.monotonic() + args.timeout
+        while sent and time.monotonic() < deadline:
+            try:
+                at, topic = states.get(timeout=max(0.0, deadline - time.monotonic()))
+            except queue.Empty:
+                break
+            if topic in sent:
+                latencies.append((at - sent.pop(topic)) * 1000)
+        failures += len(sent)
+    elapsed = time.monotonic() - started
+    client.close()
+
+    count = args.rounds * len(remotes)
+    if not latencies:
+        print("No state out of {} commands".format(count))
+        return
+    latencies.sort()
+    print(
+        "{} remotes  {:6.1f} cmd/s  p50 {:7.2f} ms  p95 {:7.2f} ms  max {:7.2f} ms"
+        "  failed {}/{}".format(
+            len(remotes),
+            len(latencies) / elapsed,
+            percentile(latencies, 0.5),
+            percentile(latencies, 0.95),
+            latencies[-1],
+            failures,
+            count,
+        )
+    )
+
+
+# ----------------------------------------------------------------------------
+# Emulation of a broker and of the bridge on the loopback, for --loopback
+# ----------------------------------------------------------------------------
+
+
+class LoopbackBroker:
+    def __init__(self):
+        self.server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.server.bind(("127.0.0.1", 0))
+        self.server.listen(16)
+        self.port = self.server.getsockname()[1]
+        self.lock = threading.Lock()
+        self.sessions = []
+        self.retained = {}
+        threading.Thread(target=self.accept_loop, daemon=True).start()
+
+    def accept_loop(self):
+        while True:
+            sock, _ = self.server.accept()
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            threading.Thread(target=self.session_loop, args=(sock,), daemon=True).start()
+
+    def session_loop(self, sock):
+        session = {"sock": sock, "filters": [], "lock": threading.Lock()}
+        try:
+            while True:
+                header, body = read_packet(sock)
+                kind = header & 0xF0
+                if kind == CONNECT:
+                    self.send(session, encode_packet(CONNACK, b"\x00\x00"))
+                    with self.lock:
+                        self.sessions.append(session)
+                elif kind == SUBSCRIBE:
+                    size = struct.unpack(">H", body[2:4])[0]
+                    topic_filter = body[4 : 4 + size].decode()
+                    with self.lock:
+                        session["filters"].append(topic_filter)
+                        retained = list(self.retained.items())
+                    self.send(session, encode_packet(SUBACK, body[:2] + b"\x00"))
+                    for topic, payload in retained:
+                        if topic_matches(topic_filter, topic):
+                            self.send(session, encode_publish(topic, payload, True))
+                elif kind == PUBLISH:
+                    self.route(*decode_publish(header, body))
+                elif kind == PINGREQ:
+                    self.send(session, encode_packet(PINGRESP))
+                elif kind == DISCONNECT:
+                    break
+        except (ConnectionError, OSError):
+            pass
+        with self.lock:
+            if session in self.sessions:
+                self.sessions.remove(session)
+        sock.close()
+
+    def route(self, topic, payload, retain):
+        with self.lock:
+            if retain and payload:
+                self.retained[topic] = payload
+            elif retain:
+                self.retained.pop(topic, None)
+            sessions = [
+                s for s in self.sessions if any(topic_matches(f, topic) for f in s["filters"])
+            ]
+        for session in sessions:
+            self.send(session, encode_publish(topic, payload, False))
+
+    def send(self, session, packet):
+        with session["lock"]:
+            session["sock"].sendall(packet)
+
+
+def emulate_bridge(port, node, count, transmit_ms):
+    """Answer the commands like the firmware: one transmission at a time, then the state."""
+    base = "somfy/{}".format(node)
+    states = {"OPEN": "open", "CLOSE": "closed", "STOP": "stopped"}
+    commands = queue.Queue()
+    client = MqttClient(
+        "127.0.0.1", port, "somfy-" + node, on_message=lambda t, p, r: commands.put((t, p))
+    )
+    client.subscribe(base + "/remotes/+/set")
+    client.publish(base + "/status", "online", True)
+    for index in range(1, count + 1):
+        remote_id = REMOTE_BASE_ADDRESS + index
+        remote_topic = "{}/remotes/{}".format(base, remote_id)
+        document = {
+            "name": "Remote {}".format(index),
+            "unique_id": "somfy_{}_{}".format(node, remote_id),
+            "command_topic": remote_topic + "/set",
+            "state_topic": remote_topic + "/state",
+            "availability_topic": base + "/status",
+        }
+        client.publish(
+            "homeassistant/cover/somfy_{}_{}/config".format(node, remote_id),
+            json.dumps(document),
+            True,
+        )
+
+    def worker():
+        while True:
+            topic, payload = commands.get()
+            state = states.get(payload.decode())
+            if state is None:
+                continue
+            time.sleep(transmit_ms / 1000)
+            client.publish(topic[: -len("/set")] + "/state", state, True)
+
+    threading.Thread(target=worker, daemon=True).start()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1", help="address of the broker")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--user", default="")
+    parser.add_argument("--password", default="")
+    parser.add_argument("--node", default="", help="chip id of the controller, all if empty")
+    parser.add_argument("--discovery-prefix", default="homeassistant")
+    parser.add_argument("--payload", choices=["OPEN", "CLOSE", "STOP"], default="STOP")
+    parser.add_argument("--rounds", type=int, default=5, help="commands per remote")
+    parser.add_argument("--timeout", type=float, default=10, help="seconds given to a round")
+    parser.add_argument("--wait", type=float, default=1, help="seconds to get retained messages")
+    parser.add_argument("--loopback", action="store_true", help="emulate broker and bridge")
+    parser.add_argument("--remotes", type=int, default=16, help="remotes of the emulated bridge")
+    parser.add_argument("--transmit-ms", type=float, default=0, help="emulated transmission")
+    args = parser.parse_args()
+
+    if args.loopback:
+        broker = LoopbackBroker()
+        args.host, args.port, args.node = "127.0.0.1", broker.port, "loopback"
+        emulate_bridge(broker.port, args.node, args.remotes, args.transmit_ms)
+    run(args)
+
+
+if __name__ == "__main__":
+    main()
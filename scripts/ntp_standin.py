@@ -0,0 +1,150 @@
+"""
+Answer the SNTP requests of the controller with a chosen time, to try the schedules.
+
+The controller asks `NTP_SERVER` for the time (see `include/config.h`). Point it to the host
+running this script, then choose the time it gets:
+- `--start 2026-03-29T00:55:00Z` starts the clock at this time (UTC), it then runs normally.
+- `--offset -3600` shifts the time of the host by this many seconds.
+
+The clock can be moved while running: type a number of seconds to jump (`-7200`, `+60`), or a
+new start time. That checks the schedules are not run again or skipped on a correction.
+
+`python scripts/ntp_standin.py --bind 0.0.0.0 --start 2026-10-25T00:25:00Z`
+
+With `--query`, the script asks a server for its time instead, to check the stand-in:
+`python scripts/ntp_standin.py --query 127.0.0.1 --port 12300`
+"""
+import argparse
+import datetime
+import socket
+import struct
+import sys
+import threading
+import time
+
+# Seconds from 1900-01-01 (NTP) to 1970-01-01 (Unix).
+NTP_EPOCH_OFFSET = 2208988800
+# Leap indicator 0, version 4, mode 4 (server).
+SERVER_HEADER = (0 << 6) | (4 << 3) | 4
+# Version 4, mode 3 (client).
+CLIENT_HEADER = (4 << 3) | 3
+
+
+def to_ntp(timestamp):
+    seconds = int(timestamp)
+    fraction = int((timestamp - seconds) * (1 << 32)) & 0xFFFFFFFF
+    return struct.pack(">LL", (seconds + NTP_EPOCH_OFFSET) & 0xFFFFFFFF, fraction)
+
+
+def from_ntp(data):
+    seconds, fraction = struct.unpack(">LL", data)
+    return seconds - NTP_EPOCH_OFFSET + fraction / (1 << 32)
+
+
+def parse_time(text):
+    value = datetime.datetime.fromisoformat(text.replace("Z", "+00:00"))
+    if value.tzinfo is None:
+        value = value.replace(tzinfo=datetime.timezone.utc)
+    return value.timestamp()
+
+
+class Clock:
+    """Time of the host, shifted by an offset that can be changed while serving."""
+
+    def __init__(self, offset):
+        self.offset = offset
+        self.lock = threading.Lock()
+
+    def now(self):
+        with self.lock:
+            return time.time() + self.offset
+
+    def jump(self, seconds):
+        with self.lock:
+            self.offset += seconds
+
+    def set(self, timestamp):
+        with self.lock:
+            self.offset = timestamp - time.time()
+
+
+def serve(sock, clock):
+    while True:
+        request, address = sock.recvfrom(512)
+        if len(request) < 48 or request[0] & 0x07 != 3:
+            continue
+        received = clock.now()
+        # Stratum 1, poll and precision as a GPS clock would give them.
+        response = struct.pack(">BBbb", SERVER_HEADER, 1, request[2], -20)
+        response += struct.pack(">LL", 0, 0) + b"GPS\0"
+        response += to_ntp(received)
+        # Originate timestamp: the transmit timestamp of the request.
+        response += request[40:48]
+        response += to_ntp(received) + to_ntp(clock.now())
+        sock.sendto(response, address)
+        print("{} <- {}".format(format_time(received), address[0]), flush=True)
+
+
+def format_time(timestamp):
+    return datetime.datetime.fromtimestamp(timestamp, datetime.timezone.utc).strftime(
+        "%Y-%m-%dT%H:%M:%SZ"
+    )
+
+
+def query(host, port, timeout):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.settimeout(timeout)
+    request = struct.pack(">B", CLIENT_HEADER) + b"\0" * 39 + to_ntp(time.time())
+    sent = time.time()
+    sock.sendto(request, (host, port))
+    response = sock.recv(512)
+    arrived = time.time()
+    if len(response) < 48 or response[0] & 0x07 != 4 or response[24:32] != request[40:48]:
+        sys.exit("Not a valid answer.")
+    transmitted = from_ntp(response[40:48])
+    print(
+        "{}  offset {:+.3f} s  round trip {:.1f} ms".format(
+            format_time(transmitted), transmitted - (sent + arrived) / 2, (arrived - sent) * 1000
+        )
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--bind", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=123, help="123 usually needs root")
+    parser.add_argument("--start", help="time given at start, ISO 8601, UTC if no zone")
+    parser.add_argument("--offset", type=float, default=0, help="seconds added to the host time")
+    parser.add_argument("--query", metavar="HOST", help="ask HOST for the time and exit")
+    parser.add_argument("--timeout", type=float, default=2)
+    args = parser.parse_args()
+
+    if args.query:
+        query(args.query, args.port, args.timeout)
+        return
+
+    clock = Clock(args.offset)
+    if args.start:
+        clock.set(parse_time(args.start))
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.port))
+    threading.Thread(target=serve, args=(sock, clock), daemon=True).start()
+    print("Serving {} on {}:{}".format(format_time(clock.now()), args.bind, args.port), flush=True)
+
+    for line in sys.stdin:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            if line[0] in "+-":
+                clock.jump(float(line))
+            else:
+                clock.set(parse_time(line))
+        except ValueError:
+            print("Give a number of seconds or an ISO 8601 time.")
+            continue
+        print("Clock now at {}".format(format_time(clock.now())), flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,252 @@
+"""
+Compare the latency and the throughput of the remote commands sent by UDP and by HTTP.
+
+Each command is sent once its previous ack is received. For both transports, the script prints
+the request-to-ack latency percentiles and the commands per second.
+
+- UDP: the packets described in `include/udpCommandHandler.h`, sent to `UDP_COMMAND_PORT`.
+  A command without ack is sent again with the same nonce, the controller acks it without
+  operating it twice. The nonces are a counter, as required with a key: when the controller
+  answers that a nonce is not newer than its last one, the counter goes on from there.
+- HTTP: `POST /api/v1/remotes/<id>/action`, one connection per command like the web page.
+
+Against a controller:
+`python scripts/udp_loadgen.py --host 192.168.1.42 --remote 1 --action stop --count 200`
+
+With `--loopback`, both endpoints are emulated on 127.0.0.1 by this script. That checks the
+generator and the packet format without a device. The figures are then only those of the host.
+
+The key is given with `--key` when `UDP_COMMAND_KEY` is set in the firmware.
+"""
+import argparse
+import hashlib
+import hmac
+import http.client
+import http.server
+import socket
+import struct
+import threading
+import time
+import urllib.parse
+
+MAGIC = ord("S")
+FLAG_NONCE = 0x01
+FLAG_HMAC = 0x02
+FLAG_ACK = 0x80
+HMAC_SIZE = 8
+ACTIONS = {"up": 1, "stop": 2, "down": 3, "pair": 4, "reset": 5}
+# Values of ResultCode in include/dto/result.h
+RESULT_COMMAND_SENT = {11, 12, 13, 14, 15}
+RESULT_PACKET_UNAUTHORIZED = 23
+RESULT_PACKET_REPLAYED = 53
+
+
+class Nonces:
+    """Counter of the nonces, started from the time so that a new run goes past the last one."""
+
+    def __init__(self):
+        self.value = int(time.time())
+
+    def next(self):
+        self.value = (self.value + 1) & 0xFFFFFFFF
+        return self.value
+
+    def resume_after(self, nonce):
+        self.value = max(self.value, nonce)
+
+
+def encode_command(remote_id, action, nonce, key):
+    flags = FLAG_NONCE | (FLAG_HMAC if key else 0)
+    packet = struct.pack(">BBLBL", MAGIC, flags, remote_id, ACTIONS[action], nonce)
+    if key:
+        packet += hmac.new(key, packet, hashlib.sha256).digest()[:HMAC_SIZE]
+    return packet
+
+
+def decode_ack(ack):
+    """Return (remote id, result code, nonce), None if the datagram is not an ack."""
+    if len(ack) != 11 or ack[0] != MAGIC or not ack[1] & FLAG_ACK:
+        return None
+    _, _, remote_id, code, nonce = struct.unpack(">BBLBL", ack)
+    return remote_id, code, nonce
+
+
+def send_udp(sock, address, remote_id, action, key, nonces, timeout, retries):
+    nonce = nonces.next()
+    packet = encode_command(remote_id, action, nonce, key)
+    sock.settimeout(timeout)
+    attempts = 0
+    while attempts <= retries:
+        attempts += 1
+        sock.sendto(packet, address)
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            try:
+                ack = decode_ack(sock.recv(64))
+            except socket.timeout:
+                break
+            if ack is None or ack[0] != remote_id:
+                continue
+            if ack[1] == RESULT_PACKET_REPLAYED and ack[2] >= nonce:
+                # The ack gives the last nonce accepted for the remote, sent again after it.
+                nonces.resume_after(ack[2])
+                nonce = nonces.next()
+                packet = encode_command(remote_id, action, nonce, key)
+                attempts -= 1
+                break
+            if ack[2] == nonce:
+                return ack[1]
+    return None
+
+
+def send_http(host, port, remote_id, action, timeout):
+    connection = http.client.HTTPConnection(host, port, timeout=timeout)
+    try:
+        connection.request(
+            "POST",
+            "/api/v1/remotes/{}/action".format(remote_id),
+            urllib.parse.urlencode({"action": action}),
+            {"Content-Type": "application/x-www-form-urlencoded"},
+        )
+        response = connection.getresponse()
+        response.read()
+        return response.status
+    except OSError:
+        return None
+    finally:
+        connection.close()
+
+
+def percentile(values, ratio):
+    index = min(len(values) - 1, int(round(ratio * (len(values) - 1))))
+    return values[index]
+
+
+def run(name, count, send):
+    latencies = []
+    failures = 0
+    started = time.monotonic()
+    for _ in range(count):
+        before = time.monotonic()
+        if send():
+            latencies.append((time.monotonic() - before) * 1000)
+        else:
+            failures += 1
+    elapsed = time.monotonic() - started
+
+    if not latencies:
+        print("{:5} no ack out of {} commands".format(name, count))
+        return
+    latencies.sort()
+    print(
+        "{:5} {:6.1f} cmd/s  p50 {:7.2f} ms  p95 {:7.2f} ms  p99 {:7.2f} ms  max {:7.2f} ms"
+        "  failed {}/{}".format(
+            name,
+            len(latencies) / elapsed,
+            percentile(latencies, 0.5),
+            percentile(latencies, 0.95),
+            percentile(latencies, 0.99),
+            latencies[-1],
+            failures,
+            count,
+        )
+    )
+
+
+# ----------------------------------------------------------------------------
+# Emulation of the controller on the loopback, for --loopback
+# ----------------------------------------------------------------------------
+
+
+def emulate_udp(sock, key):
+    handled = {}
+    accepted = {}
+    while True:
+        packet, address = sock.recvfrom(64)
+        if len(packet) < 7 or packet[0] != MAGIC:
+            continue
+        flags = packet[1]
+        remote_id = struct.unpack(">L", packet[2:6])[0]
+        nonce = struct.unpack(">L", packet[7:11])[0] if flags & FLAG_NONCE else 0
+        signed = packet[:-HMAC_SIZE] if flags & FLAG_HMAC else packet
+        if key and not hmac.compare_digest(
+            hmac.new(key, signed, hashlib.sha256).digest()[:HMAC_SIZE], packet[len(signed):]
+        ):
+            code = RESULT_PACKET_UNAUTHORIZED
+        elif key and (not flags & FLAG_NONCE or nonce < accepted.get(remote_id, 0)):
+            code = RESULT_PACKET_REPLAYED
+            nonce = accepted.get(remote_id, nonce)
+        else:
+            code = handled.setdefault((remote_id, nonce), 10 + packet[6])
+            accepted[remote_id] = nonce
+        ack = struct.pack(">BBLB", MAGIC, (flags & FLAG_NONCE) | FLAG_ACK, remote_id, code)
+        if flags & FLAG_NONCE:
+            ack += struct.pack(">L", nonce)
+        sock.sendto(ack, address)
+
+
+class EmulatedActionHandler(http.server.BaseHTTPRequestHandler):
+    def do_POST(self):
+        self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        body = b'{"message":"Command sent."}'
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def start_loopback(key):
+    udp = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    udp.bind(("127.0.0.1", 0))
+    threading.Thread(target=emulate_udp, args=(udp, key), daemon=True).start()
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), EmulatedActionHandler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    return udp.getsockname()[1], server.server_address[1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--udp-port", type=int, default=8266)
+    parser.add_argument("--http-port", type=int, default=80)
+    parser.add_argument("--remote", type=int, default=1, help="id of the remote to operate")
+    parser.add_argument("--action", choices=sorted(ACTIONS), default="stop")
+    parser.add_argument("--count", type=int, default=100, help="commands per transport")
+    parser.add_argument("--key", default="", help="UDP_COMMAND_KEY of the firmware")
+    parser.add_argument("--timeout", type=float, default=0.5, help="seconds before a retry")
+    parser.add_argument("--retries", type=int, default=2, help="UDP retransmissions")
+    parser.add_argument("--loopback", action="store_true", help="emulate the controller locally")
+    parser.add_argument("--skip-http", action="store_true")
+    args = parser.parse_args()
+
+    key = args.key.encode()
+    if args.loopback:
+        args.host = "127.0.0.1"
+        args.udp_port, args.http_port = start_loopback(key)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    address = (args.host, args.udp_port)
+    nonces = Nonces()
+    run(
+        "UDP",
+        args.count,
+        lambda: send_udp(
+            sock, address, args.remote, args.action, key, nonces, args.timeout, args.retries
+        )
+        in RESULT_COMMAND_SENT,
+    )
+    if not args.skip_http:
+        run(
+            "HTTP",
+            args.count,
+            lambda: send_http(args.host, args.http_port, args.remote, args.action, args.timeout * 4)
+            == 200,
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -26,8 +26,10 @@
  * SOFTWARE.
  */
 #include <Arduino.h>
-#include <DebugLog.h>
 
+#include <trace.h>
+#include <deferredLog.h>
+#include <metrics.h>
 #include <RTSTransmitter.h>
 
 #define PORT_TX D1
@@ -41,6 +43,11 @@
 #define SIG_HIGH GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, 1 << PORT_TX)
 #define SIG_LOW GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, 1 << PORT_TX)
 
+RTSTransmitter::RTSTransmitter(AirtimeBudget* airtime)
+    : m_airtime(airtime)
+{
+}
+
 void RTSTransmitter::init()
 {
   pinMode(PORT_TX, OUTPUT);
@@ -51,28 +58,28 @@ void RTSTransmitter::init()
 bool RTSTransmitter::sendUpCmd(const unsigned long remoteId, const unsigned int rollingCode)
 {
   this->buildFrame(remoteId, rollingCode, BYTE_ACTION_UP);
-  this->sendCommand();
+  this->transmit(remoteId);
   return true;
 }
 
 bool RTSTransmitter::sendStopCmd(const unsigned long remoteId, const unsigned int rollingCode)
 {
   this->buildFrame(remoteId, rollingCode, BYTE_ACTION_STOP);
-  this->sendCommand();
+  this->transmit(remoteId);
   return true;
 }
 
 bool RTSTransmitter::sendDownCmd(const unsigned long remoteId, const unsigned int rollingCode)
 {
   this->buildFrame(remoteId, rollingCode, BYTE_ACTION_DOWN);
-  this->sendCommand();
+  this->transmit(remoteId);
   return true;
 }
 
 bool RTSTransmitter::sendProgCmd(const unsigned long remoteId, const unsigned int rollingCode)
 {
   this->buildFrame(remoteId, rollingCode, BYTE_ACTION_PROG);
-  this->sendCommand();
+  this->transmit(remoteId);
   return true;
 }
 
@@ -87,6 +94,7 @@ size_t RTSTransmitter::getBytesFrameSize(){
 // PRIVATE
 void RTSTransmitter::buildFrame(const unsigned long remoteId, const unsigned int rollingCode, const byte action)
 {
+  TRACE_SPAN("rts.buildFrame");
   this->m_frame[0] = 0xA7;
   this->m_frame[1] = action << 4;
   this->m_frame[2] = rollingCode >> 8;
@@ -109,12 +117,28 @@ void RTSTransmitter::buildFrame(const unsigned long remoteId, const unsigned int
     this->m_frame[i] ^= this->m_frame[i - 1];
   }
 
-  // For debug
-  this->debugBuildedFrame(HEX);
-  this->debugBuildedFrame(BIN);
-  LOG_DEBUG("Frame builded.");
+  DLOG_DEBUG("Frame builded: %08lX%06lX.",
+      (unsigned long)this->m_frame[0] << 24 | (unsigned long)this->m_frame[1] << 16
+          | this->m_frame[2] << 8 | this->m_frame[3],
+      (unsigned long)this->m_frame[4] << 16 | this->m_frame[5] << 8 | this->m_frame[6]);
 };
 
+/**
+ * @brief Send the frame built and record the time the radio was busy, in the metrics and in
+ * the airtime budget.
+ *
+ * @param remoteId The remote sending the frame
+ */
+void RTSTransmitter::transmit(const unsigned long remoteId)
+{
+  TRACE_SPAN("rts.transmit");
+  const unsigned long start = micros();
+  this->sendCommand();
+  const unsigned long duration = micros() - start;
+  metrics.recordTransmission(remoteId, duration);
+  this->m_airtime->record(remoteId, duration / 1000, millis());
+}
+
 void RTSTransmitter::sendCommand()
 {
   this->sendCommand(2);
@@ -173,16 +197,4 @@ void RTSTransmitter::sendCommand(const byte sync)
 
   SIG_LOW;
   delayMicroseconds(30415); // Inter-frame silence
-};
-
-void RTSTransmitter::debugBuildedFrame(const int base)
-{
-  String debugFrame;
-  for (int i = 0; i < 7; i++)
-  {
-    debugFrame += String(this->m_frame[i], base);
-    debugFrame += " ";
-  }
-  debugFrame.toUpperCase();
-  LOG_DEBUG("Frame:", debugFrame);
-}
\ No newline at end of file
+};
\ No newline at end of file
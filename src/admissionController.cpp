@@ -0,0 +1,153 @@
+/**
+ * @file admissionController.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the admission control of the web server requests.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <admission.h>
+#include <admissionController.h>
+
+#define API_PREFIX "/api/"
+#define ACTION_SUFFIX "/action"
+
+AdmissionController::AdmissionController()
+{
+  memset(&this->m_metrics, 0, sizeof(AdmissionMetrics));
+  this->m_metrics.thresholds[ADMISSION_STATIC]
+      = { STATIC_MIN_FREE_HEAP, STATIC_MIN_FREE_BLOCK, STATIC_MAX_ACTIVE_REQUESTS };
+  this->m_metrics.thresholds[ADMISSION_API]
+      = { API_MIN_FREE_HEAP, API_MIN_FREE_BLOCK, API_MAX_ACTIVE_REQUESTS };
+  this->m_metrics.thresholds[ADMISSION_ACTION]
+      = { ACTION_MIN_FREE_HEAP, ACTION_MIN_FREE_BLOCK, ACTION_MAX_ACTIVE_REQUESTS };
+  this->m_metrics.lowestFreeHeap = UINT32_MAX;
+}
+
+/**
+ * @brief Give the priority of a request from its url and method.
+ * The body is not received yet at this point, so every remote action (STOP included) gets the
+ * highest priority.
+ *
+ * @param url The path of the request
+ * @param method The HTTP method of the request
+ * @return AdmissionPriority
+ */
+AdmissionPriority AdmissionController::classify(const char* url, const unsigned char method)
+{
+  if (strncmp(url, API_PREFIX, sizeof(API_PREFIX) - 1) != 0)
+  {
+    return ADMISSION_STATIC;
+  }
+  const size_t length = strlen(url);
+  const size_t suffixLength = sizeof(ACTION_SUFFIX) - 1;
+  if (method == HTTP_POST && length > suffixLength
+      && strcmp(url + length - suffixLength, ACTION_SUFFIX) == 0)
+  {
+    return ADMISSION_ACTION;
+  }
+  return ADMISSION_API;
+}
+
+/**
+ * @brief Try to admit a new request. An admitted request must be released when it ends.
+ *
+ * @param priority The priority of the request
+ * @param freeHeap The free heap at this time
+ * @param maxFreeBlock The largest free block of the heap at this time
+ * @return true if the request can be served
+ * @return false if it must be shed
+ */
+bool AdmissionController::admit(const AdmissionPriority priority, const uint32_t freeHeap,
+    const uint32_t maxFreeBlock)
+{
+  this->m_metrics.freeHeap = freeHeap;
+  this->m_metrics.maxFreeBlock = maxFreeBlock;
+  if (freeHeap < this->m_metrics.lowestFreeHeap)
+  {
+    this->m_metrics.lowestFreeHeap = freeHeap;
+  }
+
+  const AdmissionThresholds& thresholds = this->m_metrics.thresholds[priority];
+  if (freeHeap < thresholds.minFreeHeap || maxFreeBlock < thresholds.minFreeBlock
+      || this->m_metrics.active[priority] >= thresholds.maxActiveRequests)
+  {
+    this->m_metrics.shed[priority]++;
+    metrics.recordAdmission(priority, false);
+    LOG_WARN("Request shed. Priority:", priority, "free heap:", freeHeap,
+        "active requests:", this->m_metrics.active[priority]);
+    return false;
+  }
+
+  this->m_metrics.admitted[priority]++;
+  metrics.recordAdmission(priority, true);
+  this->m_metrics.active[priority]++;
+  this->m_metrics.activeRequests++;
+  if (this->m_metrics.activeRequests > this->m_metrics.peakActiveRequests)
+  {
+    this->m_metrics.peakActiveRequests = this->m_metrics.activeRequests;
+  }
+  return true;
+}
+
+/**
+ * @brief Release an admitted request.
+ *
+ * @param priority The priority it was admitted with
+ */
+void AdmissionController::release(const AdmissionPriority priority)
+{
+  if (this->m_metrics.active[priority] == 0)
+  {
+    return;
+  }
+  this->m_metrics.active[priority]--;
+  this->m_metrics.activeRequests--;
+}
+
+/**
+ * @brief Override the thresholds of a priority.
+ *
+ * @param priority The priority to configure
+ * @param thresholds The new thresholds
+ */
+void AdmissionController::setThresholds(
+    const AdmissionPriority priority, const AdmissionThresholds& thresholds)
+{
+  this->m_metrics.thresholds[priority] = thresholds;
+}
+
+/**
+ * @brief Get the counters and the thresholds of the admission control.
+ *
+ * @return AdmissionMetrics
+ */
+AdmissionMetrics AdmissionController::getMetrics()
+{
+  return this->m_metrics;
+}
\ No newline at end of file
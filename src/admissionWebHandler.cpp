@@ -0,0 +1,70 @@
+/**
+ * @file admissionWebHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the web server handler shedding requests under memory pressure.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <admissionController.h>
+#include <admissionWebHandler.h>
+
+#define EVENTS_URL "/api/v1/events"
+
+AdmissionWebHandler::AdmissionWebHandler(AdmissionController* admission)
+    : m_admission(admission)
+{
+}
+
+bool AdmissionWebHandler::canHandle(AsyncWebServerRequest* request)
+{
+  const AdmissionPriority priority
+      = AdmissionController::classify(request->url().c_str(), request->method());
+  if (!this->m_admission->admit(priority, ESP.getFreeHeap(), ESP.getMaxFreeBlockSize()))
+  {
+    // Shed: handleRequest answers 503.
+    return true;
+  }
+
+  if (strcmp(request->url().c_str(), EVENTS_URL) == 0)
+  {
+    // The event stream stays open: its clients are bounded by the EventBus, not by admission.
+    this->m_admission->release(priority);
+    return false;
+  }
+
+  // The connection is closed after each response, the request ends with it.
+  AdmissionController* admission = this->m_admission;
+  request->onDisconnect([admission, priority]() { admission->release(priority); });
+  return false;
+}
+
+void AdmissionWebHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  AsyncWebServerResponse* response = request->beginResponse(503);
+  response->addHeader("Retry-After", String(ADMISSION_RETRY_AFTER));
+  request->send(response);
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+/**
+ * @file airtimeBudget.cpp
+ * @author Laurette Alexandre
+ * @brief Airtime accounting of the radio over a sliding window.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <airtimeBudget.h>
+
+static unsigned long sumBuckets(const unsigned long* buckets);
+
+/**
+ * @brief Record the airtime of a transmission.
+ *
+ * @param remoteId The remote sending the frame
+ * @param duration The time on air in milliseconds
+ * @param now The current time in milliseconds
+ */
+void AirtimeBudget::record(
+    const unsigned long remoteId, const unsigned long duration, const unsigned long now)
+{
+  this->advance(now);
+  this->m_buckets[this->m_current] += duration;
+  RemoteAirtime* remote = this->findRemote(remoteId, true);
+  if (remote != nullptr)
+  {
+    remote->buckets[this->m_current] += duration;
+  }
+}
+
+/**
+ * @brief Get the airtime used by all the remotes in the window.
+ *
+ * @param now The current time in milliseconds
+ * @return unsigned long The airtime in milliseconds
+ */
+unsigned long AirtimeBudget::getUsed(const unsigned long now)
+{
+  this->advance(now);
+  return sumBuckets(this->m_buckets);
+}
+
+/**
+ * @brief Get the airtime used by a remote in the window.
+ *
+ * @param remoteId The id of the remote
+ * @param now The current time in milliseconds
+ * @return unsigned long The airtime in milliseconds
+ */
+unsigned long AirtimeBudget::getUsed(const unsigned long remoteId, const unsigned long now)
+{
+  this->advance(now);
+  RemoteAirtime* remote = this->findRemote(remoteId, false);
+  return remote == nullptr ? 0 : sumBuckets(remote->buckets);
+}
+
+/**
+ * @brief Tell if a command of the remote fits in the budget of the window, and in the part of
+ * the budget a remote can take.
+ *
+ * @param remoteId The id of the remote
+ * @param now The current time in milliseconds
+ * @return true if the command can be sent now
+ */
+bool AirtimeBudget::canSend(const unsigned long remoteId, const unsigned long now)
+{
+  return this->getUsed(now) + AIRTIME_COMMAND_ESTIMATE <= AIRTIME_BUDGET
+      && this->getUsed(remoteId, now) + AIRTIME_COMMAND_ESTIMATE <= AIRTIME_REMOTE_BUDGET;
+}
+
+// PRIVATE
+
+/**
+ * @brief Move the window to the current time, the buckets left behind are cleared.
+ *
+ * @param now The current time in milliseconds
+ */
+void AirtimeBudget::advance(const unsigned long now)
+{
+  unsigned short moves = 0;
+  while (now - this->m_bucketStart >= AIRTIME_BUCKET_DURATION)
+  {
+    this->m_bucketStart += AIRTIME_BUCKET_DURATION;
+    if (moves >= AIRTIME_WINDOW_BUCKETS)
+    {
+      // Everything is already cleared, only the start of the bucket has to catch up.
+      continue;
+    }
+    moves++;
+    this->m_current = (this->m_current + 1) % AIRTIME_WINDOW_BUCKETS;
+    this->m_buckets[this->m_current] = 0;
+    for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+    {
+      this->m_remotes[i].buckets[this->m_current] = 0;
+    }
+  }
+}
+
+/**
+ * @brief Find the airtime of a remote. A new remote takes a free place, or the place of a
+ * remote without airtime left in the window.
+ *
+ * @param remoteId The id of the remote
+ * @param create true to give a place to an unknown remote
+ * @return RemoteAirtime* The airtime of the remote, nullptr if not found or no place left
+ */
+AirtimeBudget::RemoteAirtime* AirtimeBudget::findRemote(
+    const unsigned long remoteId, const bool create)
+{
+  RemoteAirtime* place = nullptr;
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    RemoteAirtime& remote = this->m_remotes[i];
+    if (remote.remoteId == remoteId)
+    {
+      return &remote;
+    }
+    if (place == nullptr && (remote.remoteId == 0 || sumBuckets(remote.buckets) == 0))
+    {
+      place = &remote;
+    }
+  }
+  if (!create || place == nullptr)
+  {
+    return nullptr;
+  }
+  memset(place, 0, sizeof(RemoteAirtime));
+  place->remoteId = remoteId;
+  return place;
+}
+
+static unsigned long sumBuckets(const unsigned long* buckets)
+{
+  unsigned long sum = 0;
+  for (unsigned short i = 0; i < AIRTIME_WINDOW_BUCKETS; ++i)
+  {
+    sum += buckets[i];
+  }
+  return sum;
+}
\ No newline at end of file
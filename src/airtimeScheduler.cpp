@@ -0,0 +1,163 @@
+/**
+ * @file airtimeScheduler.cpp
+ * @author Laurette Alexandre
+ * @brief Scheduler of the commands within the airtime budget.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <deferredLog.h>
+#include <airtimeScheduler.h>
+
+AirtimeScheduler::AirtimeScheduler(Controller* controller, AirtimeBudget* budget)
+    : m_controller(controller)
+    , m_budget(budget)
+{
+}
+
+/**
+ * @brief Operate a remote now if the airtime budget allows it, later otherwise.
+ * A STOP cancels the command waiting for the remote and is sent at once.
+ *
+ * @param remoteId The id of the remote
+ * @param action The action, as given to Controller::operateRemote
+ * @param now The current time in milliseconds
+ * @return Result The result of the command, RESULT_COMMAND_DELAYED if it waits for airtime
+ */
+Result AirtimeScheduler::operateRemote(
+    const unsigned long remoteId, const char* action, const unsigned long now)
+{
+  DelayedCommand* place = this->findPlace(remoteId);
+  const bool isStop = strcmp(action, "stop") == 0;
+  if (isStop || this->m_budget->canSend(remoteId, now))
+  {
+    if (place != nullptr && place->remoteId == remoteId)
+    {
+      place->remoteId = 0;
+    }
+    return this->m_controller->operateRemote(remoteId, action);
+  }
+
+  Result result;
+  if (place == nullptr)
+  {
+    DLOG_WARN("Airtime spent, command to the remote %lu dropped.", remoteId);
+    result.code = RESULT_AIRTIME_EXHAUSTED;
+    return result;
+  }
+  if (place->remoteId != remoteId)
+  {
+    place->remoteId = remoteId;
+    place->queuedAt = now;
+  }
+  strncpy(place->action, action, sizeof(place->action) - 1);
+  place->action[sizeof(place->action) - 1] = '\0';
+  DLOG_INFO("Airtime spent, command to the remote %lu delayed.", remoteId);
+  result.code = RESULT_COMMAND_DELAYED;
+  result.isSuccess = true;
+  return result;
+}
+
+/**
+ * @brief Send the oldest delayed command that fits in the budget. One at most per call, a
+ * transmission blocks for more than 100 ms.
+ *
+ * @param now The current time in milliseconds
+ */
+void AirtimeScheduler::loop(const unsigned long now)
+{
+  metrics.observeAirtime(this->m_budget->getUsed(now), this->getQueueSize());
+
+  DelayedCommand* next = nullptr;
+  for (unsigned short i = 0; i < AIRTIME_QUEUE_SIZE; ++i)
+  {
+    DelayedCommand& command = this->m_queue[i];
+    if (command.remoteId == 0 || !this->m_budget->canSend(command.remoteId, now))
+    {
+      continue;
+    }
+    if (next == nullptr || now - command.queuedAt > now - next->queuedAt)
+    {
+      next = &command;
+    }
+  }
+  if (next == nullptr)
+  {
+    return;
+  }
+
+  const unsigned long remoteId = next->remoteId;
+  next->remoteId = 0;
+  metrics.recordAirtimeDelay(now - next->queuedAt);
+  Result result = this->m_controller->operateRemote(remoteId, next->action);
+  if (!result.isSuccess)
+  {
+    DLOG_WARN("Delayed command to the remote %lu failed, result %lu.", remoteId, result.code);
+  }
+}
+
+/**
+ * @brief Get the number of commands waiting for airtime.
+ *
+ * @return unsigned short The number of commands
+ */
+unsigned short AirtimeScheduler::getQueueSize()
+{
+  unsigned short size = 0;
+  for (unsigned short i = 0; i < AIRTIME_QUEUE_SIZE; ++i)
+  {
+    if (this->m_queue[i].remoteId != 0)
+    {
+      size++;
+    }
+  }
+  return size;
+}
+
+// PRIVATE
+
+/**
+ * @brief Find the delayed command of a remote, or a free place for it.
+ *
+ * @param remoteId The id of the remote
+ * @return DelayedCommand* The command of the remote, a free place, nullptr if the queue is full
+ */
+AirtimeScheduler::DelayedCommand* AirtimeScheduler::findPlace(const unsigned long remoteId)
+{
+  DelayedCommand* place = nullptr;
+  for (unsigned short i = 0; i < AIRTIME_QUEUE_SIZE; ++i)
+  {
+    if (this->m_queue[i].remoteId == remoteId)
+    {
+      return &this->m_queue[i];
+    }
+    if (place == nullptr && this->m_queue[i].remoteId == 0)
+    {
+      place = &this->m_queue[i];
+    }
+  }
+  return place;
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+/**
+ * @file bootSequence.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the staged boot sequence.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <boot.h>
+#include <config.h>
+#include <metrics.h>
+#include <networks.h>
+#include <bootSequence.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+#include <accessPointAbs.h>
+#include <networkClientAbs.h>
+
+BootSequence::BootSequence(NetworkConnector* networkConnector,
+    NetworkClientAbstract* networkClient, AccessPointAbstract* accessPoint,
+    NetworkScanner* networkScanner)
+    : m_networkConnector(networkConnector)
+    , m_networkClient(networkClient)
+    , m_accessPoint(accessPoint)
+    , m_networkScanner(networkScanner)
+{
+  memset(&this->m_profile, 0, sizeof(BootProfile));
+  this->m_profile.phase = BOOT_TRANSMITTER;
+}
+
+/**
+ * @brief Start a phase.
+ *
+ * @param phase The phase starting
+ * @param now The current time in milliseconds
+ */
+void BootSequence::beginPhase(const BootPhase phase, const unsigned long now)
+{
+  this->m_profile.phase = phase;
+  this->m_phaseStartedAt = now;
+}
+
+/**
+ * @brief End a phase and keep its duration.
+ *
+ * @param phase The phase ending
+ * @param now The current time in milliseconds
+ */
+void BootSequence::endPhase(const BootPhase phase, const unsigned long now)
+{
+  this->m_profile.durations[phase] = now - this->m_phaseStartedAt;
+  LOG_INFO("Boot phase", phase, "done in (ms):", this->m_profile.durations[phase]);
+  if (phase == BOOT_SERVER)
+  {
+    this->m_profile.serverReadyAt = now;
+  }
+}
+
+/**
+ * @brief Start to bring up the network, once the web server is running.
+ * Without WiFi configuration, the access point is started right away. The hints of the last
+ * connection are tried first, then a connection with a full scan.
+ *
+ * @param now The current time in milliseconds
+ */
+void BootSequence::startNetwork(const unsigned long now)
+{
+  if (this->m_networkConnector->loadConfigurations() == 0)
+  {
+    LOG_WARN("No wifi configuration found.");
+    this->startAccessPoint(now);
+    return;
+  }
+
+  LOG_INFO("Trying WiFi connection...");
+  this->beginPhase(BOOT_WIFI_CONNECT, now);
+  // Without hints, the second attempt is the same as the first one.
+  if (!this->m_networkConnector->connect(now, true)
+      && !this->m_networkConnector->connect(now, false))
+  {
+    LOG_ERROR("Failed to start the connection to the WiFi.");
+    this->endPhase(BOOT_WIFI_CONNECT, now);
+    this->startAccessPoint(now);
+  }
+}
+
+/**
+ * @brief Move the network phases forward. To call from the main loop.
+ *
+ * @param now The current time in milliseconds
+ */
+void BootSequence::loop(const unsigned long now)
+{
+  switch (this->m_profile.phase)
+  {
+  case BOOT_WIFI_CONNECT:
+    this->loopConnect(now);
+    break;
+  case BOOT_ACCESS_POINT:
+    // Started before the call returns: the phase ends at the first loop after it.
+    this->endPhase(BOOT_ACCESS_POINT, now);
+    LOG_INFO("AP IP address:", this->m_accessPoint->getIP());
+    this->startScan(now);
+    break;
+  case BOOT_WIFI_SCAN:
+    if (!this->m_networkScanner->isScanning())
+    {
+      this->endPhase(BOOT_WIFI_SCAN, now);
+      this->m_profile.phase = BOOT_DONE;
+      LOG_INFO("Boot done in (ms):", now);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Record a command sent. Only the first one after boot is kept.
+ *
+ * @param now The current time in milliseconds
+ */
+void BootSequence::recordCommand(const unsigned long now)
+{
+  if (this->m_profile.firstCommandAt == 0)
+  {
+    this->m_profile.firstCommandAt = now;
+  }
+}
+
+/**
+ * @brief Get the current phase.
+ *
+ * @return BootPhase
+ */
+BootPhase BootSequence::getPhase() { return this->m_profile.phase; }
+
+/**
+ * @brief Get the durations of the phases and the milestones of the boot.
+ *
+ * @return BootProfile
+ */
+BootProfile BootSequence::getProfile() { return this->m_profile; }
+
+// PRIVATE
+
+void BootSequence::loopConnect(const unsigned long now)
+{
+  const unsigned long elapsed = now - this->m_networkConnector->getStartedAt();
+  if (this->m_networkClient->isConnected())
+  {
+    this->endPhase(BOOT_WIFI_CONNECT, now);
+    metrics.recordWifiConnect(this->m_networkConnector->isHinted(), elapsed);
+    LOG_INFO("WiFi IP address:", this->m_networkClient->getIP());
+    this->m_networkConnector->saveHints();
+    this->startScan(now);
+    return;
+  }
+
+  bool isStarted = this->m_networkConnector->loop(now);
+  if (isStarted && this->m_networkConnector->isHinted() && elapsed >= WIFI_HINTED_CONNECT_TIMEOUT)
+  {
+    LOG_WARN("The WiFi did not answer with the hints of the last connection. Scanning...");
+    metrics.recordWifiHintMiss();
+    this->m_networkClient->disconnect();
+    isStarted = this->m_networkConnector->connect(now, false);
+  }
+  else if (isStarted && elapsed >= WIFI_CONNECT_TIMEOUT)
+  {
+    LOG_ERROR("Failed to connect to the WiFi.");
+    this->m_networkClient->disconnect();
+    isStarted = false;
+  }
+
+  if (!isStarted)
+  {
+    this->endPhase(BOOT_WIFI_CONNECT, now);
+    this->startAccessPoint(now);
+  }
+}
+
+void BootSequence::startAccessPoint(const unsigned long now)
+{
+  LOG_INFO("Configuring access point (AP)...");
+  this->beginPhase(BOOT_ACCESS_POINT, now);
+  this->m_accessPoint->startAccessPoint(AP_SSID, AP_PASSWORD);
+}
+
+void BootSequence::startScan(const unsigned long now)
+{
+  this->m_profile.networkReadyAt = now;
+  this->beginPhase(BOOT_WIFI_SCAN, now);
+  // The scan made to select the network is reused if still fresh.
+  this->m_networkScanner->refreshIfStale(now);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file changeLog.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the in-RAM log of database changes.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <change.h>
+#include <remote.h>
+#include <changeLog.h>
+
+/**
+ * @brief Empty the log and set the sequence its changes start after. A base drawn at random at
+ * each boot tells the sequences of a previous boot apart.
+ *
+ * @param baseSequence The sequence before the first change
+ */
+void ChangeLog::begin(const unsigned long baseSequence)
+{
+  this->m_baseSequence = baseSequence;
+  this->m_lastSequence = baseSequence;
+}
+
+/**
+ * @brief Append a change to the log. The oldest change is overwritten when the log is full.
+ *
+ * @param type The type of the change
+ * @param remote The remote after the change (or before, for a deletion)
+ * @return unsigned long The sequence number given to this change.
+ */
+unsigned long ChangeLog::record(const ChangeType type, const Remote& remote)
+{
+  this->m_lastSequence++;
+
+  Change& change = this->m_changes[this->m_lastSequence % MAX_CHANGES];
+  change.sequence = this->m_lastSequence;
+  change.type = type;
+  change.remoteId = remote.id;
+  change.rollingCode = remote.rollingCode;
+  strncpy(change.name, remote.name, MAX_REMOTE_NAME_LENGTH - 1);
+  change.name[MAX_REMOTE_NAME_LENGTH - 1] = '\0';
+
+  LOG_DEBUG("Change recorded with the sequence:", this->m_lastSequence);
+  return this->m_lastSequence;
+}
+
+/**
+ * @brief Get all changes recorded after the given sequence.
+ * If some of these changes are no longer in the log (it has wrapped), or if the sequence is
+ * unknown (from a previous boot, before the base of this one, or from the future), the feed is
+ * flagged as resyncRequired and contains no change.
+ *
+ * @param sequence The last sequence known by the client. 0 to get the whole log.
+ * @param feed The feed to fill.
+ */
+void ChangeLog::getChangesSince(const unsigned long& sequence, ChangeFeed& feed)
+{
+  feed.size = 0;
+  feed.lastSequence = this->m_lastSequence;
+  feed.resyncRequired = false;
+
+  unsigned long oldestSequence = this->m_baseSequence + 1;
+  if (this->m_lastSequence - this->m_baseSequence > MAX_CHANGES)
+  {
+    oldestSequence = this->m_lastSequence - MAX_CHANGES + 1;
+  }
+
+  const unsigned long from = sequence == 0 ? this->m_baseSequence : sequence;
+  if (from > this->m_lastSequence || from + 1 < oldestSequence)
+  {
+    LOG_WARN("Changes since this sequence are no longer available. A resync is required.");
+    feed.resyncRequired = true;
+    return;
+  }
+
+  for (unsigned long it = from + 1; it <= this->m_lastSequence; ++it)
+  {
+    feed.changes[feed.size] = this->m_changes[it % MAX_CHANGES];
+    feed.size++;
+  }
+}
+
+unsigned long ChangeLog::getLastSequence() { return this->m_lastSequence; }
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * @file commandDeduplicator.cpp
+ * @author Laurette Alexandre
+ * @brief Answers the duplicates of the remote commands without sending them again.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <result.h>
+#include <metrics.h>
+#include <eventBus.h>
+#include <deferredLog.h>
+#include <commandDeduplicator.h>
+
+/**
+ * @brief FNV-1a hash of an idempotency key, never 0.
+ */
+static unsigned long hashKey(const char* key)
+{
+  uint32_t hash = 2166136261UL;
+  for (const char* c = key; *c != '\0'; ++c)
+  {
+    hash = (hash ^ (uint8_t)*c) * 16777619UL;
+  }
+  return hash == 0 ? 1 : hash;
+}
+
+CommandDeduplicator::CommandDeduplicator(EventBus* eventBus)
+    : m_eventBus(eventBus)
+{
+}
+
+/**
+ * @brief Look for the result of a previous identical request.
+ *
+ * @param remoteId The id of the remote
+ * @param action The action requested
+ * @param key The idempotency key of the request, empty or nullptr if none
+ * @param now The current time, in milliseconds
+ * @param result Set to the result of the previous request, if found
+ * @return true, if the request is a duplicate: it should not be sent
+ * @return false, otherwise
+ */
+bool CommandDeduplicator::find(const unsigned long remoteId, const char* action,
+    const char* key, const unsigned long now, Result& result)
+{
+  this->collectEvents();
+  const bool isKeyed = key != nullptr && key[0] != '\0';
+  const unsigned long keyHash = isKeyed ? hashKey(key) : 0;
+  for (unsigned short i = 0; i < COMMAND_DEDUPE_SIZE; ++i)
+  {
+    Entry& entry = this->m_entries[i];
+    if (entry.remoteId == 0 || entry.remoteId != remoteId || strcmp(entry.action, action) != 0)
+    {
+      continue;
+    }
+    const bool isDuplicate = isKeyed
+        ? entry.keyHash == keyHash && now - entry.sentAt < IDEMPOTENCY_KEY_WINDOW
+        : entry.isLatest && now - entry.sentAt < DUPLICATE_COMMAND_WINDOW;
+    if (!isDuplicate)
+    {
+      continue;
+    }
+    entry.usedAt = now;
+    result.isSuccess = true;
+    result.code = entry.code;
+    metrics.recordSuppressedCommand(isKeyed);
+    DLOG_DEBUG("Duplicate command for the remote %lu, sent %lu ms ago.", remoteId,
+        now - entry.sentAt);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Keep the result of a request, once its command is sent.
+ *
+ * @param remoteId The id of the remote
+ * @param action The action sent
+ * @param key The idempotency key of the request, empty or nullptr if none
+ * @param result The result of the command, kept if successful
+ * @param now The current time, in milliseconds
+ */
+void CommandDeduplicator::remember(const unsigned long remoteId, const char* action,
+    const char* key, const Result& result, const unsigned long now)
+{
+  this->collectEvents();
+  if (!result.isSuccess || strlen(action) >= sizeof(Entry::action))
+  {
+    return;
+  }
+  this->markSent(remoteId, action);
+
+  // A free place, or the least recently used one.
+  Entry* entry = &this->m_entries[0];
+  for (unsigned short i = 0; i < COMMAND_DEDUPE_SIZE && entry->remoteId != 0; ++i)
+  {
+    Entry& candidate = this->m_entries[i];
+    if (candidate.remoteId == 0 || (long)(candidate.usedAt - entry->usedAt) < 0)
+    {
+      entry = &candidate;
+    }
+  }
+  entry->remoteId = remoteId;
+  entry->keyHash = key != nullptr && key[0] != '\0' ? hashKey(key) : 0;
+  strcpy(entry->action, action);
+  entry->code = result.code;
+  entry->sentAt = now;
+  entry->usedAt = now;
+  entry->isLatest = true;
+}
+
+// PRIVATE
+
+void CommandDeduplicator::collectEvents()
+{
+  if (this->m_eventBus->hasMissed(this->m_lastSequence))
+  {
+    // The commands sent meanwhile are unknown, no more duplicates but the keyed ones.
+    this->m_lastSequence = this->m_eventBus->getLastSequence();
+    for (unsigned short i = 0; i < COMMAND_DEDUPE_SIZE; ++i)
+    {
+      this->m_entries[i].isLatest = false;
+    }
+  }
+
+  Event event;
+  while (this->m_eventBus->readEvent(this->m_lastSequence, event))
+  {
+    if (event.type == EVENT_COMMAND_TRANSMITTED)
+    {
+      this->markSent(event.remoteId, event.action);
+    }
+  }
+}
+
+/**
+ * @brief Only the entries of the last action sent to a remote are duplicates in the window.
+ */
+void CommandDeduplicator::markSent(const unsigned long remoteId, const char* action)
+{
+  for (unsigned short i = 0; i < COMMAND_DEDUPE_SIZE; ++i)
+  {
+    Entry& entry = this->m_entries[i];
+    if (entry.remoteId == remoteId && entry.isLatest)
+    {
+      entry.isLatest = strcmp(entry.action, action) == 0;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+/**
+ * @file commandQueue.cpp
+ * @author Laurette Alexandre
+ * @brief Queue of the remote actions received by HTTP.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <deferredLog.h>
+#include <commandQueue.h>
+
+CommandQueue::CommandQueue(Controller* controller, CommandDeduplicator* deduplicator)
+    : m_controller(controller)
+    , m_deduplicator(deduplicator)
+{
+}
+
+/**
+ * @brief Queue a command. The place of a result not taken in time is reused.
+ *
+ * @param remoteId The id of the remote
+ * @param action The action, as given to Controller::operateRemote
+ * @param key The idempotency key of the request, nullptr or empty without
+ * @param now The current time in milliseconds
+ * @return unsigned long The ticket of the command, 0 if the queue is full
+ */
+unsigned long CommandQueue::push(
+    const unsigned long remoteId, const char* action, const char* key, const unsigned long now)
+{
+  Command* command = this->reserve(now);
+  if (command == nullptr)
+  {
+    DLOG_WARN("Command queue full, command to the remote %lu refused.", remoteId);
+    return 0;
+  }
+  command->remoteId = remoteId;
+  strncpy(command->action, action, sizeof(command->action) - 1);
+  command->action[sizeof(command->action) - 1] = '\0';
+  command->key = key == nullptr ? "" : key;
+  return command->ticket;
+}
+
+/**
+ * @brief Queue a job, e.g. a write to the database. Its result, data included, is taken as the
+ * result of a remote action.
+ *
+ * @param job The job to run from loop()
+ * @param now The current time in milliseconds
+ * @return unsigned long The ticket of the job, 0 if the queue is full
+ */
+unsigned long CommandQueue::push(CommandJob job, const unsigned long now)
+{
+  Command* command = this->reserve(now);
+  if (command == nullptr)
+  {
+    DLOG_WARN("Command queue full, job refused.");
+    return 0;
+  }
+  command->job = job;
+  return command->ticket;
+}
+
+/**
+ * @brief Operate the oldest pending command. One at most per call, a transmission blocks for
+ * more than 100 ms.
+ *
+ * @param now The current time in milliseconds
+ * @return true if a command has been operated
+ */
+bool CommandQueue::runNext(const unsigned long now)
+{
+  Command* next = nullptr;
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    Command& command = this->m_commands[i];
+    if (command.state == COMMAND_PENDING && (next == nullptr || command.ticket < next->ticket))
+    {
+      next = &command;
+    }
+  }
+  if (next == nullptr)
+  {
+    return false;
+  }
+
+  Result result;
+  const char* key = next->key.c_str();
+  if (next->job)
+  {
+    result = next->job(now);
+    next->job = nullptr;
+  }
+  else if (!this->m_deduplicator->find(next->remoteId, next->action, key, now, result))
+  {
+    result = this->m_controller->operateRemote(next->remoteId, next->action);
+    this->m_deduplicator->remember(next->remoteId, next->action, key, result, now);
+  }
+  next->state = COMMAND_DONE;
+  next->key = "";
+  next->queuedAt = now;
+  next->code = result.code;
+  next->isSuccess = result.isSuccess;
+  next->data = result.data;
+  return true;
+}
+
+/**
+ * @brief Tell if commands are waiting to be operated.
+ *
+ * @return true if runNext() has work to do
+ */
+bool CommandQueue::hasPending()
+{
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    if (this->m_commands[i].state == COMMAND_PENDING)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Tell if a command has been operated. A command unknown, e.g. forgotten, is done.
+ *
+ * @param ticket The ticket given by push()
+ * @return true if its result can be taken
+ */
+bool CommandQueue::isDone(const unsigned long ticket)
+{
+  Command* command = this->findCommand(ticket);
+  return command == nullptr || command->state == COMMAND_DONE;
+}
+
+/**
+ * @brief Take the result of a command operated, its place is freed.
+ *
+ * @param ticket The ticket given by push()
+ * @param result The result of the command
+ * @return true if the result was there
+ */
+bool CommandQueue::take(const unsigned long ticket, Result& result)
+{
+  Command* command = this->findCommand(ticket);
+  if (command == nullptr || command->state != COMMAND_DONE)
+  {
+    return false;
+  }
+  result.code = command->code;
+  result.isSuccess = command->isSuccess;
+  result.data = command->data;
+  command->data = "";
+  command->state = COMMAND_FREE;
+  return true;
+}
+
+// PRIVATE
+
+/**
+ * @brief Find a free place for a command and give it the next ticket. The place of a result
+ * not taken in time is reused.
+ *
+ * @param now The current time in milliseconds
+ * @return Command* The pending command, nullptr if the queue is full
+ */
+CommandQueue::Command* CommandQueue::reserve(const unsigned long now)
+{
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    Command& command = this->m_commands[i];
+    if (command.state == COMMAND_DONE && now - command.queuedAt >= COMMAND_RESULT_TTL)
+    {
+      command.state = COMMAND_FREE;
+      command.data = "";
+    }
+    if (command.state != COMMAND_FREE)
+    {
+      continue;
+    }
+    this->m_lastTicket++;
+    if (this->m_lastTicket == 0)
+    {
+      this->m_lastTicket = 1;
+    }
+    command.ticket = this->m_lastTicket;
+    command.state = COMMAND_PENDING;
+    command.job = nullptr;
+    command.queuedAt = now;
+    return &command;
+  }
+  return nullptr;
+}
+
+CommandQueue::Command* CommandQueue::findCommand(const unsigned long ticket)
+{
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    Command& command = this->m_commands[i];
+    if (command.state != COMMAND_FREE && command.ticket == ticket)
+    {
+      return &command;
+    }
+  }
+  return nullptr;
+}
\ No newline at end of file
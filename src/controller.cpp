@@ -31,7 +31,10 @@
 #include <controller.h>
 
 #include <config.h>
+#include <change.h>
 #include <remote.h>
+#include <trace.h>
+#include <deferredLog.h>
 #include <result.h>
 #include <networks.h>
 #include <systemInfos.h>
@@ -39,13 +42,18 @@
 #include <serializerAbs.h>
 #include <transmitterAbs.h>
 #include <networkClientAbs.h>
+#include <eventPublisherAbs.h>
+#include <networkSwitchoverAbs.h>
 
 Controller::Controller(DatabaseAbstract* database, NetworkClientAbstract* networkClient,
-    SerializerAbstract* serializer, TransmitterAbstract* transmitter)
+    SerializerAbstract* serializer, TransmitterAbstract* transmitter,
+    NetworkSwitchoverAbstract* networkSwitchover, EventPublisherAbstract* eventPublisher)
     : m_database(database)
     , m_networkClient(networkClient)
     , m_serializer(serializer)
     , m_transmitter(transmitter)
+    , m_networkSwitchover(networkSwitchover)
+    , m_eventPublisher(eventPublisher)
 {
 }
 
@@ -57,8 +65,7 @@ Result Controller::fetchSystemInfos()
   SystemInfos infos = this->m_database->getSystemInfos();
 
   result.isSuccess = true;
-  String serialized = this->m_serializer->serializeSystemInfos(infos);
-  result.data = serialized;
+  result.data = this->m_serializer->serializeSystemInfos(infos);
 
   return result;
 }
@@ -70,7 +77,7 @@ Result Controller::fetchRemote(const unsigned long id)
   if (id == 0)
   {
     LOG_ERROR("The remote id is not specified.");
-    result.error = "The remote id is not specified.";
+    result.code = RESULT_REMOTE_ID_MISSING;
     return result;
   }
 
@@ -79,13 +86,12 @@ Result Controller::fetchRemote(const unsigned long id)
   if (remote.id == 0)
   {
     LOG_ERROR("This remote doesn't exists.");
-    result.error = "This remote doesn't exists.";
+    result.code = RESULT_REMOTE_NOT_FOUND;
     return result;
   }
 
   result.isSuccess = true;
-  String serialized = this->m_serializer->serializeRemote(remote);
-  result.data = serialized;
+  result.data = this->m_serializer->serializeRemote(remote);
   LOG_DEBUG("Remote fetched.");
   return result;
 }
@@ -96,9 +102,9 @@ Result Controller::fetchAllRemotes()
   Remote remotes[MAX_REMOTES];
   this->m_database->getAllRemotes(remotes);
 
-  String serialized = this->m_serializer->serializeRemotes(remotes, MAX_REMOTES);
-
-  Result result = { serialized, "", true };
+  Result result;
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeRemotes(remotes, MAX_REMOTES);
 
   LOG_DEBUG("All Remotes fetched.");
   return result;
@@ -111,23 +117,21 @@ Result Controller::createRemote(const char* name)
   if (name == nullptr)
   {
     LOG_ERROR("The name of the remote should be specified.");
-    result.error = "The name of the remote should be specified.";
+    result.code = RESULT_REMOTE_NAME_MISSING;
     return result;
   }
 
   if (strlen(name) == 0)
   {
     LOG_ERROR("The name of the remote cannot be empty.");
-    result.error = "The name of the remote cannot be empty.";
+    result.code = RESULT_REMOTE_NAME_EMPTY;
     return result;
   }
 
   if (strlen(name) > MAX_REMOTE_NAME_LENGTH)
   {
     LOG_ERROR("The name is too long.");
-    String error = "The name is too long. It can contain only " + String(MAX_REMOTE_NAME_LENGTH - 1)
-        + " chars.";
-    result.error = error;
+    result.code = RESULT_REMOTE_NAME_TOO_LONG;
     return result;
   }
 
@@ -137,13 +141,13 @@ Result Controller::createRemote(const char* name)
   {
     LOG_ERROR(
         "The created remote is an empty remote. No space left on the device for a new remote.");
-    result.error = "No space left on the device for a new remote.";
+    result.code = RESULT_NO_SPACE_LEFT;
     return result;
   }
 
+  this->m_eventPublisher->publish(EVENT_REMOTE_CREATED, remote);
   result.isSuccess = true;
-  String serialized = this->m_serializer->serializeRemote(remote);
-  result.data = serialized;
+  result.data = this->m_serializer->serializeRemote(remote);
   LOG_DEBUG("Remote created.");
   return result;
 }
@@ -155,7 +159,7 @@ Result Controller::deleteRemote(const unsigned long id)
   if (id == 0)
   {
     LOG_ERROR("The remote id is not specified.");
-    result.error = "The remote id is not specified.";
+    result.code = RESULT_REMOTE_ID_MISSING;
     return result;
   }
 
@@ -164,11 +168,15 @@ Result Controller::deleteRemote(const unsigned long id)
   if (!isDeleted)
   {
     LOG_ERROR("The given remote doesn't exist in the database.");
-    result.error = "The given remote doesn't exist in the database.";
+    result.code = RESULT_REMOTE_NOT_FOUND;
     return result;
   }
 
+  Remote deletedRemote = {};
+  deletedRemote.id = id;
+  this->m_eventPublisher->publish(EVENT_REMOTE_DELETED, deletedRemote);
   result.isSuccess = true;
+  result.code = RESULT_REMOTE_DELETED;
   LOG_DEBUG("Remote deleted.");
   return result;
 }
@@ -181,7 +189,7 @@ Result Controller::updateRemote(
   if (id == 0)
   {
     LOG_ERROR("The remote id should be specified.");
-    result.error = "The remote id should be specified.";
+    result.code = RESULT_REMOTE_ID_MISSING;
     return result;
   }
 
@@ -190,23 +198,23 @@ Result Controller::updateRemote(
   if (remote.id == 0)
   {
     LOG_ERROR("The remote doesn't exist. It cannot be updated.");
-    result.error = "The remote doesn't exist. It cannot be updated.";
+    result.code = RESULT_REMOTE_NOT_FOUND;
     return result;
   }
 
+  bool isRenamed = false;
   if (name != nullptr)
   {
     if (strlen(name) > MAX_REMOTE_NAME_LENGTH)
     {
       LOG_ERROR("The name is too long.");
-      String error = "The name is too long. It can contain only "
-          + String(MAX_REMOTE_NAME_LENGTH - 1) + " chars.";
-      result.error = error;
+      result.code = RESULT_REMOTE_NAME_TOO_LONG;
       return result;
     }
     if (strlen(name) != 0)
     {
       LOG_DEBUG("The name of the remote will be updated.");
+      isRenamed = strcmp(remote.name, name) != 0;
       strcpy(remote.name, name);
     }
   }
@@ -231,95 +239,575 @@ Result Controller::updateRemote(
   if (!isUpdated)
   {
     LOG_ERROR("Failed to update the remote.");
-    result.error = "Something went wrong while updating the remote.";
+    result.code = RESULT_REMOTE_UPDATE_FAILED;
     return result;
   }
 
+  if (isRenamed)
+  {
+    this->m_eventPublisher->publish(EVENT_REMOTE_RENAMED, remote);
+  }
   result.isSuccess = true;
-  String serialized = this->m_serializer->serializeRemote(remote);
-  result.data = serialized;
+  result.data = this->m_serializer->serializeRemote(remote);
   LOG_DEBUG("Remote updated.");
   return result;
 }
 
+/**
+ * @brief Check a command could be operated, without sending it: the remote exists and the
+ * action is known. Lets a command be answered before it is queued.
+ *
+ * @param id The id of the remote
+ * @param action The action: up, down, stop, pair or reset
+ * @return Result Successful with RESULT_OK if the command can be operated
+ */
+Result Controller::checkCommand(const unsigned long id, const char* action)
+{
+  RemoteAction command;
+  return this->parseCommand(id, action, command);
+}
+
 Result Controller::operateRemote(const unsigned long id, const char* action)
 {
-  LOG_INFO("Operating a command with the Remote", id);
+  TRACE_SPAN("controller.operateRemote");
+  DLOG_INFO("Operating a command with the remote %lu.", id);
+  RemoteAction command;
+  Result result = this->parseCommand(id, action, command);
+  if (!result.isSuccess)
+  {
+    return result;
+  }
+  result.isSuccess = false;
+
+  Remote remote = this->m_database->getRemote(id);
+  bool isSent = false;
+  switch (command)
+  {
+  case REMOTE_ACTION_UP:
+    DLOG_INFO("Operate 'UP'.");
+    this->m_eventPublisher->publish(EVENT_COMMAND_QUEUED, remote, action);
+    isSent = this->m_transmitter->sendUpCmd(remote.id, remote.rollingCode);
+    result.code = RESULT_COMMAND_UP_SENT;
+    break;
+  case REMOTE_ACTION_STOP:
+    DLOG_INFO("Operate 'STOP'.");
+    this->m_eventPublisher->publish(EVENT_COMMAND_QUEUED, remote, action);
+    isSent = this->m_transmitter->sendStopCmd(remote.id, remote.rollingCode);
+    result.code = RESULT_COMMAND_STOP_SENT;
+    break;
+  case REMOTE_ACTION_DOWN:
+    DLOG_INFO("Operate 'DOWN'.");
+    this->m_eventPublisher->publish(EVENT_COMMAND_QUEUED, remote, action);
+    isSent = this->m_transmitter->sendDownCmd(remote.id, remote.rollingCode);
+    result.code = RESULT_COMMAND_DOWN_SENT;
+    break;
+  case REMOTE_ACTION_PAIR:
+    DLOG_INFO("Operate 'PAIR'.");
+    this->m_eventPublisher->publish(EVENT_COMMAND_QUEUED, remote, action);
+    isSent = this->m_transmitter->sendProgCmd(remote.id, remote.rollingCode);
+    result.code = RESULT_COMMAND_PAIR_SENT;
+    break;
+  case REMOTE_ACTION_RESET:
+    DLOG_INFO("Operate 'RESET'.");
+    remote.rollingCode = 0;
+    this->m_database->updateRemote(remote);
+    this->m_eventPublisher->publish(EVENT_ROLLING_CODE_RESET, remote);
+    result.isSuccess = true;
+    result.code = RESULT_ROLLING_CODE_RESET;
+    return result;
+  }
+
+  result.isSuccess = true;
+  remote.rollingCode += 1; // increment rollingCode
+  this->m_database->updateRemote(remote);
+  this->m_eventPublisher->publish(
+      isSent ? EVENT_COMMAND_TRANSMITTED : EVENT_COMMAND_FAILED, remote, action);
+  DLOG_INFO("Command sent through the remote %lu, rolling code %lu.", remote.id, remote.rollingCode);
+  return result;
+}
+
+Result Controller::fetchRemoteChanges(const unsigned long since)
+{
+  LOG_DEBUG("Fetching Remote changes...");
+  Result result;
+
+  ChangeFeed feed;
+  this->m_database->getChangesSince(since, feed);
+
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeChangeFeed(feed);
+  LOG_DEBUG("Remote changes fetched.");
+  return result;
+}
+
+/**
+ * @brief Set the travel times of a remote, used to move it to a position.
+ *
+ * @param id The id of the remote
+ * @param upTime The time to open the remote fully from closed, in milliseconds
+ * @param downTime The time to close the remote fully from open, in milliseconds
+ * @return Result
+ */
+Result Controller::calibrateRemote(
+    const unsigned long id, const unsigned long upTime, const unsigned long downTime)
+{
+  LOG_DEBUG("Calibrating Remote...");
   Result result;
   if (id == 0)
   {
     LOG_ERROR("The remote id should be specified.");
-    result.error = "The remote id should be specified.";
+    result.code = RESULT_REMOTE_ID_MISSING;
     return result;
   }
 
-  if (action == nullptr)
+  if (upTime < MIN_TRAVEL_TIME || upTime > MAX_TRAVEL_TIME || downTime < MIN_TRAVEL_TIME
+      || downTime > MAX_TRAVEL_TIME)
   {
-    LOG_ERROR("The action should be specified. Allowed actions: up, down, stop, pair, reset.");
-    result.error = "The action should be specified. Allowed actions: up, down, stop, pair, reset.";
+    LOG_ERROR("The travel times are not valid.");
+    result.code = RESULT_CALIBRATION_INVALID;
     return result;
   }
 
-  if (strlen(action) == 0)
+  Calibration calibration = { upTime, downTime };
+  if (!this->m_database->setCalibration(id, calibration))
   {
-    LOG_ERROR("The action should be specified. Allowed actions: up, down, stop, pair, reset.");
-    result.error = "The action should be specified. Allowed actions: up, down, stop, pair, reset.";
+    LOG_ERROR("The remote to calibrate doesn't exist.");
+    result.code = RESULT_REMOTE_NOT_FOUND;
     return result;
   }
 
-  Remote remote = this->m_database->getRemote(id);
+  result.isSuccess = true;
+  result.code = RESULT_REMOTE_CALIBRATED;
+  LOG_DEBUG("Remote calibrated.");
+  return result;
+}
 
-  if (remote.id == 0)
+Result Controller::fetchAllSchedules()
+{
+  LOG_DEBUG("Fetching all schedules...");
+  Schedule schedules[MAX_SCHEDULES];
+  this->m_database->getAllSchedules(schedules);
+
+  Result result;
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeSchedules(schedules, MAX_SCHEDULES);
+  return result;
+}
+
+/**
+ * @brief Create a schedule operating a remote on some days of the week.
+ *
+ * @param remoteId The id of the remote to operate
+ * @param action The action to send: up, stop or down
+ * @param event When to run: time, sunrise or sunset
+ * @param minutes For a time, the minutes since midnight, local time. For sunrise and sunset, the
+ * offset in minutes from the event, between -720 and 720.
+ * @param days The days of the week, bit 0 for sunday up to bit 6 for saturday.
+ * @return Result The created schedule.
+ */
+Result Controller::createSchedule(const unsigned long remoteId, const char* action,
+    const char* event, const int minutes, const unsigned char days)
+{
+  LOG_DEBUG("Creating a new Schedule...");
+  Result result;
+  if (remoteId == 0)
   {
-    LOG_ERROR("The remote doesn't exist. It cannot be operate.");
-    result.error = "The remote doesn't exist. It cannot be operate.";
+    LOG_ERROR("The remote id should be specified.");
+    result.code = RESULT_REMOTE_ID_MISSING;
     return result;
   }
 
+  if (action == nullptr || strlen(action) == 0)
+  {
+    LOG_ERROR("The action should be specified.");
+    result.code = RESULT_ACTION_MISSING;
+    return result;
+  }
+
+  Schedule schedule = {};
+  schedule.remoteId = remoteId;
+  schedule.days = days;
   if (strcmp(action, "up") == 0)
   {
-    LOG_INFO("Operate 'UP'.");
-    this->m_transmitter->sendUpCmd(remote.id, remote.rollingCode);
-    result.data = "Command UP sent.";
+    schedule.action = SCHEDULE_UP;
   }
   else if (strcmp(action, "stop") == 0)
   {
-    LOG_INFO("Operate 'STOP'.");
-    this->m_transmitter->sendStopCmd(remote.id, remote.rollingCode);
-    result.data = "Command STOP sent.";
+    schedule.action = SCHEDULE_STOP;
   }
   else if (strcmp(action, "down") == 0)
   {
-    LOG_INFO("Operate 'DOWN'.");
-    this->m_transmitter->sendDownCmd(remote.id, remote.rollingCode);
-    result.data = "Command DOWN sent.";
+    schedule.action = SCHEDULE_DOWN;
+  }
+  else
+  {
+    LOG_ERROR("Only up, stop and down can be scheduled.");
+    result.code = RESULT_ACTION_INVALID;
+    return result;
   }
-  else if (strcmp(action, "pair") == 0)
+
+  int minMinutes = -MAX_SUN_OFFSET_MINUTES;
+  int maxMinutes = MAX_SUN_OFFSET_MINUTES;
+  if (event != nullptr && strcmp(event, "time") == 0)
   {
-    LOG_INFO("Operate 'PAIR'.");
-    this->m_transmitter->sendProgCmd(remote.id, remote.rollingCode);
-    result.data = "Command PAIR sent.";
+    schedule.event = SCHEDULE_AT_TIME;
+    minMinutes = 0;
+    maxMinutes = 24 * 60 - 1;
   }
-  else if (strcmp(action, "reset") == 0)
+  else if (event != nullptr && strcmp(event, "sunrise") == 0)
   {
-    LOG_INFO("Operate 'RESET'.");
-    remote.rollingCode = 0;
-    this->m_database->updateRemote(remote);
-    result.isSuccess = true;
-    result.data = "Rolling code reseted.";
-    return result;
+    schedule.event = SCHEDULE_AT_SUNRISE;
+  }
+  else if (event != nullptr && strcmp(event, "sunset") == 0)
+  {
+    schedule.event = SCHEDULE_AT_SUNSET;
   }
   else
   {
-    LOG_WARN("The action is not valid.");
-    result.error = "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
+    LOG_ERROR("The event of the schedule is not valid.");
+    result.code = RESULT_SCHEDULE_INVALID;
+    return result;
+  }
+
+  if (minutes < minMinutes || minutes > maxMinutes || days == 0 || days > 0x7F)
+  {
+    LOG_ERROR("The minutes or the days of the schedule are not valid.");
+    result.code = RESULT_SCHEDULE_INVALID;
+    return result;
+  }
+  schedule.minutes = minutes;
+
+  if (this->m_database->getRemote(remoteId).id == 0)
+  {
+    LOG_ERROR("The remote to schedule doesn't exist.");
+    result.code = RESULT_REMOTE_NOT_FOUND;
+    return result;
+  }
+
+  Schedule created = this->m_database->createSchedule(schedule);
+  if (created.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new schedule.");
+    result.code = RESULT_TOO_MANY_SCHEDULES;
     return result;
   }
 
   result.isSuccess = true;
-  remote.rollingCode += 1; // increment rollingCode
-  this->m_database->updateRemote(remote);
-  LOG_INFO("Command sent through the remote", remote.id);
+  result.data = this->m_serializer->serializeSchedule(created);
+  LOG_DEBUG("Schedule created.");
+  return result;
+}
+
+Result Controller::deleteSchedule(const unsigned long id)
+{
+  LOG_DEBUG("Deleting Schedule...");
+  Result result;
+  if (id == 0 || id > MAX_SCHEDULES || !this->m_database->deleteSchedule(id))
+  {
+    LOG_ERROR("The given schedule doesn't exist in the database.");
+    result.code = RESULT_SCHEDULE_NOT_FOUND;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.code = RESULT_SCHEDULE_DELETED;
+  LOG_DEBUG("Schedule deleted.");
+  return result;
+}
+
+Result Controller::fetchAllGroups()
+{
+  LOG_DEBUG("Fetching all groups...");
+  // Static to keep the groups off the stack.
+  static Group groups[MAX_GROUPS];
+  this->m_database->getAllGroups(groups);
+
+  Result result;
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeGroups(groups, MAX_GROUPS);
+  return result;
+}
+
+/**
+ * @brief Create a group of remotes, operated together.
+ *
+ * @param name The name of the group
+ * @param remoteIds The ids of the remotes, each once
+ * @param size The number of remotes
+ * @return Result The created group.
+ */
+Result Controller::createGroup(
+    const char* name, const unsigned long remoteIds[], const unsigned char size)
+{
+  LOG_DEBUG("Creating a new Group...");
+  Result result;
+  if (name == nullptr || strlen(name) == 0 || strlen(name) >= MAX_REMOTE_NAME_LENGTH
+      || size == 0 || size > MAX_REMOTES)
+  {
+    LOG_ERROR("The name or the size of the group is not valid.");
+    result.code = RESULT_GROUP_INVALID;
+    return result;
+  }
+
+  Group group = {};
+  strncpy(group.name, name, MAX_REMOTE_NAME_LENGTH - 1);
+  for (int i = 0; i < size; i++)
+  {
+    for (int j = 0; j < i; j++)
+    {
+      if (remoteIds[j] == remoteIds[i])
+      {
+        LOG_ERROR("A remote is given twice in the group.");
+        result.code = RESULT_GROUP_INVALID;
+        return result;
+      }
+    }
+    if (remoteIds[i] == 0 || this->m_database->getRemote(remoteIds[i]).id == 0)
+    {
+      LOG_ERROR("A remote of the group doesn't exist.");
+      result.code = RESULT_GROUP_INVALID;
+      return result;
+    }
+    group.remoteIds[i] = remoteIds[i];
+  }
+  group.size = size;
+
+  Group created = this->m_database->createGroup(group);
+  if (created.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new group.");
+    result.code = RESULT_TOO_MANY_GROUPS;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeGroup(created);
+  LOG_DEBUG("Group created.");
+  return result;
+}
+
+Result Controller::deleteGroup(const unsigned long id)
+{
+  LOG_DEBUG("Deleting Group...");
+  Result result;
+  if (id == 0 || id > MAX_GROUPS || !this->m_database->deleteGroup(id))
+  {
+    LOG_ERROR("The given group doesn't exist in the database.");
+    result.code = RESULT_GROUP_NOT_FOUND;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.code = RESULT_GROUP_DELETED;
+  LOG_DEBUG("Group deleted.");
+  return result;
+}
+
+Result Controller::fetchAllScenes()
+{
+  LOG_DEBUG("Fetching all scenes...");
+  // Static to keep the scenes off the stack: about 1.2 KB.
+  static Scene scenes[MAX_SCENES];
+  this->m_database->getAllScenes(scenes);
+
+  Result result;
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeScenes(scenes, MAX_SCENES);
+  return result;
+}
+
+/**
+ * @brief Create a scene: remotes operated one after the other, each after its delay.
+ *
+ * @param name The name of the scene
+ * @param remoteIds The id of the remote of each step
+ * @param actions The action of each step: up, stop or down
+ * @param delays The delay of each step after the previous one, in milliseconds
+ * @param size The number of steps
+ * @return Result The created scene.
+ */
+Result Controller::createScene(const char* name, const unsigned long remoteIds[],
+    const char* actions[], const unsigned long delays[], const unsigned char size)
+{
+  LOG_DEBUG("Creating a new Scene...");
+  Result result;
+  if (name == nullptr || strlen(name) == 0 || strlen(name) >= MAX_REMOTE_NAME_LENGTH
+      || size == 0 || size > MAX_SCENE_STEPS)
+  {
+    LOG_ERROR("The name or the size of the scene is not valid.");
+    result.code = RESULT_SCENE_INVALID;
+    return result;
+  }
+
+  Scene scene = {};
+  strncpy(scene.name, name, MAX_REMOTE_NAME_LENGTH - 1);
+  for (int i = 0; i < size; i++)
+  {
+    SceneStep& step = scene.steps[i];
+    if (actions[i] != nullptr && strcmp(actions[i], "up") == 0)
+    {
+      step.action = SCHEDULE_UP;
+    }
+    else if (actions[i] != nullptr && strcmp(actions[i], "stop") == 0)
+    {
+      step.action = SCHEDULE_STOP;
+    }
+    else if (actions[i] != nullptr && strcmp(actions[i], "down") == 0)
+    {
+      step.action = SCHEDULE_DOWN;
+    }
+    else
+    {
+      LOG_ERROR("Only up, stop and down can be used in a scene.");
+      result.code = RESULT_SCENE_INVALID;
+      return result;
+    }
+
+    if (delays[i] > SCENE_MAX_DELAY)
+    {
+      LOG_ERROR("The delay of a step is too long.");
+      result.code = RESULT_SCENE_INVALID;
+      return result;
+    }
+    step.delay = delays[i];
+
+    if (remoteIds[i] == 0 || this->m_database->getRemote(remoteIds[i]).id == 0)
+    {
+      LOG_ERROR("A remote of the scene doesn't exist.");
+      result.code = RESULT_SCENE_INVALID;
+      return result;
+    }
+    step.remoteId = remoteIds[i];
+  }
+  scene.size = size;
+
+  Scene created = this->m_database->createScene(scene);
+  if (created.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new scene.");
+    result.code = RESULT_TOO_MANY_SCENES;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeScene(created);
+  LOG_DEBUG("Scene created.");
+  return result;
+}
+
+Result Controller::deleteScene(const unsigned long id)
+{
+  LOG_DEBUG("Deleting Scene...");
+  Result result;
+  if (id == 0 || id > MAX_SCENES || !this->m_database->deleteScene(id))
+  {
+    LOG_ERROR("The given scene doesn't exist in the database.");
+    result.code = RESULT_SCENE_NOT_FOUND;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.code = RESULT_SCENE_DELETED;
+  LOG_DEBUG("Scene deleted.");
+  return result;
+}
+
+Result Controller::fetchAllMacros()
+{
+  LOG_DEBUG("Fetching all macros...");
+  Macro macros[MAX_MACROS];
+  this->m_database->getAllMacros(macros);
+
+  Result result;
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeMacros(macros, MAX_MACROS);
+  return result;
+}
+
+/**
+ * @brief Create a macro: actions played on a remote with waits between them.
+ *
+ * @param name The name of the macro
+ * @param actions The action of each step: up, stop or down
+ * @param waits The wait after each action, in milliseconds
+ * @param size The number of steps
+ * @return Result The created macro.
+ */
+Result Controller::createMacro(const char* name, const char* actions[],
+    const unsigned long waits[], const unsigned char size)
+{
+  LOG_DEBUG("Creating a new Macro...");
+  Result result;
+  if (name == nullptr || strlen(name) == 0 || strlen(name) >= MAX_REMOTE_NAME_LENGTH
+      || size == 0 || size > MAX_MACRO_STEPS)
+  {
+    LOG_ERROR("The name or the size of the macro is not valid.");
+    result.code = RESULT_MACRO_INVALID;
+    return result;
+  }
+
+  Macro macro = {};
+  strncpy(macro.name, name, MAX_REMOTE_NAME_LENGTH - 1);
+  for (int i = 0; i < size; i++)
+  {
+    MacroStep& step = macro.steps[i];
+    if (actions[i] != nullptr && strcmp(actions[i], "up") == 0)
+    {
+      step.action = SCHEDULE_UP;
+    }
+    else if (actions[i] != nullptr && strcmp(actions[i], "stop") == 0)
+    {
+      step.action = SCHEDULE_STOP;
+    }
+    else if (actions[i] != nullptr && strcmp(actions[i], "down") == 0)
+    {
+      step.action = SCHEDULE_DOWN;
+    }
+    else
+    {
+      LOG_ERROR("Only up, stop and down can be used in a macro.");
+      result.code = RESULT_MACRO_INVALID;
+      return result;
+    }
+
+    if (waits[i] > MACRO_MAX_WAIT)
+    {
+      LOG_ERROR("The wait of a step is too long.");
+      result.code = RESULT_MACRO_INVALID;
+      return result;
+    }
+    step.wait = waits[i];
+  }
+  macro.size = size;
+
+  Macro created = this->m_database->createMacro(macro);
+  if (created.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new macro.");
+    result.code = RESULT_TOO_MANY_MACROS;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeMacro(created);
+  LOG_DEBUG("Macro created.");
+  return result;
+}
+
+Result Controller::deleteMacro(const unsigned long id)
+{
+  LOG_DEBUG("Deleting Macro...");
+  Result result;
+  if (id == 0 || id > MAX_MACROS || !this->m_database->deleteMacro(id))
+  {
+    LOG_ERROR("The given macro doesn't exist in the database.");
+    result.code = RESULT_MACRO_NOT_FOUND;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.code = RESULT_MACRO_DELETED;
+  LOG_DEBUG("Macro deleted.");
   return result;
 }
 
@@ -328,56 +816,138 @@ Result Controller::fetchNetworkConfiguration()
   LOG_DEBUG("Fetching Network Configuration...");
   Result result;
 
-  NetworkConfiguration networkConfig = this->m_database->getNetworkConfiguration();
+  NetworkConfiguration networkConfigs[MAX_NETWORK_CONFIGURATIONS];
+  unsigned char size = this->m_database->getNetworkConfigurations(networkConfigs);
 
   result.isSuccess = true;
-  String serialized = this->m_serializer->serializeNetworkConfig(networkConfig);
-  result.data = serialized;
+  result.data = this->m_serializer->serializeNetworkConfigs(networkConfigs, size);
   return result;
 }
 
 Result Controller::updateNetworkConfiguration(const char* ssid, const char* password)
+{
+  const char* ssids[] = { ssid };
+  const char* passwords[] = { password };
+  return this->updateNetworkConfigurations(ssids, passwords, 1);
+}
+
+Result Controller::updateNetworkConfigurations(
+    const char* ssids[], const char* passwords[], const unsigned char size)
 {
   LOG_DEBUG("Updating Network Configuration...");
   Result result;
-  if (ssid == nullptr)
+  if (size > MAX_NETWORK_CONFIGURATIONS)
   {
-    LOG_ERROR("The ssid should be specified.");
-    result.error = "The ssid should be specified.";
+    LOG_ERROR("Too many networks provided:", size);
+    result.code = RESULT_TOO_MANY_NETWORKS;
     return result;
   }
 
-  if (strlen(ssid) == 0)
+  NetworkConfiguration networkConfigs[MAX_NETWORK_CONFIGURATIONS];
+  memset(networkConfigs, 0, sizeof(networkConfigs));
+  for (unsigned char i = 0; i < size; ++i)
   {
-    LOG_ERROR("The ssid cannot be empty.");
-    result.error = "The ssid cannot be empty.";
-    return result;
+    if (ssids[i] == nullptr)
+    {
+      LOG_ERROR("The ssid should be specified.");
+      result.code = RESULT_SSID_MISSING;
+      return result;
+    }
+
+    if (strlen(ssids[i]) == 0)
+    {
+      LOG_ERROR("The ssid cannot be empty.");
+      result.code = RESULT_SSID_EMPTY;
+      return result;
+    }
+
+    strcpy(networkConfigs[i].ssid, ssids[i]);
+
+    if (passwords[i] == nullptr)
+    {
+      LOG_DEBUG("No password provided. Probably a free hotspot.");
+    }
+    else
+    {
+      strcpy(networkConfigs[i].password, passwords[i]);
+    }
   }
 
-  NetworkConfiguration networkConfig;
-  strcpy(networkConfig.ssid, ssid);
+  // Saved by the switchover once connected to one of them.
+  bool isStarted = this->m_networkSwitchover->begin(networkConfigs, size);
 
-  if (password == nullptr)
+  if (!isStarted)
   {
-    LOG_DEBUG("No password provided. Probably a free hotspot.");
+    LOG_ERROR("A change of the Network Configuration is already running.");
+    result.code = RESULT_NETWORK_SWITCHOVER_RUNNING;
+    return result;
   }
-  else
+
+  result.isSuccess = true;
+  result.code = RESULT_NETWORK_SWITCHOVER_STARTED;
+  result.data = this->m_serializer->serializeSwitchoverStatus(
+      this->m_networkSwitchover->getStatus());
+  LOG_DEBUG("Network Configuration switchover started.");
+  return result;
+}
+
+Result Controller::fetchNetworkSwitchover()
+{
+  LOG_DEBUG("Fetching Network Configuration switchover...");
+  Result result;
+
+  result.isSuccess = true;
+  result.data = this->m_serializer->serializeSwitchoverStatus(
+      this->m_networkSwitchover->getStatus());
+  return result;
+}
+
+// PRIVATE
+
+/**
+ * @brief Validate a command and find its action. Shared by checkCommand() and operateRemote().
+ *
+ * @param id The id of the remote
+ * @param action The action: up, down, stop, pair or reset
+ * @param command Set to the action found
+ * @return Result Successful with RESULT_OK if the command can be operated
+ */
+Result Controller::parseCommand(const unsigned long id, const char* action, RemoteAction& command)
+{
+  Result result;
+  if (id == 0)
   {
-    strcpy(networkConfig.password, password);
+    DLOG_ERROR("The remote id should be specified.");
+    result.code = RESULT_REMOTE_ID_MISSING;
+    return result;
   }
 
-  bool isUpdated = this->m_database->setNetworkConfiguration(networkConfig);
+  if (action == nullptr || strlen(action) == 0)
+  {
+    DLOG_ERROR("The action should be specified. Allowed actions: up, down, stop, pair, reset.");
+    result.code = RESULT_ACTION_MISSING;
+    return result;
+  }
 
-  if (!isUpdated)
+  if (this->m_database->getRemote(id).id == 0)
   {
-    LOG_ERROR("Something went wrong while updating the Network Configuration");
-    result.error = "Something went wrong while updating the Network Configuration";
+    DLOG_ERROR("The remote %lu doesn't exist. It cannot be operate.", id);
+    result.code = RESULT_REMOTE_NOT_FOUND;
     return result;
   }
 
-  result.isSuccess = true;
-  String serialized = this->m_serializer->serializeNetworkConfig(networkConfig);
-  result.data = serialized;
-  LOG_DEBUG("Network Configuration updated.");
+  // In the order of RemoteAction.
+  static const char* const ACTIONS[] = { "up", "stop", "down", "pair", "reset" };
+  for (unsigned char i = 0; i < sizeof(ACTIONS) / sizeof(ACTIONS[0]); ++i)
+  {
+    if (strcmp(action, ACTIONS[i]) == 0)
+    {
+      command = static_cast<RemoteAction>(i);
+      result.isSuccess = true;
+      return result;
+    }
+  }
+  DLOG_WARN("The action is not valid.");
+  result.code = RESULT_ACTION_INVALID;
   return result;
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file deferredLog.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the deferred logs, formatted out of the hot paths.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <deferredLog.h>
+
+static const char LEVEL_NAMES[] = "?EWID";
+
+DeferredLog deferredLog;
+
+/**
+ * @brief Write the records not flushed yet, as long as the output can take them without
+ * blocking. To call from the main loop.
+ *
+ * @param output The output, like Serial. It must report availableForWrite().
+ * @param maxRecords The maximum number of records to write
+ * @return unsigned short The number of records written
+ */
+unsigned short DeferredLog::flush(Print& output, const unsigned short maxRecords)
+{
+  if (this->m_head - this->m_flushed > DEFERRED_LOG_SIZE)
+  {
+    this->m_dropped += this->m_head - this->m_flushed - DEFERRED_LOG_SIZE;
+    this->m_flushed = this->m_head - DEFERRED_LOG_SIZE;
+  }
+
+  char line[RENDER_LINE_LENGTH];
+  unsigned short count = 0;
+  while (count < maxRecords && this->m_flushed != this->m_head)
+  {
+    const LogRecord& record = this->m_records[this->m_flushed % DEFERRED_LOG_SIZE];
+    size_t length = this->formatRecord(record, line, sizeof(line));
+    if (output.availableForWrite() < (int)length)
+    {
+      break;
+    }
+    output.write(reinterpret_cast<const uint8_t*>(line), length);
+    this->m_flushed++;
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Get the number of records overwritten before being flushed.
+ *
+ * @return unsigned long
+ */
+unsigned long DeferredLog::getDropped() { return this->m_dropped; }
+
+/**
+ * @brief Render the records still in the buffer, oldest first, flushed or not. Only the records
+ * kept when the rendering started are rendered, each one once.
+ *
+ * @param cursor The position of the rendering, starts zeroed
+ * @param buffer The buffer receiving the line
+ * @param size The size of the buffer
+ * @return size_t The length of the line, 0 when everything has been rendered
+ */
+size_t DeferredLog::renderLine(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  if (cursor.item == 0)
+  {
+    // The window is taken once: the records pushed between two lines are left out.
+    cursor.end = this->m_head;
+    cursor.next = this->m_head < DEFERRED_LOG_SIZE ? 0 : this->m_head - DEFERRED_LOG_SIZE;
+    cursor.item++;
+  }
+  // The records overwritten since are skipped, the following ones keep their order.
+  if (this->m_head - cursor.next > DEFERRED_LOG_SIZE)
+  {
+    cursor.next = this->m_head - DEFERRED_LOG_SIZE;
+  }
+  if (cursor.next >= cursor.end)
+  {
+    return 0;
+  }
+  const LogRecord& record = this->m_records[cursor.next % DEFERRED_LOG_SIZE];
+  cursor.next++;
+  return this->formatRecord(record, buffer, size);
+}
+
+// PRIVATE
+
+void DeferredLog::push(const unsigned char level, PGM_P format, const unsigned long* values)
+{
+  LogRecord& record = this->m_records[this->m_head % DEFERRED_LOG_SIZE];
+  record.timestamp = millis();
+  record.format = format;
+  memcpy(record.args, values, sizeof(record.args));
+  record.level = level;
+  this->m_head++;
+}
+
+/**
+ * @brief Write a record as "<timestamp> [<level>] <message>\n".
+ */
+size_t DeferredLog::formatRecord(const LogRecord& record, char* buffer, const size_t size)
+{
+  size_t length = snprintf(buffer, size, "%lu [%c] ", (unsigned long)record.timestamp,
+      LEVEL_NAMES[record.level < sizeof(LEVEL_NAMES) - 1 ? record.level : 0]);
+  if (length < size)
+  {
+    length += snprintf_P(buffer + length, size - length, record.format, record.args[0],
+        record.args[1], record.args[2]);
+  }
+  if (length >= size - 1)
+  {
+    length = size - 2;
+  }
+  buffer[length++] = '\n';
+  buffer[length] = '\0';
+  return length;
+}
\ No newline at end of file
@@ -25,26 +25,34 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#include <regex>
 #include <EEPROM.h>
 
 #include <DebugLog.h>
 
 #include <config.h>
+#include <change.h>
 #include <remote.h>
 #include <networks.h>
 #include <systemInfos.h>
+#include <trace.h>
+#include <deferredLog.h>
+#include <metrics.h>
 #include <eepromDatabase.h>
 
+// Written before the network hints. Anything else (never written EEPROM) means no hints.
+static const unsigned long NETWORK_HINTS_MAGIC = 0x48494E54;
+
 /**
  * @brief Initialise the Database in the EEPROM of the ESP
  *
  */
 void EEPROMDatabase::init()
 {
-  size_t totalSize = sizeof(NetworkConfiguration) + sizeof(Remote) * MAX_REMOTES;
+  size_t totalSize = this->m_nonceMarksAddressStart + sizeof(StoredNonceMark) * MAX_REMOTES;
   LOG_DEBUG("Allocating EEPROM space: ", totalSize);
   EEPROM.begin(totalSize);
+  // Drawn by the hardware random generator.
+  this->m_changeLog.begin(random(1, CHANGE_SEQUENCE_MAX_BASE));
 
   this->migrate();
   this->fixIntegrity();
@@ -84,18 +92,138 @@ void EEPROMDatabase::fixIntegrity()
     }
   }
   LOG_DEBUG("Corrupted Remotes detected and reseted: ", count);
+  this->loadRemotes();
+
+  // Never written before this version: erased flash reads 0xFF.
+  Schedule scheduleRead;
+  Schedule emptySchedule;
+  memset(&emptySchedule, 0, sizeof(Schedule));
+  count = 0;
+  for (int index = 0; index < MAX_SCHEDULES; ++index)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + index * sizeof(Schedule), scheduleRead);
+    if (scheduleRead.id == 0 || (scheduleRead.id == index + 1 && scheduleRead.days <= 0x7F
+        && scheduleRead.event <= SCHEDULE_AT_SUNSET && scheduleRead.action <= SCHEDULE_DOWN))
+    {
+      continue;
+    }
+    EEPROM.put(this->m_schedulesAddressStart + index * sizeof(Schedule), emptySchedule);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Schedules detected and reseted: ", count);
+
+  Calibration calibrationRead;
+  Calibration emptyCalibration = { 0, 0 };
+  count = 0;
+  for (int index = 0; index < MAX_REMOTES; ++index)
+  {
+    EEPROM.get(this->m_calibrationsAddressStart + index * sizeof(Calibration), calibrationRead);
+    if (calibrationRead.upTime <= MAX_TRAVEL_TIME && calibrationRead.downTime <= MAX_TRAVEL_TIME)
+    {
+      continue;
+    }
+    EEPROM.put(this->m_calibrationsAddressStart + index * sizeof(Calibration), emptyCalibration);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Calibrations detected and reseted: ", count);
+
+  Group groupRead;
+  Group emptyGroup;
+  memset(&emptyGroup, 0, sizeof(Group));
+  count = 0;
+  for (int index = 0; index < MAX_GROUPS; ++index)
+  {
+    EEPROM.get(this->m_groupsAddressStart + index * sizeof(Group), groupRead);
+    if (groupRead.id == 0
+        || (groupRead.id == index + 1 && groupRead.size <= MAX_REMOTES
+            && strnlen(groupRead.name, MAX_REMOTE_NAME_LENGTH) < MAX_REMOTE_NAME_LENGTH
+            && stringIsAscii(groupRead.name)))
+    {
+      continue;
+    }
+    EEPROM.put(this->m_groupsAddressStart + index * sizeof(Group), emptyGroup);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Groups detected and reseted: ", count);
+
+  Scene sceneRead;
+  Scene emptyScene;
+  memset(&emptyScene, 0, sizeof(Scene));
+  count = 0;
+  for (int index = 0; index < MAX_SCENES; ++index)
+  {
+    EEPROM.get(this->m_scenesAddressStart + index * sizeof(Scene), sceneRead);
+    bool isValid = sceneRead.id == 0
+        || (sceneRead.id == index + 1 && sceneRead.size <= MAX_SCENE_STEPS
+            && strnlen(sceneRead.name, MAX_REMOTE_NAME_LENGTH) < MAX_REMOTE_NAME_LENGTH
+            && stringIsAscii(sceneRead.name));
+    for (int step = 0; isValid && sceneRead.id != 0 && step < sceneRead.size; ++step)
+    {
+      isValid = sceneRead.steps[step].action <= SCHEDULE_DOWN
+          && sceneRead.steps[step].delay <= SCENE_MAX_DELAY;
+    }
+    if (isValid)
+    {
+      continue;
+    }
+    EEPROM.put(this->m_scenesAddressStart + index * sizeof(Scene), emptyScene);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Scenes detected and reseted: ", count);
+
+  Macro macroRead;
+  Macro emptyMacro;
+  memset(&emptyMacro, 0, sizeof(Macro));
+  count = 0;
+  for (int index = 0; index < MAX_MACROS; ++index)
+  {
+    EEPROM.get(this->m_macrosAddressStart + index * sizeof(Macro), macroRead);
+    bool isValid = macroRead.id == 0
+        || (macroRead.id == index + 1 && macroRead.size <= MAX_MACRO_STEPS
+            && strnlen(macroRead.name, MAX_REMOTE_NAME_LENGTH) < MAX_REMOTE_NAME_LENGTH
+            && stringIsAscii(macroRead.name));
+    for (int step = 0; isValid && macroRead.id != 0 && step < macroRead.size; ++step)
+    {
+      isValid = macroRead.steps[step].action <= SCHEDULE_DOWN
+          && macroRead.steps[step].wait <= MACRO_MAX_WAIT;
+    }
+    if (isValid)
+    {
+      continue;
+    }
+    EEPROM.put(this->m_macrosAddressStart + index * sizeof(Macro), emptyMacro);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Macros detected and reseted: ", count);
+
+  StoredNonceMark nonceMarkRead;
+  StoredNonceMark emptyNonceMark = { 0, 0 };
+  count = 0;
+  for (int index = 0; index < MAX_REMOTES; ++index)
+  {
+    EEPROM.get(this->m_nonceMarksAddressStart + index * sizeof(StoredNonceMark), nonceMarkRead);
+    EEPROM.get(this->m_remotesAddressStart + index * sizeof(Remote), remoteRead);
+    // Written for the remote of this place, or never written.
+    if ((nonceMarkRead.remoteId == 0 && nonceMarkRead.mark == 0)
+        || (nonceMarkRead.remoteId != 0 && nonceMarkRead.remoteId == remoteRead.id))
+    {
+      continue;
+    }
+    EEPROM.put(this->m_nonceMarksAddressStart + index * sizeof(StoredNonceMark), emptyNonceMark);
+    count++;
+  }
+  LOG_DEBUG("Corrupted Nonce marks detected and reseted: ", count);
 
   LOG_DEBUG("Analyse for corrupted version number...");
-  std::regex versionPattern("^[0-9]+\\.[0-9]+\\.[0-9]+$");
   SystemInfos infos;
   EEPROM.get(this->m_lastSystemInfosAddressStart, infos);
-  if (!std::regex_match(infos.version, versionPattern))
+  if (!this->versionIsValid(infos.version, sizeof(infos.version)))
   {
     LOG_WARN("Last version is corrupted. Firmware version will be set.");
     EEPROM.put(this->m_lastSystemInfosAddressStart, FIRMWARE_VERSION);
   }
 
-  EEPROM.commit();
+  this->commit();
 }
 
 /**
@@ -117,51 +245,125 @@ SystemInfos EEPROMDatabase::getSystemInfos()
 }
 
 /**
- * @brief Get the network configuration.
- * If the configuration is corrupted. An empty config is returned (empty SSID and password).
+ * @brief Get the configurations of the networks, by order of preference.
+ * Corrupted configurations are skipped.
  *
- * @return NetworkConfiguration
+ * @param networkConfigs Array for the configurations. Should be an array with a size of
+ * MAX_NETWORK_CONFIGURATIONS, defined in the config file.
+ * @return unsigned char The number of configurations, at the start of the array
  */
-NetworkConfiguration EEPROMDatabase::getNetworkConfiguration()
+unsigned char EEPROMDatabase::getNetworkConfigurations(NetworkConfiguration networkConfigs[])
 {
-  NetworkConfiguration networkConfig;
-  EEPROM.get(this->m_networkConfigAddressStart, networkConfig);
-  if (!this->stringIsAscii(networkConfig.ssid) || !this->stringIsAscii(networkConfig.password))
+  unsigned char size = 0;
+  for (unsigned char index = 0; index < MAX_NETWORK_CONFIGURATIONS; ++index)
   {
-    LOG_ERROR("The networkConfig seems to be corrupted. An empty config will be returned.");
-    LOG_DEBUG("SSID:", networkConfig.ssid);
-    LOG_DEBUG("Password: ", networkConfig.password);
+    NetworkConfiguration& networkConfig = networkConfigs[size];
+    EEPROM.get(this->getNetworkConfigAddress(index), networkConfig);
+    if (!this->stringIsAscii(networkConfig.ssid) || !this->stringIsAscii(networkConfig.password))
+    {
+      // Also the case of slots never written.
+      LOG_DEBUG("The networkConfig seems to be corrupted. It will be skipped:", index);
+      continue;
+    }
+    if (strlen(networkConfig.ssid) > 0)
+    {
+      size++;
+    }
+  }
+  for (unsigned char index = size; index < MAX_NETWORK_CONFIGURATIONS; ++index)
+  {
+    memset(&networkConfigs[index], 0, sizeof(NetworkConfiguration));
+  }
+  return size;
+}
 
-    strcpy(networkConfig.ssid, "");
-    strcpy(networkConfig.password, "");
+/**
+ * @brief Save new network configurations in the EEPROM, they replace the current ones.
+ *
+ * @param networkConfigs The configurations, by order of preference
+ * @param size The number of configurations, up to MAX_NETWORK_CONFIGURATIONS
+ * @return true if the configurations are saved
+ * @return false otherwise
+ */
+bool EEPROMDatabase::setNetworkConfigurations(
+    const NetworkConfiguration networkConfigs[], const unsigned char size)
+{
+  if (size > MAX_NETWORK_CONFIGURATIONS)
+  {
+    LOG_ERROR("Too many network configurations:", size);
+    return false;
   }
-  return networkConfig;
+  LOG_DEBUG("Saving new network configurations...");
+  NetworkConfiguration emptyConfig;
+  memset(&emptyConfig, 0, sizeof(NetworkConfiguration));
+  for (unsigned char index = 0; index < MAX_NETWORK_CONFIGURATIONS; ++index)
+  {
+    EEPROM.put(this->getNetworkConfigAddress(index),
+        index < size ? networkConfigs[index] : emptyConfig);
+  }
+  // The hints of the previous networks may not apply anymore.
+  StoredNetworkHints emptyHints;
+  memset(&emptyHints, 0, sizeof(StoredNetworkHints));
+  EEPROM.put(this->m_networkHintsAddressStart, emptyHints);
+  bool isCommitted = this->commit();
+  LOG_INFO("Network configurations saved.");
+  return isCommitted;
+}
+
+/**
+ * @brief Reset the current network configurations
+ *
+ */
+void EEPROMDatabase::resetNetworkConfigurations()
+{
+  LOG_DEBUG("Reseting network configurations...");
+  this->setNetworkConfigurations(NULL, 0);
+  LOG_INFO("Network configurations reseted.");
 }
 
 /**
- * @brief Save a new network configuration in the EEPROM
+ * @brief Get the hints of the last successful connection to the configured network.
  *
- * @param networkConfig
+ * @param hints The NetworkHints to fill
+ * @return true if hints have been saved for the current network
+ * @return false otherwise
  */
-bool EEPROMDatabase::setNetworkConfiguration(const NetworkConfiguration& networkConfig)
+bool EEPROMDatabase::getNetworkHints(NetworkHints& hints)
 {
-  LOG_DEBUG("Saving new network configuration...");
-  EEPROM.put(this->m_networkConfigAddressStart, networkConfig);
-  EEPROM.commit();
-  LOG_INFO("Network configuration saved.");
+  StoredNetworkHints stored;
+  EEPROM.get(this->m_networkHintsAddressStart, stored);
+  if (stored.magic != NETWORK_HINTS_MAGIC || stored.hints.channel < 1
+      || stored.hints.channel > 14)
+  {
+    LOG_DEBUG("No network hints found.");
+    return false;
+  }
+  hints = stored.hints;
   return true;
 }
 
 /**
- * @brief Reset the current network configuration
+ * @brief Save the hints of a successful connection to the configured network.
+ * Nothing is written if they did not change, to spare the flash.
  *
+ * @param hints The NetworkHints to save
+ * @return true if the hints are saved
+ * @return false otherwise
  */
-void EEPROMDatabase::resetNetworkConfiguration()
+bool EEPROMDatabase::setNetworkHints(const NetworkHints& hints)
 {
-  LOG_DEBUG("Reseting network configuration...");
-  NetworkConfiguration networkConfig = { "", "" };
-  this->setNetworkConfiguration(networkConfig);
-  LOG_INFO("Network configuration reseted.");
+  StoredNetworkHints stored;
+  EEPROM.get(this->m_networkHintsAddressStart, stored);
+  if (stored.magic == NETWORK_HINTS_MAGIC
+      && memcmp(&stored.hints, &hints, sizeof(NetworkHints)) == 0)
+  {
+    return true;
+  }
+  LOG_DEBUG("Saving new network hints...");
+  stored.magic = NETWORK_HINTS_MAGIC;
+  memcpy(&stored.hints, &hints, sizeof(NetworkHints));
+  EEPROM.put(this->m_networkHintsAddressStart, stored);
+  return this->commit();
 }
 
 /**
@@ -173,13 +375,9 @@ void EEPROMDatabase::resetNetworkConfiguration()
 void EEPROMDatabase::getAllRemotes(Remote remotes[])
 {
   LOG_DEBUG("Getting all remotes...");
-  Remote remoteRead;
   for (int i = 0; i < MAX_REMOTES; ++i)
   {
-    EEPROM.get(this->m_remotesAddressStart + i * sizeof(Remote), remoteRead);
-    remotes[i].id = remoteRead.id;
-    remotes[i].rollingCode = remoteRead.rollingCode;
-    strcpy(remotes[i].name, remoteRead.name);
+    this->m_remoteTable.read(i, remotes[i]);
   }
 }
 
@@ -191,18 +389,25 @@ void EEPROMDatabase::getAllRemotes(Remote remotes[])
  */
 Remote EEPROMDatabase::getRemote(const unsigned long& id)
 {
-  LOG_DEBUG("Looking for the remote with the ID:", id);
+  TRACE_SPAN("eeprom.getRemote");
+  DLOG_DEBUG("Looking for the remote with the ID: %lu.", id);
   int index = this->getRemoteIndex(id);
   if (index < 0)
   {
-    LOG_WARN("No Remote found.");
+    DLOG_WARN("No Remote found.");
     Remote emptyRemote = { 0, 0, "" };
     return emptyRemote;
   }
 
-  LOG_DEBUG("Remote found.");
+  DLOG_DEBUG("Remote found.");
   Remote remoteRead;
-  EEPROM.get(this->m_remotesAddressStart + index * sizeof(Remote), remoteRead);
+  this->m_remoteTable.read(index, remoteRead);
+  if (remoteRead.id != id)
+  {
+    // Deleted since it was found.
+    Remote emptyRemote = { 0, 0, "" };
+    return emptyRemote;
+  }
 
   return remoteRead;
 }
@@ -223,13 +428,466 @@ bool EEPROMDatabase::deleteRemote(const unsigned long& id)
     LOG_WARN("No Remote found for the given id. Nothing to remove.");
     return false;
   }
+  Remote deletedRemote;
+  this->m_remoteTable.read(index, deletedRemote);
   Remote emptyRemote = { 0, 0, "" };
   EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), emptyRemote);
-  EEPROM.commit();
+  this->m_remoteTable.write(index, emptyRemote);
+  // The next remote of this place starts without calibration, nor nonce mark.
+  Calibration emptyCalibration = { 0, 0 };
+  EEPROM.put(this->m_calibrationsAddressStart + index * sizeof(Calibration), emptyCalibration);
+  StoredNonceMark emptyNonceMark = { 0, 0 };
+  EEPROM.put(this->m_nonceMarksAddressStart + index * sizeof(StoredNonceMark), emptyNonceMark);
+  this->commit();
+  this->m_changeLog.record(CHANGE_REMOTE_DELETED, deletedRemote);
   LOG_DEBUG("The remote has been deleted.");
   return true;
 }
 
+/**
+ * @brief Get the travel times of a remote.
+ *
+ * @param id The id of the remote
+ * @param calibration The travel times, 0 if the remote is not calibrated.
+ * @return true if the remote exists
+ * @return false otherwise
+ */
+bool EEPROMDatabase::getCalibration(const unsigned long& id, Calibration& calibration)
+{
+  int index = this->getRemoteIndex(id);
+  if (id == 0 || index < 0)
+  {
+    return false;
+  }
+  EEPROM.get(this->m_calibrationsAddressStart + index * sizeof(Calibration), calibration);
+  return true;
+}
+
+/**
+ * @brief Set the travel times of a remote.
+ *
+ * @param id The id of the remote
+ * @param calibration The travel times
+ * @return true if the remote exists
+ * @return false otherwise
+ */
+bool EEPROMDatabase::setCalibration(const unsigned long& id, const Calibration& calibration)
+{
+  LOG_DEBUG("Calibrating remote with the ID:", id);
+  int index = this->getRemoteIndex(id);
+  if (id == 0 || index < 0)
+  {
+    LOG_WARN("No Remote found for the given id. Nothing to calibrate.");
+    return false;
+  }
+  EEPROM.put(this->m_calibrationsAddressStart + index * sizeof(Calibration), calibration);
+  this->commit();
+  return true;
+}
+
+/**
+ * @brief Get the highest nonce of the signed UDP commands that may have been accepted for a
+ * remote, before this boot included.
+ *
+ * @param id The id of the remote
+ * @param mark The nonce, 0 if none was ever written
+ * @return true if the remote exists
+ * @return false otherwise
+ */
+bool EEPROMDatabase::getNonceMark(const unsigned long& id, unsigned long& mark)
+{
+  int index = this->getRemoteIndex(id);
+  if (id == 0 || index < 0)
+  {
+    return false;
+  }
+  StoredNonceMark stored;
+  EEPROM.get(this->m_nonceMarksAddressStart + index * sizeof(StoredNonceMark), stored);
+  mark = stored.remoteId == id ? stored.mark : 0;
+  return true;
+}
+
+/**
+ * @brief Set the highest nonce of the signed UDP commands that may be accepted for a remote.
+ * Written to the flash at once.
+ *
+ * @param id The id of the remote
+ * @param mark The nonce
+ * @return true if the mark has been written
+ * @return false otherwise
+ */
+bool EEPROMDatabase::setNonceMark(const unsigned long& id, const unsigned long mark)
+{
+  int index = this->getRemoteIndex(id);
+  if (id == 0 || index < 0)
+  {
+    return false;
+  }
+  const StoredNonceMark stored = { id, mark };
+  EEPROM.put(this->m_nonceMarksAddressStart + index * sizeof(StoredNonceMark), stored);
+  return this->commit();
+}
+
+/**
+ * @brief Get all the schedules in the database
+ *
+ * @param schedules Array for the schedules. Should be an array with a size of MAX_SCHEDULES,
+ * defined in the config file. Empty schedules have the id 0.
+ */
+void EEPROMDatabase::getAllSchedules(Schedule schedules[])
+{
+  LOG_DEBUG("Getting all schedules...");
+  for (int i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + i * sizeof(Schedule), schedules[i]);
+  }
+}
+
+/**
+ * @brief Add a new schedule in the database.
+ *
+ * @param schedule The schedule to add, its id is ignored.
+ * @return Schedule The created schedule, with an id of 0 if there is no space left.
+ */
+Schedule EEPROMDatabase::createSchedule(const Schedule& schedule)
+{
+  LOG_DEBUG("Adding a new schedule...");
+  Schedule created = schedule;
+  Schedule scheduleRead;
+  for (int index = 0; index < MAX_SCHEDULES; ++index)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + index * sizeof(Schedule), scheduleRead);
+    if (scheduleRead.id != 0)
+    {
+      continue;
+    }
+    created.id = index + 1;
+    EEPROM.put(this->m_schedulesAddressStart + index * sizeof(Schedule), created);
+    this->commit();
+    LOG_DEBUG("A new schedule has been added.");
+    return created;
+  }
+  LOG_ERROR("No space left. Cannot add a new schedule.");
+  created.id = 0;
+  return created;
+}
+
+/**
+ * @brief Remove a schedule from the database
+ *
+ * @param id The id of the schedule to delete.
+ * @return true if the schedule has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteSchedule(const unsigned char id)
+{
+  LOG_DEBUG("Removing schedule with the ID:", id);
+  if (id == 0 || id > MAX_SCHEDULES)
+  {
+    return false;
+  }
+  const int address = this->m_schedulesAddressStart + (id - 1) * sizeof(Schedule);
+  Schedule scheduleRead;
+  EEPROM.get(address, scheduleRead);
+  if (scheduleRead.id != id)
+  {
+    LOG_WARN("No Schedule found for the given id. Nothing to remove.");
+    return false;
+  }
+  Schedule emptySchedule;
+  memset(&emptySchedule, 0, sizeof(Schedule));
+  EEPROM.put(address, emptySchedule);
+  this->commit();
+  LOG_DEBUG("The schedule has been deleted.");
+  return true;
+}
+
+/**
+ * @brief Get all the groups in the database
+ *
+ * @param groups Array for the groups. Should be an array with a size of MAX_GROUPS,
+ * defined in the config file. Empty groups have the id 0.
+ */
+void EEPROMDatabase::getAllGroups(Group groups[])
+{
+  LOG_DEBUG("Getting all groups...");
+  for (int i = 0; i < MAX_GROUPS; ++i)
+  {
+    EEPROM.get(this->m_groupsAddressStart + i * sizeof(Group), groups[i]);
+  }
+}
+
+/**
+ * @brief Get a group from the database.
+ *
+ * @param id The id of the group
+ * @return Group The group, with an id of 0 if it doesn't exist.
+ */
+Group EEPROMDatabase::getGroup(const unsigned char id)
+{
+  Group group;
+  memset(&group, 0, sizeof(Group));
+  if (id == 0 || id > MAX_GROUPS)
+  {
+    return group;
+  }
+  EEPROM.get(this->m_groupsAddressStart + (id - 1) * sizeof(Group), group);
+  return group;
+}
+
+/**
+ * @brief Add a new group in the database.
+ *
+ * @param group The group to add, its id is ignored.
+ * @return Group The created group, with an id of 0 if there is no space left.
+ */
+Group EEPROMDatabase::createGroup(const Group& group)
+{
+  LOG_DEBUG("Adding a new group...");
+  Group created = group;
+  unsigned char id;
+  for (int index = 0; index < MAX_GROUPS; ++index)
+  {
+    // The id comes first.
+    EEPROM.get(this->m_groupsAddressStart + index * sizeof(Group), id);
+    if (id != 0)
+    {
+      continue;
+    }
+    created.id = index + 1;
+    EEPROM.put(this->m_groupsAddressStart + index * sizeof(Group), created);
+    this->commit();
+    LOG_DEBUG("A new group has been added.");
+    return created;
+  }
+  LOG_ERROR("No space left. Cannot add a new group.");
+  created.id = 0;
+  return created;
+}
+
+/**
+ * @brief Remove a group from the database
+ *
+ * @param id The id of the group to delete.
+ * @return true if the group has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteGroup(const unsigned char id)
+{
+  LOG_DEBUG("Removing group with the ID:", id);
+  if (this->getGroup(id).id == 0)
+  {
+    LOG_WARN("No Group found for the given id. Nothing to remove.");
+    return false;
+  }
+  Group emptyGroup;
+  memset(&emptyGroup, 0, sizeof(Group));
+  EEPROM.put(this->m_groupsAddressStart + (id - 1) * sizeof(Group), emptyGroup);
+  this->commit();
+  return true;
+}
+
+/**
+ * @brief Get all the scenes in the database
+ *
+ * @param scenes Array for the scenes. Should be an array with a size of MAX_SCENES,
+ * defined in the config file. Empty scenes have the id 0.
+ */
+void EEPROMDatabase::getAllScenes(Scene scenes[])
+{
+  LOG_DEBUG("Getting all scenes...");
+  for (int i = 0; i < MAX_SCENES; ++i)
+  {
+    EEPROM.get(this->m_scenesAddressStart + i * sizeof(Scene), scenes[i]);
+  }
+}
+
+/**
+ * @brief Get a scene from the database.
+ *
+ * @param id The id of the scene
+ * @return Scene The scene, with an id of 0 if it doesn't exist.
+ */
+Scene EEPROMDatabase::getScene(const unsigned char id)
+{
+  Scene scene;
+  memset(&scene, 0, sizeof(Scene));
+  if (id == 0 || id > MAX_SCENES)
+  {
+    return scene;
+  }
+  EEPROM.get(this->m_scenesAddressStart + (id - 1) * sizeof(Scene), scene);
+  return scene;
+}
+
+/**
+ * @brief Add a new scene in the database.
+ *
+ * @param scene The scene to add, its id is ignored.
+ * @return Scene The created scene, with an id of 0 if there is no space left.
+ */
+Scene EEPROMDatabase::createScene(const Scene& scene)
+{
+  LOG_DEBUG("Adding a new scene...");
+  Scene created = scene;
+  unsigned char id;
+  for (int index = 0; index < MAX_SCENES; ++index)
+  {
+    // The id comes first.
+    EEPROM.get(this->m_scenesAddressStart + index * sizeof(Scene), id);
+    if (id != 0)
+    {
+      continue;
+    }
+    created.id = index + 1;
+    EEPROM.put(this->m_scenesAddressStart + index * sizeof(Scene), created);
+    this->commit();
+    LOG_DEBUG("A new scene has been added.");
+    return created;
+  }
+  LOG_ERROR("No space left. Cannot add a new scene.");
+  created.id = 0;
+  return created;
+}
+
+/**
+ * @brief Remove a scene from the database
+ *
+ * @param id The id of the scene to delete.
+ * @return true if the scene has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteScene(const unsigned char id)
+{
+  LOG_DEBUG("Removing scene with the ID:", id);
+  if (id == 0 || id > MAX_SCENES)
+  {
+    return false;
+  }
+  const int address = this->m_scenesAddressStart + (id - 1) * sizeof(Scene);
+  unsigned char idRead;
+  EEPROM.get(address, idRead);
+  if (idRead != id)
+  {
+    LOG_WARN("No Scene found for the given id. Nothing to remove.");
+    return false;
+  }
+  Scene emptyScene;
+  memset(&emptyScene, 0, sizeof(Scene));
+  EEPROM.put(address, emptyScene);
+  this->commit();
+  return true;
+}
+
+/**
+ * @brief Get all the macros in the database
+ *
+ * @param macros Array for the macros. Should be an array with a size of MAX_MACROS,
+ * defined in the config file. Empty macros have the id 0.
+ */
+void EEPROMDatabase::getAllMacros(Macro macros[])
+{
+  LOG_DEBUG("Getting all macros...");
+  for (int i = 0; i < MAX_MACROS; ++i)
+  {
+    EEPROM.get(this->m_macrosAddressStart + i * sizeof(Macro), macros[i]);
+  }
+}
+
+/**
+ * @brief Get a macro from the database.
+ *
+ * @param id The id of the macro
+ * @return Macro The macro, with an id of 0 if it doesn't exist.
+ */
+Macro EEPROMDatabase::getMacro(const unsigned char id)
+{
+  Macro macro;
+  memset(&macro, 0, sizeof(Macro));
+  if (id == 0 || id > MAX_MACROS)
+  {
+    return macro;
+  }
+  EEPROM.get(this->m_macrosAddressStart + (id - 1) * sizeof(Macro), macro);
+  return macro;
+}
+
+/**
+ * @brief Add a new macro in the database.
+ *
+ * @param macro The macro to add, its id is ignored.
+ * @return Macro The created macro, with an id of 0 if there is no space left.
+ */
+Macro EEPROMDatabase::createMacro(const Macro& macro)
+{
+  LOG_DEBUG("Adding a new macro...");
+  Macro created = macro;
+  unsigned char id;
+  for (int index = 0; index < MAX_MACROS; ++index)
+  {
+    // The id comes first.
+    EEPROM.get(this->m_macrosAddressStart + index * sizeof(Macro), id);
+    if (id != 0)
+    {
+      continue;
+    }
+    created.id = index + 1;
+    EEPROM.put(this->m_macrosAddressStart + index * sizeof(Macro), created);
+    this->commit();
+    LOG_DEBUG("A new macro has been added.");
+    return created;
+  }
+  LOG_ERROR("No space left. Cannot add a new macro.");
+  created.id = 0;
+  return created;
+}
+
+/**
+ * @brief Remove a macro from the database
+ *
+ * @param id The id of the macro to delete.
+ * @return true if the macro has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteMacro(const unsigned char id)
+{
+  LOG_DEBUG("Removing macro with the ID:", id);
+  if (this->getMacro(id).id == 0)
+  {
+    LOG_WARN("No Macro found for the given id. Nothing to remove.");
+    return false;
+  }
+  Macro emptyMacro;
+  memset(&emptyMacro, 0, sizeof(Macro));
+  EEPROM.put(this->m_macrosAddressStart + (id - 1) * sizeof(Macro), emptyMacro);
+  this->commit();
+  return true;
+}
+
+/**
+ * @brief Start a batch: the next writes are kept in the EEPROM cache until endBatch(). The flash
+ * is written once for all of them, instead of once per write.
+ * Warning: the writes of the batch are lost if the device resets before endBatch().
+ */
+void EEPROMDatabase::beginBatch() { this->m_isBatching = true; }
+
+/**
+ * @brief End a batch, commit its writes if any.
+ *
+ * @return true if the writes are committed, or if there was none
+ * @return false otherwise
+ */
+bool EEPROMDatabase::endBatch()
+{
+  this->m_isBatching = false;
+  if (!this->m_isBatchDirty)
+  {
+    return true;
+  }
+  this->m_isBatchDirty = false;
+  return this->commit();
+}
+
 /**
  * @brief Add a new remote in the database.
  *
@@ -252,7 +910,9 @@ Remote EEPROMDatabase::createRemote(const char* name)
   strcpy(emptyRemote.name, name);
 
   EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), emptyRemote);
-  EEPROM.commit();
+  this->m_remoteTable.write(index, emptyRemote);
+  this->commit();
+  this->m_changeLog.record(CHANGE_REMOTE_CREATED, emptyRemote);
 
   LOG_DEBUG("A new remote has been added.");
   return emptyRemote;
@@ -267,19 +927,45 @@ Remote EEPROMDatabase::createRemote(const char* name)
  */
 bool EEPROMDatabase::updateRemote(const Remote& remote)
 {
-  LOG_DEBUG("Updating remote ID:", remote.id);
+  TRACE_SPAN("eeprom.updateRemote");
+  DLOG_DEBUG("Updating remote ID: %lu.", remote.id);
   int index = this->getRemoteIndex(remote.id);
   if (index < 0)
   {
-    LOG_WARN("The remote doesn't exist in the table. It cannot be updated.");
+    DLOG_WARN("The remote doesn't exist in the table. It cannot be updated.");
     return false;
   }
+  Remote previousRemote;
+  this->m_remoteTable.read(index, previousRemote);
+
   EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), remote);
-  EEPROM.commit();
-  LOG_DEBUG("The remote has been updated.");
+  this->m_remoteTable.write(index, remote);
+  this->commit();
+
+  if (strcmp(previousRemote.name, remote.name) != 0)
+  {
+    this->m_changeLog.record(CHANGE_REMOTE_RENAMED, remote);
+  }
+  if (previousRemote.rollingCode != remote.rollingCode)
+  {
+    this->m_changeLog.record(CHANGE_REMOTE_ROLLING_CODE, remote);
+  }
+  DLOG_DEBUG("The remote has been updated.");
   return true;
 }
 
+/**
+ * @brief Get the changes made on remotes since the given sequence.
+ *
+ * @param sequence The last sequence known by the client.
+ * @param feed The feed to fill with the changes.
+ */
+void EEPROMDatabase::getChangesSince(const unsigned long& sequence, ChangeFeed& feed)
+{
+  LOG_DEBUG("Getting changes since the sequence:", sequence);
+  this->m_changeLog.getChangesSince(sequence, feed);
+}
+
 // PRIVATE
 /**
  * @brief Check if a string (char*) contains non-ascii chars.
@@ -302,18 +988,76 @@ bool EEPROMDatabase::stringIsAscii(const char* data)
   return true;
 }
 
+/**
+ * @brief Check if a version looks like "x.y.z" (digits only).
+ * Done by hand: a std::regex costs too much flash for such a check.
+ *
+ * @param version The version to analyse
+ * @param size The size of the buffer holding the version
+ * @return true if the version is valid
+ * @return false otherwise
+ */
+bool EEPROMDatabase::versionIsValid(const char* version, const size_t size)
+{
+  int dots = 0;
+  bool digitExpected = true;
+  for (size_t it = 0; it < size; ++it)
+  {
+    char current = version[it];
+    if (current == '\0')
+    {
+      return !digitExpected && dots == 2;
+    }
+    if (current >= '0' && current <= '9')
+    {
+      digitExpected = false;
+    }
+    else if (current == '.' && !digitExpected && dots < 2)
+    {
+      digitExpected = true;
+      dots++;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  // Not terminated.
+  return false;
+}
+
+/**
+ * @brief Get the address of a network configuration. The first one kept its address of the
+ * single network databases, the others are after the network hints.
+ *
+ * @param index The index of the configuration
+ * @return int The address in the EEPROM
+ */
+int EEPROMDatabase::getNetworkConfigAddress(const unsigned char index)
+{
+  if (index == 0)
+  {
+    return this->m_networkConfigAddressStart;
+  }
+  return this->m_networkConfigsAddressStart + (index - 1) * sizeof(NetworkConfiguration);
+}
+
 int EEPROMDatabase::getRemoteIndex(const unsigned long& id)
+{
+  return this->m_remoteTable.find(id);
+}
+
+/**
+ * @brief Copy the remotes of the EEPROM to the remote table, once they are checked.
+ */
+void EEPROMDatabase::loadRemotes()
 {
   Remote remoteRead;
   for (int i = 0; i < MAX_REMOTES; ++i)
   {
     EEPROM.get(this->m_remotesAddressStart + i * sizeof(Remote), remoteRead);
-    if (remoteRead.id == id)
-    {
-      return i;
-    }
+    this->m_remoteTable.write(i, remoteRead);
   }
-  return -1;
 }
 
 /**
@@ -334,4 +1078,25 @@ bool EEPROMDatabase::migrate()
   }
   // Apply migrations here.
   return true;
+}
+
+/**
+ * @brief Write the EEPROM cache to the flash and record the time spent.
+ *
+ * @return true if the data has been written
+ * @return false otherwise
+ */
+bool EEPROMDatabase::commit()
+{
+  if (this->m_isBatching)
+  {
+    // Committed by endBatch().
+    this->m_isBatchDirty = true;
+    return true;
+  }
+  TRACE_SPAN("eeprom.commit");
+  const unsigned long start = micros();
+  bool committed = EEPROM.commit();
+  metrics.recordEepromCommit(micros() - start);
+  return committed;
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+/**
+ * @file eventBus.cpp
+ * @author Laurette Alexandre
+ * @brief Fan out of the events to the subscribers of the event stream
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <event.h>
+#include <remote.h>
+#include <eventBus.h>
+#include <deferredLog.h>
+
+static const char* const EVENT_NAMES[] = { "remote_created", "remote_renamed", "remote_deleted",
+  "command_queued", "command_transmitted", "command_failed", "rolling_code_reset" };
+
+/**
+ * @brief Add an event for all the subscribers. Cheap, safe to call from any request handler.
+ *
+ * @param type The type of the event
+ * @param remote The remote concerned
+ * @param action The action of the command, for the command events
+ */
+void EventBus::publish(const EventType type, const Remote& remote, const char* action)
+{
+  this->m_lastSequence++;
+  Event& event = this->m_events[this->m_lastSequence % EVENT_BUFFER_SIZE];
+  event.sequence = this->m_lastSequence;
+  event.type = type;
+  event.remoteId = remote.id;
+  event.rollingCode = remote.rollingCode;
+  strncpy(event.name, remote.name, sizeof(event.name) - 1);
+  event.name[sizeof(event.name) - 1] = '\0';
+  strncpy(event.action, action != nullptr ? action : "", sizeof(event.action) - 1);
+  event.action[sizeof(event.action) - 1] = '\0';
+}
+
+/**
+ * @brief Take a free place of subscriber.
+ *
+ * @param lastEventId The last event received before a reconnection, 0 for a new subscriber
+ * @param now The current time in milliseconds
+ * @return short The subscriber, -1 if they are too many already
+ */
+short EventBus::subscribe(const unsigned long lastEventId, const unsigned long now)
+{
+  for (short i = 0; i < MAX_EVENT_SUBSCRIBERS; ++i)
+  {
+    Subscriber& subscriber = this->m_subscribers[i];
+    if (subscriber.isActive)
+    {
+      continue;
+    }
+    subscriber.isActive = true;
+    subscriber.isDropped = false;
+    subscriber.frameLength = 0;
+    subscriber.frameOffset = 0;
+    subscriber.lastWriteAt = now;
+    subscriber.nextSequence = this->m_lastSequence + 1;
+    // Missed events are sent again if the ring still has them, otherwise a full reload is due.
+    subscriber.needsResync = lastEventId != 0
+        && (lastEventId + 1 < this->getFirstSequence() || lastEventId > this->m_lastSequence);
+    if (lastEventId != 0 && !subscriber.needsResync)
+    {
+      subscriber.nextSequence = lastEventId + 1;
+    }
+    return i;
+  }
+  DLOG_WARN("Too many event subscribers, %lu at most.", MAX_EVENT_SUBSCRIBERS);
+  return -1;
+}
+
+/**
+ * @brief Free the place of a subscriber, once disconnected.
+ *
+ * @param subscriber The subscriber given by subscribe()
+ */
+void EventBus::unsubscribe(const short subscriber)
+{
+  if (subscriber >= 0 && subscriber < MAX_EVENT_SUBSCRIBERS)
+  {
+    this->m_subscribers[subscriber].isActive = false;
+  }
+}
+
+/**
+ * @brief Fill a buffer with the next bytes of the stream of a subscriber.
+ *
+ * @param subscriber The subscriber given by subscribe()
+ * @param buffer The buffer to fill
+ * @param maxLength The size of the buffer
+ * @param now The current time in milliseconds
+ * @return size_t The number of bytes written, 0 if there is nothing to send or if the subscriber
+ * has been dropped (see isDropped())
+ */
+size_t EventBus::read(const short subscriber, uint8_t* buffer, const size_t maxLength,
+    const unsigned long now)
+{
+  Subscriber& current = this->m_subscribers[subscriber];
+  size_t written = 0;
+  while (written < maxLength)
+  {
+    if (current.frameOffset >= current.frameLength)
+    {
+      current.frameLength = this->renderFrame(current, now);
+      current.frameOffset = 0;
+      if (current.frameLength == 0)
+      {
+        break;
+      }
+    }
+    size_t length = current.frameLength - current.frameOffset;
+    if (length > maxLength - written)
+    {
+      length = maxLength - written;
+    }
+    memcpy(buffer + written, current.frame + current.frameOffset, length);
+    current.frameOffset += length;
+    written += length;
+  }
+  if (written > 0)
+  {
+    current.lastWriteAt = now;
+  }
+  return written;
+}
+
+/**
+ * @brief Has a subscriber been dropped for being too slow ? Its stream should be closed.
+ *
+ * @param subscriber The subscriber given by subscribe()
+ * @return true, if dropped
+ * @return false, otherwise
+ */
+bool EventBus::isDropped(const short subscriber)
+{
+  return this->m_subscribers[subscriber].isDropped;
+}
+
+/**
+ * @brief Read the event following a sequence, for the readers inside the firmware. They keep
+ * their own sequence and are never dropped, they check hasMissed() instead.
+ *
+ * @param sequence The sequence of the last event read, moved to the event read
+ * @param event The event read
+ * @return true, if an event has been read
+ * @return false, if there is no new event or if the next one is no longer in the ring
+ */
+bool EventBus::readEvent(unsigned long& sequence, Event& event)
+{
+  if (sequence >= this->m_lastSequence || this->hasMissed(sequence))
+  {
+    return false;
+  }
+  sequence++;
+  event = this->m_events[sequence % EVENT_BUFFER_SIZE];
+  return true;
+}
+
+/**
+ * @brief Have events been missed by a reader, pushed out of the ring before being read ?
+ *
+ * @param sequence The sequence of the last event read
+ * @return true, if missed. The reader should start again from getLastSequence()
+ * @return false, otherwise
+ */
+bool EventBus::hasMissed(const unsigned long sequence)
+{
+  return sequence + 1 < this->getFirstSequence();
+}
+
+/**
+ * @brief Get the number of subscribers.
+ *
+ * @return unsigned char
+ */
+unsigned char EventBus::getSubscriberCount()
+{
+  unsigned char count = 0;
+  for (unsigned char i = 0; i < MAX_EVENT_SUBSCRIBERS; ++i)
+  {
+    count += this->m_subscribers[i].isActive ? 1 : 0;
+  }
+  return count;
+}
+
+/**
+ * @brief Get the sequence of the last event published.
+ *
+ * @return unsigned long
+ */
+unsigned long EventBus::getLastSequence() { return this->m_lastSequence; }
+
+// PRIVATE
+
+unsigned long EventBus::getFirstSequence()
+{
+  return this->m_lastSequence < EVENT_BUFFER_SIZE ? 1
+                                                  : this->m_lastSequence - EVENT_BUFFER_SIZE + 1;
+}
+
+size_t EventBus::renderFrame(Subscriber& subscriber, const unsigned long now)
+{
+  if (subscriber.isDropped)
+  {
+    return 0;
+  }
+  if (subscriber.needsResync)
+  {
+    subscriber.needsResync = false;
+    return snprintf(subscriber.frame, sizeof(subscriber.frame),
+        "id: %lu\nevent: resync\ndata: {}\n\n", this->m_lastSequence);
+  }
+  if (subscriber.nextSequence <= this->m_lastSequence)
+  {
+    if (subscriber.nextSequence < this->getFirstSequence())
+    {
+      DLOG_WARN("Event subscriber %lu dropped, %lu events behind.", subscriber.nextSequence,
+          this->m_lastSequence - subscriber.nextSequence);
+      subscriber.isDropped = true;
+      return 0;
+    }
+    const Event& event = this->m_events[subscriber.nextSequence % EVENT_BUFFER_SIZE];
+    subscriber.nextSequence++;
+    return this->renderEvent(event, subscriber.frame, sizeof(subscriber.frame));
+  }
+  if (now - subscriber.lastWriteAt >= EVENT_HEARTBEAT_INTERVAL)
+  {
+    subscriber.lastWriteAt = now;
+    return snprintf(subscriber.frame, sizeof(subscriber.frame), ": heartbeat\n\n");
+  }
+  return 0;
+}
+
+size_t EventBus::renderEvent(const Event& event, char* buffer, const size_t size)
+{
+  size_t length = snprintf(
+      buffer, size, "id: %lu\nevent: %s\ndata: ", event.sequence, EVENT_NAMES[event.type]);
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+  object["remote_id"] = event.remoteId;
+  if (event.type != EVENT_REMOTE_DELETED)
+  {
+    object["name"] = event.name;
+    object["rolling_code"] = event.rollingCode;
+  }
+  if (event.action[0] != '\0')
+  {
+    object["action"] = event.action;
+  }
+  length += serializeJson(doc, buffer + length, size - length - 2);
+  buffer[length++] = '\n';
+  buffer[length++] = '\n';
+  return length;
+}
\ No newline at end of file
@@ -28,6 +28,8 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
+#include <change.h>
+#include <result.h>
 #include <remote.h>
 #include <networks.h>
 #include <systemInfos.h>
@@ -67,13 +69,18 @@ String JSONSerializer::serializeRemotes(const Remote remotes[], int size)
   return output;
 };
 
-String JSONSerializer::serializeNetworkConfig(const NetworkConfiguration& networkConfig)
+String JSONSerializer::serializeNetworkConfigs(
+    const NetworkConfiguration networkConfigs[], int size)
 {
   JsonDocument doc;
-  JsonObject object = doc.to<JsonObject>();
+  JsonArray array = doc.to<JsonArray>();
 
-  object["ssid"] = networkConfig.ssid;
-  object["password"] = networkConfig.password;
+  for (int i = 0; i < size; i++)
+  {
+    JsonObject object = array.add<JsonObject>();
+    object["ssid"] = networkConfigs[i].ssid;
+    object["password"] = networkConfigs[i].password;
+  }
 
   String output;
   serializeJson(doc, output);
@@ -113,6 +120,311 @@ String JSONSerializer::serializeSystemInfos(const SystemInfos& infos){
   return output;
 }
 
+String JSONSerializer::serializeChangeFeed(const ChangeFeed& feed)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["sequence"] = feed.lastSequence;
+  object["resync_required"] = feed.resyncRequired;
+  JsonArray array = object["changes"].to<JsonArray>();
+
+  for (int i = 0; i < feed.size; i++)
+  {
+    const Change& change = feed.changes[i];
+    JsonObject changeObject = array.add<JsonObject>();
+    changeObject["sequence"] = change.sequence;
+    switch (change.type)
+    {
+    case CHANGE_REMOTE_CREATED:
+      changeObject["type"] = "created";
+      break;
+    case CHANGE_REMOTE_RENAMED:
+      changeObject["type"] = "renamed";
+      break;
+    case CHANGE_REMOTE_DELETED:
+      changeObject["type"] = "deleted";
+      break;
+    case CHANGE_REMOTE_ROLLING_CODE:
+      changeObject["type"] = "rolling_code";
+      break;
+    }
+    changeObject["id"] = change.remoteId;
+    changeObject["rolling_code"] = change.rollingCode;
+    changeObject["name"] = change.name;
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeAdmissionMetrics(const AdmissionMetrics& metrics)
+{
+  static const char* const PRIORITY_NAMES[ADMISSION_PRIORITIES] = { "static", "api", "action" };
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["active_requests"] = metrics.activeRequests;
+  object["peak_active_requests"] = metrics.peakActiveRequests;
+  object["free_heap"] = metrics.freeHeap;
+  object["max_free_block"] = metrics.maxFreeBlock;
+  object["lowest_free_heap"] = metrics.lowestFreeHeap;
+  JsonObject priorities = object["priorities"].to<JsonObject>();
+
+  for (int i = 0; i < ADMISSION_PRIORITIES; i++)
+  {
+    JsonObject priority = priorities[PRIORITY_NAMES[i]].to<JsonObject>();
+    priority["admitted"] = metrics.admitted[i];
+    priority["shed"] = metrics.shed[i];
+    priority["active_requests"] = metrics.active[i];
+    priority["min_free_heap"] = metrics.thresholds[i].minFreeHeap;
+    priority["min_free_block"] = metrics.thresholds[i].minFreeBlock;
+    priority["max_active_requests"] = metrics.thresholds[i].maxActiveRequests;
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeBootProfile(const BootProfile& profile)
+{
+  static const char* const PHASE_NAMES[BOOT_PHASES + 1] = { "transmitter", "database",
+    "filesystem", "server", "wifi_connect", "access_point", "wifi_scan", "done" };
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["phase"] = PHASE_NAMES[profile.phase];
+  object["server_ready_at"] = profile.serverReadyAt;
+  object["network_ready_at"] = profile.networkReadyAt;
+  object["first_command_at"] = profile.firstCommandAt;
+  JsonObject durations = object["durations"].to<JsonObject>();
+
+  for (int i = 0; i < BOOT_PHASES; i++)
+  {
+    durations[PHASE_NAMES[i]] = profile.durations[i];
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSwitchoverStatus(const SwitchoverStatus& status)
+{
+  static const char* const STATE_NAMES[] = { "idle", "pending", "connecting", "succeeded",
+    "rolled_back" };
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["state"] = STATE_NAMES[status.state];
+  object["duration"] = status.duration;
+  object["ssid"] = status.ssid;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSchedule(const Schedule& schedule)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeSchedule(object, schedule);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSchedules(const Schedule schedules[], int size)
+{
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+
+  for (int i = 0; i < size; i++)
+  {
+    if (schedules[i].id == 0)
+    {
+      // Empty schedule
+      continue;
+    }
+    JsonObject object = array.add<JsonObject>();
+    this->serializeSchedule(object, schedules[i]);
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeRemotePosition(const RemotePosition& position)
+{
+  static const char* const MOTION_NAMES[] = { "idle", "up", "down" };
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["id"] = position.remoteId;
+  if (position.position < 0)
+  {
+    object["position"] = nullptr;
+  }
+  else
+  {
+    object["position"] = position.position;
+  }
+  if (position.target < 0)
+  {
+    object["target"] = nullptr;
+  }
+  else
+  {
+    object["target"] = position.target;
+  }
+  object["motion"] = MOTION_NAMES[position.motion];
+  object["up_time"] = position.calibration.upTime;
+  object["down_time"] = position.calibration.downTime;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeGroup(const Group& group)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeGroup(object, group);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeGroups(const Group groups[], int size)
+{
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+
+  for (int i = 0; i < size; i++)
+  {
+    if (groups[i].id == 0)
+    {
+      // Empty group
+      continue;
+    }
+    JsonObject object = array.add<JsonObject>();
+    this->serializeGroup(object, groups[i]);
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeScene(const Scene& scene)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeScene(object, scene);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeScenes(const Scene scenes[], int size)
+{
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+
+  for (int i = 0; i < size; i++)
+  {
+    if (scenes[i].id == 0)
+    {
+      // Empty scene
+      continue;
+    }
+    JsonObject object = array.add<JsonObject>();
+    this->serializeScene(object, scenes[i]);
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSceneReport(const SceneReport& report)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["run_id"] = report.runId;
+  if (report.sceneId != 0)
+  {
+    object["scene_id"] = report.sceneId;
+  }
+  else
+  {
+    object["group_id"] = report.groupId;
+  }
+  object["duration"] = report.duration;
+
+  JsonArray steps = object["steps"].to<JsonArray>();
+  for (int i = 0; i < report.size; i++)
+  {
+    JsonObject step = steps.add<JsonObject>();
+    step["remote_id"] = report.steps[i].remoteId;
+    step["sent_at"] = report.steps[i].sentAt;
+    step["message"] = String(getResultMessage((ResultCode)report.steps[i].code));
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeMacro(const Macro& macro)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeMacro(object, macro);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeMacros(const Macro macros[], int size)
+{
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+
+  for (int i = 0; i < size; i++)
+  {
+    if (macros[i].id == 0)
+    {
+      // Empty macro
+      continue;
+    }
+    JsonObject object = array.add<JsonObject>();
+    this->serializeMacro(object, macros[i]);
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
 // PRIVATE
 
 void JSONSerializer::serializeRemote(JsonObject object, const Remote& remote)
@@ -120,4 +432,59 @@ void JSONSerializer::serializeRemote(JsonObject object, const Remote& remote)
   object["id"] = remote.id;
   object["rolling_code"] = remote.rollingCode;
   object["name"] = remote.name;
-};
\ No newline at end of file
+};
+
+void JSONSerializer::serializeSchedule(JsonObject object, const Schedule& schedule)
+{
+  static const char* const EVENT_NAMES[] = { "time", "sunrise", "sunset" };
+  static const char* const ACTION_NAMES[] = { "up", "stop", "down" };
+
+  object["id"] = schedule.id;
+  object["remote_id"] = schedule.remoteId;
+  object["action"] = ACTION_NAMES[schedule.action];
+  object["event"] = EVENT_NAMES[schedule.event];
+  object["minutes"] = (int)schedule.minutes;
+  object["days"] = schedule.days;
+}
+
+void JSONSerializer::serializeGroup(JsonObject object, const Group& group)
+{
+  object["id"] = group.id;
+  object["name"] = group.name;
+  JsonArray remoteIds = object["remote_ids"].to<JsonArray>();
+  for (int i = 0; i < group.size; i++)
+  {
+    remoteIds.add(group.remoteIds[i]);
+  }
+}
+
+void JSONSerializer::serializeScene(JsonObject object, const Scene& scene)
+{
+  static const char* const ACTION_NAMES[] = { "up", "stop", "down" };
+
+  object["id"] = scene.id;
+  object["name"] = scene.name;
+  JsonArray steps = object["steps"].to<JsonArray>();
+  for (int i = 0; i < scene.size; i++)
+  {
+    JsonObject step = steps.add<JsonObject>();
+    step["remote_id"] = scene.steps[i].remoteId;
+    step["action"] = ACTION_NAMES[scene.steps[i].action];
+    step["delay"] = scene.steps[i].delay;
+  }
+}
+
+void JSONSerializer::serializeMacro(JsonObject object, const Macro& macro)
+{
+  static const char* const ACTION_NAMES[] = { "up", "stop", "down" };
+
+  object["id"] = macro.id;
+  object["name"] = macro.name;
+  JsonArray steps = object["steps"].to<JsonArray>();
+  for (int i = 0; i < macro.size; i++)
+  {
+    JsonObject step = steps.add<JsonObject>();
+    step["action"] = ACTION_NAMES[macro.steps[i].action];
+    step["wait"] = macro.steps[i].wait;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * @file lineStream.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the stream copying rendered lines into response buffers.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <lineStream.h>
+#include <lineRendererAbs.h>
+
+LineStream::LineStream(LineRendererAbstract* renderer)
+    : m_renderer(renderer)
+{
+}
+
+/**
+ * @brief Fill a buffer with the next bytes of the rendered text.
+ *
+ * @param buffer The buffer to fill
+ * @param maxLength The size of the buffer
+ * @return size_t The number of bytes written, 0 at the end
+ */
+size_t LineStream::read(uint8_t* buffer, const size_t maxLength)
+{
+  size_t written = 0;
+  while (written < maxLength)
+  {
+    if (this->m_lineOffset >= this->m_lineLength)
+    {
+      this->m_lineLength
+          = this->m_renderer->renderLine(this->m_cursor, this->m_line, sizeof(this->m_line));
+      this->m_lineOffset = 0;
+      if (this->m_lineLength == 0)
+      {
+        break;
+      }
+    }
+    size_t length = this->m_lineLength - this->m_lineOffset;
+    if (length > maxLength - written)
+    {
+      length = maxLength - written;
+    }
+    memcpy(buffer + written, this->m_line + this->m_lineOffset, length);
+    this->m_lineOffset += length;
+    written += length;
+  }
+  return written;
+}
\ No newline at end of file
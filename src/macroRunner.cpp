@@ -0,0 +1,219 @@
+/**
+ * @file macroRunner.cpp
+ * @author Laurette Alexandre
+ * @brief Plays the macros on their remotes, from the main loop.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <macro.h>
+#include <result.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+#include <macroRunner.h>
+
+static const char* const MACRO_ACTIONS[] = { "up", "stop", "down" };
+
+MacroRunner::MacroRunner(Controller* controller, DatabaseAbstract* database, EventBus* eventBus)
+    : m_controller(controller)
+    , m_database(database)
+    , m_eventBus(eventBus)
+{
+}
+
+/**
+ * @brief Start a macro on a remote, its first action is sent now.
+ *
+ * @param remoteId The id of the remote
+ * @param macroId The id of the macro
+ * @param now The current time, in milliseconds
+ * @return Result The result of the first action, if sent
+ */
+Result MacroRunner::run(
+    const unsigned long remoteId, const unsigned long macroId, const unsigned long now)
+{
+  this->collectEvents();
+  Result result;
+  if (remoteId == 0)
+  {
+    result.code = RESULT_REMOTE_ID_MISSING;
+    return result;
+  }
+  if (macroId == 0 || macroId > MAX_MACROS)
+  {
+    result.code = RESULT_MACRO_NOT_FOUND;
+    return result;
+  }
+  const Macro macro = this->m_database->getMacro(macroId);
+  if (macro.id == 0 || macro.size == 0)
+  {
+    result.code = RESULT_MACRO_NOT_FOUND;
+    return result;
+  }
+
+  Run* run = this->findRun(remoteId);
+  if (run == nullptr)
+  {
+    run = this->findRun(0);
+  }
+  if (run == nullptr)
+  {
+    result.code = RESULT_TOO_MANY_RUNNING_MACROS;
+    return result;
+  }
+  run->remoteId = remoteId;
+  run->macro = macro;
+  run->next = 0;
+
+  result = this->play(*run, now);
+  if (!result.isSuccess)
+  {
+    return result;
+  }
+  DLOG_INFO("Macro %lu started on the remote %lu.", macroId, remoteId);
+  result.code = RESULT_MACRO_STARTED;
+  return result;
+}
+
+/**
+ * @brief Send the next action due, if any. One at most per call, a transmission blocks for more
+ * than 100 ms. To call from the main loop, as often as possible: the delay of a call delays
+ * the action.
+ *
+ * @param now The current time, in milliseconds
+ */
+void MacroRunner::loop(const unsigned long now)
+{
+  this->collectEvents();
+  for (unsigned short i = 0; i < MAX_RUNNING_MACROS; ++i)
+  {
+    Run& run = this->m_runs[i];
+    if (run.remoteId == 0 || (long)(now - run.dueAt) < 0)
+    {
+      continue;
+    }
+    DLOG_DEBUG("Macro step of the remote %lu, %lu ms late.", run.remoteId, now - run.dueAt);
+    this->play(run, now);
+    return;
+  }
+}
+
+/**
+ * @brief Cancel the macro of a remote. Its last action is not undone.
+ *
+ * @param remoteId The id of the remote
+ * @return true, if a macro was running on the remote
+ * @return false, otherwise
+ */
+bool MacroRunner::cancel(const unsigned long remoteId)
+{
+  Run* run = this->findRun(remoteId);
+  if (run == nullptr)
+  {
+    return false;
+  }
+  run->remoteId = 0;
+  return true;
+}
+
+bool MacroRunner::isRunning(const unsigned long remoteId)
+{
+  return remoteId != 0 && this->findRun(remoteId) != nullptr;
+}
+
+// PRIVATE
+
+/**
+ * @brief Cancel the macros of the remotes stopped or deleted since the last call.
+ *
+ * @param ownRemoteId The remote of the command just sent by a macro, 0 if none
+ * @param ownAction The action of this command, its event is skipped once
+ */
+void MacroRunner::collectEvents(unsigned long ownRemoteId, const char* ownAction)
+{
+  if (this->m_eventBus->hasMissed(this->m_lastSequence))
+  {
+    // The STOPs in the missed events are not known, the macros go on.
+    DLOG_WARN("Macro runner behind the events.");
+    this->m_lastSequence = this->m_eventBus->getLastSequence();
+  }
+
+  Event event;
+  while (this->m_eventBus->readEvent(this->m_lastSequence, event))
+  {
+    if (ownRemoteId != 0 && event.type == EVENT_COMMAND_TRANSMITTED
+        && event.remoteId == ownRemoteId && strcmp(event.action, ownAction) == 0)
+    {
+      // Its own command, not a STOP of another client.
+      ownRemoteId = 0;
+      continue;
+    }
+    const bool isStop
+        = event.type == EVENT_COMMAND_TRANSMITTED && strcmp(event.action, "stop") == 0;
+    if ((isStop || event.type == EVENT_REMOTE_DELETED) && this->cancel(event.remoteId))
+    {
+      DLOG_INFO("Macro of the remote %lu cancelled.", event.remoteId);
+    }
+  }
+}
+
+/**
+ * @brief Send the next action of a run, and plan the one after.
+ */
+Result MacroRunner::play(Run& run, const unsigned long now)
+{
+  const unsigned long remoteId = run.remoteId;
+  const MacroStep& step = run.macro.steps[run.next];
+  Result result = this->m_controller->operateRemote(remoteId, MACRO_ACTIONS[step.action]);
+  // The other events published meanwhile are still seen, a STOP among them cancels the run.
+  this->collectEvents(remoteId, MACRO_ACTIONS[step.action]);
+  if (!result.isSuccess)
+  {
+    DLOG_WARN("Macro of the remote %lu stopped, result %lu.", remoteId, result.code);
+    run.remoteId = 0;
+    return result;
+  }
+  run.dueAt = now + step.wait;
+  if (++run.next >= run.macro.size)
+  {
+    run.remoteId = 0;
+  }
+  return result;
+}
+
+MacroRunner::Run* MacroRunner::findRun(const unsigned long remoteId)
+{
+  for (unsigned short i = 0; i < MAX_RUNNING_MACROS; ++i)
+  {
+    if (this->m_runs[i].remoteId == remoteId)
+    {
+      return &this->m_runs[i];
+    }
+  }
+  return nullptr;
+}
\ No newline at end of file
@@ -30,28 +30,216 @@
 #include <DebugLog.h>
 #include <LittleFS.h>
 #include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
 #include <ESPAsyncTCP.h>
 #include <ESPAsyncWebServer.h>
 
 #include <config.h>
 #include <remote.h>
+#include <result.h>
 #include <networks.h>
+#include <router.h>
 #include <controller.h>
 #include <wifiClient.h>
 #include <wifiAccessPoint.h>
 #include <RTSTransmitter.h>
 #include <eepromDatabase.h>
 #include <jsonSerializer.h>
+#include <routerWebHandler.h>
+#include <staticAssetHandler.h>
+#include <admissionController.h>
+#include <admissionWebHandler.h>
+#include <networkScanner.h>
+#include <metrics.h>
+#include <lineStream.h>
+#include <trace.h>
+#include <deferredLog.h>
+#include <networkConnector.h>
+#include <bootSequence.h>
+#include <wifiSupervisor.h>
+#include <networkSwitchover.h>
+#include <udpCommandHandler.h>
+#include <eventBus.h>
+#include <mqttClient.h>
+#include <mqttBridge.h>
+#include <scheduler.h>
+#include <positionTracker.h>
+#include <sceneRunner.h>
+#include <macroRunner.h>
+#include <commandDeduplicator.h>
+#include <airtimeBudget.h>
+#include <airtimeScheduler.h>
+#include <commandQueue.h>
+#include <taskScheduler.h>
 
 EEPROMDatabase database;
 WifiClient wifiClient;
 WifiAccessPoint wifiAP;
 JSONSerializer serializer;
-RTSTransmitter transmitter;
+AirtimeBudget airtimeBudget;
+RTSTransmitter transmitter(&airtimeBudget);
 
 AsyncWebServer server(SERVER_PORT);
-Network networks[MAX_NETWORK_SCAN];
-Controller controller(&database, &wifiClient, &serializer, &transmitter);
+Router router;
+RouterWebHandler routerHandler(&router);
+StaticAssetHandler assetHandler(LittleFS);
+AdmissionController admission;
+AdmissionWebHandler admissionHandler(&admission);
+NetworkScanner networkScanner(&wifiClient);
+NetworkConnector networkConnector(&database, &wifiClient, &networkScanner);
+NetworkSwitchover networkSwitchover(&database, &networkConnector, &wifiClient, &wifiAP);
+EventBus eventBus;
+Controller controller(
+    &database, &wifiClient, &serializer, &transmitter, &networkSwitchover, &eventBus);
+MqttClient mqttClient(MQTT_HOST, MQTT_PORT, MQTT_USER, MQTT_PASSWORD);
+MqttBridge mqttBridge(&controller, &database, &eventBus, &mqttClient);
+AirtimeScheduler airtimeScheduler(&controller, &airtimeBudget);
+Scheduler scheduler(&database, &airtimeScheduler);
+PositionTracker positionTracker(&controller, &database, &eventBus);
+SceneRunner sceneRunner(&controller, &database);
+MacroRunner macroRunner(&controller, &database, &eventBus);
+CommandDeduplicator commandDeduplicator(&eventBus);
+BootSequence bootSequence(&networkConnector, &wifiClient, &wifiAP, &networkScanner);
+WifiSupervisor wifiSupervisor(&networkConnector, &wifiClient, &wifiAP);
+WiFiUDP udp;
+UdpCommandHandler udpCommandHandler(&controller, &database, UDP_COMMAND_KEY);
+CommandQueue commandQueue(&controller, &commandDeduplicator);
+TaskScheduler tasks;
+short commandTask = -1;
+
+// ============================================================================
+// WEBSERVER RESPONSES
+// ============================================================================
+/**
+ * @brief Send {"message":"..."} for a result code.
+ * The message is copied chunk by chunk from flash into the TCP buffer, no String is built.
+ *
+ * @param request The request to answer
+ * @param code The HTTP status code
+ * @param resultCode The result code giving the message
+ */
+void sendMessage(AsyncWebServerRequest* request, int code, const ResultCode resultCode)
+{
+  AsyncWebServerResponse* response = request->beginResponse("application/json",
+      getResultBodyLength(resultCode),
+      [resultCode](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+      { return readResultBody(resultCode, buffer, maxLen, index); });
+  response->setCode(code);
+  request->send(response);
+}
+
+// Requests waiting for their queued command, answered from loop() once it is operated: the
+// status code depends on its result.
+struct HeldRequest
+{
+  AsyncWebServerRequest* request; // nullptr when the place is free or the client has left.
+  unsigned long ticket;
+  int successCode;
+  bool isAction; // A remote action, recorded as a command sent.
+};
+HeldRequest heldRequests[COMMAND_QUEUE_SIZE] = {};
+
+/**
+ * @brief Hold a request until its command is operated. The connection stays open meanwhile,
+ * the TCP stack keeps running.
+ *
+ * @param request The request to answer
+ * @param ticket The ticket of the command, 0 if the queue was full
+ * @param successCode The HTTP status code when the command succeeds
+ * @param isAction true for a remote action
+ */
+void holdRequest(AsyncWebServerRequest* request, const unsigned long ticket,
+    const int successCode, const bool isAction)
+{
+  if (ticket == 0)
+  {
+    sendMessage(request, 503, RESULT_TOO_MANY_PENDING_COMMANDS);
+    return;
+  }
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    HeldRequest& held = heldRequests[i];
+    if (held.request != nullptr)
+    {
+      continue;
+    }
+    held.request = request;
+    held.ticket = ticket;
+    held.successCode = successCode;
+    held.isAction = isAction;
+    // Replaces the callback of the admission control, one per request: released here too.
+    const AdmissionPriority priority
+        = AdmissionController::classify(request->url().c_str(), request->method());
+    request->onDisconnect(
+        [ticket, priority]()
+        {
+          for (unsigned short j = 0; j < COMMAND_QUEUE_SIZE; ++j)
+          {
+            if (heldRequests[j].ticket == ticket)
+            {
+              heldRequests[j].request = nullptr;
+            }
+          }
+          admission.release(priority);
+        });
+    tasks.wake(commandTask, millis());
+    return;
+  }
+  // One place per command of the queue, never reached.
+  sendMessage(request, 503, RESULT_TOO_MANY_PENDING_COMMANDS);
+}
+
+/**
+ * @brief Queue a job and hold its request until it has run.
+ *
+ * @param request The request to answer
+ * @param successCode The HTTP status code when the job succeeds, sent with its data if any
+ * @param job The job, e.g. a write to the database
+ */
+void queueJob(AsyncWebServerRequest* request, const int successCode, CommandJob job)
+{
+  holdRequest(request, commandQueue.push(job, millis()), successCode, false);
+}
+
+/**
+ * @brief Answer the requests whose command has been operated. Called from loop().
+ *
+ * @param now The current time in milliseconds
+ */
+void answerHeldRequests(const unsigned long now)
+{
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    HeldRequest& held = heldRequests[i];
+    if (held.request == nullptr || !commandQueue.isDone(held.ticket))
+    {
+      continue;
+    }
+    AsyncWebServerRequest* request = held.request;
+    held.request = nullptr;
+    Result result;
+    if (!commandQueue.take(held.ticket, result))
+    {
+      request->send(500);
+      continue;
+    }
+    if (!result.isSuccess)
+    {
+      sendMessage(request, 400, result.code);
+      continue;
+    }
+    if (held.isAction)
+    {
+      bootSequence.recordCommand(now);
+    }
+    if (result.data.length() > 0)
+    {
+      request->send(held.successCode, "application/json", result.data);
+      continue;
+    }
+    sendMessage(request, held.successCode, result.code);
+  }
+}
 
 // ============================================================================
 // WEBSERVER CALLBACKS HTML
@@ -65,97 +253,242 @@ void homePage(AsyncWebServerRequest* request)
 // ============================================================================
 // WEBSERVER CALLBACKS RESTAPI
 // ============================================================================
-void handleSystemRestart(AsyncWebServerRequest* request)
+void handleSystemRestart(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to restart module reached.");
   request->send(200, "application/json", "{\"message\":\"Restarting...\"}");
   ESP.restart();
 }
 
-void handleFetchSystemInfos(AsyncWebServerRequest* request)
+void handleFetchSystemInfos(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to fetch system informations reached.");
   Result result = controller.fetchSystemInfos();
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, result.code);
     return;
   }
   request->send(200, "application/json", result.data);
 }
 
-void handleFetchWifiNetworks(AsyncWebServerRequest* request)
+void handleFetchAdmissionMetrics(AsyncWebServerRequest* request, const RouteParams& params)
 {
-  LOG_INFO("Endpoint to fetch Wifi Networks reached.");
-  String serialized = serializer.serializeNetworks(networks, MAX_NETWORK_SCAN);
+  LOG_INFO("Endpoint to fetch admission metrics reached.");
+  String serialized = serializer.serializeAdmissionMetrics(admission.getMetrics());
+  request->send(200, "application/json", serialized);
+}
+
+void handleFetchBootProfile(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch boot profile reached.");
+  String serialized = serializer.serializeBootProfile(bootSequence.getProfile());
   request->send(200, "application/json", serialized);
 }
 
-void handleFetchWifiConfiguration(AsyncWebServerRequest* request)
+void handleFetchMetrics(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch metrics reached.");
+  // Rendered line by line into the chunks of the response, no String holds the whole text.
+  LineStream stream(&metrics);
+  AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain; version=0.0.4",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      { return stream.read(buffer, maxLen); });
+  request->send(response);
+}
+
+void handleFetchLogs(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch logs reached.");
+  LineStream stream(&deferredLog);
+  AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      { return stream.read(buffer, maxLen); });
+  request->send(response);
+}
+
+#ifdef SOMFY_TRACE
+void handleFetchTraces(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch traces reached.");
+  // Open the JSON in chrome://tracing or https://ui.perfetto.dev
+  LineStream stream(&traces);
+  AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      { return stream.read(buffer, maxLen); });
+  request->send(response);
+}
+
+void handleClearTraces(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to clear traces reached.");
+  traces.clear();
+  request->send(204);
+}
+#endif // SOMFY_TRACE
+
+void handleFetchWifiNetworks(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch Wifi Networks reached.");
+  // Cached networks are sent right away, a new scan runs in background when they are too old.
+  const unsigned long now = millis();
+  networkScanner.refreshIfStale(now);
+  String serialized
+      = serializer.serializeNetworks(networkScanner.getNetworks(), networkScanner.getSize());
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json", serialized);
+  if (networkScanner.hasResults())
+  {
+    response->addHeader("Age", String(networkScanner.getAge(now) / 1000));
+  }
+  request->send(response);
+}
+
+void handleFetchWifiConfiguration(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to fetch Network Configuration reached.");
   Result result = controller.fetchNetworkConfiguration();
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, result.code);
     return;
   }
   request->send(200, "application/json", result.data);
 }
 
-void handleUpdateWifiConfiguration(AsyncWebServerRequest* request)
+void handleUpdateWifiConfiguration(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to update the Wifi Wonfiguration reached.");
 
-  String ssid;
-  String password;
-  if (request->hasParam("ssid", true))
+  // Several networks are given as repeated ssid and password fields, by order of preference.
+  // One more than the maximum is read to report the excess.
+  String ssids[MAX_NETWORK_CONFIGURATIONS + 1];
+  String passwords[MAX_NETWORK_CONFIGURATIONS + 1];
+  unsigned char ssidsSize = 0;
+  unsigned char passwordsSize = 0;
+  for (size_t i = 0; i < request->params(); ++i)
   {
-    AsyncWebParameter* p = request->getParam("ssid", true);
-    ssid = p->value();
+    AsyncWebParameter* p = request->getParam(i);
+    if (!p->isPost())
+    {
+      continue;
+    }
+    if (p->name() == "ssid" && ssidsSize <= MAX_NETWORK_CONFIGURATIONS)
+    {
+      ssids[ssidsSize++] = p->value();
+    }
+    else if (p->name() == "password" && passwordsSize <= MAX_NETWORK_CONFIGURATIONS)
+    {
+      passwords[passwordsSize++] = p->value();
+    }
   }
-  if (request->hasParam("password", true))
+
+  // Without any ssid, the controller reports it as empty.
+  unsigned char size = ssidsSize > 0 ? ssidsSize : 1;
+  const char* ssidValues[MAX_NETWORK_CONFIGURATIONS + 1];
+  const char* passwordValues[MAX_NETWORK_CONFIGURATIONS + 1];
+  for (unsigned char i = 0; i < size; ++i)
   {
-    AsyncWebParameter* p = request->getParam("password", true);
-    password = p->value();
+    ssidValues[i] = ssids[i].c_str();
+    passwordValues[i] = passwords[i].c_str();
   }
 
-  Result result = controller.updateNetworkConfiguration(ssid.c_str(), password.c_str());
+  Result result = controller.updateNetworkConfigurations(ssidValues, passwordValues, size);
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, result.code == RESULT_NETWORK_SWITCHOVER_RUNNING ? 409 : 400,
+        result.code);
     return;
   }
-  request->send(201, "application/json", result.data);
+  // Applied from loop(), the outcome is given by /api/v1/wifi/switchover.
+  request->send(202, "application/json", result.data);
 }
 
-void handleFetchAllRemotes(AsyncWebServerRequest* request)
+void handleFetchWifiSwitchover(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch the Wifi Configuration switchover reached.");
+  Result result = controller.fetchNetworkSwitchover();
+  request->send(200, "application/json", result.data);
+}
+
+void handleFetchAllRemotes(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to fetch all remotes reached.");
   Result result = controller.fetchAllRemotes();
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, result.code);
+    return;
+  }
+  request->send(200, "application/json", result.data);
+}
+
+void handleFetchRemoteChanges(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch remote changes reached.");
+
+  unsigned long since = 0;
+  if (request->hasParam("since"))
+  {
+    AsyncWebParameter* p = request->getParam("since");
+    since = p->value().toInt();
+  }
+
+  Result result = controller.fetchRemoteChanges(since);
+  if (!result.isSuccess)
+  {
+    sendMessage(request, 400, result.code);
     return;
   }
   request->send(200, "application/json", result.data);
 }
 
-void handleFetchRemote(AsyncWebServerRequest* request)
+void handleEventStream(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to stream events reached.");
+  // Sent back by the browser when its EventSource reconnects.
+  unsigned long lastEventId = 0;
+  if (request->hasHeader("Last-Event-ID"))
+  {
+    lastEventId = strtoul(request->getHeader("Last-Event-ID")->value().c_str(), nullptr, 10);
+  }
+
+  const short subscriber = eventBus.subscribe(lastEventId, millis());
+  if (subscriber < 0)
+  {
+    sendMessage(request, 503, RESULT_TOO_MANY_SUBSCRIBERS);
+    return;
+  }
+  // Never ends by itself: the callback is polled until the client leaves or is dropped.
+  AsyncWebServerResponse* response = request->beginChunkedResponse("text/event-stream",
+      [subscriber](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+      {
+        size_t length = eventBus.read(subscriber, buffer, maxLen, millis());
+        if (length == 0 && !eventBus.isDropped(subscriber))
+        {
+          return RESPONSE_TRY_AGAIN;
+        }
+        return length;
+      });
+  response->addHeader("Cache-Control", "no-cache");
+  request->onDisconnect([subscriber]() { eventBus.unsubscribe(subscriber); });
+  request->send(response);
+}
+
+void handleFetchRemote(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to fetch a remote reached.");
-  unsigned long remoteId = request->pathArg(0).toInt();
+  unsigned long remoteId = params.values[0];
 
   Result result = controller.fetchRemote(remoteId);
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, result.code);
     return;
   }
   request->send(200, "application/json", result.data);
 }
 
-void handleCreateRemote(AsyncWebServerRequest* request)
+void handleCreateRemote(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to create a remote reached.");
 
@@ -166,19 +499,14 @@ void handleCreateRemote(AsyncWebServerRequest* request)
     name = p->value();
   }
 
-  Result result = controller.createRemote(name.c_str());
-  if (!result.isSuccess)
-  {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
-    return;
-  }
-  request->send(201, "application/json", result.data);
+  queueJob(request, 201,
+      [name](const unsigned long now) { return controller.createRemote(name.c_str()); });
 }
 
-void handleUpdateRemote(AsyncWebServerRequest* request)
+void handleUpdateRemote(AsyncWebServerRequest* request, const RouteParams& params)
 {
   LOG_INFO("Endpoint to update a remote reached.");
-  unsigned long remoteId = request->pathArg(0).toInt();
+  unsigned long remoteId = params.values[0];
 
   String name;
   unsigned int rollingCode = 0;
@@ -195,137 +523,727 @@ void handleUpdateRemote(AsyncWebServerRequest* request)
     rollingCode = int(p->value().toInt());
   }
 
-  Result result = controller.updateRemote(remoteId, name.c_str(), rollingCode);
+  queueJob(request, 200,
+      [remoteId, name, rollingCode](const unsigned long now)
+      { return controller.updateRemote(remoteId, name.c_str(), rollingCode); });
+}
+
+void handleDeleteRemote(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to delete a remote reached.");
+  unsigned long remoteId = params.values[0];
+
+  queueJob(request, 200,
+      [remoteId](const unsigned long now) { return controller.deleteRemote(remoteId); });
+}
+
+void handleActionRemote(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  DLOG_INFO("Endpoint to operate an action on a remote reached.");
+  unsigned long remoteId = params.values[0];
+
+  String action;
+  if (request->hasParam("action", true))
+  {
+    AsyncWebParameter* p = request->getParam("action", true);
+    action = p->value();
+  }
+
+  if (action == "position")
+  {
+    // Out of range when not given.
+    int position = -1;
+    if (request->hasParam("position", true))
+    {
+      position = request->getParam("position", true)->value().toInt();
+    }
+    // The tracker sends the first frame at once, from loop() too.
+    const unsigned long ticket = commandQueue.push(
+        [remoteId, position](const unsigned long now)
+        { return positionTracker.moveTo(remoteId, position, now); },
+        millis());
+    holdRequest(request, ticket, 200, true);
+    return;
+  }
+  if (action == "macro")
+  {
+    unsigned long macroId = 0;
+    if (request->hasParam("macro_id", true))
+    {
+      macroId = request->getParam("macro_id", true)->value().toInt();
+    }
+    const unsigned long ticket = commandQueue.push(
+        [remoteId, macroId](const unsigned long now)
+        { return macroRunner.run(remoteId, macroId, now); },
+        millis());
+    holdRequest(request, ticket, 200, true);
+    return;
+  }
+
+  String key;
+  if (request->hasHeader("Idempotency-Key"))
+  {
+    key = request->getHeader("Idempotency-Key")->value();
+  }
+  else if (request->hasParam("idempotency_key", true))
+  {
+    key = request->getParam("idempotency_key", true)->value();
+  }
+  // Checked at once, not to fill the queue with commands bound to fail.
+  Result result = controller.checkCommand(remoteId, action.c_str());
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, result.code);
     return;
   }
-  request->send(200, "application/json", result.data);
+  holdRequest(
+      request, commandQueue.push(remoteId, action.c_str(), key.c_str(), millis()), 200, true);
 }
 
-void handleDeleteRemote(AsyncWebServerRequest* request)
+void handleFetchRemotePosition(AsyncWebServerRequest* request, const RouteParams& params)
 {
-  LOG_INFO("Endpoint to delete a remote reached.");
-  unsigned long remoteId = request->pathArg(0).toInt();
+  LOG_INFO("Endpoint to fetch the position of a remote reached.");
+  unsigned long remoteId = params.values[0];
 
-  Result result = controller.deleteRemote(remoteId);
-  if (!result.isSuccess)
+  RemotePosition position;
+  if (!positionTracker.getPosition(remoteId, millis(), position))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, 400, RESULT_REMOTE_NOT_FOUND);
     return;
   }
-  request->send(200, "application/json", "{\"message\":\"The remote has been deleted.\"}");
+  request->send(200, "application/json", serializer.serializeRemotePosition(position));
 }
 
-void handleActionRemote(AsyncWebServerRequest* request)
+void handleCalibrateRemote(AsyncWebServerRequest* request, const RouteParams& params)
 {
-  LOG_INFO("Endpoint to operate an action on a remote reached.");
-  unsigned long remoteId = request->pathArg(0).toInt();
+  LOG_INFO("Endpoint to calibrate a remote reached.");
+  unsigned long remoteId = params.values[0];
+
+  unsigned long upTime = 0;
+  unsigned long downTime = 0;
+  if (request->hasParam("up_time", true))
+  {
+    upTime = request->getParam("up_time", true)->value().toInt();
+  }
+  if (request->hasParam("down_time", true))
+  {
+    downTime = request->getParam("down_time", true)->value().toInt();
+  }
 
+  queueJob(request, 200,
+      [remoteId, upTime, downTime](const unsigned long now)
+      { return controller.calibrateRemote(remoteId, upTime, downTime); });
+}
+
+void handleFetchAllSchedules(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch all schedules reached.");
+  Result result = controller.fetchAllSchedules();
+  request->send(200, "application/json", result.data);
+}
+
+void handleCreateSchedule(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to create a schedule reached.");
+
+  unsigned long remoteId = 0;
   String action;
+  String event;
+  int minutes = 0;
+  // Every day by default.
+  unsigned char days = 0x7F;
+
+  if (request->hasParam("remote_id", true))
+  {
+    remoteId = request->getParam("remote_id", true)->value().toInt();
+  }
   if (request->hasParam("action", true))
   {
-    AsyncWebParameter* p = request->getParam("action", true);
-    action = p->value();
+    action = request->getParam("action", true)->value();
+  }
+  if (request->hasParam("event", true))
+  {
+    event = request->getParam("event", true)->value();
+  }
+  if (request->hasParam("minutes", true))
+  {
+    minutes = request->getParam("minutes", true)->value().toInt();
+  }
+  if (request->hasParam("days", true))
+  {
+    const long value = request->getParam("days", true)->value().toInt();
+    // Out of range values are reported by the controller.
+    days = (value < 0 || value > 0x7F) ? 0 : value;
+  }
+
+  queueJob(request, 201,
+      [remoteId, action, event, minutes, days](const unsigned long now)
+      {
+        Result result
+            = controller.createSchedule(remoteId, action.c_str(), event.c_str(), minutes, days);
+        if (result.isSuccess)
+        {
+          scheduler.reload();
+        }
+        return result;
+      });
+}
+
+void handleDeleteSchedule(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to delete a schedule reached.");
+  unsigned long scheduleId = params.values[0];
+
+  queueJob(request, 200,
+      [scheduleId](const unsigned long now)
+      {
+        Result result = controller.deleteSchedule(scheduleId);
+        if (result.isSuccess)
+        {
+          scheduler.reload();
+        }
+        return result;
+      });
+}
+
+/**
+ * @brief Parse a list of remote ids: "1,2,3".
+ *
+ * @param text The list
+ * @param remoteIds Filled with the ids
+ * @param maxSize The size of remoteIds
+ * @return unsigned char The number of ids, 0 if the list is not valid
+ */
+unsigned char parseRemoteIds(
+    const char* text, unsigned long remoteIds[], const unsigned char maxSize)
+{
+  unsigned char size = 0;
+  while (*text != '\0')
+  {
+    if (size == maxSize)
+    {
+      return 0;
+    }
+    char* end;
+    remoteIds[size] = strtoul(text, &end, 10);
+    if (end == text || (*end != ',' && *end != '\0'))
+    {
+      return 0;
+    }
+    size++;
+    text = *end == ',' ? end + 1 : end;
+  }
+  return size;
+}
+
+/**
+ * @brief Parse the steps of a scene: "remote_id:action:delay,...", the delay in milliseconds.
+ * The actions point into text, whose separators are replaced by '\0'.
+ *
+ * @return unsigned char The number of steps, 0 if the list is not valid
+ */
+unsigned char parseSceneSteps(char* text, unsigned long remoteIds[], const char* actions[],
+    unsigned long delays[], const unsigned char maxSize)
+{
+  unsigned char size = 0;
+  while (*text != '\0')
+  {
+    if (size == maxSize)
+    {
+      return 0;
+    }
+    char* end;
+    remoteIds[size] = strtoul(text, &end, 10);
+    if (end == text || *end != ':')
+    {
+      return 0;
+    }
+    actions[size] = end + 1;
+    char* separator = strchr(end + 1, ':');
+    if (separator == nullptr)
+    {
+      return 0;
+    }
+    *separator = '\0';
+    delays[size] = strtoul(separator + 1, &end, 10);
+    if (end == separator + 1 || (*end != ',' && *end != '\0'))
+    {
+      return 0;
+    }
+    size++;
+    text = *end == ',' ? end + 1 : end;
+  }
+  return size;
+}
+
+/**
+ * @brief Parse the steps of a macro: "action:wait,...", the wait in milliseconds.
+ * The actions point into text, whose separators are replaced by '\0'.
+ *
+ * @return unsigned char The number of steps, 0 if the list is not valid
+ */
+unsigned char parseMacroSteps(
+    char* text, const char* actions[], unsigned long waits[], const unsigned char maxSize)
+{
+  unsigned char size = 0;
+  while (*text != '\0')
+  {
+    char* separator = strchr(text, ':');
+    if (size == maxSize || separator == nullptr)
+    {
+      return 0;
+    }
+    *separator = '\0';
+    actions[size] = text;
+    char* end;
+    waits[size] = strtoul(separator + 1, &end, 10);
+    if (end == separator + 1 || (*end != ',' && *end != '\0'))
+    {
+      return 0;
+    }
+    size++;
+    text = *end == ',' ? end + 1 : end;
+  }
+  return size;
+}
+
+/**
+ * @brief Answer with the report of a run once it is over. The response is kept open meanwhile,
+ * the steps are sent by loop().
+ *
+ * @param request The request to answer
+ * @param runId The id of the run, given by the scene runner
+ */
+void sendSceneReport(AsyncWebServerRequest* request, const unsigned long runId)
+{
+  AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+      [runId, body = String()](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      {
+        if (!sceneRunner.isFinished(runId))
+        {
+          return RESPONSE_TRY_AGAIN;
+        }
+        if (index == 0)
+        {
+          const SceneReport& report = sceneRunner.getReport();
+          // Replaced if another run has started since.
+          body = report.runId == runId ? serializer.serializeSceneReport(report)
+                                       : String("{\"run_id\":") + String(runId) + "}";
+        }
+        if (index >= body.length())
+        {
+          return 0;
+        }
+        const size_t length = body.length() - index < maxLen ? body.length() - index : maxLen;
+        memcpy(buffer, body.c_str() + index, length);
+        return length;
+      });
+  request->send(response);
+}
+
+void handleFetchAllGroups(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch all groups reached.");
+  Result result = controller.fetchAllGroups();
+  request->send(200, "application/json", result.data);
+}
+
+void handleCreateGroup(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to create a group reached.");
+
+  String name;
+  String ids;
+  if (request->hasParam("name", true))
+  {
+    name = request->getParam("name", true)->value();
+  }
+  if (request->hasParam("remote_ids", true))
+  {
+    ids = request->getParam("remote_ids", true)->value();
   }
 
-  Result result = controller.operateRemote(remoteId, action.c_str());
+  queueJob(request, 201,
+      [name, ids](const unsigned long now)
+      {
+        unsigned long remoteIds[MAX_REMOTES];
+        const unsigned char size = parseRemoteIds(ids.c_str(), remoteIds, MAX_REMOTES);
+        return controller.createGroup(name.c_str(), remoteIds, size);
+      });
+}
+
+void handleDeleteGroup(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to delete a group reached.");
+  const unsigned long groupId = params.values[0];
+  queueJob(request, 200,
+      [groupId](const unsigned long now) { return controller.deleteGroup(groupId); });
+}
+
+void handleActionGroup(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  DLOG_INFO("Endpoint to operate an action on a group reached.");
+  String action;
+  if (request->hasParam("action", true))
+  {
+    action = request->getParam("action", true)->value();
+  }
+
+  Result result = sceneRunner.runGroup(params.values[0], action.c_str(), millis());
   if (!result.isSuccess)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.error + "\"}");
+    sendMessage(request, result.code == RESULT_SCENE_RUNNING ? 503 : 400, result.code);
+    return;
+  }
+  bootSequence.recordCommand(millis());
+  sendSceneReport(request, sceneRunner.getRunId());
+}
+
+void handleFetchAllScenes(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch all scenes reached.");
+  Result result = controller.fetchAllScenes();
+  request->send(200, "application/json", result.data);
+}
+
+void handleCreateScene(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to create a scene reached.");
+
+  String name;
+  String steps;
+  if (request->hasParam("name", true))
+  {
+    name = request->getParam("name", true)->value();
+  }
+  if (request->hasParam("steps", true))
+  {
+    steps = request->getParam("steps", true)->value();
+  }
+
+  queueJob(request, 201,
+      [name, steps](const unsigned long now) mutable
+      {
+        unsigned long remoteIds[MAX_SCENE_STEPS];
+        const char* actions[MAX_SCENE_STEPS];
+        unsigned long delays[MAX_SCENE_STEPS];
+        // Parsed in place, the actions point into it.
+        const unsigned char size = parseSceneSteps(
+            const_cast<char*>(steps.c_str()), remoteIds, actions, delays, MAX_SCENE_STEPS);
+        return controller.createScene(name.c_str(), remoteIds, actions, delays, size);
+      });
+}
+
+void handleDeleteScene(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to delete a scene reached.");
+  const unsigned long sceneId = params.values[0];
+  queueJob(request, 200,
+      [sceneId](const unsigned long now) { return controller.deleteScene(sceneId); });
+}
+
+void handleRunScene(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  DLOG_INFO("Endpoint to run a scene reached.");
+  Result result = sceneRunner.runScene(params.values[0], millis());
+  if (!result.isSuccess)
+  {
+    sendMessage(request, result.code == RESULT_SCENE_RUNNING ? 503 : 400, result.code);
+    return;
+  }
+  bootSequence.recordCommand(millis());
+  sendSceneReport(request, sceneRunner.getRunId());
+}
+
+void handleFetchAllMacros(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to fetch all macros reached.");
+  Result result = controller.fetchAllMacros();
+  request->send(200, "application/json", result.data);
+}
+
+void handleCreateMacro(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to create a macro reached.");
+
+  String name;
+  String steps;
+  if (request->hasParam("name", true))
+  {
+    name = request->getParam("name", true)->value();
+  }
+  if (request->hasParam("steps", true))
+  {
+    steps = request->getParam("steps", true)->value();
+  }
+
+  queueJob(request, 201,
+      [name, steps](const unsigned long now) mutable
+      {
+        const char* actions[MAX_MACRO_STEPS];
+        unsigned long waits[MAX_MACRO_STEPS];
+        // Parsed in place, the actions point into it.
+        const unsigned char size = parseMacroSteps(
+            const_cast<char*>(steps.c_str()), actions, waits, MAX_MACRO_STEPS);
+        return controller.createMacro(name.c_str(), actions, waits, size);
+      });
+}
+
+void handleDeleteMacro(AsyncWebServerRequest* request, const RouteParams& params)
+{
+  LOG_INFO("Endpoint to delete a macro reached.");
+  const unsigned long macroId = params.values[0];
+  queueJob(request, 200,
+      [macroId](const unsigned long now) { return controller.deleteMacro(macroId); });
+}
+
+// ============================================================================
+// UDP COMMANDS
+// ============================================================================
+
+/**
+ * @brief Operate the next command received by UDP, if any, and send its ack back.
+ * Polled from loop(): no TCP connection, no HTTP parsing, no routing.
+ */
+void handleUdpCommand()
+{
+  int size = udp.parsePacket();
+  if (size <= 0)
+  {
+    return;
+  }
+  uint8_t packet[UDP_MAX_PACKET_SIZE];
+  udp.read(packet, sizeof(packet));
+  // Bigger packets are only partly read, the size given makes them invalid.
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+  Result result = udpCommandHandler.handle(packet, size, ack, ackLength);
+  if (ackLength > 0)
+  {
+    udp.beginPacket(udp.remoteIP(), udp.remotePort());
+    udp.write(ack, ackLength);
+    udp.endPacket();
+  }
+  if (result.isSuccess)
+  {
+    bootSequence.recordCommand(millis());
+  }
+}
+
+// ============================================================================
+// TASKS
+// ============================================================================
+
+void runBootSequence(const unsigned long now) { bootSequence.loop(now); }
+
+void runWifi(const unsigned long now)
+{
+  if (bootSequence.getPhase() != BOOT_DONE)
+  {
     return;
   }
-  request->send(200, "application/json", "{\"message\":\"" + result.data + "\"}");
+  if (networkSwitchover.isRunning())
+  {
+    networkSwitchover.loop(now);
+    // The supervision starts over from the outcome of the switchover.
+    wifiSupervisor.reset();
+    return;
+  }
+  wifiSupervisor.loop(now);
+}
+
+void runUdpCommands(const unsigned long now) { handleUdpCommand(); }
+
+void runCommands(const unsigned long now)
+{
+  commandQueue.runNext(now);
+  answerHeldRequests(now);
+  if (commandQueue.hasPending())
+  {
+    tasks.wake(commandTask, now);
+  }
+}
+
+void runPositions(const unsigned long now) { positionTracker.loop(now); }
+
+void runScenes(const unsigned long now) { sceneRunner.loop(now); }
+
+void runMacros(const unsigned long now) { macroRunner.loop(now); }
+
+void runMqtt(const unsigned long now)
+{
+  if (bootSequence.getPhase() == BOOT_DONE)
+  {
+    mqttBridge.loop(now);
+  }
 }
 
+void runSchedules(const unsigned long now)
+{
+  if (bootSequence.getPhase() == BOOT_DONE)
+  {
+    scheduler.loop(time(nullptr));
+  }
+}
+
+void runAirtime(const unsigned long now) { airtimeScheduler.loop(now); }
+
+void runNetworkScanner(const unsigned long now) { networkScanner.loop(now); }
+
+void runLogs(const unsigned long now) { deferredLog.flush(Serial, DEFERRED_LOG_FLUSH_BATCH); }
+
 // ============================================================================
 // SETUP
 // ============================================================================
+/**
+ * @brief Register a route of the API. A route the router has no space for is logged: its
+ * requests would fall through to the static files.
+ *
+ * @return true if the route has been registered
+ */
+bool route(const char* path, const unsigned char methods, RouteHandler handler,
+    const char* header = nullptr)
+{
+  if (router.on(path, methods, handler, header))
+  {
+    return true;
+  }
+  LOG_ERROR("Route not registered, raise MAX_ROUTES or MAX_ROUTE_NODES:", path);
+  return false;
+}
+
 #ifndef PIO_UNIT_TESTING
 void setup()
 {
   Serial.begin(115200);
-  while (!Serial)
-    continue;
-  // Wait one second to avoid bad chars in serial
-  delay(5000);
 
   // Open the output for 433.42MHz and 433.92MHz transmitter
   LOG_INFO("Initializing pin for transmitter...");
+  bootSequence.beginPhase(BOOT_TRANSMITTER, millis());
   transmitter.init();
+  bootSequence.endPhase(BOOT_TRANSMITTER, millis());
 
   // Database Setup
   LOG_INFO("Initializing database...");
+  bootSequence.beginPhase(BOOT_DATABASE, millis());
   database.init();
+  bootSequence.endPhase(BOOT_DATABASE, millis());
 
   // SPIFFS Setup
   LOG_INFO("Setuping SPIFFS...");
-  if (!LittleFS.begin())
+  bootSequence.beginPhase(BOOT_FILESYSTEM, millis());
+  bool filesystemMounted = LittleFS.begin();
+  if (!filesystemMounted)
   {
+    // The API stays usable without the web interface.
     LOG_ERROR("An Error has occurred while mounting SPIFFS.");
-    return;
   }
   else
   {
     LOG_INFO("SPIFFS setup done.");
   }
-
-  // WIFI Setup
-  LOG_INFO("Fetching all wifi networks...");
-  wifiClient.getNetworks(networks);
-  LOG_INFO("Trying WiFi connection...");
-  NetworkConfiguration networkConfig = database.getNetworkConfiguration();
-  if (strlen(networkConfig.ssid) == 0)
-  {
-    LOG_WARN("No wifi configuration found.");
-    LOG_INFO("Configuring access point (AP)...");
-    wifiAP.startAccessPoint(AP_SSID, AP_PASSWORD);
-    LOG_INFO("AP IP address:", wifiAP.getIP());
-  }
-  else
-  {
-    bool wifiConnected = wifiClient.connect(networkConfig.ssid, networkConfig.password);
-    if (!wifiConnected)
-    {
-      LOG_ERROR("Failed to connect to the WiFi.");
-      // Not connected to wifi, starting the AP mode
-      LOG_INFO("Configuring access point (AP)...");
-      wifiAP.startAccessPoint(AP_SSID, AP_PASSWORD);
-      LOG_INFO("AP IP address:", wifiAP.getIP());
-    }
-    else
-    {
-      LOG_INFO("WiFi IP address:", wifiClient.getIP());
-    }
-  }
+  bool assetsLoaded = filesystemMounted && assetHandler.load();
+  bootSequence.endPhase(BOOT_FILESYSTEM, millis());
 
   // SERVER setup
+  bootSequence.beginPhase(BOOT_SERVER, millis());
   // HTML
   DefaultHeaders::Instance().addHeader("Access-Control-Allow-Origin", "*");
+  // Admission control before any other handler.
+  server.addHandler(&admissionHandler);
+  // The API before the files: its requests never look up the filesystem. The routes are
+  // registered below.
+  server.addHandler(&routerHandler);
+  // Pre-compressed assets first, plain files of the filesystem as fallback.
+  if (assetsLoaded)
+  {
+    server.addHandler(&assetHandler);
+  }
   server.serveStatic("/", LittleFS, "/");
   server.on("/", HTTP_GET, homePage);
   // server.onNotFound(not_found_page);
 
   // API REST
-  server.on("/api/v1/system/restart", HTTP_POST, handleSystemRestart);
-  server.on("/api/v1/system/infos", HTTP_GET, handleFetchSystemInfos);
-  server.on("/api/v1/wifi/networks", HTTP_GET, handleFetchWifiNetworks);
-  server.on("/api/v1/wifi/config", HTTP_GET, handleFetchWifiConfiguration);
-  server.on("/api/v1/wifi/config", HTTP_POST, handleUpdateWifiConfiguration);
-  server.on("^\\/api/v1/remotes$", HTTP_GET, handleFetchAllRemotes);
-  server.on("^\\/api/v1/remotes$", HTTP_POST, handleCreateRemote);
-  server.on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_GET, handleFetchRemote);
-  server.on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_PATCH, handleUpdateRemote);
-  server.on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_DELETE, handleDeleteRemote);
-  server.on("^\\/api/v1/remotes\\/([0-9]+)\\/action$", HTTP_POST, handleActionRemote);
+  route("/api/v1/system/restart", HTTP_POST, handleSystemRestart);
+  route("/api/v1/system/infos", HTTP_GET, handleFetchSystemInfos);
+  route("/api/v1/system/admission", HTTP_GET, handleFetchAdmissionMetrics);
+  route("/api/v1/system/boot", HTTP_GET, handleFetchBootProfile);
+  route("/metrics", HTTP_GET, handleFetchMetrics);
+  route("/api/v1/system/logs", HTTP_GET, handleFetchLogs);
+#ifdef SOMFY_TRACE
+  route("/api/v1/system/traces", HTTP_GET, handleFetchTraces);
+  route("/api/v1/system/traces", HTTP_DELETE, handleClearTraces);
+#endif
+  route("/api/v1/wifi/networks", HTTP_GET, handleFetchWifiNetworks);
+  route("/api/v1/wifi/config", HTTP_GET, handleFetchWifiConfiguration);
+  route("/api/v1/wifi/config", HTTP_POST, handleUpdateWifiConfiguration);
+  route("/api/v1/wifi/switchover", HTTP_GET, handleFetchWifiSwitchover);
+  route("/api/v1/remotes", HTTP_GET, handleFetchAllRemotes);
+  route("/api/v1/remotes", HTTP_POST, handleCreateRemote);
+  route("/api/v1/remotes/changes", HTTP_GET, handleFetchRemoteChanges);
+  route("/api/v1/events", HTTP_GET, handleEventStream, "Last-Event-ID");
+  route("/api/v1/remotes/{id}", HTTP_GET, handleFetchRemote);
+  route("/api/v1/remotes/{id}", HTTP_PATCH, handleUpdateRemote);
+  route("/api/v1/remotes/{id}", HTTP_DELETE, handleDeleteRemote);
+  route("/api/v1/remotes/{id}/action", HTTP_POST, handleActionRemote, "Idempotency-Key");
+  route("/api/v1/remotes/{id}/position", HTTP_GET, handleFetchRemotePosition);
+  route("/api/v1/remotes/{id}/calibration", HTTP_POST, handleCalibrateRemote);
+  route("/api/v1/schedules", HTTP_GET, handleFetchAllSchedules);
+  route("/api/v1/schedules", HTTP_POST, handleCreateSchedule);
+  route("/api/v1/schedules/{id}", HTTP_DELETE, handleDeleteSchedule);
+  route("/api/v1/groups", HTTP_GET, handleFetchAllGroups);
+  route("/api/v1/groups", HTTP_POST, handleCreateGroup);
+  route("/api/v1/groups/{id}", HTTP_DELETE, handleDeleteGroup);
+  route("/api/v1/groups/{id}/action", HTTP_POST, handleActionGroup);
+  route("/api/v1/scenes", HTTP_GET, handleFetchAllScenes);
+  route("/api/v1/scenes", HTTP_POST, handleCreateScene);
+  route("/api/v1/scenes/{id}", HTTP_DELETE, handleDeleteScene);
+  route("/api/v1/scenes/{id}/run", HTTP_POST, handleRunScene);
+  route("/api/v1/macros", HTTP_GET, handleFetchAllMacros);
+  route("/api/v1/macros", HTTP_POST, handleCreateMacro);
+  route("/api/v1/macros/{id}", HTTP_DELETE, handleDeleteMacro);
 
   // Start the server
   server.begin();
+  udp.begin(UDP_COMMAND_PORT);
+  // Synchronised by SNTP once connected, the schedules wait for it.
+  configTime(TIME_ZONE, NTP_SERVER);
+  if (MQTT_HOST[0] != '\0')
+  {
+    char nodeId[9];
+    snprintf(nodeId, sizeof(nodeId), "%06lx", (unsigned long)ESP.getChipId());
+    mqttClient.onMessage([](const char* topic, const char* payload, const size_t length)
+        { mqttBridge.receive(topic, payload, length); });
+    mqttBridge.begin(nodeId);
+  }
+  bootSequence.endPhase(BOOT_SERVER, millis());
+
+  // Tasks run from loop(), in this order
+  tasks.add("boot", runBootSequence, 0);
+  tasks.add("wifi", runWifi, 0);
+  tasks.add("udp", runUdpCommands, 0);
+  commandTask = tasks.add("commands", runCommands, TASK_ON_WAKE);
+  // Every loop: the STOP of a remote moved to a position is due to the millisecond.
+  tasks.add("positions", runPositions, 0);
+  // Every loop as well: the steps of a scene are spaced by a few tens of milliseconds.
+  tasks.add("scenes", runScenes, 0);
+  // And the waits of the macros, to the millisecond.
+  tasks.add("macros", runMacros, 0);
+  tasks.add("mqtt", runMqtt, 0);
+  tasks.add("schedules", runSchedules, 1000);
+  // The scheduled commands delayed by the airtime budget.
+  tasks.add("airtime", runAirtime, 1000);
+  tasks.add("scanner", runNetworkScanner, 0);
+  tasks.add("logs", runLogs, 0);
+
+  // WIFI Setup, carried on from loop()
+  wifiClient.init();
+  bootSequence.startNetwork(millis());
 }
 
 void loop()
 {
-  // put your main code here, to run repeatedly:
+  // The work of the subsystems is done by the tasks, in short steps.
+  tasks.loop(millis());
 }
 #endif // PIO_UNIT_TESTING
@@ -0,0 +1,665 @@
+/**
+ * @file metrics.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the registry of the operational metrics.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <metrics.h>
+
+enum MetricsSection : unsigned char
+{
+  SECTION_UPTIME,
+  SECTION_FREE_HEAP,
+  SECTION_HEAP_FRAGMENTATION,
+  SECTION_MAX_FREE_BLOCK,
+  SECTION_RESET_REASON,
+  SECTION_WIFI_RSSI,
+  SECTION_WIFI_CONNECTS,
+  SECTION_WIFI_HINT_MISSES,
+  SECTION_WIFI_DISCONNECTS,
+  SECTION_WIFI_RECONNECT_ATTEMPTS,
+  SECTION_WIFI_OUTAGE_SECONDS,
+  SECTION_EEPROM_COMMITS,
+  SECTION_EEPROM_COMMIT_SECONDS,
+  SECTION_RADIO_BUSY_SECONDS,
+  SECTION_SUPPRESSED_COMMANDS,
+  SECTION_ADMITTED_REQUESTS,
+  SECTION_SHED_REQUESTS,
+  SECTION_AIRTIME_WINDOW_SECONDS,
+  SECTION_AIRTIME_BUDGET_SECONDS,
+  SECTION_AIRTIME_QUEUED_COMMANDS,
+  SECTION_AIRTIME_DELAYED_COMMANDS,
+  SECTION_AIRTIME_DELAY_SECONDS,
+  SECTION_TRANSMISSIONS,
+  SECTION_REMOTE_AIRTIME,
+  SECTION_ROUTE_LATENCIES,
+  SECTION_TASK_RUNS,
+  SECTION_TASK_RUN_SECONDS,
+  SECTION_TASK_RUN_SECONDS_MAX,
+  SECTION_TASK_LATENCY_SECONDS,
+  SECTION_END
+};
+
+// Upper bounds of the latency buckets in microseconds, the last bucket is +Inf.
+static const unsigned long LATENCY_BOUNDS[METRICS_LATENCY_BUCKETS - 1]
+    = { 500, 1000, 5000, 10000, 50000, 100000, 250000, 500000, 1000000 };
+static const char* const LATENCY_LABELS[METRICS_LATENCY_BUCKETS]
+    = { "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.25", "0.5", "1", "+Inf" };
+
+// Names of the WebRequestMethod bits.
+static const char* const METHOD_NAMES[] = { "GET", "POST", "DELETE", "PUT", "PATCH", "HEAD",
+  "OPTIONS" };
+
+MetricsRegistry metrics;
+
+/**
+ * @brief Write a duration in microseconds as seconds.
+ */
+static void formatSeconds(char* buffer, const size_t size, const uint64_t duration)
+{
+  snprintf(buffer, size, "%lu.%06lu", (unsigned long)(duration / 1000000),
+      (unsigned long)(duration % 1000000));
+}
+
+/**
+ * @brief Write the names of the methods of a mask, separated by commas.
+ */
+static void formatMethods(char* buffer, const size_t size, const unsigned char methods)
+{
+  size_t length = 0;
+  buffer[0] = '\0';
+  for (unsigned char i = 0; i < sizeof(METHOD_NAMES) / sizeof(METHOD_NAMES[0]); ++i)
+  {
+    if ((methods & (1 << i)) && length < size)
+    {
+      length += snprintf(buffer + length, size - length, length == 0 ? "%s" : ",%s",
+          METHOD_NAMES[i]);
+    }
+  }
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+  for (int i = 0; i < METRICS_MAX_ROUTES; ++i)
+  {
+    this->m_routes[i].route = -1;
+  }
+}
+
+/**
+ * @brief Record the time spent in the handler of a route. Only the first METRICS_MAX_ROUTES
+ * routes reached get a histogram.
+ *
+ * @param route The index of the route in the router
+ * @param path The path of the route. Must stay valid forever (a literal).
+ * @param methods The mask of the methods of the route
+ * @param duration The time spent in microseconds
+ */
+void MetricsRegistry::observeRouteLatency(const short route, const char* path,
+    const unsigned char methods, const unsigned long duration)
+{
+  LatencyHistogram* histogram = nullptr;
+  for (int i = 0; i < METRICS_MAX_ROUTES; ++i)
+  {
+    if (this->m_routes[i].route == route)
+    {
+      histogram = &this->m_routes[i];
+      break;
+    }
+    if (this->m_routes[i].route < 0)
+    {
+      histogram = &this->m_routes[i];
+      memset(histogram, 0, sizeof(LatencyHistogram));
+      histogram->route = route;
+      histogram->path = path;
+      histogram->methods = methods;
+      break;
+    }
+  }
+  if (histogram == nullptr)
+  {
+    return;
+  }
+
+  unsigned char bucket = 0;
+  while (bucket < METRICS_LATENCY_BUCKETS - 1 && duration > LATENCY_BOUNDS[bucket])
+  {
+    bucket++;
+  }
+  histogram->buckets[bucket]++;
+  histogram->sum += duration;
+}
+
+/**
+ * @brief Record a commit of the EEPROM.
+ *
+ * @param duration The time spent in microseconds
+ */
+void MetricsRegistry::recordEepromCommit(const unsigned long duration)
+{
+  this->m_eepromCommits++;
+  this->m_eepromCommitDuration += duration;
+}
+
+/**
+ * @brief Record a command sent by the radio.
+ *
+ * @param remoteId The remote sending the command
+ * @param duration The time the radio was busy in microseconds
+ */
+void MetricsRegistry::recordTransmission(const unsigned long remoteId, const unsigned long duration)
+{
+  this->m_radioBusyDuration += duration;
+  for (int i = 0; i < this->m_transmissionsSize; ++i)
+  {
+    if (this->m_transmissions[i].remoteId == remoteId)
+    {
+      this->m_transmissions[i].count++;
+      this->m_transmissions[i].duration += duration;
+      return;
+    }
+  }
+  if (this->m_transmissionsSize < MAX_REMOTES)
+  {
+    this->m_transmissions[this->m_transmissionsSize] = { remoteId, 1, duration };
+    this->m_transmissionsSize++;
+  }
+}
+
+/**
+ * @brief Record a successful connection to the WiFi.
+ *
+ * @param hinted true if the access point and channel of the last connection were given
+ * @param duration The time taken to connect in milliseconds
+ */
+void MetricsRegistry::recordWifiConnect(const bool hinted, const unsigned long duration)
+{
+  this->m_wifiConnects[hinted ? 1 : 0]++;
+  this->m_wifiConnectDuration[hinted ? 1 : 0] += (uint64_t)duration * 1000;
+}
+
+/**
+ * @brief Record a connection with hints that failed, a full scan follows.
+ */
+void MetricsRegistry::recordWifiHintMiss() { this->m_wifiHintMisses++; }
+
+/**
+ * @brief Record a loss of the connection to the WiFi.
+ */
+void MetricsRegistry::recordWifiDisconnect() { this->m_wifiDisconnects++; }
+
+/**
+ * @brief Record an attempt to connect again to the WiFi after a loss.
+ */
+void MetricsRegistry::recordWifiReconnectAttempt() { this->m_wifiReconnectAttempts++; }
+
+/**
+ * @brief Record the end of an outage of the WiFi.
+ *
+ * @param duration The time without WiFi in milliseconds
+ */
+void MetricsRegistry::recordWifiOutage(const unsigned long duration)
+{
+  this->m_wifiOutageDuration += (uint64_t)duration * 1000;
+}
+
+/**
+ * @brief Record a remote command answered without being sent again.
+ *
+ * @param isKeyed true if recognized by its idempotency key, false if by the duplicate window
+ */
+void MetricsRegistry::recordSuppressedCommand(const bool isKeyed)
+{
+  this->m_suppressedCommands[isKeyed ? 1 : 0]++;
+}
+
+/**
+ * @brief Record a request admitted or shed by the admission control.
+ *
+ * @param priority The priority of the request
+ * @param isAdmitted true if admitted, false if shed
+ */
+void MetricsRegistry::recordAdmission(const AdmissionPriority priority, const bool isAdmitted)
+{
+  if (isAdmitted)
+  {
+    this->m_admittedRequests[priority]++;
+    return;
+  }
+  this->m_shedRequests[priority]++;
+}
+
+/**
+ * @brief Keep the airtime of the radio in the current window and the commands waiting for
+ * airtime.
+ *
+ * @param used The airtime used in the window in milliseconds
+ * @param queued The number of commands waiting
+ */
+void MetricsRegistry::observeAirtime(const unsigned long used, const unsigned short queued)
+{
+  this->m_airtimeUsed = used;
+  this->m_airtimeQueued = queued;
+}
+
+/**
+ * @brief Record a command sent late to stay within the airtime budget.
+ *
+ * @param duration The time the command waited in milliseconds
+ */
+void MetricsRegistry::recordAirtimeDelay(const unsigned long duration)
+{
+  this->m_airtimeDelays++;
+  this->m_airtimeDelayDuration += (uint64_t)duration * 1000;
+}
+
+/**
+ * @brief Record a run of a task of the task scheduler.
+ *
+ * @param task The index of the task in the scheduler
+ * @param name The name of the task. Must stay valid forever (a literal).
+ * @param duration The time spent in the task in microseconds
+ * @param latency The time the task waited after being due in milliseconds
+ */
+void MetricsRegistry::recordTask(const unsigned char task, const char* name,
+    const unsigned long duration, const unsigned long latency)
+{
+  if (task >= MAX_TASKS)
+  {
+    return;
+  }
+  TaskRuns& runs = this->m_tasks[task];
+  runs.name = name;
+  runs.count++;
+  runs.duration += duration;
+  if (duration > runs.maxDuration)
+  {
+    runs.maxDuration = duration;
+  }
+  runs.latency += (uint64_t)latency * 1000;
+}
+
+/**
+ * @brief Render the next line of the metrics in the Prometheus text format.
+ *
+ * @param cursor The position of the rendering, starts zeroed
+ * @param buffer The buffer receiving the line, with its '\n'
+ * @param size The size of the buffer
+ * @return size_t The length of the line, 0 when everything has been rendered
+ */
+size_t MetricsRegistry::renderLine(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  while (cursor.section < SECTION_END)
+  {
+    size_t length = this->renderSection(cursor, buffer, size);
+    if (length > 0)
+    {
+      return length < size ? length : size - 1;
+    }
+  }
+  return 0;
+}
+
+// PRIVATE
+
+size_t MetricsRegistry::renderSection(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  char value[24];
+  switch (cursor.section)
+  {
+  case SECTION_UPTIME:
+    snprintf(value, sizeof(value), "%lu", millis() / 1000);
+    return this->renderValue(cursor, buffer, size, "somfy_uptime_seconds", "gauge", value);
+  case SECTION_FREE_HEAP:
+    snprintf(value, sizeof(value), "%lu", (unsigned long)ESP.getFreeHeap());
+    return this->renderValue(cursor, buffer, size, "somfy_heap_free_bytes", "gauge", value);
+  case SECTION_HEAP_FRAGMENTATION:
+    snprintf(value, sizeof(value), "%u", ESP.getHeapFragmentation());
+    return this->renderValue(
+        cursor, buffer, size, "somfy_heap_fragmentation_percent", "gauge", value);
+  case SECTION_MAX_FREE_BLOCK:
+    snprintf(value, sizeof(value), "%lu", (unsigned long)ESP.getMaxFreeBlockSize());
+    return this->renderValue(
+        cursor, buffer, size, "somfy_heap_max_free_block_bytes", "gauge", value);
+  case SECTION_RESET_REASON:
+    if (cursor.line == 0)
+    {
+      cursor.line++;
+      return snprintf(buffer, size, "# TYPE somfy_reset_info gauge\n");
+    }
+    if (cursor.line == 1)
+    {
+      cursor.line++;
+      return snprintf(
+          buffer, size, "somfy_reset_info{reason=\"%s\"} 1\n", ESP.getResetReason().c_str());
+    }
+    return this->nextSection(cursor);
+  case SECTION_WIFI_RSSI:
+    if (WiFi.status() != WL_CONNECTED)
+    {
+      return this->nextSection(cursor);
+    }
+    snprintf(value, sizeof(value), "%ld", (long)WiFi.RSSI());
+    return this->renderValue(cursor, buffer, size, "somfy_wifi_rssi_dbm", "gauge", value);
+  case SECTION_WIFI_CONNECTS:
+    return this->renderWifiConnects(cursor, buffer, size);
+  case SECTION_WIFI_HINT_MISSES:
+    snprintf(value, sizeof(value), "%lu", this->m_wifiHintMisses);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_wifi_hint_misses_total", "counter", value);
+  case SECTION_WIFI_DISCONNECTS:
+    snprintf(value, sizeof(value), "%lu", this->m_wifiDisconnects);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_wifi_disconnects_total", "counter", value);
+  case SECTION_WIFI_RECONNECT_ATTEMPTS:
+    snprintf(value, sizeof(value), "%lu", this->m_wifiReconnectAttempts);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_wifi_reconnect_attempts_total", "counter", value);
+  case SECTION_WIFI_OUTAGE_SECONDS:
+    formatSeconds(value, sizeof(value), this->m_wifiOutageDuration);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_wifi_outage_seconds_total", "counter", value);
+  case SECTION_EEPROM_COMMITS:
+    snprintf(value, sizeof(value), "%lu", this->m_eepromCommits);
+    return this->renderValue(cursor, buffer, size, "somfy_eeprom_commits_total", "counter", value);
+  case SECTION_EEPROM_COMMIT_SECONDS:
+    formatSeconds(value, sizeof(value), this->m_eepromCommitDuration);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_eeprom_commit_seconds_total", "counter", value);
+  case SECTION_RADIO_BUSY_SECONDS:
+    formatSeconds(value, sizeof(value), this->m_radioBusyDuration);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_radio_busy_seconds_total", "counter", value);
+  case SECTION_SUPPRESSED_COMMANDS:
+    return this->renderSuppressedCommands(cursor, buffer, size);
+  case SECTION_ADMITTED_REQUESTS:
+    return this->renderAdmissions(
+        cursor, buffer, size, "somfy_http_requests_admitted_total", this->m_admittedRequests);
+  case SECTION_SHED_REQUESTS:
+    return this->renderAdmissions(
+        cursor, buffer, size, "somfy_http_requests_shed_total", this->m_shedRequests);
+  case SECTION_AIRTIME_WINDOW_SECONDS:
+    formatSeconds(value, sizeof(value), (uint64_t)this->m_airtimeUsed * 1000);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_airtime_window_seconds", "gauge", value);
+  case SECTION_AIRTIME_BUDGET_SECONDS:
+    formatSeconds(value, sizeof(value), (uint64_t)AIRTIME_BUDGET * 1000);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_airtime_budget_seconds", "gauge", value);
+  case SECTION_AIRTIME_QUEUED_COMMANDS:
+    snprintf(value, sizeof(value), "%u", this->m_airtimeQueued);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_airtime_queued_commands", "gauge", value);
+  case SECTION_AIRTIME_DELAYED_COMMANDS:
+    snprintf(value, sizeof(value), "%lu", this->m_airtimeDelays);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_airtime_delayed_commands_total", "counter", value);
+  case SECTION_AIRTIME_DELAY_SECONDS:
+    formatSeconds(value, sizeof(value), this->m_airtimeDelayDuration);
+    return this->renderValue(
+        cursor, buffer, size, "somfy_airtime_delay_seconds_total", "counter", value);
+  case SECTION_TRANSMISSIONS:
+    return this->renderTransmissions(cursor, buffer, size);
+  case SECTION_REMOTE_AIRTIME:
+    return this->renderRemoteAirtime(cursor, buffer, size);
+  case SECTION_ROUTE_LATENCIES:
+    return this->renderRouteLatencies(cursor, buffer, size);
+  case SECTION_TASK_RUNS:
+    return this->renderTasks(cursor, buffer, size, "somfy_task_runs_total", "counter", 0);
+  case SECTION_TASK_RUN_SECONDS:
+    return this->renderTasks(cursor, buffer, size, "somfy_task_run_seconds_total", "counter", 1);
+  case SECTION_TASK_RUN_SECONDS_MAX:
+    return this->renderTasks(cursor, buffer, size, "somfy_task_run_seconds_max", "gauge", 2);
+  case SECTION_TASK_LATENCY_SECONDS:
+    return this->renderTasks(
+        cursor, buffer, size, "somfy_task_latency_seconds_total", "counter", 3);
+  default:
+    return this->nextSection(cursor);
+  }
+}
+
+size_t MetricsRegistry::renderValue(RenderCursor& cursor, char* buffer, const size_t size,
+    const char* name, const char* type, const char* value)
+{
+  if (cursor.line == 0)
+  {
+    cursor.line++;
+    return snprintf(buffer, size, "# TYPE %s %s\n", name, type);
+  }
+  if (cursor.line == 1)
+  {
+    cursor.line++;
+    return snprintf(buffer, size, "%s %s\n", name, value);
+  }
+  return this->nextSection(cursor);
+}
+
+size_t MetricsRegistry::renderWifiConnects(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  // Line 0 is the type, then the sum and the count without hints, then with hints.
+  if (cursor.line == 0)
+  {
+    cursor.line++;
+    return snprintf(buffer, size, "# TYPE somfy_wifi_connect_seconds summary\n");
+  }
+  if (cursor.line > 4)
+  {
+    return this->nextSection(cursor);
+  }
+  const unsigned char hinted = (cursor.line - 1) / 2;
+  const char* label = hinted ? "true" : "false";
+  if (cursor.line++ % 2 == 1)
+  {
+    char sum[24];
+    formatSeconds(sum, sizeof(sum), this->m_wifiConnectDuration[hinted]);
+    return snprintf(
+        buffer, size, "somfy_wifi_connect_seconds_sum{hints=\"%s\"} %s\n", label, sum);
+  }
+  return snprintf(buffer, size, "somfy_wifi_connect_seconds_count{hints=\"%s\"} %lu\n", label,
+      this->m_wifiConnects[hinted]);
+}
+
+size_t MetricsRegistry::renderSuppressedCommands(
+    RenderCursor& cursor, char* buffer, const size_t size)
+{
+  static const char* const REASONS[] = { "window", "key" };
+
+  // Line 0 is the type, then one line per reason.
+  if (cursor.line == 0)
+  {
+    cursor.line++;
+    return snprintf(buffer, size, "# TYPE somfy_suppressed_commands_total counter\n");
+  }
+  if (cursor.line > 2)
+  {
+    return this->nextSection(cursor);
+  }
+  const unsigned char reason = cursor.line++ - 1;
+  return snprintf(buffer, size, "somfy_suppressed_commands_total{reason=\"%s\"} %lu\n",
+      REASONS[reason], this->m_suppressedCommands[reason]);
+}
+
+size_t MetricsRegistry::renderAdmissions(RenderCursor& cursor, char* buffer, const size_t size,
+    const char* name, const unsigned long counts[])
+{
+  static const char* const PRIORITIES[ADMISSION_PRIORITIES] = { "static", "api", "action" };
+
+  // Line 0 is the type, then one line per priority.
+  if (cursor.line == 0)
+  {
+    cursor.line++;
+    return snprintf(buffer, size, "# TYPE %s counter\n", name);
+  }
+  if (cursor.line > ADMISSION_PRIORITIES)
+  {
+    return this->nextSection(cursor);
+  }
+  const unsigned char priority = cursor.line++ - 1;
+  return snprintf(buffer, size, "%s{priority=\"%s\"} %lu\n", name, PRIORITIES[priority],
+      counts[priority]);
+}
+
+size_t MetricsRegistry::renderTransmissions(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  // Item 0 is the type, then one item per remote.
+  if (cursor.item == 0)
+  {
+    cursor.item++;
+    return snprintf(buffer, size, "# TYPE somfy_rts_transmissions_total counter\n");
+  }
+  if (cursor.item > this->m_transmissionsSize)
+  {
+    return this->nextSection(cursor);
+  }
+  const RemoteTransmissions& transmissions = this->m_transmissions[cursor.item - 1];
+  cursor.item++;
+  return snprintf(buffer, size, "somfy_rts_transmissions_total{remote=\"%lu\"} %lu\n",
+      transmissions.remoteId, transmissions.count);
+}
+
+size_t MetricsRegistry::renderRemoteAirtime(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  // Item 0 is the type, then one item per remote.
+  if (cursor.item == 0)
+  {
+    cursor.item++;
+    return snprintf(buffer, size, "# TYPE somfy_rts_airtime_seconds_total counter\n");
+  }
+  if (cursor.item > this->m_transmissionsSize)
+  {
+    return this->nextSection(cursor);
+  }
+  const RemoteTransmissions& transmissions = this->m_transmissions[cursor.item - 1];
+  cursor.item++;
+  char duration[24];
+  formatSeconds(duration, sizeof(duration), transmissions.duration);
+  return snprintf(buffer, size, "somfy_rts_airtime_seconds_total{remote=\"%lu\"} %s\n",
+      transmissions.remoteId, duration);
+}
+
+size_t MetricsRegistry::renderRouteLatencies(
+    RenderCursor& cursor, char* buffer, const size_t size)
+{
+  // Item 0 is the type, then one item per route: a line per bucket, the sum and the count.
+  if (cursor.item == 0)
+  {
+    cursor.item++;
+    return snprintf(buffer, size, "# TYPE somfy_http_handler_seconds histogram\n");
+  }
+  if (cursor.line > METRICS_LATENCY_BUCKETS + 1)
+  {
+    cursor.item++;
+    cursor.line = 0;
+  }
+  if (cursor.item > METRICS_MAX_ROUTES || this->m_routes[cursor.item - 1].route < 0)
+  {
+    return this->nextSection(cursor);
+  }
+
+  const LatencyHistogram& histogram = this->m_routes[cursor.item - 1];
+  const unsigned char line = cursor.line;
+  cursor.line++;
+
+  char methods[48];
+  formatMethods(methods, sizeof(methods), histogram.methods);
+  unsigned long count = 0;
+  // Buckets are cumulative, the sum and the count lines take them all.
+  for (unsigned char i = 0; i < METRICS_LATENCY_BUCKETS; ++i)
+  {
+    if (i <= line || line >= METRICS_LATENCY_BUCKETS)
+    {
+      count += histogram.buckets[i];
+    }
+  }
+
+  if (line < METRICS_LATENCY_BUCKETS)
+  {
+    return snprintf(buffer, size,
+        "somfy_http_handler_seconds_bucket{route=\"%s\",method=\"%s\",le=\"%s\"} %lu\n",
+        histogram.path, methods, LATENCY_LABELS[line], count);
+  }
+  if (line == METRICS_LATENCY_BUCKETS)
+  {
+    char sum[24];
+    formatSeconds(sum, sizeof(sum), histogram.sum);
+    return snprintf(buffer, size,
+        "somfy_http_handler_seconds_sum{route=\"%s\",method=\"%s\"} %s\n", histogram.path,
+        methods, sum);
+  }
+  return snprintf(buffer, size,
+      "somfy_http_handler_seconds_count{route=\"%s\",method=\"%s\"} %lu\n", histogram.path,
+      methods, count);
+}
+
+size_t MetricsRegistry::renderTasks(RenderCursor& cursor, char* buffer, const size_t size,
+    const char* name, const char* type, const unsigned char series)
+{
+  // Item 0 is the type, then one item per task: its count, run time, longest run or latency.
+  if (cursor.item == 0)
+  {
+    cursor.item++;
+    return snprintf(buffer, size, "# TYPE %s %s\n", name, type);
+  }
+  // The tasks never run yet are skipped.
+  while (cursor.item <= MAX_TASKS && this->m_tasks[cursor.item - 1].name == nullptr)
+  {
+    cursor.item++;
+  }
+  if (cursor.item > MAX_TASKS)
+  {
+    return this->nextSection(cursor);
+  }
+  const TaskRuns& runs = this->m_tasks[cursor.item - 1];
+  cursor.item++;
+  char value[24];
+  switch (series)
+  {
+  case 0:
+    snprintf(value, sizeof(value), "%lu", runs.count);
+    break;
+  case 1:
+    formatSeconds(value, sizeof(value), runs.duration);
+    break;
+  case 2:
+    formatSeconds(value, sizeof(value), runs.maxDuration);
+    break;
+  default:
+    formatSeconds(value, sizeof(value), runs.latency);
+    break;
+  }
+  return snprintf(buffer, size, "%s{task=\"%s\"} %s\n", name, runs.name, value);
+}
+
+size_t MetricsRegistry::nextSection(RenderCursor& cursor)
+{
+  cursor.section++;
+  cursor.item = 0;
+  cursor.line = 0;
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,473 @@
+/**
+ * @file mqttBridge.cpp
+ * @author Laurette Alexandre
+ * @brief Bridge between the controller and a MQTT broker
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <mqtt.h>
+#include <event.h>
+#include <remote.h>
+#include <result.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <mqttBridge.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+#include <mqttClientAbs.h>
+
+static const char* const COVER_STATES[] = { "", "open", "closed", "stopped" };
+
+MqttBridge::MqttBridge(Controller* controller, DatabaseAbstract* database, EventBus* eventBus,
+    MqttClientAbstract* client)
+    : m_controller(controller)
+    , m_database(database)
+    , m_eventBus(eventBus)
+    , m_client(client)
+{
+}
+
+/**
+ * @brief Start the bridge. The topics of the node are built from its id.
+ *
+ * @param nodeId Id of this controller in the topics, unique on the broker
+ */
+void MqttBridge::begin(const char* nodeId)
+{
+  strncpy(this->m_nodeId, nodeId, sizeof(this->m_nodeId) - 1);
+  snprintf(this->m_baseTopic, sizeof(this->m_baseTopic), "%s/%s", MQTT_BASE_TOPIC, nodeId);
+  // Everything is announced once connected, older events are not needed.
+  this->m_lastSequence = this->m_eventBus->getLastSequence();
+  this->m_isStarted = true;
+}
+
+/**
+ * @brief Operate the commands received, keep the connection and publish what changed.
+ * To call from the main loop.
+ *
+ * @param now The current time in milliseconds
+ */
+void MqttBridge::loop(const unsigned long now)
+{
+  if (!this->m_isStarted)
+  {
+    return;
+  }
+  this->operateNextCommand();
+  // Folded even while disconnected, the states are published once connected again.
+  this->collectEvents();
+
+  if (!this->m_client->isConnected())
+  {
+    if (this->m_isConnected)
+    {
+      DLOG_WARN("MQTT connection lost.");
+      this->m_isConnected = false;
+      this->m_attempts = 0;
+      this->m_nextAttemptAt = now + this->nextDelay();
+    }
+    if ((long)(now - this->m_nextAttemptAt) >= 0)
+    {
+      this->reconnect(now);
+    }
+    return;
+  }
+  if (!this->m_isConnected)
+  {
+    this->connected();
+  }
+  this->flush();
+}
+
+/**
+ * @brief Queue a command received on a command topic. Called from the network stack: the
+ * remote is only operated by the next loop().
+ *
+ * @param topic The topic of the message
+ * @param payload The payload of the message, not null terminated
+ * @param length The length of the payload
+ * @return true, if a command has been queued
+ * @return false, if the message is not a command or if too many commands are waiting
+ */
+bool MqttBridge::receive(const char* topic, const char* payload, const size_t length)
+{
+  const size_t baseLength = strlen(this->m_baseTopic);
+  if (strncmp(topic, this->m_baseTopic, baseLength) != 0
+      || strncmp(topic + baseLength, "/remotes/", 9) != 0)
+  {
+    return false;
+  }
+  const char* idStart = topic + baseLength + 9;
+  char* idEnd = nullptr;
+  const unsigned long id = strtoul(idStart, &idEnd, 10);
+  if (idEnd == idStart || strcmp(idEnd, "/set") != 0)
+  {
+    return false;
+  }
+
+  MqttCommand command;
+  command.remoteId = id;
+  // Payloads of Home Assistant, or the actions of the API.
+  if (length == 4 && strncmp(payload, "OPEN", length) == 0)
+  {
+    strcpy(command.action, "up");
+  }
+  else if (length == 5 && strncmp(payload, "CLOSE", length) == 0)
+  {
+    strcpy(command.action, "down");
+  }
+  else if (length == 4 && strncmp(payload, "STOP", length) == 0)
+  {
+    strcpy(command.action, "stop");
+  }
+  else if (length > 0 && length < sizeof(command.action))
+  {
+    memcpy(command.action, payload, length);
+    command.action[length] = '\0';
+  }
+  else
+  {
+    return false;
+  }
+
+  const unsigned short next = (this->m_inboxHead + 1) % MQTT_INBOX_SIZE;
+  if (next == this->m_inboxTail)
+  {
+    DLOG_WARN("MQTT command for the remote %lu dropped, too many commands waiting.", id);
+    return false;
+  }
+  this->m_inbox[this->m_inboxHead] = command;
+  this->m_inboxHead = next;
+  return true;
+}
+
+/**
+ * @brief Is the bridge connected to the broker ?
+ *
+ * @return true, if connected
+ * @return false, otherwise
+ */
+bool MqttBridge::isConnected() { return this->m_isConnected; }
+
+/**
+ * @brief Get the number of connections attempted since the last one was lost.
+ *
+ * @return unsigned char
+ */
+unsigned char MqttBridge::getAttempts() { return this->m_attempts; }
+
+// PRIVATE
+
+void MqttBridge::operateNextCommand()
+{
+  // One command per loop: a transmission blocks for more than 100 ms.
+  if (this->m_inboxTail == this->m_inboxHead)
+  {
+    return;
+  }
+  const MqttCommand& command = this->m_inbox[this->m_inboxTail];
+  Result result = this->m_controller->operateRemote(command.remoteId, command.action);
+  if (!result.isSuccess)
+  {
+    DLOG_WARN("MQTT command for the remote %lu failed, result %lu.", command.remoteId,
+        result.code);
+  }
+  this->m_inboxTail = (this->m_inboxTail + 1) % MQTT_INBOX_SIZE;
+}
+
+void MqttBridge::collectEvents()
+{
+  if (this->m_eventBus->hasMissed(this->m_lastSequence))
+  {
+    DLOG_WARN("MQTT bridge behind the events, all the remotes are published again.");
+    this->m_lastSequence = this->m_eventBus->getLastSequence();
+    this->m_needsSync = true;
+  }
+
+  Event event;
+  while (this->m_eventBus->readEvent(this->m_lastSequence, event))
+  {
+    RemoteState* remote = this->findRemote(event.remoteId);
+    if (remote == nullptr)
+    {
+      this->m_needsSync = true;
+      continue;
+    }
+    switch (event.type)
+    {
+    case EVENT_REMOTE_CREATED:
+    case EVENT_REMOTE_RENAMED:
+      remote->pending |= PENDING_DISCOVERY;
+      break;
+    case EVENT_REMOTE_DELETED:
+      remote->state = COVER_UNKNOWN;
+      remote->pending = PENDING_REMOVAL;
+      break;
+    case EVENT_COMMAND_TRANSMITTED:
+      if (strcmp(event.action, "up") == 0)
+      {
+        remote->state = COVER_OPEN;
+      }
+      else if (strcmp(event.action, "down") == 0)
+      {
+        remote->state = COVER_CLOSED;
+      }
+      else if (strcmp(event.action, "stop") == 0)
+      {
+        remote->state = COVER_STOPPED;
+      }
+      else
+      {
+        break;
+      }
+      remote->pending |= PENDING_STATE;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+MqttBridge::RemoteState* MqttBridge::findRemote(const unsigned long id)
+{
+  RemoteState* free = nullptr;
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    if (this->m_remotes[i].id == id)
+    {
+      return &this->m_remotes[i];
+    }
+    if (free == nullptr && this->m_remotes[i].id == 0)
+    {
+      free = &this->m_remotes[i];
+    }
+  }
+  if (free != nullptr)
+  {
+    free->id = id;
+    free->state = COVER_UNKNOWN;
+    free->pending = 0;
+  }
+  return free;
+}
+
+void MqttBridge::connected()
+{
+  DLOG_INFO("MQTT connected after %lu attempts.", this->m_attempts);
+  this->m_isConnected = true;
+  this->m_attempts = 0;
+  // The broker may have lost everything: subscribe, announce and publish the states again.
+  this->m_needsSubscribe = true;
+  this->m_needsOnline = true;
+  this->m_needsSync = true;
+}
+
+void MqttBridge::reconnect(const unsigned long now)
+{
+  DLOG_INFO("Connecting to the MQTT broker, attempt %lu.", this->m_attempts + 1);
+  char clientId[sizeof(this->m_nodeId) + 8];
+  snprintf(clientId, sizeof(clientId), "somfy-%s", this->m_nodeId);
+  char willTopic[MQTT_TOPIC_LENGTH];
+  snprintf(willTopic, sizeof(willTopic), "%s/status", this->m_baseTopic);
+  this->m_client->beginConnect(clientId, willTopic, "offline");
+  if (this->m_attempts < 255)
+  {
+    this->m_attempts++;
+  }
+  this->m_nextAttemptAt = now + this->nextDelay();
+}
+
+/**
+ * @brief Delay before the next attempt: doubled at each attempt up to the maximum, then drawn
+ * between its half and its whole.
+ */
+unsigned long MqttBridge::nextDelay()
+{
+  unsigned long delay = MQTT_RECONNECT_MIN_DELAY;
+  for (unsigned char i = 0; i < this->m_attempts && delay < MQTT_RECONNECT_MAX_DELAY; ++i)
+  {
+    delay *= 2;
+  }
+  if (delay > MQTT_RECONNECT_MAX_DELAY)
+  {
+    delay = MQTT_RECONNECT_MAX_DELAY;
+  }
+  return delay / 2 + random(delay / 2 + 1);
+}
+
+void MqttBridge::sync()
+{
+  Remote remotes[MAX_REMOTES];
+  this->m_database->getAllRemotes(remotes);
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    if (remotes[i].id == 0)
+    {
+      continue;
+    }
+    RemoteState* remote = this->findRemote(remotes[i].id);
+    if (remote == nullptr)
+    {
+      break;
+    }
+    remote->pending |= PENDING_DISCOVERY;
+    if (remote->state != COVER_UNKNOWN)
+    {
+      remote->pending |= PENDING_STATE;
+    }
+  }
+  this->m_needsSync = false;
+}
+
+void MqttBridge::flush()
+{
+  unsigned short budget = MQTT_PUBLISH_BATCH;
+  if (this->m_needsSubscribe)
+  {
+    char topic[MQTT_TOPIC_LENGTH];
+    snprintf(topic, sizeof(topic), "%s/remotes/+/set", this->m_baseTopic);
+    if (!this->m_client->subscribe(topic))
+    {
+      return;
+    }
+    this->m_needsSubscribe = false;
+  }
+  if (this->m_needsOnline)
+  {
+    char topic[MQTT_TOPIC_LENGTH];
+    snprintf(topic, sizeof(topic), "%s/status", this->m_baseTopic);
+    if (!this->m_client->publish(topic, "online", true))
+    {
+      return;
+    }
+    this->m_needsOnline = false;
+    budget--;
+  }
+  if (this->m_needsSync)
+  {
+    this->sync();
+  }
+  for (unsigned short i = 0; i < MAX_REMOTES && budget > 0; ++i)
+  {
+    if (this->m_remotes[i].pending != 0 && !this->publishRemote(this->m_remotes[i], budget))
+    {
+      // Buffers of the client full, the rest waits for the next loop.
+      return;
+    }
+  }
+}
+
+bool MqttBridge::publishRemote(RemoteState& remote, unsigned short& budget)
+{
+  char topic[MQTT_TOPIC_LENGTH];
+  if (remote.pending & PENDING_REMOVAL)
+  {
+    // Empty retained messages remove the entity from Home Assistant and the state from the
+    // broker.
+    this->buildDiscoveryTopic(topic, remote.id);
+    if (!this->m_client->publish(topic, "", true))
+    {
+      return false;
+    }
+    this->buildRemoteTopic(topic, remote.id, "state");
+    if (!this->m_client->publish(topic, "", true))
+    {
+      return false;
+    }
+    budget = budget > 2 ? budget - 2 : 0;
+    remote.id = 0;
+    remote.pending = 0;
+    return true;
+  }
+  if (budget > 0 && (remote.pending & PENDING_DISCOVERY))
+  {
+    if (!this->publishDiscovery(remote.id))
+    {
+      return false;
+    }
+    remote.pending &= ~PENDING_DISCOVERY;
+    budget--;
+  }
+  if (budget > 0 && (remote.pending & PENDING_STATE))
+  {
+    this->buildRemoteTopic(topic, remote.id, "state");
+    if (!this->m_client->publish(topic, COVER_STATES[remote.state], true))
+    {
+      return false;
+    }
+    remote.pending &= ~PENDING_STATE;
+    budget--;
+  }
+  return true;
+}
+
+bool MqttBridge::publishDiscovery(const unsigned long id)
+{
+  Remote remote = this->m_database->getRemote(id);
+  if (remote.id == 0)
+  {
+    // Deleted since, its removal follows.
+    return true;
+  }
+  char topic[MQTT_TOPIC_LENGTH];
+  char uniqueId[MQTT_TOPIC_LENGTH];
+  snprintf(uniqueId, sizeof(uniqueId), "somfy_%s_%lu", this->m_nodeId, id);
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+  object["name"] = remote.name;
+  object["unique_id"] = uniqueId;
+  this->buildRemoteTopic(topic, id, "set");
+  object["command_topic"] = topic;
+  this->buildRemoteTopic(topic, id, "state");
+  object["state_topic"] = topic;
+  snprintf(topic, sizeof(topic), "%s/status", this->m_baseTopic);
+  object["availability_topic"] = topic;
+  JsonObject device = object["device"].to<JsonObject>();
+  snprintf(uniqueId, sizeof(uniqueId), "somfy_%s", this->m_nodeId);
+  device["identifiers"].to<JsonArray>().add(uniqueId);
+  device["name"] = "Somfy Controller";
+  device["model"] = "SomfyController";
+  device["sw_version"] = FIRMWARE_VERSION;
+
+  char document[MQTT_DOCUMENT_LENGTH];
+  serializeJson(doc, document, sizeof(document));
+  this->buildDiscoveryTopic(topic, id);
+  return this->m_client->publish(topic, document, true);
+}
+
+void MqttBridge::buildRemoteTopic(char* topic, const unsigned long id, const char* suffix)
+{
+  snprintf(topic, MQTT_TOPIC_LENGTH, "%s/remotes/%lu/%s", this->m_baseTopic, id, suffix);
+}
+
+void MqttBridge::buildDiscoveryTopic(char* topic, const unsigned long id)
+{
+  snprintf(topic, MQTT_TOPIC_LENGTH, "%s/cover/somfy_%s_%lu/config", MQTT_DISCOVERY_PREFIX,
+      this->m_nodeId, id);
+}
\ No newline at end of file
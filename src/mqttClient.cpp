@@ -0,0 +1,116 @@
+/**
+ * @file mqttClient.cpp
+ * @author Laurette Alexandre
+ * @brief MQTT client on top of AsyncMqttClient
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <AsyncMqttClient.h>
+
+#include <config.h>
+#include <mqttClient.h>
+#include <deferredLog.h>
+
+MqttClient::MqttClient(
+    const char* host, const unsigned short port, const char* user, const char* password)
+{
+  this->m_client.setServer(host, port);
+  if (user[0] != '\0')
+  {
+    this->m_client.setCredentials(user, password);
+  }
+  // Called by the TCP stack between two runs of loop(), it may log: a single writer at a time.
+  this->m_client.onDisconnect([](AsyncMqttClientDisconnectReason reason)
+      { DLOG_INFO("MQTT disconnected, reason %lu.", (unsigned long)reason); });
+  this->m_client.onMessage(
+      [this](char* topic, char* payload, AsyncMqttClientMessageProperties properties,
+          size_t length, size_t index, size_t total)
+      {
+        // Messages split in several parts are far too long to be commands.
+        if (index == 0 && length == total && this->m_handler)
+        {
+          this->m_handler(topic, payload, length);
+        }
+      });
+}
+
+/**
+ * @brief Set the function called for each message received. It runs in the network stack and
+ * must return quickly.
+ *
+ * @param handler The function to call
+ */
+void MqttClient::onMessage(MqttMessageHandler handler) { this->m_handler = handler; }
+
+/**
+ * @brief Start the connection to the broker, without waiting for it.
+ * Poll isConnected() to know when the client is connected.
+ *
+ * @param clientId The id of the client on the broker
+ * @param willTopic The topic of the message published by the broker if the client disappears
+ * @param willPayload The message published by the broker if the client disappears
+ */
+void MqttClient::beginConnect(const char* clientId, const char* willTopic, const char* willPayload)
+{
+  LOG_DEBUG("Starting the connection to the MQTT broker...");
+  strncpy(this->m_clientId, clientId, sizeof(this->m_clientId) - 1);
+  strncpy(this->m_willTopic, willTopic, sizeof(this->m_willTopic) - 1);
+  strncpy(this->m_willPayload, willPayload, sizeof(this->m_willPayload) - 1);
+  this->m_client.setClientId(this->m_clientId);
+  this->m_client.setWill(this->m_willTopic, 1, true, this->m_willPayload);
+  this->m_client.connect();
+}
+
+/**
+ * @brief Is the client connected to the broker ?
+ *
+ * @return true, if connected
+ * @return false, otherwise
+ */
+bool MqttClient::isConnected() { return this->m_client.connected(); }
+
+/**
+ * @brief Subscribe to a topic.
+ *
+ * @param topic The topic, wildcards allowed
+ * @return true, if the subscription has been sent
+ * @return false, otherwise
+ */
+bool MqttClient::subscribe(const char* topic) { return this->m_client.subscribe(topic, 0) != 0; }
+
+/**
+ * @brief Publish a message with the QoS 0. Nothing is queued: when the buffers of the TCP
+ * connection are full, the message is refused and the caller tries again later.
+ *
+ * @param topic The topic
+ * @param payload The message
+ * @param retain Should the broker keep the message for the next subscribers ?
+ * @return true, if the message has been sent
+ * @return false, otherwise
+ */
+bool MqttClient::publish(const char* topic, const char* payload, const bool retain)
+{
+  return this->m_client.publish(topic, 0, retain, payload, strlen(payload)) != 0;
+}
\ No newline at end of file
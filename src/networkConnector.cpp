@@ -0,0 +1,239 @@
+/**
+ * @file networkConnector.cpp
+ * @author Laurette Alexandre
+ * @brief Connection to the best known WiFi network
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <networks.h>
+#include <databaseAbs.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+#include <networkClientAbs.h>
+
+NetworkConnector::NetworkConnector(DatabaseAbstract* database,
+    NetworkClientAbstract* networkClient, NetworkScanner* networkScanner)
+    : m_database(database)
+    , m_networkClient(networkClient)
+    , m_networkScanner(networkScanner)
+{
+}
+
+/**
+ * @brief Read the configurations of the known networks from the database.
+ *
+ * @return unsigned char The number of known networks
+ */
+unsigned char NetworkConnector::loadConfigurations()
+{
+  this->m_size = this->m_database->getNetworkConfigurations(this->m_networkConfigs);
+  return this->m_size;
+}
+
+/**
+ * @brief Start the connection to the best known network, without waiting for it.
+ * With several known networks and no fresh scan, a scan is started and the connection is
+ * started by loop() once it is done.
+ *
+ * @param now The current time in milliseconds
+ * @param withHints Try the hints of the last connection first
+ * @return true if the connection (or the scan before it) has started
+ * @return false otherwise
+ */
+bool NetworkConnector::connect(const unsigned long now, const bool withHints)
+{
+  this->m_startedAt = now;
+  this->m_isSelecting = false;
+  this->m_index = -1;
+  if (this->loadConfigurations() == 0)
+  {
+    return false;
+  }
+
+  NetworkHints hints;
+  short index = -1;
+  if (withHints && this->m_database->getNetworkHints(hints))
+  {
+    index = this->findConfiguration(hints.ssid);
+  }
+  this->m_isHinted = index >= 0;
+  if (this->m_isHinted)
+  {
+    if (!WIFI_REUSE_IP)
+    {
+      hints.ip = 0;
+    }
+    LOG_INFO("Connecting to the last WiFi network:", hints.ssid);
+    this->m_index = index;
+    return this->m_networkClient->beginConnect(this->m_networkConfigs[index], &hints);
+  }
+  return this->connectAmongConfigurations(now);
+}
+
+/**
+ * @brief Start the connection to the best network among the given ones, not the saved ones.
+ *
+ * @param now The current time in milliseconds
+ * @param networkConfigs The configurations of the networks to try
+ * @param size The number of configurations, up to MAX_NETWORK_CONFIGURATIONS
+ * @return true if the connection (or the scan before it) has started
+ * @return false otherwise
+ */
+bool NetworkConnector::connect(const unsigned long now,
+    const NetworkConfiguration networkConfigs[], const unsigned char size)
+{
+  this->m_startedAt = now;
+  this->m_isSelecting = false;
+  this->m_isHinted = false;
+  this->m_index = -1;
+  this->m_size = size < MAX_NETWORK_CONFIGURATIONS ? size : MAX_NETWORK_CONFIGURATIONS;
+  memcpy(this->m_networkConfigs, networkConfigs, sizeof(NetworkConfiguration) * this->m_size);
+  if (this->m_size == 0)
+  {
+    return false;
+  }
+  return this->connectAmongConfigurations(now);
+}
+
+/**
+ * @brief Start the connection once the scan for the strongest network is done.
+ * To call from the main loop while connecting.
+ *
+ * @param now The current time in milliseconds
+ * @return true if nothing failed
+ * @return false if the connection could not be started
+ */
+bool NetworkConnector::loop(const unsigned long now)
+{
+  if (!this->m_isSelecting || this->m_networkScanner->isScanning())
+  {
+    return true;
+  }
+  this->m_isSelecting = false;
+  return this->connectStrongest();
+}
+
+/**
+ * @brief Save the hints of the current connection, to connect faster next time.
+ * They are saved for the network of the last connect(), the one they are looked up by.
+ */
+void NetworkConnector::saveHints()
+{
+  NetworkHints hints;
+  if (this->m_networkClient->getConnectionHints(hints))
+  {
+    if (this->m_index >= 0)
+    {
+      strcpy(hints.ssid, this->m_networkConfigs[this->m_index].ssid);
+    }
+    this->m_database->setNetworkHints(hints);
+  }
+}
+
+/**
+ * @brief Is a scan running before the connection ?
+ *
+ * @return true, if waiting for the scan
+ * @return false, otherwise
+ */
+bool NetworkConnector::isSelecting() { return this->m_isSelecting; }
+
+/**
+ * @brief Was the connection started with the hints of the last connection ?
+ *
+ * @return true, if hinted
+ * @return false, otherwise
+ */
+bool NetworkConnector::isHinted() { return this->m_isHinted; }
+
+/**
+ * @brief Get the time connect() was called, scan included.
+ *
+ * @return unsigned long The time in milliseconds
+ */
+unsigned long NetworkConnector::getStartedAt() { return this->m_startedAt; }
+
+/**
+ * @brief Get the SSID of the network the last connect() has started to join.
+ *
+ * @return const char* The SSID, empty while scanning or if no connection was started
+ */
+const char* NetworkConnector::getSsid()
+{
+  return this->m_index >= 0 ? this->m_networkConfigs[this->m_index].ssid : "";
+}
+
+/**
+ * @brief Is the device connected to one of the networks of the last connect() ?
+ * The station only joins the network it was given, so being connected once a network was
+ * given is enough, whatever the client reports about the link.
+ *
+ * @return true, if connected to one of them
+ * @return false, otherwise
+ */
+bool NetworkConnector::isConnectedToConfiguration()
+{
+  return this->m_index >= 0 && this->m_networkClient->isConnected();
+}
+
+// PRIVATE
+
+short NetworkConnector::findConfiguration(const char* ssid)
+{
+  for (unsigned char index = 0; index < this->m_size; ++index)
+  {
+    if (strcmp(this->m_networkConfigs[index].ssid, ssid) == 0)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+bool NetworkConnector::connectAmongConfigurations(const unsigned long now)
+{
+  if (this->m_size > 1 && this->m_networkScanner->refreshIfStale(now))
+  {
+    LOG_INFO("Scanning for the strongest known WiFi network...");
+    this->m_isSelecting = true;
+    return true;
+  }
+  return this->connectStrongest();
+}
+
+bool NetworkConnector::connectStrongest()
+{
+  short index = this->m_networkScanner->selectNetwork(this->m_networkConfigs, this->m_size);
+  if (index < 0)
+  {
+    // Not visible, or hidden: the preferred network is tried.
+    index = 0;
+  }
+  LOG_INFO("Connecting to the WiFi network:", this->m_networkConfigs[index].ssid);
+  this->m_index = index;
+  return this->m_networkClient->beginConnect(this->m_networkConfigs[index]);
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+/**
+ * @file networkScanner.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the cache of the networks found by asynchronous scans.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <networks.h>
+#include <networkScanner.h>
+#include <networkClientAbs.h>
+
+NetworkScanner::NetworkScanner(NetworkClientAbstract* networkClient)
+    : m_networkClient(networkClient)
+{
+}
+
+/**
+ * @brief Start a new scan, unless one is already running.
+ *
+ * @param now The current time in milliseconds
+ * @return true if a scan is running
+ * @return false if it failed to start
+ */
+bool NetworkScanner::refresh(const unsigned long now)
+{
+  if (this->m_isScanning)
+  {
+    return true;
+  }
+  if (!this->m_networkClient->startScan())
+  {
+    LOG_WARN("Failed to start the scan of the WiFi networks.");
+    return false;
+  }
+  LOG_DEBUG("Scan of the WiFi networks started.");
+  this->m_isScanning = true;
+  this->m_scanStartedAt = now;
+  return true;
+}
+
+/**
+ * @brief Start a new scan if there is no result yet or if they are older than the TTL.
+ *
+ * @param now The current time in milliseconds
+ * @return true if a scan is running
+ * @return false otherwise
+ */
+bool NetworkScanner::refreshIfStale(const unsigned long now)
+{
+  if (this->m_hasResults && this->getAge(now) < NETWORK_SCAN_TTL)
+  {
+    return this->m_isScanning;
+  }
+  return this->refresh(now);
+}
+
+/**
+ * @brief Collect the results of the running scan once it is done. To call from the main loop.
+ *
+ * @param now The current time in milliseconds
+ */
+void NetworkScanner::loop(const unsigned long now)
+{
+  if (!this->m_isScanning)
+  {
+    return;
+  }
+
+  int status = this->m_networkClient->getScanStatus();
+  if (status == NETWORK_SCAN_RUNNING)
+  {
+    if (now - this->m_scanStartedAt >= NETWORK_SCAN_TIMEOUT)
+    {
+      LOG_WARN("Scan of the WiFi networks timed out.");
+      this->m_networkClient->deleteScanResults();
+      this->m_isScanning = false;
+    }
+    return;
+  }
+
+  this->m_isScanning = false;
+  if (status == NETWORK_SCAN_FAILED)
+  {
+    LOG_WARN("Scan of the WiFi networks failed.");
+    return;
+  }
+
+  this->m_size = 0;
+  Network network;
+  for (int i = 0; i < status; ++i)
+  {
+    if (this->m_networkClient->getScanResult(i, network))
+    {
+      this->addNetwork(network);
+    }
+  }
+  this->m_networkClient->deleteScanResults();
+  this->m_hasResults = true;
+  this->m_scannedAt = now;
+  LOG_DEBUG("WiFi networks found:", this->m_size);
+}
+
+/**
+ * @brief Get the networks of the last scan, sorted by RSSI.
+ *
+ * @return const Network*
+ */
+const Network* NetworkScanner::getNetworks() { return this->m_networks; }
+
+/**
+ * @brief Get the number of networks of the last scan.
+ *
+ * @return unsigned char
+ */
+unsigned char NetworkScanner::getSize() { return this->m_size; }
+
+/**
+ * @brief Is there a completed scan ?
+ *
+ * @return true, if a scan has completed
+ * @return false, otherwise
+ */
+bool NetworkScanner::hasResults() { return this->m_hasResults; }
+
+/**
+ * @brief Is a scan running ?
+ *
+ * @return true, if a scan is running
+ * @return false, otherwise
+ */
+bool NetworkScanner::isScanning() { return this->m_isScanning; }
+
+/**
+ * @brief Get the age of the results.
+ *
+ * @param now The current time in milliseconds
+ * @return unsigned long The age in milliseconds
+ */
+unsigned long NetworkScanner::getAge(const unsigned long now) { return now - this->m_scannedAt; }
+
+/**
+ * @brief Select the known network with the strongest signal in the last scan.
+ *
+ * @param networkConfigs The configurations of the known networks
+ * @param size The number of configurations
+ * @return short The index of the configuration, -1 if no known network was found
+ */
+short NetworkScanner::selectNetwork(
+    const NetworkConfiguration networkConfigs[], const unsigned char size)
+{
+  // Networks are sorted by RSSI, the first known one is the strongest.
+  for (int i = 0; i < this->m_size; ++i)
+  {
+    for (unsigned char index = 0; index < size; ++index)
+    {
+      if (strcmp(this->m_networks[i].SSID, networkConfigs[index].ssid) == 0)
+      {
+        return index;
+      }
+    }
+  }
+  return -1;
+}
+
+// PRIVATE
+
+/**
+ * @brief Insert a network at its place in the list sorted by RSSI. A network with the same SSID
+ * is replaced if the new one is stronger. The weakest network is dropped when the list is full.
+ *
+ * @param network The network to add
+ */
+void NetworkScanner::addNetwork(const Network& network)
+{
+  if (network.SSID[0] == '\0')
+  {
+    // Hidden network
+    return;
+  }
+
+  for (int i = 0; i < this->m_size; ++i)
+  {
+    if (strcmp(this->m_networks[i].SSID, network.SSID) == 0)
+    {
+      if (this->m_networks[i].RSSI >= network.RSSI)
+      {
+        return;
+      }
+      // Remove the weaker duplicate, it is inserted again below.
+      memmove(&this->m_networks[i], &this->m_networks[i + 1],
+          (this->m_size - i - 1) * sizeof(Network));
+      this->m_size--;
+      break;
+    }
+  }
+
+  int position = this->m_size;
+  while (position > 0 && this->m_networks[position - 1].RSSI < network.RSSI)
+  {
+    position--;
+  }
+  if (position >= MAX_NETWORK_SCAN)
+  {
+    return;
+  }
+
+  int last = this->m_size < MAX_NETWORK_SCAN ? this->m_size : MAX_NETWORK_SCAN - 1;
+  memmove(&this->m_networks[position + 1], &this->m_networks[position],
+      (last - position) * sizeof(Network));
+  this->m_networks[position] = network;
+  if (this->m_size < MAX_NETWORK_SCAN)
+  {
+    this->m_size++;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+/**
+ * @file networkSwitchover.cpp
+ * @author Laurette Alexandre
+ * @brief Live switchover to a new WiFi configuration
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <networks.h>
+#include <deferredLog.h>
+#include <databaseAbs.h>
+#include <accessPointAbs.h>
+#include <networkConnector.h>
+#include <networkClientAbs.h>
+#include <networkSwitchover.h>
+
+NetworkSwitchover::NetworkSwitchover(DatabaseAbstract* database,
+    NetworkConnector* networkConnector, NetworkClientAbstract* networkClient,
+    AccessPointAbstract* accessPoint)
+    : m_database(database)
+    , m_networkConnector(networkConnector)
+    , m_networkClient(networkClient)
+    , m_accessPoint(accessPoint)
+{
+}
+
+/**
+ * @brief Ask to switch to new networks. Safe to call from a request handler: the WiFi is only
+ * touched by the next loop().
+ *
+ * @param networkConfigs The configurations of the new networks, by order of preference
+ * @param size The number of configurations
+ * @return true if the switchover is started
+ * @return false if another one is still running, or no network is given
+ */
+bool NetworkSwitchover::begin(const NetworkConfiguration networkConfigs[],
+    const unsigned char size)
+{
+  if (this->isRunning() || size == 0 || size > MAX_NETWORK_CONFIGURATIONS)
+  {
+    return false;
+  }
+  memcpy(this->m_networkConfigs, networkConfigs, sizeof(NetworkConfiguration) * size);
+  this->m_size = size;
+  this->m_status.state = SWITCHOVER_PENDING;
+  this->m_status.duration = 0;
+  this->m_status.ssid[0] = '\0';
+  return true;
+}
+
+/**
+ * @brief Carry on the switchover. To call from the main loop.
+ *
+ * @param now The current time in milliseconds
+ */
+void NetworkSwitchover::loop(const unsigned long now)
+{
+  switch (this->m_status.state)
+  {
+  case SWITCHOVER_PENDING:
+    this->start(now);
+    break;
+  case SWITCHOVER_CONNECTING:
+    if (!this->m_networkConnector->isSelecting()
+        && this->m_networkConnector->isConnectedToConfiguration())
+    {
+      this->succeed(now);
+    }
+    else if (!this->m_networkConnector->loop(now)
+        || now - this->m_startedAt >= WIFI_SWITCHOVER_TIMEOUT)
+    {
+      this->rollBack(now);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Is a switchover waiting or connecting ?
+ *
+ * @return true, if running
+ * @return false, otherwise
+ */
+bool NetworkSwitchover::isRunning()
+{
+  return this->m_status.state == SWITCHOVER_PENDING
+      || this->m_status.state == SWITCHOVER_CONNECTING;
+}
+
+/**
+ * @brief Get the status of the last switchover.
+ *
+ * @return SwitchoverStatus
+ */
+SwitchoverStatus NetworkSwitchover::getStatus() { return this->m_status; }
+
+// PRIVATE
+
+void NetworkSwitchover::start(const unsigned long now)
+{
+  LOG_INFO("Trying the new WiFi configuration...");
+  this->m_startedAt = now;
+  this->m_status.state = SWITCHOVER_CONNECTING;
+  // Only one station interface: the current link is dropped, the access point keeps the device
+  // reachable until the end.
+  this->m_hasStartedAccessPoint = !this->m_accessPoint->isRunning();
+  if (this->m_hasStartedAccessPoint)
+  {
+    this->m_accessPoint->startAccessPoint(AP_SSID, AP_PASSWORD);
+  }
+  this->m_networkClient->disconnect();
+  if (!this->m_networkConnector->connect(now, this->m_networkConfigs, this->m_size))
+  {
+    this->rollBack(now);
+  }
+}
+
+void NetworkSwitchover::succeed(const unsigned long now)
+{
+  this->m_status.duration = now - this->m_startedAt;
+  this->m_status.state = SWITCHOVER_SUCCEEDED;
+  strcpy(this->m_status.ssid, this->m_networkConnector->getSsid());
+  DLOG_INFO("Switched to the new WiFi configuration in %lu ms.", this->m_status.duration);
+
+  // Saving the configurations clears the hints of the previous network, new ones come after.
+  this->m_database->setNetworkConfigurations(this->m_networkConfigs, this->m_size);
+  this->m_networkConnector->saveHints();
+  if (this->m_hasStartedAccessPoint)
+  {
+    this->m_accessPoint->stopAccessPoint();
+  }
+}
+
+void NetworkSwitchover::rollBack(const unsigned long now)
+{
+  this->m_status.duration = now - this->m_startedAt;
+  this->m_status.state = SWITCHOVER_ROLLED_BACK;
+  DLOG_WARN("The new WiFi configuration failed after %lu ms, rolling back.",
+      this->m_status.duration);
+  // The supervision reconnects to the saved networks, and closes the access point once done.
+  this->m_networkClient->disconnect();
+}
\ No newline at end of file
@@ -0,0 +1,354 @@
+/**
+ * @file positionTracker.cpp
+ * @author Laurette Alexandre
+ * @brief Estimated positions of the remotes, from their travel times.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <result.h>
+#include <position.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+#include <positionTracker.h>
+
+PositionTracker::PositionTracker(
+    Controller* controller, DatabaseAbstract* database, EventBus* eventBus)
+    : m_controller(controller)
+    , m_database(database)
+    , m_eventBus(eventBus)
+{
+}
+
+/**
+ * @brief Follow the commands sent since the last call, and stop the remotes reaching their
+ * position. To call from the main loop, as often as possible: the delay of a call delays the
+ * STOP.
+ *
+ * @param now The current time, in milliseconds
+ */
+void PositionTracker::loop(const unsigned long now)
+{
+  this->collectEvents(now);
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    Travel& travel = this->m_travels[i];
+    if (travel.remoteId == 0 || !travel.hasStop || (long)(now - travel.stopAt) < 0)
+    {
+      continue;
+    }
+    travel.hasStop = false;
+    DLOG_DEBUG("Remote %lu at its position, %lu ms late.", travel.remoteId, now - travel.stopAt);
+    Result result = this->m_controller->operateRemote(travel.remoteId, "stop");
+    if (!result.isSuccess)
+    {
+      // Still moving, up to the end of its travel.
+      DLOG_WARN("The remote %lu could not be stopped, result %lu.", travel.remoteId, result.code);
+      continue;
+    }
+    travel.position = this->getPositionAt(travel, now);
+    travel.motion = MOTION_IDLE;
+    travel.isEchoPending = true;
+    travel.echo = MOTION_IDLE;
+  }
+}
+
+/**
+ * @brief Move a remote to a position. UP or DOWN is sent now, the STOP is sent by loop().
+ * Fully opening or closing a remote does not need its position, the remote stops by itself.
+ *
+ * @param remoteId The id of the remote
+ * @param position The position to reach, from 0 (closed) to 100 (open)
+ * @param now The current time, in milliseconds
+ * @return Result
+ */
+Result PositionTracker::moveTo(
+    const unsigned long remoteId, const int position, const unsigned long now)
+{
+  this->collectEvents(now);
+  Result result;
+  if (position < 0 || position > 100)
+  {
+    result.code = RESULT_POSITION_INVALID;
+    return result;
+  }
+  Calibration calibration;
+  Travel* travel = nullptr;
+  if (remoteId == 0 || !this->m_database->getCalibration(remoteId, calibration)
+      || (travel = this->findTravel(remoteId, true)) == nullptr)
+  {
+    result.code = RESULT_REMOTE_NOT_FOUND;
+    return result;
+  }
+  if (calibration.upTime == 0 || calibration.downTime == 0)
+  {
+    result.code = RESULT_REMOTE_NOT_CALIBRATED;
+    return result;
+  }
+
+  this->settle(*travel, now);
+  const unsigned short current = this->getPositionAt(*travel, now);
+  const unsigned short goal = position * (POSITION_OPEN / 100);
+  const bool isEnd = goal == 0 || goal == POSITION_OPEN;
+  if (current == POSITION_UNKNOWN && !isEnd)
+  {
+    result.code = RESULT_POSITION_UNKNOWN;
+    return result;
+  }
+
+  result.isSuccess = true;
+  result.code = RESULT_MOVING_TO_POSITION;
+  if (current == goal)
+  {
+    // Already there, stopped now if moving.
+    travel->hasStop = travel->motion != MOTION_IDLE;
+    travel->stopAt = now;
+    travel->target = goal;
+    return result;
+  }
+
+  const Motion motion = goal > current || goal == POSITION_OPEN ? MOTION_UP : MOTION_DOWN;
+  if (travel->motion != motion)
+  {
+    result = this->m_controller->operateRemote(remoteId, motion == MOTION_UP ? "up" : "down");
+    if (!result.isSuccess)
+    {
+      return result;
+    }
+    this->start(*travel, motion, now);
+    travel->isEchoPending = true;
+    travel->echo = motion;
+    result.code = RESULT_MOVING_TO_POSITION;
+  }
+  travel->hasStop = !isEnd;
+  travel->target = goal;
+  if (!isEnd)
+  {
+    const unsigned long distance = goal > current ? goal - current : current - goal;
+    travel->stopAt = now + distance * travel->duration / POSITION_OPEN;
+  }
+  return result;
+}
+
+/**
+ * @brief Get the estimated position of a remote.
+ *
+ * @param remoteId The id of the remote
+ * @param now The current time, in milliseconds
+ * @param position The estimated position
+ * @return true if the remote exists
+ * @return false otherwise
+ */
+bool PositionTracker::getPosition(
+    const unsigned long remoteId, const unsigned long now, RemotePosition& position)
+{
+  Calibration calibration;
+  if (remoteId == 0 || !this->m_database->getCalibration(remoteId, calibration))
+  {
+    return false;
+  }
+  position.remoteId = remoteId;
+  position.calibration = calibration;
+  position.position = -1;
+  position.target = -1;
+  position.motion = MOTION_IDLE;
+
+  Travel* travel = this->findTravel(remoteId, false);
+  if (travel == nullptr)
+  {
+    return true;
+  }
+  const unsigned short current = this->getPositionAt(*travel, now);
+  if (current != POSITION_UNKNOWN)
+  {
+    position.position = (current + 50) / 100;
+  }
+  if (travel->hasStop)
+  {
+    position.target = travel->target / 100;
+  }
+  if (travel->motion != MOTION_IDLE && now - travel->startedAt < travel->duration)
+  {
+    position.motion = travel->motion;
+  }
+  return true;
+}
+
+// PRIVATE
+
+void PositionTracker::collectEvents(const unsigned long now)
+{
+  if (this->m_eventBus->hasMissed(this->m_lastSequence))
+  {
+    DLOG_WARN("Position tracker behind the events, all the positions are unknown.");
+    this->m_lastSequence = this->m_eventBus->getLastSequence();
+    for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+    {
+      this->m_travels[i].position = POSITION_UNKNOWN;
+      this->m_travels[i].motion = MOTION_IDLE;
+      this->m_travels[i].hasStop = false;
+      this->m_travels[i].isEchoPending = false;
+    }
+  }
+
+  Event event;
+  while (this->m_eventBus->readEvent(this->m_lastSequence, event))
+  {
+    if (event.type == EVENT_REMOTE_DELETED)
+    {
+      Travel* travel = this->findTravel(event.remoteId, false);
+      if (travel != nullptr)
+      {
+        memset(travel, 0, sizeof(Travel));
+      }
+      continue;
+    }
+    if (event.type != EVENT_COMMAND_TRANSMITTED)
+    {
+      continue;
+    }
+    Travel* travel = this->findTravel(event.remoteId, true);
+    if (travel == nullptr || this->isEcho(*travel, event.action))
+    {
+      continue;
+    }
+    this->settle(*travel, now);
+    if (strcmp(event.action, "up") == 0 && travel->motion != MOTION_UP)
+    {
+      this->start(*travel, MOTION_UP, now);
+    }
+    else if (strcmp(event.action, "down") == 0 && travel->motion != MOTION_DOWN)
+    {
+      this->start(*travel, MOTION_DOWN, now);
+    }
+    else if (strcmp(event.action, "stop") == 0)
+    {
+      // A STOP to a stopped remote moves it to its favourite position, unknown here.
+      travel->position = travel->motion == MOTION_IDLE ? POSITION_UNKNOWN
+                                                       : this->getPositionAt(*travel, now);
+      travel->motion = MOTION_IDLE;
+      travel->hasStop = false;
+    }
+  }
+}
+
+void PositionTracker::start(Travel& travel, const Motion motion, const unsigned long now)
+{
+  Calibration calibration = { 0, 0 };
+  this->m_database->getCalibration(travel.remoteId, calibration);
+  travel.position = this->getPositionAt(travel, now);
+  travel.duration = motion == MOTION_UP ? calibration.upTime : calibration.downTime;
+  travel.hasStop = false;
+  travel.isEchoPending = false;
+  if (travel.duration == 0)
+  {
+    // Not calibrated: where it stops cannot be known.
+    travel.position = POSITION_UNKNOWN;
+    travel.motion = MOTION_IDLE;
+    return;
+  }
+  travel.motion = motion;
+  travel.startedAt = now;
+}
+
+void PositionTracker::settle(Travel& travel, const unsigned long now)
+{
+  if (travel.motion == MOTION_IDLE || now - travel.startedAt < travel.duration)
+  {
+    return;
+  }
+  // End of the travel, the remote stopped by itself.
+  travel.position = this->getPositionAt(travel, now);
+  travel.motion = MOTION_IDLE;
+  travel.hasStop = false;
+}
+
+bool PositionTracker::isEcho(Travel& travel, const char* action)
+{
+  static const char* const ACTIONS[] = { "stop", "up", "down" };
+
+  if (!travel.isEchoPending || strcmp(action, ACTIONS[travel.echo]) != 0)
+  {
+    return false;
+  }
+  travel.isEchoPending = false;
+  return true;
+}
+
+unsigned short PositionTracker::getPositionAt(const Travel& travel, const unsigned long now)
+{
+  if (travel.motion == MOTION_IDLE)
+  {
+    return travel.position;
+  }
+  const unsigned long elapsed = now - travel.startedAt;
+  if (elapsed >= travel.duration)
+  {
+    return travel.motion == MOTION_UP ? POSITION_OPEN : 0;
+  }
+  if (travel.position == POSITION_UNKNOWN)
+  {
+    return POSITION_UNKNOWN;
+  }
+  // Below 120 s of travel, the product fits in 32 bits.
+  const unsigned long distance = elapsed * POSITION_OPEN / travel.duration;
+  if (travel.motion == MOTION_UP)
+  {
+    return travel.position + distance < POSITION_OPEN ? travel.position + distance : POSITION_OPEN;
+  }
+  return travel.position > distance ? travel.position - distance : 0;
+}
+
+PositionTracker::Travel* PositionTracker::findTravel(
+    const unsigned long remoteId, const bool create)
+{
+  if (remoteId == 0)
+  {
+    return nullptr;
+  }
+  Travel* freeTravel = nullptr;
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    if (this->m_travels[i].remoteId == remoteId)
+    {
+      return &this->m_travels[i];
+    }
+    if (freeTravel == nullptr && this->m_travels[i].remoteId == 0)
+    {
+      freeTravel = &this->m_travels[i];
+    }
+  }
+  if (!create || freeTravel == nullptr)
+  {
+    return nullptr;
+  }
+  memset(freeTravel, 0, sizeof(Travel));
+  freeTravel->remoteId = remoteId;
+  freeTravel->position = POSITION_UNKNOWN;
+  return freeTravel;
+}
\ No newline at end of file
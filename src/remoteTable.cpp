@@ -0,0 +1,108 @@
+/**
+ * @file remoteTable.cpp
+ * @author Laurette Alexandre
+ * @brief Table of the remotes in RAM, read without locks.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+
+#include <remoteTable.h>
+
+/**
+ * @brief Write a remote at its place. A single writer at a time: the main loop.
+ *
+ * @param index The place of the remote, below MAX_REMOTES
+ * @param remote The remote
+ */
+void RemoteTable::write(const unsigned char index, const Remote& remote)
+{
+  Place& place = this->m_places[index];
+  uint32_t words[REMOTE_WORDS] = {};
+  memcpy(words, &remote, sizeof(Remote));
+  const uint32_t sequence = place.sequence.load(std::memory_order_relaxed);
+
+  // Odd: the readers take the second copy while the first one is written. Released, the second
+  // copy of the previous write is complete for a reader seeing this sequence.
+  place.sequence.store(sequence + 1, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (unsigned char i = 0; i < REMOTE_WORDS; ++i)
+  {
+    place.copies[0][i].store(words[i], std::memory_order_relaxed);
+  }
+
+  // Even: back to the first copy, up to date, while the second one is written.
+  std::atomic_thread_fence(std::memory_order_release);
+  place.sequence.store(sequence + 2, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (unsigned char i = 0; i < REMOTE_WORDS; ++i)
+  {
+    place.copies[1][i].store(words[i], std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Read the remote of a place, as it was before or after a write, never in between.
+ * Safe from any context, it never waits for the writer.
+ *
+ * @param index The place of the remote, below MAX_REMOTES
+ * @param remote The remote read
+ */
+void RemoteTable::read(const unsigned char index, Remote& remote) const
+{
+  const Place& place = this->m_places[index];
+  uint32_t words[REMOTE_WORDS];
+  uint32_t sequence;
+  do
+  {
+    sequence = place.sequence.load(std::memory_order_acquire);
+    const std::atomic<uint32_t>* copy = place.copies[sequence & 1];
+    for (unsigned char i = 0; i < REMOTE_WORDS; ++i)
+    {
+      words[i] = copy[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Read again if the writer has moved to the copy read meanwhile.
+  } while (place.sequence.load(std::memory_order_relaxed) != sequence);
+  memcpy(&remote, words, sizeof(Remote));
+}
+
+/**
+ * @brief Find the place of a remote.
+ *
+ * @param id The id of the remote, 0 for a free place
+ * @return int The index of the place, -1 if not found
+ */
+int RemoteTable::find(const unsigned long id) const
+{
+  Remote remote;
+  for (unsigned char i = 0; i < MAX_REMOTES; ++i)
+  {
+    this->read(i, remote);
+    if (remote.id == id)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+/**
+ * @file result.cpp
+ * @author Laurette Alexandre
+ * @brief Flash resident messages of the Controller Result DTO.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <result.h>
+
+static const char MESSAGE_OK[] PROGMEM = "OK.";
+static const char MESSAGE_REMOTE_ID_MISSING[] PROGMEM = "The remote id should be specified.";
+static const char MESSAGE_REMOTE_NOT_FOUND[] PROGMEM = "The remote doesn't exist.";
+static const char MESSAGE_REMOTE_NAME_MISSING[] PROGMEM
+    = "The name of the remote should be specified.";
+static const char MESSAGE_REMOTE_NAME_EMPTY[] PROGMEM = "The name of the remote cannot be empty.";
+static const char MESSAGE_REMOTE_NAME_TOO_LONG[] PROGMEM = "The name of the remote is too long.";
+static const char MESSAGE_REMOTE_UPDATE_FAILED[] PROGMEM
+    = "Something went wrong while updating the remote.";
+static const char MESSAGE_REMOTE_DELETED[] PROGMEM = "The remote has been deleted.";
+static const char MESSAGE_NO_SPACE_LEFT[] PROGMEM = "No space left on the device for a new remote.";
+static const char MESSAGE_ACTION_MISSING[] PROGMEM
+    = "The action should be specified. Allowed actions: up, down, stop, pair, reset.";
+static const char MESSAGE_ACTION_INVALID[] PROGMEM
+    = "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
+static const char MESSAGE_COMMAND_UP_SENT[] PROGMEM = "Command UP sent.";
+static const char MESSAGE_COMMAND_STOP_SENT[] PROGMEM = "Command STOP sent.";
+static const char MESSAGE_COMMAND_DOWN_SENT[] PROGMEM = "Command DOWN sent.";
+static const char MESSAGE_COMMAND_PAIR_SENT[] PROGMEM = "Command PAIR sent.";
+static const char MESSAGE_ROLLING_CODE_RESET[] PROGMEM = "Rolling code reseted.";
+static const char MESSAGE_SSID_MISSING[] PROGMEM = "The ssid should be specified.";
+static const char MESSAGE_SSID_EMPTY[] PROGMEM = "The ssid cannot be empty.";
+static const char MESSAGE_NETWORK_CONFIGURATION_UPDATE_FAILED[] PROGMEM
+    = "Something went wrong while updating the Network Configuration.";
+static const char MESSAGE_TOO_MANY_NETWORKS[] PROGMEM = "Too many networks provided.";
+static const char MESSAGE_NETWORK_SWITCHOVER_STARTED[] PROGMEM
+    = "Trying the new Network Configuration.";
+static const char MESSAGE_NETWORK_SWITCHOVER_RUNNING[] PROGMEM
+    = "A change of the Network Configuration is already running.";
+static const char MESSAGE_PACKET_INVALID[] PROGMEM = "The packet is not valid.";
+static const char MESSAGE_PACKET_UNAUTHORIZED[] PROGMEM
+    = "The signature of the packet is not valid.";
+static const char MESSAGE_TOO_MANY_SUBSCRIBERS[] PROGMEM
+    = "Too many clients are listening to the events.";
+static const char MESSAGE_SCHEDULE_INVALID[] PROGMEM
+    = "The schedule is not valid. Allowed events: time, sunrise, sunset.";
+static const char MESSAGE_SCHEDULE_NOT_FOUND[] PROGMEM = "The schedule doesn't exist.";
+static const char MESSAGE_SCHEDULE_DELETED[] PROGMEM = "The schedule has been deleted.";
+static const char MESSAGE_TOO_MANY_SCHEDULES[] PROGMEM
+    = "No space left on the device for a new schedule.";
+static const char MESSAGE_CALIBRATION_INVALID[] PROGMEM
+    = "The travel times should be between 1 and 120 seconds, in milliseconds.";
+static const char MESSAGE_REMOTE_CALIBRATED[] PROGMEM = "The travel times have been saved.";
+static const char MESSAGE_REMOTE_NOT_CALIBRATED[] PROGMEM
+    = "The travel times of the remote should be set first.";
+static const char MESSAGE_POSITION_INVALID[] PROGMEM
+    = "The position should be specified, from 0 (closed) to 100 (open).";
+static const char MESSAGE_POSITION_UNKNOWN[] PROGMEM
+    = "The position is unknown. Open or close the remote fully first.";
+static const char MESSAGE_MOVING_TO_POSITION[] PROGMEM = "Moving to the position.";
+static const char MESSAGE_GROUP_INVALID[] PROGMEM
+    = "A group needs a name and existing remotes, given by their ids.";
+static const char MESSAGE_GROUP_NOT_FOUND[] PROGMEM = "The group doesn't exist.";
+static const char MESSAGE_GROUP_DELETED[] PROGMEM = "The group has been deleted.";
+static const char MESSAGE_TOO_MANY_GROUPS[] PROGMEM = "No space left on the device for a new group.";
+static const char MESSAGE_SCENE_INVALID[] PROGMEM
+    = "A scene needs a name and steps: remote_id:action:delay. Allowed actions: up, stop, down.";
+static const char MESSAGE_SCENE_NOT_FOUND[] PROGMEM = "The scene doesn't exist.";
+static const char MESSAGE_SCENE_DELETED[] PROGMEM = "The scene has been deleted.";
+static const char MESSAGE_TOO_MANY_SCENES[] PROGMEM = "No space left on the device for a new scene.";
+static const char MESSAGE_SCENE_RUNNING[] PROGMEM = "A scene or a group is already running.";
+static const char MESSAGE_MACRO_INVALID[] PROGMEM
+    = "A macro needs a name and steps: action:wait. Allowed actions: up, stop, down.";
+static const char MESSAGE_MACRO_NOT_FOUND[] PROGMEM = "The macro doesn't exist.";
+static const char MESSAGE_MACRO_DELETED[] PROGMEM = "The macro has been deleted.";
+static const char MESSAGE_TOO_MANY_MACROS[] PROGMEM = "No space left on the device for a new macro.";
+static const char MESSAGE_MACRO_STARTED[] PROGMEM = "Macro started.";
+static const char MESSAGE_TOO_MANY_RUNNING_MACROS[] PROGMEM
+    = "Too many macros are running, wait for one to end.";
+static const char MESSAGE_COMMAND_DELAYED[] PROGMEM
+    = "The airtime budget is spent, the command will be sent later.";
+static const char MESSAGE_AIRTIME_EXHAUSTED[] PROGMEM
+    = "The airtime budget is spent and too many commands are waiting.";
+static const char MESSAGE_TOO_MANY_PENDING_COMMANDS[] PROGMEM
+    = "Too many commands are waiting to be sent, try again.";
+static const char MESSAGE_PACKET_REPLAYED[] PROGMEM
+    = "The packet needs a nonce greater than the last one of the remote.";
+
+// Indexed by ResultCode. Keep both in the same order.
+static const char* const RESULT_MESSAGES[] PROGMEM = {
+  MESSAGE_OK,
+  MESSAGE_REMOTE_ID_MISSING,
+  MESSAGE_REMOTE_NOT_FOUND,
+  MESSAGE_REMOTE_NAME_MISSING,
+  MESSAGE_REMOTE_NAME_EMPTY,
+  MESSAGE_REMOTE_NAME_TOO_LONG,
+  MESSAGE_REMOTE_UPDATE_FAILED,
+  MESSAGE_REMOTE_DELETED,
+  MESSAGE_NO_SPACE_LEFT,
+  MESSAGE_ACTION_MISSING,
+  MESSAGE_ACTION_INVALID,
+  MESSAGE_COMMAND_UP_SENT,
+  MESSAGE_COMMAND_STOP_SENT,
+  MESSAGE_COMMAND_DOWN_SENT,
+  MESSAGE_COMMAND_PAIR_SENT,
+  MESSAGE_ROLLING_CODE_RESET,
+  MESSAGE_SSID_MISSING,
+  MESSAGE_SSID_EMPTY,
+  MESSAGE_NETWORK_CONFIGURATION_UPDATE_FAILED,
+  MESSAGE_TOO_MANY_NETWORKS,
+  MESSAGE_NETWORK_SWITCHOVER_STARTED,
+  MESSAGE_NETWORK_SWITCHOVER_RUNNING,
+  MESSAGE_PACKET_INVALID,
+  MESSAGE_PACKET_UNAUTHORIZED,
+  MESSAGE_TOO_MANY_SUBSCRIBERS,
+  MESSAGE_SCHEDULE_INVALID,
+  MESSAGE_SCHEDULE_NOT_FOUND,
+  MESSAGE_SCHEDULE_DELETED,
+  MESSAGE_TOO_MANY_SCHEDULES,
+  MESSAGE_CALIBRATION_INVALID,
+  MESSAGE_REMOTE_CALIBRATED,
+  MESSAGE_REMOTE_NOT_CALIBRATED,
+  MESSAGE_POSITION_INVALID,
+  MESSAGE_POSITION_UNKNOWN,
+  MESSAGE_MOVING_TO_POSITION,
+  MESSAGE_GROUP_INVALID,
+  MESSAGE_GROUP_NOT_FOUND,
+  MESSAGE_GROUP_DELETED,
+  MESSAGE_TOO_MANY_GROUPS,
+  MESSAGE_SCENE_INVALID,
+  MESSAGE_SCENE_NOT_FOUND,
+  MESSAGE_SCENE_DELETED,
+  MESSAGE_TOO_MANY_SCENES,
+  MESSAGE_SCENE_RUNNING,
+  MESSAGE_MACRO_INVALID,
+  MESSAGE_MACRO_NOT_FOUND,
+  MESSAGE_MACRO_DELETED,
+  MESSAGE_TOO_MANY_MACROS,
+  MESSAGE_MACRO_STARTED,
+  MESSAGE_TOO_MANY_RUNNING_MACROS,
+  MESSAGE_COMMAND_DELAYED,
+  MESSAGE_AIRTIME_EXHAUSTED,
+  MESSAGE_TOO_MANY_PENDING_COMMANDS,
+  MESSAGE_PACKET_REPLAYED,
+};
+static_assert(sizeof(RESULT_MESSAGES) / sizeof(RESULT_MESSAGES[0]) == RESULT_CODES,
+    "One message per ResultCode, in the same order.");
+
+static const char BODY_PREFIX[] = "{\"message\":\"";
+static const char BODY_SUFFIX[] = "\"}";
+
+/**
+ * @brief Get the message of a result code. The message stays in flash, nothing is allocated.
+ *
+ * @param code The code of the result
+ * @return const __FlashStringHelper* The message, to use with the _P functions or print().
+ */
+const __FlashStringHelper* getResultMessage(const ResultCode code)
+{
+  if (code >= RESULT_CODES)
+  {
+    return FPSTR(MESSAGE_OK);
+  }
+  return FPSTR(pgm_read_ptr(&RESULT_MESSAGES[code]));
+}
+
+/**
+ * @brief Get the length of the body {"message":"..."} of a result code.
+ *
+ * @param code The code of the result
+ * @return size_t The length of the body, without '\0'
+ */
+size_t getResultBodyLength(const ResultCode code)
+{
+  return sizeof(BODY_PREFIX) - 1 + strlen_P(reinterpret_cast<PGM_P>(getResultMessage(code)))
+      + sizeof(BODY_SUFFIX) - 1;
+}
+
+/**
+ * @brief Copy a chunk of the body {"message":"..."} of a result code. The message is read from
+ * flash byte by byte, no String is built.
+ *
+ * @param code The code of the result
+ * @param buffer The buffer to fill, e.g. the TCP buffer of a response
+ * @param maxLen The size of the buffer
+ * @param index The offset in the body of the first byte to copy
+ * @return size_t The number of bytes copied, 0 once the body is over
+ */
+size_t readResultBody(
+    const ResultCode code, uint8_t* buffer, const size_t maxLen, const size_t index)
+{
+  PGM_P message = reinterpret_cast<PGM_P>(getResultMessage(code));
+  const size_t prefixLength = sizeof(BODY_PREFIX) - 1;
+  const size_t messageLength = strlen_P(message);
+  const size_t length = prefixLength + messageLength + sizeof(BODY_SUFFIX) - 1;
+  size_t written = 0;
+  for (size_t i = index; written < maxLen && i < length; ++written, ++i)
+  {
+    if (i < prefixLength)
+    {
+      buffer[written] = BODY_PREFIX[i];
+    }
+    else if (i < prefixLength + messageLength)
+    {
+      buffer[written] = pgm_read_byte(message + i - prefixLength);
+    }
+    else
+    {
+      buffer[written] = BODY_SUFFIX[i - prefixLength - messageLength];
+    }
+  }
+  return written;
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+/**
+ * @file router.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the HTTP path router.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <router.h>
+
+/**
+ * @brief Register a handler for a path.
+ *
+ * @param path The path. Must stay valid forever (a literal). Ex: "/api/v1/remotes/{id}".
+ * @param methods Mask of the HTTP methods (WebRequestMethod) handled.
+ * @param handler The function to call.
+ * @param header A request header read by the handler, nullptr if none. Must stay valid forever.
+ * The web server drops the headers no handler asked for.
+ * @return true if the route has been registered
+ * @return false if there is no space left in the tables
+ */
+bool Router::on(const char* path, const unsigned char methods, RouteHandler handler,
+    const char* header)
+{
+  if (this->m_routesCount >= MAX_ROUTES)
+  {
+    LOG_ERROR("No space left for a new route:", path);
+    return false;
+  }
+
+  short node = 0;
+  const char* segment = path;
+  while (*segment != '\0')
+  {
+    if (*segment == '/')
+    {
+      ++segment;
+      continue;
+    }
+    const char* end = segment;
+    while (*end != '\0' && *end != '/')
+    {
+      ++end;
+    }
+    const size_t length = end - segment;
+    if (length > 255)
+    {
+      LOG_ERROR("Segment too long in the route:", path);
+      return false;
+    }
+    bool isParam = segment[0] == '{' && segment[length - 1] == '}';
+    if (!isParam && length > this->m_longestSegment)
+    {
+      this->m_longestSegment = length;
+    }
+
+    short child = this->findChild(node, segment, length, isParam);
+    if (child < 0)
+    {
+      child = this->addChild(node, segment, length, isParam);
+      if (child < 0)
+      {
+        LOG_ERROR("No space left for a new route:", path);
+        return false;
+      }
+    }
+    node = child;
+    segment = end;
+  }
+
+  Route& route = this->m_routes[this->m_routesCount];
+  route.path = path;
+  route.methods = methods;
+  route.handler = handler;
+  route.header = header;
+  route.next = this->m_nodes[node].firstRoute;
+  this->m_nodes[node].firstRoute = this->m_routesCount;
+  this->m_routesCount++;
+  return true;
+}
+
+/**
+ * @brief Find the handler of an URL.
+ *
+ * @param url The path of the request, without the query string.
+ * @param method The HTTP method of the request (WebRequestMethod).
+ * @param params Filled with the integer parameters found in the path.
+ * @return RouteHandler The handler, or nullptr if no route matches.
+ */
+RouteHandler Router::match(const char* url, const unsigned char method, RouteParams& params)
+{
+  short route = this->matchRoute(url, method, params);
+  return route < 0 ? nullptr : this->m_routes[route].handler;
+}
+
+/**
+ * @brief Find the route of an URL. Each segment follows a single '/' and the URL does not end
+ * with one, as the regex routes required: "/api//v1/remotes" and "/api/v1/remotes/" match no
+ * route. A segment longer than the longest literal and parameter matches nothing.
+ *
+ * @param url The path of the request, without the query string.
+ * @param method The HTTP method of the request (WebRequestMethod).
+ * @param params Filled with the integer parameters found in the path.
+ * @return short The index of the route, or -1 if no route matches.
+ */
+short Router::matchRoute(const char* url, const unsigned char method, RouteParams& params)
+{
+  params.size = 0;
+  short node = 0;
+  const char* segment = url;
+  while (*segment != '\0')
+  {
+    if (segment[0] != '/' || segment[1] == '/' || segment[1] == '\0')
+    {
+      return -1;
+    }
+    ++segment;
+    const char* end = segment;
+    while (*end != '\0' && *end != '/')
+    {
+      ++end;
+    }
+    const size_t length = end - segment;
+    if (length > this->m_longestSegment)
+    {
+      // Matches no literal, nor a parameter.
+      return -1;
+    }
+
+    short next = -1;
+    short paramChild = -1;
+    for (short child = this->m_nodes[node].firstChild; child >= 0;
+         child = this->m_nodes[child].nextSibling)
+    {
+      const Node& candidate = this->m_nodes[child];
+      if (candidate.isParam)
+      {
+        paramChild = child;
+      }
+      else if (candidate.length == length && strncmp(candidate.segment, segment, length) == 0)
+      {
+        next = child;
+        break;
+      }
+    }
+
+    if (next < 0)
+    {
+      if (paramChild < 0 || params.size >= MAX_ROUTE_PARAMS
+          || !this->parseParam(segment, length, params.values[params.size]))
+      {
+        return -1;
+      }
+      params.size++;
+      next = paramChild;
+    }
+    node = next;
+    segment = end;
+  }
+
+  for (short route = this->m_nodes[node].firstRoute; route >= 0;
+       route = this->m_routes[route].next)
+  {
+    if (this->m_routes[route].methods & method)
+    {
+      return route;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Get the handler of a route.
+ *
+ * @param route The index of the route
+ * @return RouteHandler
+ */
+RouteHandler Router::getHandler(const short route) { return this->m_routes[route].handler; }
+
+/**
+ * @brief Get the path registered for a route.
+ *
+ * @param route The index of the route
+ * @return const char*
+ */
+const char* Router::getPath(const short route) { return this->m_routes[route].path; }
+
+/**
+ * @brief Get the mask of the methods of a route.
+ *
+ * @param route The index of the route
+ * @return unsigned char
+ */
+unsigned char Router::getMethods(const short route) { return this->m_routes[route].methods; }
+
+/**
+ * @brief Get the request header read by the handler of a route.
+ *
+ * @param route The index of the route
+ * @return const char* The name of the header, nullptr if none
+ */
+const char* Router::getHeader(const short route) { return this->m_routes[route].header; }
+
+// PRIVATE
+short Router::findChild(
+    const short parent, const char* segment, const unsigned char length, const bool isParam)
+{
+  for (short child = this->m_nodes[parent].firstChild; child >= 0;
+       child = this->m_nodes[child].nextSibling)
+  {
+    const Node& candidate = this->m_nodes[child];
+    if (isParam && candidate.isParam)
+    {
+      return child;
+    }
+    if (!isParam && !candidate.isParam && candidate.length == length
+        && strncmp(candidate.segment, segment, length) == 0)
+    {
+      return child;
+    }
+  }
+  return -1;
+}
+
+short Router::addChild(
+    const short parent, const char* segment, const unsigned char length, const bool isParam)
+{
+  if (this->m_nodesCount >= MAX_ROUTE_NODES)
+  {
+    return -1;
+  }
+  short child = this->m_nodesCount;
+  Node& node = this->m_nodes[child];
+  node.segment = segment;
+  node.length = length;
+  node.isParam = isParam;
+  node.firstChild = -1;
+  node.nextSibling = this->m_nodes[parent].firstChild;
+  node.firstRoute = -1;
+  this->m_nodes[parent].firstChild = child;
+  this->m_nodesCount++;
+  return child;
+}
+
+/**
+ * @brief Parse an integer parameter. Only digits are allowed.
+ *
+ * @return true if the segment is a valid integer
+ * @return false otherwise
+ */
+bool Router::parseParam(const char* segment, const size_t length, unsigned long& value)
+{
+  if (length == 0 || length > MAX_PARAM_DIGITS)
+  {
+    return false;
+  }
+  value = 0;
+  for (unsigned char i = 0; i < length; ++i)
+  {
+    if (segment[i] < '0' || segment[i] > '9')
+    {
+      return false;
+    }
+    value = value * 10 + (segment[i] - '0');
+  }
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @file routerWebHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the web server handler dispatching to the Router.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#include <router.h>
+#include <trace.h>
+#include <metrics.h>
+#include <routerWebHandler.h>
+
+RouterWebHandler::RouterWebHandler(Router* router)
+    : m_router(router)
+{
+}
+
+bool RouterWebHandler::canHandle(AsyncWebServerRequest* request)
+{
+  RouteParams params;
+  short route = this->m_router->matchRoute(request->url().c_str(), request->method(), params);
+  if (route < 0)
+  {
+    return false;
+  }
+  // The other headers are dropped once the handler is chosen.
+  const char* header = this->m_router->getHeader(route);
+  if (header != nullptr)
+  {
+    request->addInterestingHeader(header);
+  }
+  return true;
+}
+
+void RouterWebHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  TRACE_SPAN("http.handleRequest");
+  RouteParams params;
+  short route;
+  {
+    TRACE_SPAN("router.match");
+    route = this->m_router->matchRoute(request->url().c_str(), request->method(), params);
+  }
+  if (route < 0)
+  {
+    request->send(404);
+    return;
+  }
+  const unsigned long start = micros();
+  this->m_router->getHandler(route)(request, params);
+  metrics.observeRouteLatency(route, this->m_router->getPath(route),
+      this->m_router->getMethods(route), micros() - start);
+}
\ No newline at end of file
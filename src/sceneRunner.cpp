@@ -0,0 +1,239 @@
+/**
+ * @file sceneRunner.cpp
+ * @author Laurette Alexandre
+ * @brief Runs the scenes and the groups, spacing their transmissions.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <scene.h>
+#include <result.h>
+#include <schedule.h>
+#include <controller.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+#include <sceneRunner.h>
+
+static const char* const SCENE_ACTIONS[] = { "up", "stop", "down" };
+
+SceneRunner::SceneRunner(Controller* controller, DatabaseAbstract* database)
+    : m_controller(controller)
+    , m_database(database)
+{
+}
+
+/**
+ * @brief Start a scene. Its steps are sent by loop().
+ *
+ * @param id The id of the scene
+ * @param now The current time, in milliseconds
+ * @return Result
+ */
+Result SceneRunner::runScene(const unsigned long id, const unsigned long now)
+{
+  Result result;
+  if (this->m_isRunning)
+  {
+    result.code = RESULT_SCENE_RUNNING;
+    return result;
+  }
+  if (id == 0 || id > MAX_SCENES)
+  {
+    result.code = RESULT_SCENE_NOT_FOUND;
+    return result;
+  }
+  this->m_scene = this->m_database->getScene(id);
+  if (this->m_scene.id == 0 || this->m_scene.size == 0)
+  {
+    result.code = RESULT_SCENE_NOT_FOUND;
+    return result;
+  }
+
+  this->start(now);
+  this->m_report.sceneId = this->m_scene.id;
+  DLOG_INFO("Scene %lu started, run %lu.", id, this->m_lastRunId);
+  result.isSuccess = true;
+  return result;
+}
+
+/**
+ * @brief Start an action on every remote of a group. The remotes are operated one after the
+ * other by loop(), spaced by SCENE_STAGGER_GAP.
+ *
+ * @param id The id of the group
+ * @param action The action to send: up, stop or down
+ * @param now The current time, in milliseconds
+ * @return Result
+ */
+Result SceneRunner::runGroup(const unsigned long id, const char* action, const unsigned long now)
+{
+  Result result;
+  if (this->m_isRunning)
+  {
+    result.code = RESULT_SCENE_RUNNING;
+    return result;
+  }
+  if (action == nullptr || strlen(action) == 0)
+  {
+    result.code = RESULT_ACTION_MISSING;
+    return result;
+  }
+  unsigned char sceneAction = 0;
+  while (sceneAction < 3 && strcmp(action, SCENE_ACTIONS[sceneAction]) != 0)
+  {
+    sceneAction++;
+  }
+  if (sceneAction == 3)
+  {
+    result.code = RESULT_ACTION_INVALID;
+    return result;
+  }
+  if (id == 0 || id > MAX_GROUPS)
+  {
+    result.code = RESULT_GROUP_NOT_FOUND;
+    return result;
+  }
+  const Group group = this->m_database->getGroup(id);
+  if (group.id == 0 || group.size == 0)
+  {
+    result.code = RESULT_GROUP_NOT_FOUND;
+    return result;
+  }
+
+  // Run as a scene without delays.
+  this->m_scene = {};
+  this->m_scene.size = group.size;
+  for (unsigned char i = 0; i < group.size; ++i)
+  {
+    this->m_scene.steps[i] = { group.remoteIds[i], 0, sceneAction };
+  }
+  this->start(now);
+  this->m_report.groupId = group.id;
+  DLOG_INFO("Group %lu started, run %lu.", id, this->m_lastRunId);
+  result.isSuccess = true;
+  return result;
+}
+
+/**
+ * @brief Send the next step of the run, once due. One at most per call, a transmission blocks
+ * for more than 100 ms. To call from the main loop.
+ *
+ * @param now The current time, in milliseconds
+ * @return true, if the run is over
+ * @return false, otherwise
+ */
+bool SceneRunner::loop(const unsigned long now)
+{
+  if (!this->m_isRunning)
+  {
+    return false;
+  }
+  if (this->m_isPlanPending)
+  {
+    // First call after the transmission: the gap starts now.
+    const unsigned short delay = this->m_scene.steps[this->m_next].delay;
+    this->m_dueAt = now + (delay > SCENE_STAGGER_GAP ? delay : SCENE_STAGGER_GAP);
+    this->m_isPlanPending = false;
+  }
+  if ((long)(now - this->m_dueAt) < 0)
+  {
+    return false;
+  }
+
+  const SceneStep& step = this->m_scene.steps[this->m_next];
+  if (!this->m_isBatching)
+  {
+    this->m_database->beginBatch();
+    this->m_isBatching = true;
+  }
+  Result result = this->m_controller->operateRemote(step.remoteId, SCENE_ACTIONS[step.action]);
+  if (!result.isSuccess)
+  {
+    DLOG_WARN("Step %lu of run %lu failed, result %lu.", this->m_next, this->m_lastRunId,
+        result.code);
+  }
+  SceneStepReport& report = this->m_report.steps[this->m_next];
+  report.remoteId = step.remoteId;
+  report.sentAt = now - this->m_startedAt;
+  report.code = result.code;
+  this->m_report.size = ++this->m_next;
+
+  if (this->m_next >= this->m_scene.size)
+  {
+    this->finish(now);
+    return true;
+  }
+  if (this->m_scene.steps[this->m_next].delay > SCENE_MAX_BATCH_DELAY)
+  {
+    // Not kept uncommitted while waiting.
+    this->m_database->endBatch();
+    this->m_isBatching = false;
+  }
+  this->m_isPlanPending = true;
+  return false;
+}
+
+bool SceneRunner::isRunning() { return this->m_isRunning; }
+
+/**
+ * @brief Get the id of the last run started. The ids start at 1.
+ */
+unsigned long SceneRunner::getRunId() { return this->m_lastRunId; }
+
+bool SceneRunner::isFinished(const unsigned long runId)
+{
+  return runId != 0 && runId <= this->m_lastRunId
+      && (runId != this->m_lastRunId || !this->m_isRunning);
+}
+
+/**
+ * @brief Get the report of the last run, complete once it is finished.
+ */
+const SceneReport& SceneRunner::getReport() { return this->m_report; }
+
+// PRIVATE
+
+void SceneRunner::start(const unsigned long now)
+{
+  this->m_report = {};
+  this->m_report.runId = ++this->m_lastRunId;
+  this->m_isRunning = true;
+  this->m_isPlanPending = false;
+  this->m_next = 0;
+  this->m_startedAt = now;
+  this->m_dueAt = now + this->m_scene.steps[0].delay;
+}
+
+void SceneRunner::finish(const unsigned long now)
+{
+  if (this->m_isBatching)
+  {
+    this->m_database->endBatch();
+    this->m_isBatching = false;
+  }
+  this->m_isRunning = false;
+  this->m_report.duration = now - this->m_startedAt;
+  DLOG_INFO("Run %lu over in %lu ms.", this->m_lastRunId, this->m_report.duration);
+}
\ No newline at end of file
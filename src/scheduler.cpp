@@ -0,0 +1,229 @@
+/**
+ * @file scheduler.cpp
+ * @author Laurette Alexandre
+ * @brief Runs the schedules of the remotes
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <time.h>
+
+#include <sun.h>
+#include <config.h>
+#include <result.h>
+#include <schedule.h>
+#include <scheduler.h>
+#include <controller.h>
+#include <timerWheel.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+
+// The clock is not set before this time (November 2023), nothing can be planned.
+static const time_t MIN_VALID_TIME = 1700000000;
+
+static const char* const SCHEDULE_ACTIONS[] = { "up", "stop", "down" };
+
+static time_t makeLocalTime(const struct tm& date, const int minutes);
+
+Scheduler::Scheduler(DatabaseAbstract* database, AirtimeScheduler* airtimeScheduler)
+    : m_database(database)
+    , m_airtimeScheduler(airtimeScheduler)
+    , m_wheel(m_timers, MAX_SCHEDULES)
+{
+}
+
+/**
+ * @brief Read the schedules again from the database, at the next loop(). To call once they
+ * have been changed.
+ */
+void Scheduler::reload() { this->m_isStarted = false; }
+
+/**
+ * @brief Run the schedule due, if any. One at most per call, a transmission blocks for more
+ * than 100 ms. To call from the main loop.
+ *
+ * @param now The current time, UTC
+ * @return true, if a schedule has run
+ * @return false, otherwise
+ */
+bool Scheduler::loop(const time_t now)
+{
+  if (now < MIN_VALID_TIME)
+  {
+    return false;
+  }
+  const long elapsed = (long)((unsigned long)now - this->m_wheel.getTime());
+  if (!this->m_isStarted || elapsed < 0 || elapsed > SCHEDULE_MAX_CATCH_UP)
+  {
+    if (this->m_isStarted)
+    {
+      DLOG_WARN("Clock moved by %lu s, schedules planned again.", elapsed < 0 ? -elapsed : elapsed);
+    }
+    this->start(now);
+  }
+  this->m_wheel.advance(now);
+
+  const int index = this->m_wheel.popExpired();
+  if (index < 0)
+  {
+    return false;
+  }
+  const Schedule& schedule = this->m_schedules[index];
+  const time_t plannedAt = this->m_nextRuns[index];
+  this->plan(index, plannedAt);
+
+  if (now - plannedAt > SCHEDULE_MAX_LATENESS)
+  {
+    DLOG_WARN("Schedule %lu skipped, %lu s late.", schedule.id, now - plannedAt);
+    return false;
+  }
+  DLOG_INFO("Schedule %lu runs for the remote %lu.", schedule.id, schedule.remoteId);
+  Result result = this->m_airtimeScheduler->operateRemote(
+      schedule.remoteId, SCHEDULE_ACTIONS[schedule.action], millis());
+  if (!result.isSuccess)
+  {
+    DLOG_WARN("Schedule %lu failed, result %lu.", schedule.id, result.code);
+  }
+  return true;
+}
+
+/**
+ * @brief Get the time of the next run of a schedule.
+ *
+ * @param id The id of the schedule
+ * @return time_t The time, UTC. 0 if not planned (unknown schedule, clock not set yet, no day
+ * selected or no sunrise at this latitude).
+ */
+time_t Scheduler::getNextRun(const unsigned char id)
+{
+  if (!this->m_isStarted)
+  {
+    return 0;
+  }
+  for (unsigned short i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    if (this->m_schedules[i].id == id)
+    {
+      return this->m_nextRuns[i];
+    }
+  }
+  return 0;
+}
+
+// PRIVATE
+
+void Scheduler::start(const time_t now)
+{
+  this->m_database->getAllSchedules(this->m_schedules);
+  this->m_wheel.reset(now);
+  for (unsigned short i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    this->m_nextRuns[i] = 0;
+    if (this->m_schedules[i].id != 0)
+    {
+      this->plan(i, now);
+    }
+  }
+  this->m_isStarted = true;
+}
+
+void Scheduler::plan(const unsigned short index, const time_t after)
+{
+  const time_t nextRun = this->computeNextRun(this->m_schedules[index], after);
+  this->m_nextRuns[index] = nextRun;
+  if (nextRun != 0)
+  {
+    this->m_wheel.schedule(index, nextRun);
+  }
+}
+
+time_t Scheduler::computeNextRun(const Schedule& schedule, const time_t after)
+{
+  struct tm today;
+  localtime_r(&after, &today);
+  // Today, or one of the next 7 days.
+  for (int offset = 0; offset <= 7; ++offset)
+  {
+    struct tm date = today;
+    date.tm_mday += offset;
+    date.tm_hour = 12;
+    date.tm_min = 0;
+    date.tm_sec = 0;
+    date.tm_isdst = -1;
+    // Normalised date and day of the week.
+    mktime(&date);
+    if ((schedule.days & (1 << date.tm_wday)) == 0)
+    {
+      continue;
+    }
+    time_t run;
+    if (schedule.event == SCHEDULE_AT_TIME)
+    {
+      run = makeLocalTime(date, schedule.minutes);
+    }
+    else if (computeSunEvent(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday,
+                 LOCATION_LATITUDE, LOCATION_LONGITUDE, schedule.event == SCHEDULE_AT_SUNRISE,
+                 run))
+    {
+      run += schedule.minutes * 60;
+    }
+    else
+    {
+      continue;
+    }
+    if (run > after)
+    {
+      return run;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Get the time of a local time of a day. A time skipped by the change to summer time is
+ * taken as winter time (02:30 runs at 03:30). A time repeated by the change to winter time runs
+ * the first time.
+ */
+static time_t makeLocalTime(const struct tm& date, const int minutes)
+{
+  time_t found = 0;
+  time_t skipped = 0;
+  // Summer time first, the earliest of a repeated time.
+  for (int isDst = 1; isDst >= 0; --isDst)
+  {
+    struct tm local = date;
+    local.tm_hour = minutes / 60;
+    local.tm_min = minutes % 60;
+    local.tm_sec = 0;
+    local.tm_isdst = isDst;
+    const time_t time = mktime(&local);
+    if (local.tm_isdst == isDst && local.tm_hour == minutes / 60 && local.tm_min == minutes % 60)
+    {
+      found = time;
+      break;
+    }
+    skipped = time;
+  }
+  return found != 0 ? found : skipped;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+/**
+ * @file staticAssetHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the web server handler for pre-compressed static assets.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <FS.h>
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <staticAssetHandler.h>
+
+#define ASSETS_MANIFEST "/assets.manifest"
+#define CACHE_CONTROL_IMMUTABLE "public, max-age=31536000, immutable"
+#define CACHE_CONTROL_REVALIDATE "no-cache"
+
+StaticAssetHandler::StaticAssetHandler(FS& fs)
+    : m_fs(fs)
+{
+}
+
+/**
+ * @brief Load the manifest of the assets from the filesystem.
+ *
+ * @return true if at least one asset is available
+ * @return false otherwise (the filesystem was built without scripts/build_assets.py)
+ */
+bool StaticAssetHandler::load()
+{
+  LOG_DEBUG("Loading assets manifest...");
+  File manifest = this->m_fs.open(ASSETS_MANIFEST, "r");
+  if (!manifest)
+  {
+    LOG_WARN("No assets manifest found. Assets will be served uncompressed.");
+    return false;
+  }
+  bool isLoaded = this->loadManifest(manifest);
+  manifest.close();
+  return isLoaded;
+}
+
+/**
+ * @brief Load the assets from the lines of a manifest.
+ * A line too long for any asset is skipped whole, its end is not read as another line.
+ *
+ * @param manifest The stream of the manifest
+ * @return true if at least one asset is available
+ * @return false otherwise
+ */
+bool StaticAssetHandler::loadManifest(Stream& manifest)
+{
+  char line[MAX_ASSET_PATH_LENGTH + 16];
+  while (manifest.available())
+  {
+    size_t length = manifest.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[length] = '\0';
+    if (length == sizeof(line) - 1 && manifest.peek() >= 0)
+    {
+      // Stopped by the size of the buffer, before the end of the line.
+      if (manifest.read() != '\n')
+      {
+        while (manifest.available() && manifest.read() != '\n')
+        {
+        }
+        LOG_WARN("Too long asset line ignored:", line);
+        continue;
+      }
+    }
+    if (length > 0 && !this->addAsset(line))
+    {
+      LOG_WARN("Invalid or ignored asset:", line);
+    }
+  }
+
+  LOG_DEBUG("Assets loaded:", this->m_assetsCount);
+  return this->m_assetsCount > 0;
+}
+
+/**
+ * @brief Add an asset from a line of the manifest: "<path> <etag> <immutable>".
+ *
+ * @param line The line to parse
+ * @return true if the asset has been added
+ * @return false if the line is invalid or there is no space left
+ */
+bool StaticAssetHandler::addAsset(const char* line)
+{
+  if (this->m_assetsCount >= MAX_ASSETS)
+  {
+    return false;
+  }
+
+  const char* separator = strchr(line, ' ');
+  if (separator == nullptr || separator == line || line[0] != '/'
+      || (size_t)(separator - line) >= MAX_ASSET_PATH_LENGTH)
+  {
+    return false;
+  }
+  const char* etag = separator + 1;
+  const char* etagEnd = strchr(etag, ' ');
+  if (etagEnd == nullptr || etagEnd - etag != 8)
+  {
+    return false;
+  }
+
+  Asset& asset = this->m_assets[this->m_assetsCount];
+  memcpy(asset.path, line, separator - line);
+  asset.path[separator - line] = '\0';
+  asset.etag[0] = '"';
+  memcpy(asset.etag + 1, etag, 8);
+  asset.etag[9] = '"';
+  asset.etag[10] = '\0';
+  asset.immutable = etagEnd[1] == '1';
+  this->m_assetsCount++;
+  return true;
+}
+
+/**
+ * @brief Find the asset served for an URL. "/" serves "/index.html".
+ *
+ * @param url The path of the request
+ * @return int The index of the asset, -1 if not found
+ */
+int StaticAssetHandler::findAsset(const char* url)
+{
+  if (strcmp(url, "/") == 0)
+  {
+    url = "/index.html";
+  }
+  for (int i = 0; i < this->m_assetsCount; ++i)
+  {
+    if (strcmp(this->m_assets[i].path, url) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool StaticAssetHandler::canHandle(AsyncWebServerRequest* request)
+{
+  if (request->method() != HTTP_GET && request->method() != HTTP_HEAD)
+  {
+    return false;
+  }
+  if (this->findAsset(request->url().c_str()) < 0)
+  {
+    return false;
+  }
+  // Headers not declared here are dropped before handleRequest().
+  request->addInterestingHeader("If-None-Match");
+  return true;
+}
+
+void StaticAssetHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  int index = this->findAsset(request->url().c_str());
+  if (index < 0)
+  {
+    request->send(404);
+    return;
+  }
+  const Asset& asset = this->m_assets[index];
+  const char* cacheControl = asset.immutable ? CACHE_CONTROL_IMMUTABLE : CACHE_CONTROL_REVALIDATE;
+
+  AsyncWebServerResponse* response;
+  if (request->hasHeader("If-None-Match")
+      && strstr(request->getHeader("If-None-Match")->value().c_str(), asset.etag) != nullptr)
+  {
+    response = request->beginResponse(304);
+  }
+  else
+  {
+    // Only "<path>.gz" exists: the response adds "Content-Encoding: gzip" and keeps the content
+    // type of <path>.
+    response = request->beginResponse(this->m_fs, asset.path);
+  }
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", cacheControl);
+  request->send(response);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ * @file sun.cpp
+ * @author Laurette Alexandre
+ * @brief Sunrise and sunset times
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <math.h>
+#include <time.h>
+
+#include <sun.h>
+
+// Official zenith of the sunrise and the sunset, with the refraction of the atmosphere.
+static const double SUN_ZENITH = 90.833;
+static const double DEGREES = M_PI / 180.0;
+
+static double normalize(double value, const double range)
+{
+  value = fmod(value, range);
+  return value < 0 ? value + range : value;
+}
+
+/**
+ * @brief Compute the time of the sunrise or of the sunset of a day, within two minutes.
+ * Algorithm of the Almanac for Computers (US Naval Observatory).
+ *
+ * @param year The year of the day
+ * @param month The month of the day, from 1
+ * @param day The day of the month, from 1
+ * @param latitude The latitude in degrees, north is positive
+ * @param longitude The longitude in degrees, east is positive
+ * @param isSunrise True for the sunrise, false for the sunset
+ * @param time The time of the event, UTC
+ * @return true, if the sun rises (or sets) this day
+ * @return false, otherwise (polar day or night)
+ */
+bool computeSunEvent(const int year, const int month, const int day, const float latitude,
+    const float longitude, const bool isSunrise, time_t& time)
+{
+  const time_t midnight = daysToUtcTime(year, month, day);
+  const int dayOfYear = (midnight - daysToUtcTime(year, 1, 1)) / 86400 + 1;
+  const double longitudeHour = longitude / 15.0;
+  const double t = dayOfYear + ((isSunrise ? 6.0 : 18.0) - longitudeHour) / 24.0;
+
+  const double meanAnomaly = 0.9856 * t - 3.289;
+  const double trueLongitude = normalize(meanAnomaly + 1.916 * sin(meanAnomaly * DEGREES)
+          + 0.020 * sin(2 * meanAnomaly * DEGREES) + 282.634,
+      360.0);
+  double rightAscension
+      = normalize(atan(0.91764 * tan(trueLongitude * DEGREES)) / DEGREES, 360.0);
+  // Same quadrant as the true longitude.
+  rightAscension += floor(trueLongitude / 90.0) * 90.0 - floor(rightAscension / 90.0) * 90.0;
+  rightAscension /= 15.0;
+
+  const double sinDeclination = 0.39782 * sin(trueLongitude * DEGREES);
+  const double cosDeclination = cos(asin(sinDeclination));
+  const double cosHourAngle
+      = (cos(SUN_ZENITH * DEGREES) - sinDeclination * sin(latitude * DEGREES))
+      / (cosDeclination * cos(latitude * DEGREES));
+  if (cosHourAngle > 1.0 || cosHourAngle < -1.0)
+  {
+    return false;
+  }
+  double hourAngle = acos(cosHourAngle) / DEGREES;
+  if (isSunrise)
+  {
+    hourAngle = 360.0 - hourAngle;
+  }
+  const double localTime = hourAngle / 15.0 + rightAscension - 0.06571 * t - 6.622;
+  double hours = normalize(localTime - longitudeHour, 24.0);
+  // The event belongs to the day around its solar noon, it may be the day before in UTC.
+  const double solarNoon = 12.0 - longitudeHour;
+  if (hours - solarNoon > 12.0)
+  {
+    hours -= 24.0;
+  }
+  else if (solarNoon - hours > 12.0)
+  {
+    hours += 24.0;
+  }
+  time = midnight + (time_t)lround(hours * 3600.0);
+  return true;
+}
+
+/**
+ * @brief Get the UTC time of the midnight of a day.
+ *
+ * @param year The year
+ * @param month The month, from 1
+ * @param day The day of the month, from 1
+ * @return time_t
+ */
+time_t daysToUtcTime(const int year, const int month, const int day)
+{
+  // Days from civil, the year starting in March.
+  const int y = month <= 2 ? year - 1 : year;
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const int yearOfEra = y - era * 400;
+  const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  const long days = (long)era * 146097 + dayOfEra - 719468;
+  return (time_t)days * 86400;
+}
\ No newline at end of file
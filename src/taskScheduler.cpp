@@ -0,0 +1,130 @@
+/**
+ * @file taskScheduler.cpp
+ * @author Laurette Alexandre
+ * @brief Cooperative scheduler of the tasks run from loop().
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <trace.h>
+#include <metrics.h>
+#include <deferredLog.h>
+#include <taskScheduler.h>
+
+/**
+ * @brief Add a task, to run from the next loop().
+ *
+ * @param name The name of the task in the metrics. Must stay valid forever (a literal).
+ * @param function The function doing a step of the task
+ * @param period The time between two runs in milliseconds, 0 for every loop, TASK_ON_WAKE to
+ * run only once woken up
+ * @return short The index of the task, -1 if there is no place left
+ */
+short TaskScheduler::add(const char* name, TaskFunction function, const unsigned long period)
+{
+  if (this->m_size >= MAX_TASKS)
+  {
+    DLOG_ERROR("No place left for a task, increase MAX_TASKS.");
+    return -1;
+  }
+  Task& task = this->m_tasks[this->m_size];
+  task.name = name;
+  task.function = function;
+  task.period = period;
+  task.dueAt = 0;
+  task.isQueued = period != TASK_ON_WAKE;
+  task.isStarted = false;
+  return this->m_size++;
+}
+
+/**
+ * @brief Queue a task to run at the next loop(). The time waited is counted from the first
+ * wake up since its last run.
+ *
+ * @param task The index of the task
+ * @param now The current time in milliseconds
+ */
+void TaskScheduler::wake(const short task, const unsigned long now)
+{
+  if (task < 0 || task >= this->m_size)
+  {
+    return;
+  }
+  Task& queued = this->m_tasks[task];
+  if (!queued.isQueued || (long)(queued.dueAt - now) > 0)
+  {
+    queued.dueAt = now;
+    queued.isQueued = true;
+  }
+}
+
+/**
+ * @brief Run the tasks due, each one once at most, in the order they were added.
+ *
+ * @param now The current time in milliseconds
+ */
+void TaskScheduler::loop(const unsigned long now)
+{
+  const unsigned long start = micros();
+  for (unsigned char i = 0; i < this->m_size; ++i)
+  {
+    Task& task = this->m_tasks[i];
+    // A task before may have blocked for a while, the time of this one is taken again.
+    const unsigned long taskNow = now + (micros() - start) / 1000;
+    if (!task.isQueued || (task.isStarted && (long)(taskNow - task.dueAt) < 0))
+    {
+      continue;
+    }
+
+    if (task.period == 0 || (!task.isStarted && task.period != TASK_ON_WAKE))
+    {
+      task.dueAt = taskNow;
+    }
+    task.isStarted = true;
+    const unsigned long latency = taskNow - task.dueAt;
+    if (task.period == 0 || task.period == TASK_ON_WAKE)
+    {
+      // Woken up again if queued during its run.
+      task.isQueued = task.period == 0;
+    }
+    else
+    {
+      // Late runs are not caught up, the task runs again a period after.
+      task.dueAt = latency >= task.period ? taskNow + task.period : task.dueAt + task.period;
+    }
+
+    TRACE_SPAN(task.name);
+    const unsigned long taskStart = micros();
+    task.function(taskNow);
+    metrics.recordTask(i, task.name, micros() - taskStart, latency);
+  }
+}
+
+/**
+ * @brief Get the number of tasks added.
+ *
+ * @return unsigned char The number of tasks
+ */
+unsigned char TaskScheduler::getSize() { return this->m_size; }
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+ * @file timerWheel.cpp
+ * @author Laurette Alexandre
+ * @brief Hierarchical timer wheel
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <timerWheel.h>
+
+TimerWheel::TimerWheel(TimerNode* nodes, const unsigned short capacity)
+    : m_nodes(nodes)
+    , m_capacity(capacity)
+{
+  this->reset(0);
+}
+
+/**
+ * @brief Drop all the timers and set the time.
+ *
+ * @param now The current time in seconds
+ */
+void TimerWheel::reset(const unsigned long now)
+{
+  this->m_time = now;
+  for (unsigned char level = 0; level < LEVELS; ++level)
+  {
+    for (unsigned char slot = 0; slot < SLOTS; ++slot)
+    {
+      this->m_slots[level][slot] = TIMER_NONE;
+    }
+  }
+  this->m_expiredHead = TIMER_NONE;
+  this->m_expiredTail = TIMER_NONE;
+}
+
+/**
+ * @brief Start a timer. It must not be running already.
+ *
+ * @param timer The index of the node of the timer
+ * @param expires The time of expiry in seconds. Expires at the next advance() if already past.
+ */
+void TimerWheel::schedule(const unsigned short timer, const unsigned long expires)
+{
+  if (timer >= this->m_capacity)
+  {
+    return;
+  }
+  this->m_nodes[timer].expires = expires;
+  this->place(timer);
+}
+
+/**
+ * @brief Move the time forward, the timers expiring until then can be taken by popExpired().
+ *
+ * @param now The current time in seconds
+ */
+void TimerWheel::advance(const unsigned long now)
+{
+  while ((long)(now - this->m_time) > 0)
+  {
+    this->m_time++;
+    // Wrap of a level: the next slot of the level above is moved down.
+    for (unsigned char level = 1; level < LEVELS; ++level)
+    {
+      if ((this->m_time & ((1UL << (SLOT_BITS * level)) - 1)) != 0)
+      {
+        break;
+      }
+      this->cascade(level, (this->m_time >> (SLOT_BITS * level)) & (SLOTS - 1));
+    }
+    const unsigned char slot = this->m_time & (SLOTS - 1);
+    unsigned short timer = this->m_slots[0][slot];
+    this->m_slots[0][slot] = TIMER_NONE;
+    while (timer != TIMER_NONE)
+    {
+      const unsigned short next = this->m_nodes[timer].next;
+      this->appendExpired(timer);
+      timer = next;
+    }
+  }
+}
+
+/**
+ * @brief Take the next expired timer, in order of expiry.
+ *
+ * @return int The index of the node of the timer, -1 if none expired
+ */
+int TimerWheel::popExpired()
+{
+  const unsigned short timer = this->m_expiredHead;
+  if (timer == TIMER_NONE)
+  {
+    return -1;
+  }
+  this->m_expiredHead = this->m_nodes[timer].next;
+  if (this->m_expiredHead == TIMER_NONE)
+  {
+    this->m_expiredTail = TIMER_NONE;
+  }
+  return timer;
+}
+
+/**
+ * @brief Get the time the wheel has been advanced to.
+ *
+ * @return unsigned long
+ */
+unsigned long TimerWheel::getTime() { return this->m_time; }
+
+// PRIVATE
+
+void TimerWheel::place(const unsigned short timer)
+{
+  const unsigned long expires = this->m_nodes[timer].expires;
+  const long delta = (long)(expires - this->m_time);
+  if (delta <= 0)
+  {
+    this->appendExpired(timer);
+    return;
+  }
+  unsigned char level = 0;
+  while (level < LEVELS - 1 && (unsigned long)delta >= (1UL << (SLOT_BITS * (level + 1))))
+  {
+    level++;
+  }
+  unsigned long slotTime = expires;
+  if ((unsigned long)delta >= (1UL << (SLOT_BITS * LEVELS)))
+  {
+    // Beyond the wheel: in its last slot, placed again when moved down.
+    slotTime = this->m_time + (1UL << (SLOT_BITS * LEVELS)) - 1;
+  }
+  const unsigned char slot = (slotTime >> (SLOT_BITS * level)) & (SLOTS - 1);
+  this->m_nodes[timer].next = this->m_slots[level][slot];
+  this->m_slots[level][slot] = timer;
+}
+
+void TimerWheel::cascade(const unsigned char level, const unsigned char slot)
+{
+  unsigned short timer = this->m_slots[level][slot];
+  this->m_slots[level][slot] = TIMER_NONE;
+  while (timer != TIMER_NONE)
+  {
+    const unsigned short next = this->m_nodes[timer].next;
+    this->place(timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::appendExpired(const unsigned short timer)
+{
+  this->m_nodes[timer].next = TIMER_NONE;
+  if (this->m_expiredTail == TIMER_NONE)
+  {
+    this->m_expiredHead = timer;
+  }
+  else
+  {
+    this->m_nodes[this->m_expiredTail].next = timer;
+  }
+  this->m_expiredTail = timer;
+}
\ No newline at end of file
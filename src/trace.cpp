@@ -0,0 +1,124 @@
+/**
+ * @file trace.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the trace spans of the hot paths.
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <config.h>
+#include <trace.h>
+
+#ifdef SOMFY_TRACE
+TraceBuffer traces;
+#endif
+
+/**
+ * @brief Write a number of CPU cycles as microseconds, with a nanosecond precision.
+ */
+static void formatMicroseconds(char* buffer, const size_t size, const uint32_t cycles)
+{
+  const uint64_t nanoseconds = (uint64_t)cycles * 1000 / ESP.getCpuFreqMHz();
+  snprintf(buffer, size, "%lu.%03lu", (unsigned long)(nanoseconds / 1000),
+      (unsigned long)(nanoseconds % 1000));
+}
+
+/**
+ * @brief Record a span. The oldest span is dropped when the buffer is full.
+ *
+ * @param name The name of the span. Must stay valid forever (a literal).
+ * @param start The cycle counter at the beginning of the span
+ * @param end The cycle counter at the end of the span
+ */
+void TraceBuffer::record(const char* name, const uint32_t start, const uint32_t end)
+{
+  this->m_events[this->m_recorded % TRACE_BUFFER_SIZE] = { name, start, end - start };
+  this->m_recorded++;
+  if (this->m_size < TRACE_BUFFER_SIZE)
+  {
+    this->m_size++;
+  }
+}
+
+/**
+ * @brief Drop all the spans.
+ */
+void TraceBuffer::clear()
+{
+  this->m_size = 0;
+}
+
+/**
+ * @brief Get the number of spans kept.
+ *
+ * @return unsigned short
+ */
+unsigned short TraceBuffer::getSize() { return this->m_size; }
+
+/**
+ * @brief Render the next line of the spans in the Chrome trace event format, oldest first.
+ * Only the spans kept when the rendering started are rendered, each one once, the spans dropped
+ * meanwhile are skipped. Each event starts with its separator to keep a valid JSON.
+ *
+ * @param cursor The position of the rendering, starts zeroed
+ * @param buffer The buffer receiving the line
+ * @param size The size of the buffer
+ * @return size_t The length of the line, 0 when everything has been rendered
+ */
+size_t TraceBuffer::renderLine(RenderCursor& cursor, char* buffer, const size_t size)
+{
+  if (cursor.section > 0)
+  {
+    return 0;
+  }
+  if (cursor.item == 0)
+  {
+    cursor.end = this->m_recorded;
+    cursor.next = this->m_recorded - this->m_size;
+    cursor.item++;
+    return snprintf(buffer, size, "{\"traceEvents\":[\n");
+  }
+  if (this->m_recorded - cursor.next > this->m_size)
+  {
+    cursor.next = this->m_recorded - this->m_size;
+  }
+  if (cursor.next >= cursor.end)
+  {
+    cursor.section++;
+    return snprintf(buffer, size, "],\"displayTimeUnit\":\"ms\"}\n");
+  }
+
+  const TraceEvent& event = this->m_events[cursor.next % TRACE_BUFFER_SIZE];
+  cursor.next++;
+  char start[24];
+  char duration[24];
+  formatMicroseconds(start, sizeof(start), event.start);
+  formatMicroseconds(duration, sizeof(duration), event.duration);
+  const char* separator = cursor.item == 1 ? "" : ",";
+  cursor.item++;
+  size_t length = snprintf(buffer, size,
+      "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%s,\"dur\":%s,\"pid\":1,\"tid\":1}\n", separator,
+      event.name, start, duration);
+  return length < size ? length : size - 1;
+}
\ No newline at end of file
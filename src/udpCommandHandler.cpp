@@ -0,0 +1,330 @@
+/**
+ * @file udpCommandHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Compact UDP protocol to operate the remotes
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <bearssl/bearssl_hmac.h>
+
+#include <config.h>
+#include <result.h>
+#include <trace.h>
+#include <controller.h>
+#include <databaseAbs.h>
+#include <deferredLog.h>
+#include <udpCommandHandler.h>
+
+static unsigned long readUnsignedLong(const uint8_t* buffer)
+{
+  return (unsigned long)buffer[0] << 24 | (unsigned long)buffer[1] << 16
+      | (unsigned long)buffer[2] << 8 | buffer[3];
+}
+
+static void writeUnsignedLong(uint8_t* buffer, const unsigned long value)
+{
+  buffer[0] = value >> 24;
+  buffer[1] = value >> 16;
+  buffer[2] = value >> 8;
+  buffer[3] = value;
+}
+
+UdpCommandHandler::UdpCommandHandler(
+    Controller* controller, DatabaseAbstract* database, const char* key)
+    : m_controller(controller)
+    , m_database(database)
+    , m_key(key)
+{
+}
+
+/**
+ * @brief Operate a command received by UDP.
+ *
+ * @param packet The content of the datagram
+ * @param length The length of the datagram
+ * @param ack The buffer receiving the ack to send back
+ * @param ackLength The length of the ack, 0 if nothing should be sent back
+ * @return Result The result of the command, without data
+ */
+Result UdpCommandHandler::handle(const uint8_t* packet, const size_t length,
+    uint8_t ack[UDP_MAX_ACK_SIZE], size_t& ackLength)
+{
+  TRACE_SPAN("udp.handle");
+  Result result;
+  result.code = RESULT_PACKET_INVALID;
+  ackLength = 0;
+  if (length < UDP_HEADER_SIZE || packet[0] != UDP_MAGIC || (packet[1] & UDP_FLAG_ACK))
+  {
+    // Not for us, not even acked.
+    DLOG_WARN("Unknown UDP packet of %lu bytes dropped.", length);
+    return result;
+  }
+
+  const unsigned char flags = packet[1];
+  const unsigned long remoteId = readUnsignedLong(packet + 2);
+  const bool hasNonce = flags & UDP_FLAG_NONCE;
+  const size_t signedLength = UDP_HEADER_SIZE + (hasNonce ? UDP_NONCE_SIZE : 0);
+  const size_t expectedLength = signedLength + (flags & UDP_FLAG_HMAC ? UDP_HMAC_SIZE : 0);
+  unsigned long nonce = hasNonce && length >= signedLength
+      ? readUnsignedLong(packet + UDP_HEADER_SIZE)
+      : 0;
+
+  if (length != expectedLength)
+  {
+    DLOG_WARN("UDP command of %lu bytes instead of %lu.", length, expectedLength);
+  }
+  else if (!this->isAuthentic(packet, signedLength, flags & UDP_FLAG_HMAC))
+  {
+    DLOG_WARN("UDP command for the remote %lu with a wrong signature.", remoteId);
+    result.code = RESULT_PACKET_UNAUTHORIZED;
+  }
+  else if (this->m_key[0] != '\0')
+  {
+    result = this->operateSigned(remoteId, packet[6], hasNonce, nonce);
+  }
+  else
+  {
+    result = this->operateOnce(remoteId, packet[6], hasNonce, nonce);
+  }
+
+  ack[0] = UDP_MAGIC;
+  ack[1] = (flags & UDP_FLAG_NONCE) | UDP_FLAG_ACK;
+  writeUnsignedLong(ack + 2, remoteId);
+  ack[6] = result.code;
+  ackLength = UDP_HEADER_SIZE;
+  if (hasNonce)
+  {
+    writeUnsignedLong(ack + UDP_HEADER_SIZE, nonce);
+    ackLength += UDP_NONCE_SIZE;
+  }
+  return result;
+}
+
+/**
+ * @brief Compute the signature of a command with the key of the handler.
+ *
+ * @param data The bytes to sign
+ * @param length The number of bytes to sign
+ * @param hmac The buffer receiving the truncated HMAC-SHA256
+ */
+void UdpCommandHandler::sign(const uint8_t* data, const size_t length,
+    uint8_t hmac[UDP_HMAC_SIZE])
+{
+  br_hmac_key_context keyContext;
+  br_hmac_context context;
+  uint8_t digest[32];
+  br_hmac_key_init(&keyContext, &br_sha256_vtable, this->m_key, strlen(this->m_key));
+  br_hmac_init(&context, &keyContext, 0);
+  br_hmac_update(&context, data, length);
+  br_hmac_out(&context, digest);
+  memcpy(hmac, digest, UDP_HMAC_SIZE);
+}
+
+// PRIVATE
+
+bool UdpCommandHandler::isAuthentic(const uint8_t* packet, const size_t signedLength,
+    const bool isSigned)
+{
+  const bool hasKey = this->m_key[0] != '\0';
+  if (!hasKey || !isSigned)
+  {
+    // A signature cannot be checked without key.
+    return !hasKey && !isSigned;
+  }
+  uint8_t hmac[UDP_HMAC_SIZE];
+  this->sign(packet, signedLength, hmac);
+  // Compared in constant time, the position of the first wrong byte is not leaked.
+  uint8_t difference = 0;
+  for (unsigned char i = 0; i < UDP_HMAC_SIZE; ++i)
+  {
+    difference |= hmac[i] ^ packet[signedLength + i];
+  }
+  return difference == 0;
+}
+
+Result UdpCommandHandler::operate(const unsigned long remoteId, const unsigned char action)
+{
+  static const char* const ACTIONS[] = { "up", "stop", "down", "pair", "reset" };
+  if (action < UDP_ACTION_UP || action > UDP_ACTION_RESET)
+  {
+    Result result;
+    result.code = RESULT_ACTION_INVALID;
+    return result;
+  }
+  return this->m_controller->operateRemote(remoteId, ACTIONS[action - UDP_ACTION_UP]);
+}
+
+Result UdpCommandHandler::operateOnce(const unsigned long remoteId, const unsigned char action,
+    const bool hasNonce, const unsigned long nonce)
+{
+  short handled = hasNonce ? this->findHandled(remoteId, nonce) : -1;
+  if (handled >= 0)
+  {
+    DLOG_DEBUG("UDP command %lu for the remote %lu already handled.", nonce, remoteId);
+    Result result;
+    result.code = this->m_handled[handled].code;
+    result.isSuccess = this->m_handled[handled].isSuccess;
+    return result;
+  }
+  Result result = this->operate(remoteId, action);
+  if (hasNonce)
+  {
+    this->remember(remoteId, nonce, result);
+  }
+  return result;
+}
+
+Result UdpCommandHandler::operateSigned(const unsigned long remoteId, const unsigned char action,
+    const bool hasNonce, unsigned long& nonce)
+{
+  Result result;
+  const short index = this->loadAccepted(remoteId);
+  AcceptedNonce* accepted = index < 0 ? nullptr : &this->m_accepted[index];
+  // The mark read from the database may have been accepted, unless none was ever saved.
+  if (!hasNonce
+      || (accepted != nullptr
+          && (nonce < accepted->nonce
+              || (nonce == accepted->nonce && !accepted->isSent && accepted->reserved != 0))))
+  {
+    DLOG_WARN("UDP command %lu for the remote %lu replayed or without nonce.", nonce, remoteId);
+    result.code = RESULT_PACKET_REPLAYED;
+    if (accepted != nullptr)
+    {
+      nonce = accepted->nonce;
+    }
+    return result;
+  }
+  if (accepted != nullptr && accepted->isSent && nonce == accepted->nonce)
+  {
+    DLOG_DEBUG("UDP command %lu for the remote %lu already handled.", nonce, remoteId);
+    result.code = accepted->code;
+    result.isSuccess = true;
+    return result;
+  }
+  if (accepted != nullptr && nonce > accepted->reserved)
+  {
+    // Written before the command is sent, a restart right after it cannot let it be replayed.
+    // A block of nonces is reserved at once to spare the flash.
+    const unsigned long reserved
+        = nonce <= 0xFFFFFFFF - UDP_NONCE_BLOCK ? nonce + UDP_NONCE_BLOCK : 0xFFFFFFFF;
+    if (!this->m_database->setNonceMark(remoteId, reserved))
+    {
+      DLOG_ERROR("Nonce of the remote %lu not saved, UDP command refused.", remoteId);
+      result.code = RESULT_REMOTE_UPDATE_FAILED;
+      return result;
+    }
+    accepted->reserved = reserved;
+  }
+  result = this->operate(remoteId, action);
+  // A failed command did nothing, its replay does nothing either.
+  if (result.isSuccess && accepted != nullptr)
+  {
+    accepted->nonce = nonce;
+    accepted->code = result.code;
+    accepted->isSent = true;
+    accepted->acceptedAt = ++this->m_acceptedCount;
+  }
+  return result;
+}
+
+short UdpCommandHandler::findAccepted(const unsigned long remoteId)
+{
+  for (unsigned char i = 0; i < this->m_acceptedSize; ++i)
+  {
+    if (this->m_accepted[i].remoteId == remoteId)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Find the nonces of a remote, read from the database the first time.
+ *
+ * @return short The index of the nonces, -1 if the remote does not exist
+ */
+short UdpCommandHandler::loadAccepted(const unsigned long remoteId)
+{
+  short index = this->findAccepted(remoteId);
+  unsigned long mark = 0;
+  if (index >= 0 || !this->m_database->getNonceMark(remoteId, mark))
+  {
+    return index;
+  }
+  if (this->m_acceptedSize < MAX_REMOTES)
+  {
+    index = this->m_acceptedSize++;
+  }
+  else
+  {
+    // A full table has a deleted remote: the one accepted the longest ago is the likeliest. Its
+    // mark stays in the database anyway.
+    index = 0;
+    for (unsigned char i = 1; i < this->m_acceptedSize; ++i)
+    {
+      if (this->m_accepted[i].acceptedAt < this->m_accepted[index].acceptedAt)
+      {
+        index = i;
+      }
+    }
+  }
+  AcceptedNonce& accepted = this->m_accepted[index];
+  accepted.remoteId = remoteId;
+  // The commands up to the mark may have been accepted, before the restart too.
+  accepted.nonce = mark;
+  accepted.code = RESULT_PACKET_REPLAYED;
+  accepted.isSent = false;
+  accepted.reserved = mark;
+  accepted.acceptedAt = ++this->m_acceptedCount;
+  return index;
+}
+
+short UdpCommandHandler::findHandled(const unsigned long remoteId, const unsigned long nonce)
+{
+  for (unsigned char i = 0; i < this->m_handledSize; ++i)
+  {
+    if (this->m_handled[i].remoteId == remoteId && this->m_handled[i].nonce == nonce)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void UdpCommandHandler::remember(const unsigned long remoteId, const unsigned long nonce,
+    const Result& result)
+{
+  HandledCommand& handled = this->m_handled[this->m_handledNext];
+  handled.remoteId = remoteId;
+  handled.nonce = nonce;
+  handled.code = result.code;
+  handled.isSuccess = result.isSuccess;
+  this->m_handledNext = (this->m_handledNext + 1) % UDP_DEDUPE_SIZE;
+  if (this->m_handledSize < UDP_DEDUPE_SIZE)
+  {
+    this->m_handledSize++;
+  }
+}
\ No newline at end of file
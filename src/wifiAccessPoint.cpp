@@ -46,6 +46,14 @@ void WifiAccessPoint::startAccessPoint(const char* ssid, const char* password)
   }
 };
 
+void WifiAccessPoint::stopAccessPoint()
+{
+  LOG_DEBUG("Closing Access Point...");
+  WiFi.softAPdisconnect(true);
+};
+
+bool WifiAccessPoint::isRunning() { return (WiFi.getMode() & WIFI_AP) != 0; };
+
 String WifiAccessPoint::getIP() {
   return WiFi.softAPIP().toString();
 };
\ No newline at end of file
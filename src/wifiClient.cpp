@@ -33,55 +33,100 @@
 #include <wifiClient.h>
 
 /**
- * @brief Connect this device to a network
- *
- * @param conf The NetworkConfiguration to use
- * @return true, if the device is connected to the network
- * @return false, otherwise
+ * @brief Prepare the station interface, before any connection.
+ * The SDK neither saves the configuration to flash, the database keeps the credentials, nor
+ * reconnects by itself, the WifiSupervisor does.
  */
-bool WifiClient::connect(const NetworkConfiguration& conf)
+void WifiClient::init()
 {
-  return this->connect(conf.ssid, conf.password);
-}
+  WiFi.persistent(false);
+  WiFi.setAutoReconnect(false);
+};
 
 /**
- * @brief Connect this device to a network
+ * @brief Start the connection to a network, without waiting for it.
+ * Poll isConnected() to know when the device is connected.
+ * With hints, the access point is joined directly on its channel, without scanning.
  *
- * @param ssid The SSID of the network to connect to
- * @param password The password of the network
- * @return true, if the device is connected to the network
+ * @param conf The NetworkConfiguration to use
+ * @param hints The NetworkHints of the last connection, NULL to scan for the network
+ * @return true, if the connection has started
  * @return false, otherwise
  */
-bool WifiClient::connect(const char* ssid, const char* password)
+bool WifiClient::beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints)
 {
-  LOG_DEBUG("Trying to connect to the WiFi...");
-  LOG_DEBUG("SSID provided: ", ssid);
-  LOG_DEBUG("Password provided: ", password);
-
-  WiFi.begin(ssid, password);
-
-  while (WiFi.status() != WL_CONNECTED && millis() < 15000)
+  LOG_DEBUG("Starting the connection to the WiFi...");
+  LOG_DEBUG("SSID provided: ", conf.ssid);
+  if (hints != NULL && hints->ip != 0)
   {
-    digitalWrite(LED_BUILTIN, LOW);
-    delay(250);
-    digitalWrite(LED_BUILTIN, HIGH);
-    delay(250);
-    LOG_DEBUG(".");
+    WiFi.config(IPAddress(hints->ip), IPAddress(hints->gateway), IPAddress(hints->subnet),
+        IPAddress(hints->dns));
   }
-
-  if (WiFi.status() == WL_CONNECTED)
+  else
   {
-    LOG_INFO("WiFi connected.");
-    return true;
+    // Back to DHCP.
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
   }
-  else
+  if (hints == NULL)
+  {
+    return WiFi.begin(conf.ssid, conf.password) != WL_CONNECT_FAILED;
+  }
+  LOG_DEBUG("Channel provided: ", hints->channel);
+  return WiFi.begin(conf.ssid, conf.password, hints->channel, hints->bssid) != WL_CONNECT_FAILED;
+};
+
+/**
+ * @brief Get the access point and the addresses of the current connection.
+ *
+ * @param hints The NetworkHints to fill
+ * @return true, if connected
+ * @return false, otherwise
+ */
+bool WifiClient::getConnectionHints(NetworkHints& hints)
+{
+  if (!this->isConnected())
   {
-    LOG_ERROR("Failed to connect to the Wifi. Canceling...");
-    WiFi.disconnect();
     return false;
   }
+  WifiClient::fillHints(hints, WiFi.SSID().c_str(), WiFi.BSSID(), WiFi.channel(), WiFi.localIP(),
+      WiFi.gatewayIP(), WiFi.subnetMask(), WiFi.dnsIP());
+  return true;
+};
+
+/**
+ * @brief Fill hints from the state of the station interface.
+ * The SSID is truncated to the size of the hints, the hints are only used for the network they
+ * were saved with.
+ *
+ * @param hints The NetworkHints to fill
+ * @param ssid The SSID of the network joined
+ * @param bssid The 6 bytes of the MAC address of the access point
+ * @param channel The channel of the access point
+ * @param ip The IP address of the device
+ * @param gateway The IP address of the gateway
+ * @param subnet The subnet mask
+ * @param dns The IP address of the DNS server
+ */
+void WifiClient::fillHints(NetworkHints& hints, const char* ssid, const unsigned char* bssid,
+    const unsigned char channel, const unsigned long ip, const unsigned long gateway,
+    const unsigned long subnet, const unsigned long dns)
+{
+  // Zeroed padding too, hints are compared byte by byte before being saved.
+  memset(&hints, 0, sizeof(NetworkHints));
+  strncpy(hints.ssid, ssid, sizeof(hints.ssid) - 1);
+  memcpy(hints.bssid, bssid, sizeof(hints.bssid));
+  hints.channel = channel;
+  hints.ip = ip;
+  hints.gateway = gateway;
+  hints.subnet = subnet;
+  hints.dns = dns;
 };
 
+/**
+ * @brief Stop the connection to the network, or the attempt to connect.
+ */
+void WifiClient::disconnect() { WiFi.disconnect(); };
+
 /**
  * @brief Get the IP Address of this device
  *
@@ -98,34 +143,67 @@ String WifiClient::getIP() { return WiFi.localIP().toString(); };
 bool WifiClient::isConnected() { return (WiFi.status() == WL_CONNECTED); };
 
 /**
- * @brief Return the list of Network found
+ * @brief Start an asynchronous scan of the networks.
+ * The station interface is enabled if needed, the current connection and the access point are
+ * kept.
  *
- * @param networks Array of Networks.
+ * @return true if the scan is running
+ * @return false otherwise
  */
-void WifiClient::getNetworks(Network networks[])
+bool WifiClient::startScan()
 {
-  WiFi.mode(WIFI_STA);
-  WiFi.disconnect();
-  delay(100);
-
-  int count = WiFi.scanNetworks(false);
-  if (count == 0)
+  if (WiFi.scanComplete() == WIFI_SCAN_RUNNING)
   {
-    LOG_WARN("No Wifi Networks detected.");
+    return true;
   }
-  else
+  WiFiMode_t mode = WiFi.getMode();
+  if (mode == WIFI_OFF)
+  {
+    WiFi.mode(WIFI_STA);
+  }
+  else if (mode == WIFI_AP)
   {
-    for (int i = 0; i < count && i < MAX_NETWORK_SCAN; ++i)
-    {
-      // Get SSID and RSSI for each network found
-      strcpy(networks[i].SSID, WiFi.SSID(i).c_str());
-      networks[i].RSSI = WiFi.RSSI(i); // Signal strength in dBm
-    }
+    WiFi.mode(WIFI_AP_STA);
+  }
+  return WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING;
+};
 
-    for (int i = count; i < MAX_NETWORK_SCAN; ++i)
-    {
-      strcpy(networks[i].SSID, "");
-      networks[i].RSSI = -255;
-    }
+/**
+ * @brief Get the status of the last scan.
+ *
+ * @return int NETWORK_SCAN_RUNNING, NETWORK_SCAN_FAILED or the number of networks found
+ */
+int WifiClient::getScanStatus()
+{
+  int status = WiFi.scanComplete();
+  if (status == WIFI_SCAN_RUNNING)
+  {
+    return NETWORK_SCAN_RUNNING;
   }
+  return status < 0 ? NETWORK_SCAN_FAILED : status;
 };
+
+/**
+ * @brief Get a network found by the last scan.
+ *
+ * @param index The index of the network in the scan results
+ * @param network The Network to fill
+ * @return true if the network exists
+ * @return false otherwise
+ */
+bool WifiClient::getScanResult(const int index, Network& network)
+{
+  if (index < 0 || index >= WiFi.scanComplete())
+  {
+    return false;
+  }
+  strncpy(network.SSID, WiFi.SSID(index).c_str(), sizeof(network.SSID) - 1);
+  network.SSID[sizeof(network.SSID) - 1] = '\0';
+  network.RSSI = WiFi.RSSI(index); // Signal strength in dBm
+  return true;
+};
+
+/**
+ * @brief Free the results of the last scan.
+ */
+void WifiClient::deleteScanResults() { WiFi.scanDelete(); };
\ No newline at end of file
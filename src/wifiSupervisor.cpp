@@ -0,0 +1,188 @@
+/**
+ * @file wifiSupervisor.cpp
+ * @author Laurette Alexandre
+ * @brief Supervision of the WiFi connection once booted
+ * @version 2.0.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2024 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <networks.h>
+#include <deferredLog.h>
+#include <wifiSupervisor.h>
+#include <accessPointAbs.h>
+#include <networkConnector.h>
+#include <networkClientAbs.h>
+
+WifiSupervisor::WifiSupervisor(NetworkConnector* networkConnector,
+    NetworkClientAbstract* networkClient, AccessPointAbstract* accessPoint)
+    : m_networkConnector(networkConnector)
+    , m_networkClient(networkClient)
+    , m_accessPoint(accessPoint)
+{
+}
+
+/**
+ * @brief Check the connection and retry it when lost. To call from the main loop, once booted.
+ *
+ * @param now The current time in milliseconds
+ */
+void WifiSupervisor::loop(const unsigned long now)
+{
+  switch (this->m_state)
+  {
+  case LINK_IDLE:
+    this->start(now);
+    break;
+  case LINK_UP:
+    if (!this->m_networkClient->isConnected())
+    {
+      this->linkLost(now);
+    }
+    break;
+  case LINK_DOWN:
+    if (this->m_networkClient->isConnected())
+    {
+      this->linkRecovered(now);
+      break;
+    }
+    if (now - this->m_outageStartedAt >= WIFI_OUTAGE_AP_DELAY
+        && !this->m_accessPoint->isRunning())
+    {
+      LOG_WARN("No WiFi for too long. Configuring access point (AP)...");
+      this->m_accessPoint->startAccessPoint(AP_SSID, AP_PASSWORD);
+      LOG_INFO("AP IP address:", this->m_accessPoint->getIP());
+    }
+    // Connection to the strongest network, once the scan started by the attempt is done.
+    this->m_networkConnector->loop(now);
+    if ((long)(now - this->m_nextAttemptAt) >= 0)
+    {
+      this->reconnect(now);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Forget the state of the connection, the next loop() checks it again from scratch.
+ * Used while the configuration of the WiFi is changed by someone else.
+ */
+void WifiSupervisor::reset() { this->m_state = LINK_IDLE; }
+
+/**
+ * @brief Get the state of the connection.
+ *
+ * @return LinkState
+ */
+LinkState WifiSupervisor::getState() { return this->m_state; }
+
+/**
+ * @brief Get the number of reconnections attempted since the connection was lost.
+ *
+ * @return unsigned char
+ */
+unsigned char WifiSupervisor::getAttempts() { return this->m_attempts; }
+
+// PRIVATE
+
+void WifiSupervisor::start(const unsigned long now)
+{
+  if (this->m_networkConnector->loadConfigurations() == 0)
+  {
+    this->m_state = LINK_DISABLED;
+    return;
+  }
+  if (this->m_networkClient->isConnected())
+  {
+    this->m_state = LINK_UP;
+    return;
+  }
+  // The boot did not manage to connect, keep trying in background.
+  this->m_state = LINK_DOWN;
+  this->m_outageStartedAt = now;
+  this->m_attempts = 0;
+  this->m_nextAttemptAt = now + this->nextDelay();
+}
+
+void WifiSupervisor::linkLost(const unsigned long now)
+{
+  DLOG_WARN("WiFi connection lost.");
+  metrics.recordWifiDisconnect();
+  this->m_state = LINK_DOWN;
+  this->m_outageStartedAt = now;
+  this->m_attempts = 0;
+  // The WiFi stack retries on its own first, the first attempt is delayed too.
+  this->m_nextAttemptAt = now + this->nextDelay();
+}
+
+void WifiSupervisor::linkRecovered(const unsigned long now)
+{
+  DLOG_INFO("WiFi connection back after %lu ms and %lu attempts.", now - this->m_outageStartedAt,
+      this->m_attempts);
+  metrics.recordWifiOutage(now - this->m_outageStartedAt);
+  this->m_state = LINK_UP;
+  this->m_attempts = 0;
+  this->m_networkConnector->saveHints();
+  if (this->m_accessPoint->isRunning())
+  {
+    LOG_INFO("Closing the fallback access point (AP)...");
+    this->m_accessPoint->stopAccessPoint();
+  }
+}
+
+void WifiSupervisor::reconnect(const unsigned long now)
+{
+  DLOG_INFO("Reconnecting to the WiFi, attempt %lu.", this->m_attempts + 1);
+  metrics.recordWifiReconnectAttempt();
+  // No disconnection first: starting the connection again drops the attempt in progress.
+  // Hints only on the first attempt, the access point may have moved to another channel.
+  this->m_networkConnector->connect(now, this->m_attempts == 0);
+  if (this->m_attempts < 255)
+  {
+    this->m_attempts++;
+  }
+  this->m_nextAttemptAt = now + this->nextDelay();
+}
+
+/**
+ * @brief Delay before the next attempt: doubled at each attempt up to the maximum, then drawn
+ * between its half and its whole.
+ */
+unsigned long WifiSupervisor::nextDelay()
+{
+  unsigned long delay = WIFI_RECONNECT_MIN_DELAY;
+  for (unsigned char i = 0; i < this->m_attempts && delay < WIFI_RECONNECT_MAX_DELAY; ++i)
+  {
+    delay *= 2;
+  }
+  if (delay > WIFI_RECONNECT_MAX_DELAY)
+  {
+    delay = WIFI_RECONNECT_MAX_DELAY;
+  }
+  return delay / 2 + random(delay / 2 + 1);
+}
\ No newline at end of file
@@ -5,6 +5,32 @@
 #include "./test_eepromDatabase.h"
 #include "./test_RTSTransmitter.h"
 #include "./test_controller.h"
+#include "./test_changeLog.h"
+#include "./test_router.h"
+#include "./test_staticAssetHandler.h"
+#include "./test_admissionController.h"
+#include "./test_networkScanner.h"
+#include "./test_metrics.h"
+#include "./test_trace.h"
+#include "./test_deferredLog.h"
+#include "./test_bootSequence.h"
+#include "./test_wifiSupervisor.h"
+#include "./test_networkConnector.h"
+#include "./test_networkSwitchover.h"
+#include "./test_udpCommandHandler.h"
+#include "./test_eventBus.h"
+#include "./test_mqttBridge.h"
+#include "./test_timerWheel.h"
+#include "./test_scheduler.h"
+#include "./test_positionTracker.h"
+#include "./test_sceneRunner.h"
+#include "./test_macroRunner.h"
+#include "./test_commandDeduplicator.h"
+#include "./test_airtimeBudget.h"
+#include "./test_airtimeScheduler.h"
+#include "./test_taskScheduler.h"
+#include "./test_commandQueue.h"
+#include "./test_wifiClient.h"
 
 void setUp(void)
 {
@@ -19,11 +45,56 @@ void tearDown(void)
   FakeDatabase::shouldReturnEmptyRemote = false;
   FakeDatabase::shouldFailCreateRemote = false;
   FakeDatabase::shouldFailUpdateNetworkConfiguration = false;
+  FakeDatabase::shouldReturnEmptyNetworkConfiguration = false;
+  FakeDatabase::hasSeveralNetworkConfigurations = false;
+  FakeDatabase::hasNetworkHints = false;
+  FakeDatabase::setNetworkHintsCalled = false;
+  FakeDatabase::setNetworkConfigurationsCalled = false;
+  memset(&FakeDatabase::savedHints, 0, sizeof(NetworkHints));
+  memset(FakeDatabase::schedules, 0, sizeof(FakeDatabase::schedules));
+  FakeDatabase::calibration = { 0, 0 };
+  memset(FakeDatabase::nonceMarks, 0, sizeof(FakeDatabase::nonceMarks));
+  FakeDatabase::nonceMarkWrites = 0;
+  memset(FakeDatabase::groups, 0, sizeof(FakeDatabase::groups));
+  memset(FakeDatabase::scenes, 0, sizeof(FakeDatabase::scenes));
+  memset(FakeDatabase::macros, 0, sizeof(FakeDatabase::macros));
+  FakeDatabase::isBatching = false;
+  FakeDatabase::batchCount = 0;
 
   FakeTransmitter::sendUPCommandCalled = false;
   FakeTransmitter::sendSTOPCommandCalled = false;
   FakeTransmitter::sendDOWNCommandCalled = false;
   FakeTransmitter::sendPROGCommandCalled = false;
+
+  FakeNetworkClient::isConnectedToNetwork = true;
+  FakeNetworkClient::beginConnectCalled = false;
+  FakeNetworkClient::beginConnectWithHints = false;
+  FakeNetworkClient::beginConnectCount = 0;
+  FakeNetworkClient::connectedSsid[0] = '\0';
+  FakeNetworkClient::reportsSsid = true;
+  FakeNetworkClient::disconnectCalled = false;
+  FakeNetworkClient::shouldFailStartScan = false;
+  FakeNetworkClient::startScanCalled = false;
+  FakeNetworkClient::scanStatus = NETWORK_SCAN_FAILED;
+
+  FakeAccessPoint::startAccessPointCalled = false;
+  FakeAccessPoint::stopAccessPointCalled = false;
+  FakeAccessPoint::running = false;
+
+  FakeNetworkSwitchover::isRunning = false;
+  FakeNetworkSwitchover::beginCalled = false;
+
+  FakeEventPublisher::publishCount = 0;
+  FakeEventPublisher::lastType = EVENT_REMOTE_CREATED;
+
+  FakeMqttClient::connected = false;
+  FakeMqttClient::beginConnectCount = 0;
+  FakeMqttClient::subscribedTopic[0] = '\0';
+  FakeMqttClient::publishCount = 0;
+  FakeMqttClient::acceptedPublishes = -1;
+  FakeMqttClient::lastTopic[0] = '\0';
+  FakeMqttClient::lastPayload[0] = '\0';
+  FakeMqttClient::lastRetain = false;
 }
 
 void RUN_UNITY_TESTS()
@@ -37,6 +108,58 @@ void RUN_UNITY_TESTS()
   RUN_CONTROLLER_TESTS();
   // RTS Transmitter tests
   RUN_RTSTRANSMITTER_TESTS();
+  // ChangeLog tests
+  RUN_CHANGELOG_TESTS();
+  // Router tests
+  RUN_ROUTER_TESTS();
+  // StaticAssetHandler tests
+  RUN_STATICASSETHANDLER_TESTS();
+  // AdmissionController tests
+  RUN_ADMISSIONCONTROLLER_TESTS();
+  // NetworkScanner tests
+  RUN_NETWORKSCANNER_TESTS();
+  // Metrics tests
+  RUN_METRICS_TESTS();
+  // Trace tests
+  RUN_TRACE_TESTS();
+  // DeferredLog tests
+  RUN_DEFERREDLOG_TESTS();
+  // BootSequence tests
+  RUN_BOOTSEQUENCE_TESTS();
+  // WifiSupervisor tests
+  RUN_WIFISUPERVISOR_TESTS();
+  // NetworkConnector tests
+  RUN_NETWORKCONNECTOR_TESTS();
+  // NetworkSwitchover tests
+  RUN_NETWORKSWITCHOVER_TESTS();
+  // UdpCommandHandler tests
+  RUN_UDPCOMMANDHANDLER_TESTS();
+  // EventBus tests
+  RUN_EVENTBUS_TESTS();
+  // MqttBridge tests
+  RUN_MQTTBRIDGE_TESTS();
+  // TimerWheel tests
+  RUN_TIMERWHEEL_TESTS();
+  // Scheduler tests
+  RUN_SCHEDULER_TESTS();
+  // PositionTracker tests
+  RUN_POSITIONTRACKER_TESTS();
+  // SceneRunner tests
+  RUN_SCENERUNNER_TESTS();
+  // MacroRunner tests
+  RUN_MACRORUNNER_TESTS();
+  // CommandDeduplicator tests
+  RUN_COMMANDDEDUPLICATOR_TESTS();
+  // AirtimeBudget tests
+  RUN_AIRTIMEBUDGET_TESTS();
+  // AirtimeScheduler tests
+  RUN_AIRTIMESCHEDULER_TESTS();
+  // TaskScheduler tests
+  RUN_TASKSCHEDULER_TESTS();
+  // CommandQueue tests
+  RUN_COMMANDQUEUE_TESTS();
+  // WifiClient tests
+  RUN_WIFICLIENT_TESTS();
   UNITY_END();
 }
 
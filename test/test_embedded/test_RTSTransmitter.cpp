@@ -5,7 +5,8 @@
 #include <RTSTransmitter.h>
 #include "./test_RTSTransmitter.h"
 
-RTSTransmitter transmitterTest;
+AirtimeBudget transmitterAirtime;
+RTSTransmitter transmitterTest(&transmitterAirtime);
 
 void RUN_RTSTRANSMITTER_TESTS(void){
     RUN_TEST(test_METHOD_sendUpCommand_WITH_remote_SHOULD_return_true_AND_build_specific_frame);
@@ -0,0 +1,113 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <admissionController.h>
+
+#include "./test_admissionController.h"
+
+void RUN_ADMISSIONCONTROLLER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_classify_WITH_urls_SHOULD_return_priority);
+  RUN_TEST(test_METHOD_admit_WITH_enough_memory_SHOULD_return_true);
+  RUN_TEST(test_METHOD_admit_WITH_low_heap_SHOULD_shed_static_before_action);
+  RUN_TEST(test_METHOD_admit_WITH_fragmented_heap_SHOULD_return_false);
+  RUN_TEST(test_METHOD_admit_WITH_too_many_active_requests_SHOULD_return_false);
+  RUN_TEST(test_METHOD_release_WITH_active_request_SHOULD_admit_again);
+  RUN_TEST(test_METHOD_admit_WITH_api_requests_active_SHOULD_still_admit_static);
+}
+
+void test_METHOD_classify_WITH_urls_SHOULD_return_priority(void)
+{
+  TEST_ASSERT_EQUAL(ADMISSION_STATIC, AdmissionController::classify("/", HTTP_GET));
+  TEST_ASSERT_EQUAL(
+      ADMISSION_STATIC, AdmissionController::classify("/static/js/esprtsomfy.js", HTTP_GET));
+  TEST_ASSERT_EQUAL(ADMISSION_API, AdmissionController::classify("/api/v1/remotes", HTTP_GET));
+  TEST_ASSERT_EQUAL(
+      ADMISSION_API, AdmissionController::classify("/api/v1/remotes/42/action", HTTP_GET));
+  TEST_ASSERT_EQUAL(
+      ADMISSION_ACTION, AdmissionController::classify("/api/v1/remotes/42/action", HTTP_POST));
+}
+
+void test_METHOD_admit_WITH_enough_memory_SHOULD_return_true(void)
+{
+  AdmissionController admission;
+
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+
+  AdmissionMetrics metrics = admission.getMetrics();
+  TEST_ASSERT_EQUAL(1, metrics.admitted[ADMISSION_STATIC]);
+  TEST_ASSERT_EQUAL(1, metrics.activeRequests);
+  TEST_ASSERT_EQUAL(30000, metrics.freeHeap);
+}
+
+void test_METHOD_admit_WITH_low_heap_SHOULD_shed_static_before_action(void)
+{
+  AdmissionController admission;
+  const uint32_t freeHeap = ACTION_MIN_FREE_HEAP + 1;
+
+  TEST_ASSERT_FALSE(admission.admit(ADMISSION_STATIC, freeHeap, freeHeap));
+  TEST_ASSERT_FALSE(admission.admit(ADMISSION_API, freeHeap, freeHeap));
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_ACTION, freeHeap, freeHeap));
+
+  AdmissionMetrics metrics = admission.getMetrics();
+  TEST_ASSERT_EQUAL(1, metrics.shed[ADMISSION_STATIC]);
+  TEST_ASSERT_EQUAL(1, metrics.shed[ADMISSION_API]);
+  TEST_ASSERT_EQUAL(0, metrics.shed[ADMISSION_ACTION]);
+  TEST_ASSERT_EQUAL(freeHeap, metrics.lowestFreeHeap);
+}
+
+void test_METHOD_admit_WITH_fragmented_heap_SHOULD_return_false(void)
+{
+  AdmissionController admission;
+
+  TEST_ASSERT_FALSE(admission.admit(ADMISSION_API, 30000, API_MIN_FREE_BLOCK - 1));
+  TEST_ASSERT_EQUAL(0, admission.getMetrics().activeRequests);
+}
+
+void test_METHOD_admit_WITH_too_many_active_requests_SHOULD_return_false(void)
+{
+  AdmissionController admission;
+  admission.setThresholds(ADMISSION_STATIC, { 0, 0, 1 });
+
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+  TEST_ASSERT_FALSE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_ACTION, 30000, 20000));
+  TEST_ASSERT_EQUAL(2, admission.getMetrics().peakActiveRequests);
+}
+
+void test_METHOD_release_WITH_active_request_SHOULD_admit_again(void)
+{
+  AdmissionController admission;
+  admission.setThresholds(ADMISSION_STATIC, { 0, 0, 1 });
+
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+  admission.release(ADMISSION_STATIC);
+  TEST_ASSERT_TRUE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+  admission.release(ADMISSION_STATIC);
+  admission.release(ADMISSION_STATIC);
+  TEST_ASSERT_EQUAL(0, admission.getMetrics().activeRequests);
+}
+
+void test_METHOD_admit_WITH_api_requests_active_SHOULD_still_admit_static(void)
+{
+  AdmissionController admission;
+
+  // The event stream and the requests of the page, counted apart from the assets.
+  for (unsigned short i = 0; i < API_MAX_ACTIVE_REQUESTS; ++i)
+  {
+    TEST_ASSERT_TRUE(admission.admit(ADMISSION_API, 30000, 20000));
+  }
+  for (unsigned short i = 0; i < STATIC_MAX_ACTIVE_REQUESTS; ++i)
+  {
+    TEST_ASSERT_TRUE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+  }
+  TEST_ASSERT_FALSE(admission.admit(ADMISSION_STATIC, 30000, 20000));
+
+  AdmissionMetrics metrics = admission.getMetrics();
+  TEST_ASSERT_EQUAL(STATIC_MAX_ACTIVE_REQUESTS, metrics.active[ADMISSION_STATIC]);
+  TEST_ASSERT_EQUAL(API_MAX_ACTIVE_REQUESTS, metrics.active[ADMISSION_API]);
+  TEST_ASSERT_EQUAL(
+      STATIC_MAX_ACTIVE_REQUESTS + API_MAX_ACTIVE_REQUESTS, metrics.activeRequests);
+}
\ No newline at end of file
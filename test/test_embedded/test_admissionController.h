@@ -0,0 +1,11 @@
+#pragma once
+
+void RUN_ADMISSIONCONTROLLER_TESTS(void);
+
+void test_METHOD_classify_WITH_urls_SHOULD_return_priority(void);
+void test_METHOD_admit_WITH_enough_memory_SHOULD_return_true(void);
+void test_METHOD_admit_WITH_low_heap_SHOULD_shed_static_before_action(void);
+void test_METHOD_admit_WITH_fragmented_heap_SHOULD_return_false(void);
+void test_METHOD_admit_WITH_too_many_active_requests_SHOULD_return_false(void);
+void test_METHOD_release_WITH_active_request_SHOULD_admit_again(void);
+void test_METHOD_admit_WITH_api_requests_active_SHOULD_still_admit_static(void);
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <airtimeBudget.h>
+
+#include "./test_airtimeBudget.h"
+
+void RUN_AIRTIMEBUDGET_TESTS(void)
+{
+  RUN_TEST(test_METHOD_record_WITH_remotes_SHOULD_count_total_AND_per_remote);
+  RUN_TEST(test_METHOD_getUsed_WITH_window_elapsed_SHOULD_forget_oldest_bucket);
+  RUN_TEST(test_METHOD_canSend_WITH_budget_spent_SHOULD_return_false);
+}
+
+void test_METHOD_record_WITH_remotes_SHOULD_count_total_AND_per_remote(void)
+{
+  AirtimeBudget budget;
+
+  budget.record(1, 350, 1000);
+  budget.record(2, 340, 2000);
+  budget.record(1, 360, AIRTIME_BUCKET_DURATION + 3000);
+
+  const unsigned long now = AIRTIME_BUCKET_DURATION + 4000;
+  TEST_ASSERT_EQUAL_UINT32(1050, budget.getUsed(now));
+  TEST_ASSERT_EQUAL_UINT32(710, budget.getUsed(1, now));
+  TEST_ASSERT_EQUAL_UINT32(340, budget.getUsed(2, now));
+  TEST_ASSERT_EQUAL_UINT32(0, budget.getUsed(3, now));
+}
+
+void test_METHOD_getUsed_WITH_window_elapsed_SHOULD_forget_oldest_bucket(void)
+{
+  AirtimeBudget budget;
+  const unsigned long start = 5 * AIRTIME_BUCKET_DURATION + 100;
+
+  budget.record(1, 350, start);
+  budget.record(1, 350, start + AIRTIME_BUCKET_DURATION);
+
+  const unsigned long end = start - 100 + AIRTIME_WINDOW_BUCKETS * AIRTIME_BUCKET_DURATION;
+  TEST_ASSERT_EQUAL_UINT32(700, budget.getUsed(end - 1));
+  TEST_ASSERT_EQUAL_UINT32(350, budget.getUsed(end));
+  TEST_ASSERT_EQUAL_UINT32(350, budget.getUsed(1, end));
+  TEST_ASSERT_EQUAL_UINT32(0, budget.getUsed(end + 10 * AIRTIME_BUCKET_DURATION));
+}
+
+void test_METHOD_canSend_WITH_budget_spent_SHOULD_return_false(void)
+{
+  AirtimeBudget budget;
+
+  TEST_ASSERT_TRUE(budget.canSend(1, 1000));
+  budget.record(1, AIRTIME_REMOTE_BUDGET, 1000);
+  TEST_ASSERT_FALSE(budget.canSend(1, 1000));
+  TEST_ASSERT_TRUE(budget.canSend(2, 1000));
+
+  budget.record(2, AIRTIME_BUDGET - AIRTIME_REMOTE_BUDGET, 1000);
+  TEST_ASSERT_FALSE(budget.canSend(2, 1000));
+  TEST_ASSERT_FALSE(budget.canSend(3, 1000));
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+void RUN_AIRTIMEBUDGET_TESTS(void);
+
+void test_METHOD_record_WITH_remotes_SHOULD_count_total_AND_per_remote(void);
+void test_METHOD_getUsed_WITH_window_elapsed_SHOULD_forget_oldest_bucket(void);
+void test_METHOD_canSend_WITH_budget_spent_SHOULD_return_false(void);
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <result.h>
+#include <controller.h>
+#include <airtimeBudget.h>
+#include <airtimeScheduler.h>
+
+#include "./test_controller.h"
+#include "./test_airtimeScheduler.h"
+
+FakeDatabase airtimeDatabaseFake;
+FakeNetworkClient airtimeNetworkClientFake;
+FakeSerializer airtimeSerializerFake;
+FakeTransmitter airtimeTransmitterFake;
+FakeNetworkSwitchover airtimeNetworkSwitchoverFake;
+FakeEventPublisher airtimeEventPublisherFake;
+Controller airtimeController(&airtimeDatabaseFake, &airtimeNetworkClientFake,
+    &airtimeSerializerFake, &airtimeTransmitterFake, &airtimeNetworkSwitchoverFake,
+    &airtimeEventPublisherFake);
+
+void RUN_AIRTIMESCHEDULER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_operateRemote_WITH_budget_left_SHOULD_send_now);
+  RUN_TEST(test_METHOD_operateRemote_WITH_budget_spent_SHOULD_send_once_window_moves);
+  RUN_TEST(test_METHOD_operateRemote_WITH_stop_SHOULD_send_AND_cancel_delayed_command);
+  RUN_TEST(test_METHOD_operateRemote_WITH_full_queue_SHOULD_return_error);
+}
+
+void test_METHOD_operateRemote_WITH_budget_left_SHOULD_send_now(void)
+{
+  AirtimeBudget budget;
+  AirtimeScheduler scheduler(&airtimeController, &budget);
+
+  Result result = scheduler.operateRemote(1, "up", 1000);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_UP_SENT, result.code);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(0, scheduler.getQueueSize());
+}
+
+void test_METHOD_operateRemote_WITH_budget_spent_SHOULD_send_once_window_moves(void)
+{
+  AirtimeBudget budget;
+  AirtimeScheduler scheduler(&airtimeController, &budget);
+  budget.record(1, AIRTIME_REMOTE_BUDGET, 1000);
+
+  Result result = scheduler.operateRemote(1, "down", 2000);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DELAYED, result.code);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(1, scheduler.getQueueSize());
+
+  const unsigned long end = AIRTIME_WINDOW_BUCKETS * AIRTIME_BUCKET_DURATION;
+  scheduler.loop(end - 1);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+
+  scheduler.loop(end);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(0, scheduler.getQueueSize());
+}
+
+void test_METHOD_operateRemote_WITH_stop_SHOULD_send_AND_cancel_delayed_command(void)
+{
+  AirtimeBudget budget;
+  AirtimeScheduler scheduler(&airtimeController, &budget);
+  budget.record(1, AIRTIME_BUDGET, 1000);
+
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DELAYED, scheduler.operateRemote(1, "up", 2000).code);
+  Result result = scheduler.operateRemote(1, "stop", 3000);
+
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, result.code);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(0, scheduler.getQueueSize());
+  scheduler.loop(AIRTIME_WINDOW_BUCKETS * AIRTIME_BUCKET_DURATION);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+}
+
+void test_METHOD_operateRemote_WITH_full_queue_SHOULD_return_error(void)
+{
+  AirtimeBudget budget;
+  AirtimeScheduler scheduler(&airtimeController, &budget);
+  budget.record(1, AIRTIME_BUDGET, 1000);
+
+  for (unsigned short i = 0; i < AIRTIME_QUEUE_SIZE; ++i)
+  {
+    TEST_ASSERT_EQUAL(RESULT_COMMAND_DELAYED, scheduler.operateRemote(i + 1, "up", 2000).code);
+  }
+  // A newer command of a remote takes the place of its waiting one.
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DELAYED, scheduler.operateRemote(1, "down", 2000).code);
+  Result result = scheduler.operateRemote(AIRTIME_QUEUE_SIZE + 1, "up", 2000);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_AIRTIME_EXHAUSTED, result.code);
+  TEST_ASSERT_EQUAL(AIRTIME_QUEUE_SIZE, scheduler.getQueueSize());
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+void RUN_AIRTIMESCHEDULER_TESTS(void);
+
+void test_METHOD_operateRemote_WITH_budget_left_SHOULD_send_now(void);
+void test_METHOD_operateRemote_WITH_budget_spent_SHOULD_send_once_window_moves(void);
+void test_METHOD_operateRemote_WITH_stop_SHOULD_send_AND_cancel_delayed_command(void);
+void test_METHOD_operateRemote_WITH_full_queue_SHOULD_return_error(void);
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <boot.h>
+#include <config.h>
+#include <bootSequence.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+
+#include "./test_controller.h"
+#include "./test_networkScanner.h"
+#include "./test_bootSequence.h"
+
+FakeDatabase bootDatabaseFake;
+FakeNetworkClient bootNetworkClientFake;
+FakeAccessPoint bootAccessPointFake;
+
+void RUN_BOOTSEQUENCE_TESTS(void)
+{
+  RUN_TEST(test_METHOD_endPhase_SHOULD_record_duration);
+  RUN_TEST(test_METHOD_startNetwork_WITHOUT_configuration_SHOULD_start_access_point);
+  RUN_TEST(test_METHOD_loop_WITH_wifi_connected_SHOULD_scan_AND_finish);
+  RUN_TEST(test_METHOD_loop_WITH_connection_timeout_SHOULD_fallback_to_access_point);
+  RUN_TEST(test_METHOD_startNetwork_WITH_network_hints_SHOULD_connect_with_hints);
+  RUN_TEST(test_METHOD_loop_WITH_hinted_connection_timeout_SHOULD_connect_without_hints);
+  RUN_TEST(test_METHOD_loop_WITH_several_networks_SHOULD_time_scan_AND_connection);
+  RUN_TEST(test_METHOD_recordCommand_SHOULD_keep_first_command);
+}
+
+void test_METHOD_endPhase_SHOULD_record_duration(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+
+  boot.beginPhase(BOOT_DATABASE, 10);
+  boot.endPhase(BOOT_DATABASE, 25);
+  boot.beginPhase(BOOT_SERVER, 30);
+  boot.endPhase(BOOT_SERVER, 34);
+
+  BootProfile profile = boot.getProfile();
+  TEST_ASSERT_EQUAL(15, profile.durations[BOOT_DATABASE]);
+  TEST_ASSERT_EQUAL(4, profile.durations[BOOT_SERVER]);
+  TEST_ASSERT_EQUAL(34, profile.serverReadyAt);
+}
+
+void test_METHOD_startNetwork_WITHOUT_configuration_SHOULD_start_access_point(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeDatabase::shouldReturnEmptyNetworkConfiguration = true;
+
+  boot.startNetwork(100);
+
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectCalled);
+  TEST_ASSERT_TRUE(FakeAccessPoint::startAccessPointCalled);
+  TEST_ASSERT_EQUAL(BOOT_ACCESS_POINT, boot.getPhase());
+  TEST_ASSERT_FALSE(FakeNetworkClient::startScanCalled);
+
+  boot.loop(130);
+
+  BootProfile profile = boot.getProfile();
+  TEST_ASSERT_EQUAL(BOOT_WIFI_SCAN, profile.phase);
+  TEST_ASSERT_EQUAL(30, profile.durations[BOOT_ACCESS_POINT]);
+  TEST_ASSERT_EQUAL(130, profile.networkReadyAt);
+  TEST_ASSERT_TRUE(FakeNetworkClient::startScanCalled);
+}
+
+void test_METHOD_loop_WITH_wifi_connected_SHOULD_scan_AND_finish(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeNetworkClient::isConnectedToNetwork = false;
+
+  boot.startNetwork(100);
+  TEST_ASSERT_TRUE(FakeNetworkClient::beginConnectCalled);
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectWithHints);
+  boot.loop(1000);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_CONNECT, boot.getPhase());
+
+  FakeNetworkClient::isConnectedToNetwork = true;
+  boot.loop(2900);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_SCAN, boot.getPhase());
+  TEST_ASSERT_TRUE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_TRUE(FakeDatabase::setNetworkHintsCalled);
+
+  FakeNetworkClient::scanStatus = 0;
+  scanner.loop(5000);
+  boot.loop(5000);
+
+  BootProfile profile = boot.getProfile();
+  TEST_ASSERT_EQUAL(BOOT_DONE, profile.phase);
+  TEST_ASSERT_EQUAL(2800, profile.durations[BOOT_WIFI_CONNECT]);
+  TEST_ASSERT_EQUAL(2100, profile.durations[BOOT_WIFI_SCAN]);
+  TEST_ASSERT_EQUAL(2900, profile.networkReadyAt);
+}
+
+void test_METHOD_loop_WITH_connection_timeout_SHOULD_fallback_to_access_point(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeNetworkClient::isConnectedToNetwork = false;
+
+  boot.startNetwork(100);
+  boot.loop(100 + WIFI_CONNECT_TIMEOUT - 1);
+  TEST_ASSERT_FALSE(FakeAccessPoint::startAccessPointCalled);
+
+  boot.loop(100 + WIFI_CONNECT_TIMEOUT);
+  TEST_ASSERT_TRUE(FakeNetworkClient::disconnectCalled);
+  TEST_ASSERT_TRUE(FakeAccessPoint::startAccessPointCalled);
+  TEST_ASSERT_EQUAL(BOOT_ACCESS_POINT, boot.getPhase());
+  TEST_ASSERT_EQUAL(WIFI_CONNECT_TIMEOUT, boot.getProfile().durations[BOOT_WIFI_CONNECT]);
+
+  boot.loop(100 + WIFI_CONNECT_TIMEOUT + 20);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_SCAN, boot.getPhase());
+  TEST_ASSERT_EQUAL(20, boot.getProfile().durations[BOOT_ACCESS_POINT]);
+}
+
+void test_METHOD_startNetwork_WITH_network_hints_SHOULD_connect_with_hints(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeDatabase::hasNetworkHints = true;
+  FakeNetworkClient::isConnectedToNetwork = false;
+
+  boot.startNetwork(100);
+
+  TEST_ASSERT_TRUE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_CONNECT, boot.getPhase());
+}
+
+void test_METHOD_loop_WITH_hinted_connection_timeout_SHOULD_connect_without_hints(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeDatabase::hasNetworkHints = true;
+  FakeNetworkClient::isConnectedToNetwork = false;
+
+  boot.startNetwork(100);
+  boot.loop(100 + WIFI_HINTED_CONNECT_TIMEOUT);
+
+  TEST_ASSERT_TRUE(FakeNetworkClient::disconnectCalled);
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_CONNECT, boot.getPhase());
+
+  // The full timeout starts again for the connection without hints.
+  boot.loop(100 + WIFI_HINTED_CONNECT_TIMEOUT + WIFI_CONNECT_TIMEOUT - 1);
+  TEST_ASSERT_FALSE(FakeAccessPoint::startAccessPointCalled);
+  boot.loop(100 + WIFI_HINTED_CONNECT_TIMEOUT + WIFI_CONNECT_TIMEOUT);
+  TEST_ASSERT_TRUE(FakeAccessPoint::startAccessPointCalled);
+}
+
+void test_METHOD_loop_WITH_several_networks_SHOULD_time_scan_AND_connection(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+  FakeDatabase::hasSeveralNetworkConfigurations = true;
+  FakeNetworkClient::isConnectedToNetwork = false;
+  Network networks[] = { { "baz", -50 }, { "foo", -70 } };
+
+  boot.startNetwork(100);
+  completeScan(networks, 2);
+  scanner.loop(2300);
+  boot.loop(2300);
+  TEST_ASSERT_EQUAL_STRING("baz", FakeNetworkClient::connectedSsid);
+
+  FakeNetworkClient::isConnectedToNetwork = true;
+  boot.loop(3100);
+  TEST_ASSERT_EQUAL(BOOT_WIFI_SCAN, boot.getPhase());
+  // The scan of the selection is part of the connection, and reused for the last phase.
+  TEST_ASSERT_EQUAL(3000, boot.getProfile().durations[BOOT_WIFI_CONNECT]);
+  boot.loop(3200);
+  TEST_ASSERT_EQUAL(BOOT_DONE, boot.getPhase());
+}
+
+void test_METHOD_recordCommand_SHOULD_keep_first_command(void)
+{
+  NetworkScanner scanner(&bootNetworkClientFake);
+  NetworkConnector connector(&bootDatabaseFake, &bootNetworkClientFake, &scanner);
+  BootSequence boot(&connector, &bootNetworkClientFake, &bootAccessPointFake, &scanner);
+
+  boot.recordCommand(1500);
+  boot.recordCommand(3000);
+
+  TEST_ASSERT_EQUAL(1500, boot.getProfile().firstCommandAt);
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+void RUN_BOOTSEQUENCE_TESTS(void);
+
+void test_METHOD_endPhase_SHOULD_record_duration(void);
+void test_METHOD_startNetwork_WITHOUT_configuration_SHOULD_start_access_point(void);
+void test_METHOD_loop_WITH_wifi_connected_SHOULD_scan_AND_finish(void);
+void test_METHOD_loop_WITH_connection_timeout_SHOULD_fallback_to_access_point(void);
+void test_METHOD_startNetwork_WITH_network_hints_SHOULD_connect_with_hints(void);
+void test_METHOD_loop_WITH_hinted_connection_timeout_SHOULD_connect_without_hints(void);
+void test_METHOD_loop_WITH_several_networks_SHOULD_time_scan_AND_connection(void);
+void test_METHOD_recordCommand_SHOULD_keep_first_command(void);
\ No newline at end of file
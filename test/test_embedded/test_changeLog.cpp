@@ -0,0 +1,140 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <change.h>
+#include <remote.h>
+#include <changeLog.h>
+
+#include "./test_changeLog.h"
+
+void RUN_CHANGELOG_TESTS(void)
+{
+  RUN_TEST(test_METHOD_getChangesSince_WITH_empty_log_SHOULD_return_no_change);
+  RUN_TEST(test_METHOD_getChangesSince_WITH_known_sequence_SHOULD_return_newer_changes);
+  RUN_TEST(test_METHOD_getChangesSince_WITH_future_sequence_SHOULD_require_resync);
+  RUN_TEST(test_METHOD_getChangesSince_WITH_sequence_of_previous_boot_SHOULD_require_resync);
+  RUN_TEST(test_METHOD_getChangesSince_WITH_wrapped_log_SHOULD_require_resync);
+  RUN_TEST(test_METHOD_getChangesSince_WITH_wrapped_log_AND_recent_sequence_SHOULD_return_changes);
+}
+
+void test_METHOD_getChangesSince_WITH_empty_log_SHOULD_return_no_change(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+
+  changeLog.getChangesSince(0, feed);
+
+  TEST_ASSERT_EQUAL(0, feed.size);
+  TEST_ASSERT_EQUAL(0, feed.lastSequence);
+  TEST_ASSERT_FALSE(feed.resyncRequired);
+}
+
+void test_METHOD_getChangesSince_WITH_known_sequence_SHOULD_return_newer_changes(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+  Remote remote = { 1048576, 0, "foo" };
+
+  changeLog.record(CHANGE_REMOTE_CREATED, remote);
+  strcpy(remote.name, "bar");
+  changeLog.record(CHANGE_REMOTE_RENAMED, remote);
+  remote.rollingCode = 1;
+  changeLog.record(CHANGE_REMOTE_ROLLING_CODE, remote);
+
+  changeLog.getChangesSince(1, feed);
+
+  TEST_ASSERT_FALSE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(3, feed.lastSequence);
+  TEST_ASSERT_EQUAL(2, feed.size);
+  TEST_ASSERT_EQUAL(2, feed.changes[0].sequence);
+  TEST_ASSERT_EQUAL(CHANGE_REMOTE_RENAMED, feed.changes[0].type);
+  TEST_ASSERT_EQUAL_STRING("bar", feed.changes[0].name);
+  TEST_ASSERT_EQUAL(3, feed.changes[1].sequence);
+  TEST_ASSERT_EQUAL(CHANGE_REMOTE_ROLLING_CODE, feed.changes[1].type);
+  TEST_ASSERT_EQUAL(1, feed.changes[1].rollingCode);
+}
+
+void test_METHOD_getChangesSince_WITH_future_sequence_SHOULD_require_resync(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+  Remote remote = { 1048576, 0, "foo" };
+  changeLog.record(CHANGE_REMOTE_CREATED, remote);
+
+  // The client knows a sequence from before a restart of the device.
+  changeLog.getChangesSince(42, feed);
+
+  TEST_ASSERT_TRUE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(0, feed.size);
+  TEST_ASSERT_EQUAL(1, feed.lastSequence);
+}
+
+void test_METHOD_getChangesSince_WITH_sequence_of_previous_boot_SHOULD_require_resync(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+  Remote remote = { 1048576, 0, "foo" };
+  // The client knows the sequence 5 from the previous boot, this boot has made 7 changes since.
+  changeLog.begin(1000);
+  for (int i = 0; i < 7; i++)
+  {
+    remote.rollingCode = i;
+    changeLog.record(CHANGE_REMOTE_ROLLING_CODE, remote);
+  }
+
+  changeLog.getChangesSince(5, feed);
+
+  TEST_ASSERT_TRUE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(0, feed.size);
+  TEST_ASSERT_EQUAL(1007, feed.lastSequence);
+
+  // The sequences of this boot, and the whole log.
+  changeLog.getChangesSince(1005, feed);
+  TEST_ASSERT_FALSE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(2, feed.size);
+  TEST_ASSERT_EQUAL(1006, feed.changes[0].sequence);
+  changeLog.getChangesSince(0, feed);
+  TEST_ASSERT_FALSE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(7, feed.size);
+  TEST_ASSERT_EQUAL(1001, feed.changes[0].sequence);
+}
+
+void test_METHOD_getChangesSince_WITH_wrapped_log_SHOULD_require_resync(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+  Remote remote = { 1048576, 0, "foo" };
+  for (int i = 0; i < MAX_CHANGES + 2; i++)
+  {
+    remote.rollingCode = i;
+    changeLog.record(CHANGE_REMOTE_ROLLING_CODE, remote);
+  }
+
+  changeLog.getChangesSince(0, feed);
+
+  TEST_ASSERT_TRUE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(0, feed.size);
+  TEST_ASSERT_EQUAL(MAX_CHANGES + 2, feed.lastSequence);
+}
+
+void test_METHOD_getChangesSince_WITH_wrapped_log_AND_recent_sequence_SHOULD_return_changes(void)
+{
+  ChangeLog changeLog;
+  ChangeFeed feed;
+  Remote remote = { 1048576, 0, "foo" };
+  for (int i = 0; i < MAX_CHANGES + 2; i++)
+  {
+    remote.rollingCode = i;
+    changeLog.record(CHANGE_REMOTE_ROLLING_CODE, remote);
+  }
+
+  // The oldest change still in the log has the sequence 3.
+  changeLog.getChangesSince(2, feed);
+
+  TEST_ASSERT_FALSE(feed.resyncRequired);
+  TEST_ASSERT_EQUAL(MAX_CHANGES, feed.size);
+  TEST_ASSERT_EQUAL(3, feed.changes[0].sequence);
+  TEST_ASSERT_EQUAL(MAX_CHANGES + 2, feed.changes[MAX_CHANGES - 1].sequence);
+  TEST_ASSERT_EQUAL(MAX_CHANGES + 1, feed.changes[MAX_CHANGES - 1].rollingCode);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+void RUN_CHANGELOG_TESTS(void);
+
+void test_METHOD_getChangesSince_WITH_empty_log_SHOULD_return_no_change(void);
+void test_METHOD_getChangesSince_WITH_known_sequence_SHOULD_return_newer_changes(void);
+void test_METHOD_getChangesSince_WITH_future_sequence_SHOULD_require_resync(void);
+void test_METHOD_getChangesSince_WITH_sequence_of_previous_boot_SHOULD_require_resync(void);
+void test_METHOD_getChangesSince_WITH_wrapped_log_SHOULD_require_resync(void);
+void test_METHOD_getChangesSince_WITH_wrapped_log_AND_recent_sequence_SHOULD_return_changes(void);
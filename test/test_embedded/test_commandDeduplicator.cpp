@@ -0,0 +1,119 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <remote.h>
+#include <result.h>
+#include <eventBus.h>
+#include <commandDeduplicator.h>
+
+#include "./test_commandDeduplicator.h"
+
+static Result sentResult(const ResultCode code)
+{
+  Result result;
+  result.isSuccess = true;
+  result.code = code;
+  return result;
+}
+
+void RUN_COMMANDDEDUPLICATOR_TESTS(void)
+{
+  RUN_TEST(test_METHOD_find_WITH_same_action_in_window_SHOULD_return_previous_result);
+  RUN_TEST(test_METHOD_find_WITH_window_elapsed_SHOULD_return_false);
+  RUN_TEST(test_METHOD_find_WITH_other_command_sent_meanwhile_SHOULD_return_false);
+  RUN_TEST(test_METHOD_find_WITH_same_key_SHOULD_return_previous_result);
+  RUN_TEST(test_METHOD_find_WITH_new_key_SHOULD_return_false);
+  RUN_TEST(test_METHOD_remember_WITH_full_cache_SHOULD_replace_least_recently_used);
+}
+
+void test_METHOD_find_WITH_same_action_in_window_SHOULD_return_previous_result(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Result result;
+
+  TEST_ASSERT_FALSE(deduplicator.find(1, "up", nullptr, 1000, result));
+  deduplicator.remember(1, "up", nullptr, sentResult(RESULT_COMMAND_UP_SENT), 1000);
+
+  TEST_ASSERT_TRUE(deduplicator.find(1, "up", "", 1400, result));
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_UP_SENT, result.code);
+  TEST_ASSERT_FALSE(deduplicator.find(1, "down", nullptr, 1400, result));
+  TEST_ASSERT_FALSE(deduplicator.find(2, "up", nullptr, 1400, result));
+}
+
+void test_METHOD_find_WITH_window_elapsed_SHOULD_return_false(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Result result;
+
+  deduplicator.remember(1, "stop", nullptr, sentResult(RESULT_COMMAND_STOP_SENT), 1000);
+
+  const unsigned long end = 1000 + DUPLICATE_COMMAND_WINDOW;
+  TEST_ASSERT_TRUE(deduplicator.find(1, "stop", nullptr, end - 1, result));
+  TEST_ASSERT_FALSE(deduplicator.find(1, "stop", nullptr, end, result));
+}
+
+void test_METHOD_find_WITH_other_command_sent_meanwhile_SHOULD_return_false(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Remote remote = { 1, 42, "foo" };
+  Result result;
+
+  deduplicator.remember(1, "up", nullptr, sentResult(RESULT_COMMAND_UP_SENT), 1000);
+  // A STOP by another client, the next UP moves the remote again.
+  bus.publish(EVENT_COMMAND_TRANSMITTED, remote, "stop");
+
+  TEST_ASSERT_FALSE(deduplicator.find(1, "up", nullptr, 1200, result));
+}
+
+void test_METHOD_find_WITH_same_key_SHOULD_return_previous_result(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Remote remote = { 1, 42, "foo" };
+  Result result;
+
+  deduplicator.remember(1, "down", "a1b2", sentResult(RESULT_COMMAND_DOWN_SENT), 1000);
+  bus.publish(EVENT_COMMAND_TRANSMITTED, remote, "stop");
+
+  // Retried long after, once another command was sent: still the same request.
+  TEST_ASSERT_TRUE(deduplicator.find(1, "down", "a1b2", 1000 + IDEMPOTENCY_KEY_WINDOW - 1, result));
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DOWN_SENT, result.code);
+  TEST_ASSERT_FALSE(deduplicator.find(1, "down", "a1b2", 1000 + IDEMPOTENCY_KEY_WINDOW, result));
+}
+
+void test_METHOD_find_WITH_new_key_SHOULD_return_false(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Result result;
+
+  deduplicator.remember(1, "down", "a1b2", sentResult(RESULT_COMMAND_DOWN_SENT), 1000);
+
+  // A new key is a new request, even within the window.
+  TEST_ASSERT_FALSE(deduplicator.find(1, "down", "c3d4", 1100, result));
+}
+
+void test_METHOD_remember_WITH_full_cache_SHOULD_replace_least_recently_used(void)
+{
+  EventBus bus;
+  CommandDeduplicator deduplicator(&bus);
+  Result result;
+
+  for (unsigned long remoteId = 1; remoteId <= COMMAND_DEDUPE_SIZE; ++remoteId)
+  {
+    deduplicator.remember(remoteId, "up", "key", sentResult(RESULT_COMMAND_UP_SENT), remoteId);
+  }
+  // The remote 1 is used again, the remote 2 is now the least recently used.
+  TEST_ASSERT_TRUE(deduplicator.find(1, "up", "key", 100, result));
+  deduplicator.remember(
+      COMMAND_DEDUPE_SIZE + 1, "up", "key", sentResult(RESULT_COMMAND_UP_SENT), 200);
+
+  TEST_ASSERT_TRUE(deduplicator.find(1, "up", "key", 300, result));
+  TEST_ASSERT_FALSE(deduplicator.find(2, "up", "key", 300, result));
+  TEST_ASSERT_TRUE(deduplicator.find(COMMAND_DEDUPE_SIZE + 1, "up", "key", 300, result));
+}
\ No newline at end of file
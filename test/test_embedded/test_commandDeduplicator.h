@@ -0,0 +1,10 @@
+#pragma once
+
+void RUN_COMMANDDEDUPLICATOR_TESTS(void);
+
+void test_METHOD_find_WITH_same_action_in_window_SHOULD_return_previous_result(void);
+void test_METHOD_find_WITH_window_elapsed_SHOULD_return_false(void);
+void test_METHOD_find_WITH_other_command_sent_meanwhile_SHOULD_return_false(void);
+void test_METHOD_find_WITH_same_key_SHOULD_return_previous_result(void);
+void test_METHOD_find_WITH_new_key_SHOULD_return_false(void);
+void test_METHOD_remember_WITH_full_cache_SHOULD_replace_least_recently_used(void);
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <result.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <commandQueue.h>
+#include <commandDeduplicator.h>
+
+#include "./test_controller.h"
+#include "./test_commandQueue.h"
+
+FakeDatabase queueDatabaseFake;
+FakeNetworkClient queueNetworkClientFake;
+FakeSerializer queueSerializerFake;
+FakeTransmitter queueTransmitterFake;
+FakeNetworkSwitchover queueNetworkSwitchoverFake;
+
+void RUN_COMMANDQUEUE_TESTS(void)
+{
+  RUN_TEST(test_METHOD_runNext_SHOULD_operate_commands_in_order_AND_keep_results);
+  RUN_TEST(test_METHOD_runNext_WITH_duplicate_SHOULD_not_send_it_again);
+  RUN_TEST(test_METHOD_push_WITH_full_queue_SHOULD_return_zero_until_results_expire);
+  RUN_TEST(test_METHOD_runNext_WITH_job_SHOULD_run_it_AND_keep_its_data);
+}
+
+void test_METHOD_runNext_SHOULD_operate_commands_in_order_AND_keep_results(void)
+{
+  EventBus bus;
+  Controller controller(&queueDatabaseFake, &queueNetworkClientFake, &queueSerializerFake,
+      &queueTransmitterFake, &queueNetworkSwitchoverFake, &bus);
+  CommandDeduplicator deduplicator(&bus);
+  CommandQueue queue(&controller, &deduplicator);
+  Result result;
+
+  const unsigned long down = queue.push(1, "down", nullptr, 1000);
+  const unsigned long up = queue.push(2, "up", "", 1000);
+  TEST_ASSERT_NOT_EQUAL(0, down);
+  TEST_ASSERT_FALSE(queue.isDone(down));
+  TEST_ASSERT_FALSE(queue.take(down, result));
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+
+  TEST_ASSERT_TRUE(queue.runNext(1010));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_TRUE(queue.isDone(down));
+  TEST_ASSERT_TRUE(queue.hasPending());
+
+  TEST_ASSERT_TRUE(queue.runNext(1020));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_FALSE(queue.hasPending());
+  TEST_ASSERT_FALSE(queue.runNext(1030));
+
+  TEST_ASSERT_TRUE(queue.take(up, result));
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_UP_SENT, result.code);
+  TEST_ASSERT_FALSE(queue.take(up, result));
+}
+
+void test_METHOD_runNext_WITH_duplicate_SHOULD_not_send_it_again(void)
+{
+  EventBus bus;
+  Controller controller(&queueDatabaseFake, &queueNetworkClientFake, &queueSerializerFake,
+      &queueTransmitterFake, &queueNetworkSwitchoverFake, &bus);
+  CommandDeduplicator deduplicator(&bus);
+  CommandQueue queue(&controller, &deduplicator);
+  Result result;
+
+  queue.push(1, "stop", "key", 1000);
+  const unsigned long retry = queue.push(1, "stop", "key", 1100);
+  queue.runNext(1200);
+  FakeTransmitter::sendSTOPCommandCalled = false;
+  queue.runNext(1200 + DUPLICATE_COMMAND_WINDOW);
+
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_TRUE(queue.take(retry, result));
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, result.code);
+}
+
+void test_METHOD_push_WITH_full_queue_SHOULD_return_zero_until_results_expire(void)
+{
+  EventBus bus;
+  Controller controller(&queueDatabaseFake, &queueNetworkClientFake, &queueSerializerFake,
+      &queueTransmitterFake, &queueNetworkSwitchoverFake, &bus);
+  CommandDeduplicator deduplicator(&bus);
+  CommandQueue queue(&controller, &deduplicator);
+
+  for (unsigned short i = 0; i < COMMAND_QUEUE_SIZE; ++i)
+  {
+    TEST_ASSERT_NOT_EQUAL(0, queue.push(1, "up", nullptr, 1000));
+  }
+  TEST_ASSERT_EQUAL(0, queue.push(1, "up", nullptr, 1000));
+
+  // Operated but never taken, the requests have left.
+  while (queue.runNext(2000))
+  {
+  }
+  TEST_ASSERT_EQUAL(0, queue.push(1, "up", nullptr, 2000 + COMMAND_RESULT_TTL - 1));
+  TEST_ASSERT_NOT_EQUAL(0, queue.push(1, "up", nullptr, 2000 + COMMAND_RESULT_TTL));
+}
+
+void test_METHOD_runNext_WITH_job_SHOULD_run_it_AND_keep_its_data(void)
+{
+  EventBus bus;
+  Controller controller(&queueDatabaseFake, &queueNetworkClientFake, &queueSerializerFake,
+      &queueTransmitterFake, &queueNetworkSwitchoverFake, &bus);
+  CommandDeduplicator deduplicator(&bus);
+  CommandQueue queue(&controller, &deduplicator);
+  unsigned long ranAt = 0;
+  Result result;
+
+  const unsigned long ticket = queue.push(
+      [&ranAt](const unsigned long now)
+      {
+        ranAt = now;
+        Result jobResult;
+        jobResult.isSuccess = true;
+        jobResult.code = RESULT_REMOTE_DELETED;
+        jobResult.data = "{\"id\":1}";
+        return jobResult;
+      },
+      1000);
+  TEST_ASSERT_NOT_EQUAL(0, ticket);
+  TEST_ASSERT_EQUAL(0, ranAt);
+
+  TEST_ASSERT_TRUE(queue.runNext(1010));
+  TEST_ASSERT_EQUAL(1010, ranAt);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_TRUE(queue.take(ticket, result));
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_DELETED, result.code);
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1}", result.data.c_str());
+}
\ No newline at end of file
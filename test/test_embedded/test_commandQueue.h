@@ -0,0 +1,8 @@
+#pragma once
+
+void RUN_COMMANDQUEUE_TESTS(void);
+
+void test_METHOD_runNext_SHOULD_operate_commands_in_order_AND_keep_results(void);
+void test_METHOD_runNext_WITH_duplicate_SHOULD_not_send_it_again(void);
+void test_METHOD_push_WITH_full_queue_SHOULD_return_zero_until_results_expire(void);
+void test_METHOD_runNext_WITH_job_SHOULD_run_it_AND_keep_its_data(void);
\ No newline at end of file
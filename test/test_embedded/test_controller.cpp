@@ -15,6 +15,21 @@ bool FakeDatabase::shouldFailUpdateRemote = false;
 bool FakeDatabase::shouldReturnEmptyRemote = false;
 bool FakeDatabase::shouldFailCreateRemote = false;
 bool FakeDatabase::shouldFailUpdateNetworkConfiguration = false;
+bool FakeDatabase::shouldReturnEmptyNetworkConfiguration = false;
+bool FakeDatabase::hasSeveralNetworkConfigurations = false;
+bool FakeDatabase::hasNetworkHints = false;
+bool FakeDatabase::setNetworkHintsCalled = false;
+bool FakeDatabase::setNetworkConfigurationsCalled = false;
+NetworkHints FakeDatabase::savedHints = {};
+Schedule FakeDatabase::schedules[MAX_SCHEDULES] = {};
+Calibration FakeDatabase::calibration = { 0, 0 };
+unsigned long FakeDatabase::nonceMarks[MAX_REMOTES + 1] = {};
+unsigned char FakeDatabase::nonceMarkWrites = 0;
+Group FakeDatabase::groups[MAX_GROUPS] = {};
+Scene FakeDatabase::scenes[MAX_SCENES] = {};
+Macro FakeDatabase::macros[MAX_MACROS] = {};
+bool FakeDatabase::isBatching = false;
+unsigned char FakeDatabase::batchCount = 0;
 
 void FakeDatabase::init() { }
 
@@ -26,14 +41,28 @@ SystemInfos FakeDatabase::getSystemInfos()
   return infos;
 }
 
-NetworkConfiguration FakeDatabase::getNetworkConfiguration()
+unsigned char FakeDatabase::getNetworkConfigurations(NetworkConfiguration networkConfigs[])
 {
-  NetworkConfiguration conf = { "foo", "bar" };
-  return conf;
+  memset(networkConfigs, 0, sizeof(NetworkConfiguration) * MAX_NETWORK_CONFIGURATIONS);
+  if (FakeDatabase::shouldReturnEmptyNetworkConfiguration)
+  {
+    return 0;
+  }
+  strcpy(networkConfigs[0].ssid, "foo");
+  strcpy(networkConfigs[0].password, "bar");
+  if (!FakeDatabase::hasSeveralNetworkConfigurations)
+  {
+    return 1;
+  }
+  strcpy(networkConfigs[1].ssid, "baz");
+  strcpy(networkConfigs[1].password, "qux");
+  return 2;
 }
 
-bool FakeDatabase::setNetworkConfiguration(const NetworkConfiguration& networkConfig)
+bool FakeDatabase::setNetworkConfigurations(
+    const NetworkConfiguration networkConfigs[], const unsigned char size)
 {
+  FakeDatabase::setNetworkConfigurationsCalled = true;
   if (this->shouldFailUpdateNetworkConfiguration)
   {
     return false;
@@ -41,7 +70,26 @@ bool FakeDatabase::setNetworkConfiguration(const NetworkConfiguration& networkCo
   return true;
 }
 
-void FakeDatabase::resetNetworkConfiguration() { }
+void FakeDatabase::resetNetworkConfigurations() { }
+
+bool FakeDatabase::getNetworkHints(NetworkHints& hints)
+{
+  if (!FakeDatabase::hasNetworkHints)
+  {
+    return false;
+  }
+  memset(&hints, 0, sizeof(NetworkHints));
+  strcpy(hints.ssid, "foo");
+  hints.channel = 6;
+  return true;
+}
+
+bool FakeDatabase::setNetworkHints(const NetworkHints& hints)
+{
+  FakeDatabase::setNetworkHintsCalled = true;
+  FakeDatabase::savedHints = hints;
+  return true;
+}
 
 Remote FakeDatabase::createRemote(const char* name)
 {
@@ -54,7 +102,14 @@ Remote FakeDatabase::createRemote(const char* name)
   return remote;
 }
 
-void FakeDatabase::getAllRemotes(Remote remotes[]) { }
+void FakeDatabase::getAllRemotes(Remote remotes[])
+{
+  for (int i = 0; i < MAX_REMOTES; ++i)
+  {
+    remotes[i] = { 0, 0, "" };
+  }
+  remotes[0] = this->getRemote(1);
+}
 
 Remote FakeDatabase::getRemote(const unsigned long& id)
 {
@@ -87,6 +142,217 @@ bool FakeDatabase::deleteRemote(const unsigned long& id)
   return true;
 }
 
+bool FakeDatabase::getCalibration(const unsigned long& id, Calibration& calibration)
+{
+  if (this->shouldReturnEmptyRemote)
+  {
+    return false;
+  }
+  calibration = FakeDatabase::calibration;
+  return true;
+}
+
+bool FakeDatabase::setCalibration(const unsigned long& id, const Calibration& calibration)
+{
+  if (this->shouldFailUpdateRemote)
+  {
+    return false;
+  }
+  FakeDatabase::calibration = calibration;
+  return true;
+}
+
+bool FakeDatabase::getNonceMark(const unsigned long& id, unsigned long& mark)
+{
+  if (this->shouldReturnEmptyRemote || id == 0 || id > MAX_REMOTES)
+  {
+    return false;
+  }
+  mark = FakeDatabase::nonceMarks[id];
+  return true;
+}
+
+bool FakeDatabase::setNonceMark(const unsigned long& id, const unsigned long mark)
+{
+  if (this->shouldFailUpdateRemote || id == 0 || id > MAX_REMOTES)
+  {
+    return false;
+  }
+  FakeDatabase::nonceMarks[id] = mark;
+  FakeDatabase::nonceMarkWrites++;
+  return true;
+}
+
+void FakeDatabase::getAllSchedules(Schedule schedules[])
+{
+  memcpy(schedules, FakeDatabase::schedules, sizeof(FakeDatabase::schedules));
+}
+
+Schedule FakeDatabase::createSchedule(const Schedule& schedule)
+{
+  Schedule created = schedule;
+  created.id = 0;
+  for (int i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    if (FakeDatabase::schedules[i].id == 0)
+    {
+      created.id = i + 1;
+      FakeDatabase::schedules[i] = created;
+      break;
+    }
+  }
+  return created;
+}
+
+bool FakeDatabase::deleteSchedule(const unsigned char id)
+{
+  if (id == 0 || id > MAX_SCHEDULES || FakeDatabase::schedules[id - 1].id != id)
+  {
+    return false;
+  }
+  memset(&FakeDatabase::schedules[id - 1], 0, sizeof(Schedule));
+  return true;
+}
+
+void FakeDatabase::getAllGroups(Group groups[])
+{
+  memcpy(groups, FakeDatabase::groups, sizeof(FakeDatabase::groups));
+}
+
+Group FakeDatabase::getGroup(const unsigned char id)
+{
+  Group group = {};
+  if (id == 0 || id > MAX_GROUPS)
+  {
+    return group;
+  }
+  return FakeDatabase::groups[id - 1];
+}
+
+Group FakeDatabase::createGroup(const Group& group)
+{
+  Group created = group;
+  created.id = 0;
+  for (int i = 0; i < MAX_GROUPS; ++i)
+  {
+    if (FakeDatabase::groups[i].id == 0)
+    {
+      created.id = i + 1;
+      FakeDatabase::groups[i] = created;
+      break;
+    }
+  }
+  return created;
+}
+
+bool FakeDatabase::deleteGroup(const unsigned char id)
+{
+  if (this->getGroup(id).id == 0)
+  {
+    return false;
+  }
+  memset(&FakeDatabase::groups[id - 1], 0, sizeof(Group));
+  return true;
+}
+
+void FakeDatabase::getAllScenes(Scene scenes[])
+{
+  memcpy(scenes, FakeDatabase::scenes, sizeof(FakeDatabase::scenes));
+}
+
+Scene FakeDatabase::getScene(const unsigned char id)
+{
+  Scene scene = {};
+  if (id == 0 || id > MAX_SCENES)
+  {
+    return scene;
+  }
+  return FakeDatabase::scenes[id - 1];
+}
+
+Scene FakeDatabase::createScene(const Scene& scene)
+{
+  Scene created = scene;
+  created.id = 0;
+  for (int i = 0; i < MAX_SCENES; ++i)
+  {
+    if (FakeDatabase::scenes[i].id == 0)
+    {
+      created.id = i + 1;
+      FakeDatabase::scenes[i] = created;
+      break;
+    }
+  }
+  return created;
+}
+
+bool FakeDatabase::deleteScene(const unsigned char id)
+{
+  if (this->getScene(id).id == 0)
+  {
+    return false;
+  }
+  memset(&FakeDatabase::scenes[id - 1], 0, sizeof(Scene));
+  return true;
+}
+
+void FakeDatabase::getAllMacros(Macro macros[])
+{
+  memcpy(macros, FakeDatabase::macros, sizeof(FakeDatabase::macros));
+}
+
+Macro FakeDatabase::getMacro(const unsigned char id)
+{
+  Macro macro = {};
+  if (id == 0 || id > MAX_MACROS)
+  {
+    return macro;
+  }
+  return FakeDatabase::macros[id - 1];
+}
+
+Macro FakeDatabase::createMacro(const Macro& macro)
+{
+  Macro created = macro;
+  created.id = 0;
+  for (int i = 0; i < MAX_MACROS; ++i)
+  {
+    if (FakeDatabase::macros[i].id == 0)
+    {
+      created.id = i + 1;
+      FakeDatabase::macros[i] = created;
+      break;
+    }
+  }
+  return created;
+}
+
+bool FakeDatabase::deleteMacro(const unsigned char id)
+{
+  if (this->getMacro(id).id == 0)
+  {
+    return false;
+  }
+  memset(&FakeDatabase::macros[id - 1], 0, sizeof(Macro));
+  return true;
+}
+
+void FakeDatabase::beginBatch() { FakeDatabase::isBatching = true; }
+
+bool FakeDatabase::endBatch()
+{
+  FakeDatabase::isBatching = false;
+  FakeDatabase::batchCount++;
+  return true;
+}
+
+void FakeDatabase::getChangesSince(const unsigned long& sequence, ChangeFeed& feed)
+{
+  feed.size = 0;
+  feed.lastSequence = sequence;
+  feed.resyncRequired = false;
+}
+
 // Fake Serializer
 String FakeSerializer::serializeRemote(const Remote& remote) { return String("Remote serialized"); }
 
@@ -95,7 +361,7 @@ String FakeSerializer::serializeRemotes(const Remote remotes[], int size)
   return String("Remotes serialized");
 }
 
-String FakeSerializer::serializeNetworkConfig(const NetworkConfiguration& networkConfig)
+String FakeSerializer::serializeNetworkConfigs(const NetworkConfiguration networkConfigs[], int size)
 {
   return String("NetworkConfiguration serialized");
 }
@@ -110,6 +376,67 @@ String FakeSerializer::serializeSystemInfos(const SystemInfos& infos)
   return String("SystemInfos serialized");
 }
 
+String FakeSerializer::serializeChangeFeed(const ChangeFeed& feed)
+{
+  return String("ChangeFeed serialized");
+}
+
+String FakeSerializer::serializeAdmissionMetrics(const AdmissionMetrics& metrics)
+{
+  return String("AdmissionMetrics serialized");
+}
+
+String FakeSerializer::serializeBootProfile(const BootProfile& profile)
+{
+  return String("BootProfile serialized");
+}
+
+String FakeSerializer::serializeSwitchoverStatus(const SwitchoverStatus& status)
+{
+  return String("SwitchoverStatus serialized");
+}
+
+String FakeSerializer::serializeSchedule(const Schedule& schedule)
+{
+  return String("Schedule serialized");
+}
+
+String FakeSerializer::serializeSchedules(const Schedule schedules[], int size)
+{
+  return String("Schedules serialized");
+}
+
+String FakeSerializer::serializeRemotePosition(const RemotePosition& position)
+{
+  return String("RemotePosition serialized");
+}
+
+String FakeSerializer::serializeGroup(const Group& group) { return String("Group serialized"); }
+
+String FakeSerializer::serializeGroups(const Group groups[], int size)
+{
+  return String("Groups serialized");
+}
+
+String FakeSerializer::serializeScene(const Scene& scene) { return String("Scene serialized"); }
+
+String FakeSerializer::serializeScenes(const Scene scenes[], int size)
+{
+  return String("Scenes serialized");
+}
+
+String FakeSerializer::serializeSceneReport(const SceneReport& report)
+{
+  return String("SceneReport serialized");
+}
+
+String FakeSerializer::serializeMacro(const Macro& macro) { return String("Macro serialized"); }
+
+String FakeSerializer::serializeMacros(const Macro macros[], int size)
+{
+  return String("Macros serialized");
+}
+
 // Fake Transmitter
 bool FakeTransmitter::sendUPCommandCalled = false;
 bool FakeTransmitter::sendSTOPCommandCalled = false;
@@ -138,11 +465,142 @@ bool FakeTransmitter::sendProgCmd(const unsigned long remoteId, const unsigned i
 }
 
 // Fake NetworkClient
-bool FakeNetworkClient::connect(const NetworkConfiguration& conf) { return true; };
-bool FakeNetworkClient::connect(const char* ssid, const char* password) { return true; };
+bool FakeNetworkClient::isConnectedToNetwork = true;
+bool FakeNetworkClient::beginConnectCalled = false;
+bool FakeNetworkClient::beginConnectWithHints = false;
+int FakeNetworkClient::beginConnectCount = 0;
+char FakeNetworkClient::connectedSsid[33] = "";
+bool FakeNetworkClient::reportsSsid = true;
+bool FakeNetworkClient::disconnectCalled = false;
+bool FakeNetworkClient::shouldFailStartScan = false;
+bool FakeNetworkClient::startScanCalled = false;
+int FakeNetworkClient::scanStatus = NETWORK_SCAN_FAILED;
+Network FakeNetworkClient::scanResults[8];
+
+bool FakeNetworkClient::beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints)
+{
+  FakeNetworkClient::beginConnectCalled = true;
+  FakeNetworkClient::beginConnectWithHints = hints != NULL;
+  FakeNetworkClient::beginConnectCount++;
+  strcpy(FakeNetworkClient::connectedSsid, conf.ssid);
+  return true;
+};
+bool FakeNetworkClient::getConnectionHints(NetworkHints& hints)
+{
+  memset(&hints, 0, sizeof(NetworkHints));
+  if (FakeNetworkClient::reportsSsid)
+  {
+    strcpy(hints.ssid, FakeNetworkClient::connectedSsid);
+  }
+  hints.channel = 11;
+  return FakeNetworkClient::isConnectedToNetwork;
+};
+void FakeNetworkClient::disconnect() { FakeNetworkClient::disconnectCalled = true; };
 String FakeNetworkClient::getIP() { return String("192.168.1.42"); };
-bool FakeNetworkClient::isConnected() { return true; };
-void FakeNetworkClient::getNetworks(Network networks[]) {};
+bool FakeNetworkClient::isConnected() { return FakeNetworkClient::isConnectedToNetwork; };
+bool FakeNetworkClient::startScan()
+{
+  FakeNetworkClient::startScanCalled = true;
+  FakeNetworkClient::scanStatus = FakeNetworkClient::shouldFailStartScan ? NETWORK_SCAN_FAILED
+                                                                          : NETWORK_SCAN_RUNNING;
+  return !FakeNetworkClient::shouldFailStartScan;
+};
+int FakeNetworkClient::getScanStatus() { return FakeNetworkClient::scanStatus; };
+bool FakeNetworkClient::getScanResult(const int index, Network& network)
+{
+  if (index < 0 || index >= FakeNetworkClient::scanStatus)
+  {
+    return false;
+  }
+  network = FakeNetworkClient::scanResults[index];
+  return true;
+};
+void FakeNetworkClient::deleteScanResults() { FakeNetworkClient::scanStatus = NETWORK_SCAN_FAILED; };
+
+// Fake AccessPoint
+bool FakeAccessPoint::startAccessPointCalled = false;
+bool FakeAccessPoint::stopAccessPointCalled = false;
+bool FakeAccessPoint::running = false;
+
+void FakeAccessPoint::startAccessPoint(const char* ssid, const char* password)
+{
+  FakeAccessPoint::startAccessPointCalled = true;
+  FakeAccessPoint::running = true;
+};
+void FakeAccessPoint::stopAccessPoint()
+{
+  FakeAccessPoint::stopAccessPointCalled = true;
+  FakeAccessPoint::running = false;
+};
+bool FakeAccessPoint::isRunning() { return FakeAccessPoint::running; };
+String FakeAccessPoint::getIP() { return String("192.168.4.1"); };
+
+// Fake NetworkSwitchover
+bool FakeNetworkSwitchover::isRunning = false;
+bool FakeNetworkSwitchover::beginCalled = false;
+
+bool FakeNetworkSwitchover::begin(
+    const NetworkConfiguration networkConfigs[], const unsigned char size)
+{
+  FakeNetworkSwitchover::beginCalled = true;
+  return !FakeNetworkSwitchover::isRunning;
+};
+SwitchoverStatus FakeNetworkSwitchover::getStatus()
+{
+  SwitchoverStatus status = { SWITCHOVER_PENDING, 0, "" };
+  return status;
+};
+
+// Fake EventPublisher
+int FakeEventPublisher::publishCount = 0;
+EventType FakeEventPublisher::lastType = EVENT_REMOTE_CREATED;
+
+void FakeEventPublisher::publish(const EventType type, const Remote& remote, const char* action)
+{
+  FakeEventPublisher::publishCount++;
+  FakeEventPublisher::lastType = type;
+};
+
+// Fake MqttClient
+bool FakeMqttClient::connected = false;
+int FakeMqttClient::beginConnectCount = 0;
+char FakeMqttClient::subscribedTopic[MQTT_TOPIC_LENGTH] = "";
+int FakeMqttClient::publishCount = 0;
+int FakeMqttClient::acceptedPublishes = -1;
+char FakeMqttClient::lastTopic[MQTT_TOPIC_LENGTH] = "";
+char FakeMqttClient::lastPayload[MQTT_DOCUMENT_LENGTH] = "";
+bool FakeMqttClient::lastRetain = false;
+
+void FakeMqttClient::beginConnect(
+    const char* clientId, const char* willTopic, const char* willPayload)
+{
+  FakeMqttClient::beginConnectCount++;
+};
+
+bool FakeMqttClient::isConnected() { return FakeMqttClient::connected; };
+
+bool FakeMqttClient::subscribe(const char* topic)
+{
+  strcpy(FakeMqttClient::subscribedTopic, topic);
+  return true;
+};
+
+bool FakeMqttClient::publish(const char* topic, const char* payload, const bool retain)
+{
+  if (FakeMqttClient::acceptedPublishes == 0)
+  {
+    return false;
+  }
+  if (FakeMqttClient::acceptedPublishes > 0)
+  {
+    FakeMqttClient::acceptedPublishes--;
+  }
+  FakeMqttClient::publishCount++;
+  strcpy(FakeMqttClient::lastTopic, topic);
+  strcpy(FakeMqttClient::lastPayload, payload);
+  FakeMqttClient::lastRetain = retain;
+  return true;
+};
 
 // TEST CONTROLLER
 // ############################################################################
@@ -151,8 +609,11 @@ FakeDatabase databaseFake;
 FakeNetworkClient networkClientFake;
 FakeSerializer serializerFake;
 FakeTransmitter transmitterFake;
+FakeNetworkSwitchover networkSwitchoverFake;
+FakeEventPublisher eventPublisherFake;
 
-Controller controllerTest(&databaseFake, &networkClientFake, &serializerFake, &transmitterFake);
+Controller controllerTest(&databaseFake, &networkClientFake, &serializerFake, &transmitterFake,
+    &networkSwitchoverFake, &eventPublisherFake);
 
 void RUN_CONTROLLER_TESTS(void){
   RUN_TEST(test_METHOD_fetchSystemInfos_SHOULD_return_systeminfos);
@@ -172,6 +633,7 @@ void RUN_CONTROLLER_TESTS(void){
   RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_name_too_long_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_null_name_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_valid_name_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_new_name_SHOULD_publish_renamed_event);
   RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_operateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false);
@@ -179,17 +641,37 @@ void RUN_CONTROLLER_TESTS(void){
   RUN_TEST(test_METHOD_operateRemote_WITH_empty_action_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_operateRemote_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_operateRemote_WITH_unknown_action_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_checkCommand_SHOULD_validate_command_WITHOUT_sending_it);
   RUN_TEST(test_METHOD_operateRemote_WITH_valide_remote_AND_up_action_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_operateRemote_WITH_valide_remote_AND_stop_action_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_operateRemote_WITH_valide_remote_AND_down_action_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_operateRemote_WITH_valide_remote_AND_pair_action_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_fetchRemoteChanges_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_valid_data_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_valid_data_AND_empty_password_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_null_SSID_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_empty_SSID_SHOULD_return_result_WITH_success_to_false);
-  RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_update_fail_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_updateNetworkConfiguration_WITH_switchover_running_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_updateNetworkConfigurations_WITH_two_networks_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_updateNetworkConfigurations_WITH_too_many_networks_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_fetchNetworkSwitchover_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_createSchedule_WITH_valid_schedule_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_createSchedule_WITH_invalid_minutes_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createSchedule_WITH_unknown_event_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createSchedule_WITH_no_space_left_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_deleteSchedule_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_calibrateRemote_WITH_valid_times_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_calibrateRemote_WITH_too_long_time_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createGroup_WITH_valid_remotes_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_createGroup_WITH_remote_given_twice_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createScene_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_createScene_WITH_invalid_action_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createScene_WITH_too_long_delay_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_deleteScene_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createMacro_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_createMacro_WITH_too_long_wait_SHOULD_return_result_WITH_success_to_false);
 }
 
 void test_METHOD_fetchSystemInfos_SHOULD_return_systeminfos(void)
@@ -198,7 +680,7 @@ void test_METHOD_fetchSystemInfos_SHOULD_return_systeminfos(void)
 
   TEST_ASSERT_TRUE(result.isSuccess);
   TEST_ASSERT_EQUAL_STRING("SystemInfos serialized", result.data.c_str());
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_fetchRemote_WITH_unspecified_id_SHOULD_return_result_WITH_success_to_false(void)
@@ -207,7 +689,7 @@ void test_METHOD_fetchRemote_WITH_unspecified_id_SHOULD_return_result_WITH_succe
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, result.code);
 }
 
 void test_METHOD_fetchRemote_WITH_remote_not_found_SHOULD_return_result_WITH_success_to_false(void)
@@ -218,7 +700,7 @@ void test_METHOD_fetchRemote_WITH_remote_not_found_SHOULD_return_result_WITH_suc
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_FOUND, result.code);
 }
 
 void test_METHOD_fetchRemote_SHOULD_return_result_WITH_success_to_true(void)
@@ -227,7 +709,7 @@ void test_METHOD_fetchRemote_SHOULD_return_result_WITH_success_to_true(void)
 
   TEST_ASSERT_EQUAL_STRING("Remote serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_fetchAllRemotes_SHOULD_return_result_WITH_success_to_true(void)
@@ -236,7 +718,7 @@ void test_METHOD_fetchAllRemotes_SHOULD_return_result_WITH_success_to_true(void)
 
   TEST_ASSERT_EQUAL_STRING("Remotes serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_createRemote_WITH_null_name_SHOULD_return_result_WITH_success_to_false(void)
@@ -245,7 +727,7 @@ void test_METHOD_createRemote_WITH_null_name_SHOULD_return_result_WITH_success_t
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NAME_MISSING, result.code);
 }
 
 void test_METHOD_createRemote_WITH_empty_name_SHOULD_return_result_WITH_success_to_false(void)
@@ -254,7 +736,7 @@ void test_METHOD_createRemote_WITH_empty_name_SHOULD_return_result_WITH_success_
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NAME_EMPTY, result.code);
 }
 
 void test_METHOD_createRemote_WITH_name_too_long_SHOULD_return_result_WITH_success_to_false(void)
@@ -263,7 +745,7 @@ void test_METHOD_createRemote_WITH_name_too_long_SHOULD_return_result_WITH_succe
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NAME_TOO_LONG, result.code);
 }
 
 void test_METHOD_createRemote_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void)
@@ -273,7 +755,7 @@ void test_METHOD_createRemote_WITH_database_fail_SHOULD_return_result_WITH_succe
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_NO_SPACE_LEFT, result.code);
 }
 
 void test_METHOD_createRemote_SHOULD_return_result_WITH_success_to_true(void)
@@ -282,7 +764,8 @@ void test_METHOD_createRemote_SHOULD_return_result_WITH_success_to_true(void)
 
   TEST_ASSERT_EQUAL_STRING("Remote serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
+  TEST_ASSERT_EQUAL(EVENT_REMOTE_CREATED, FakeEventPublisher::lastType);
 }
 
 void test_METHOD_deleteRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false(void)
@@ -291,7 +774,7 @@ void test_METHOD_deleteRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_suc
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, result.code);
 }
 
 void test_METHOD_deleteRemote_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void)
@@ -302,7 +785,7 @@ void test_METHOD_deleteRemote_WITH_database_fail_SHOULD_return_result_WITH_succe
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_FOUND, result.code);
 }
 
 void test_METHOD_deleteRemote_SHOULD_return_result_WITH_success_to_true(void)
@@ -310,7 +793,8 @@ void test_METHOD_deleteRemote_SHOULD_return_result_WITH_success_to_true(void)
   Result result = controllerTest.deleteRemote(1);
 
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_DELETED, result.code);
+  TEST_ASSERT_EQUAL(EVENT_REMOTE_DELETED, FakeEventPublisher::lastType);
 }
 
 void test_METHOD_updateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false(void)
@@ -319,7 +803,7 @@ void test_METHOD_updateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_suc
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, result.code);
 }
 
 void test_METHOD_updateRemote_WITH_remote_not_found_SHOULD_return_result_WITH_success_to_false(void)
@@ -330,7 +814,7 @@ void test_METHOD_updateRemote_WITH_remote_not_found_SHOULD_return_result_WITH_su
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_FOUND, result.code);
 }
 
 void test_METHOD_updateRemote_WITH_valid_remote_AND_name_too_long_SHOULD_return_result_WITH_success_to_false(
@@ -340,7 +824,7 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_name_too_long_SHOULD_return_
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NAME_TOO_LONG, result.code);
 }
 
 void test_METHOD_updateRemote_WITH_valid_remote_AND_null_name_SHOULD_return_result_WITH_success_to_true(
@@ -350,7 +834,7 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_null_name_SHOULD_return_resu
 
   TEST_ASSERT_EQUAL_STRING("Remote serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_name_SHOULD_return_result_WITH_success_to_true(
@@ -360,7 +844,18 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_name_SHOULD_return_res
 
   TEST_ASSERT_EQUAL_STRING("Remote serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
+  // Same name, nothing to tell.
+  TEST_ASSERT_EQUAL(0, FakeEventPublisher::publishCount);
+}
+
+void test_METHOD_updateRemote_WITH_valid_remote_AND_new_name_SHOULD_publish_renamed_event(void)
+{
+  Result result = controllerTest.updateRemote(1, "bar", 0);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(1, FakeEventPublisher::publishCount);
+  TEST_ASSERT_EQUAL(EVENT_REMOTE_RENAMED, FakeEventPublisher::lastType);
 }
 
 void test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD_return_result_WITH_success_to_true(
@@ -370,7 +865,7 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD
 
   TEST_ASSERT_EQUAL_STRING("Remote serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail_SHOULD_return_result_WITH_success_to_false(
@@ -382,7 +877,7 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_UPDATE_FAILED, result.code);
 }
 
 void test_METHOD_operateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false(void)
@@ -391,7 +886,7 @@ void test_METHOD_operateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_su
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, result.code);
 }
 
 void test_METHOD_operateRemote_WITH_null_action_SHOULD_return_result_WITH_success_to_false(void)
@@ -400,7 +895,7 @@ void test_METHOD_operateRemote_WITH_null_action_SHOULD_return_result_WITH_succes
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_ACTION_MISSING, result.code);
 }
 
 void test_METHOD_operateRemote_WITH_empty_action_SHOULD_return_result_WITH_success_to_false(void)
@@ -409,7 +904,7 @@ void test_METHOD_operateRemote_WITH_empty_action_SHOULD_return_result_WITH_succe
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_ACTION_MISSING, result.code);
 }
 
 void test_METHOD_operateRemote_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
@@ -421,7 +916,7 @@ void test_METHOD_operateRemote_WITH_not_found_remote_SHOULD_return_result_WITH_s
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_FOUND, result.code);
 }
 
 void test_METHOD_operateRemote_WITH_unknown_action_SHOULD_return_result_WITH_success_to_false(void)
@@ -430,7 +925,22 @@ void test_METHOD_operateRemote_WITH_unknown_action_SHOULD_return_result_WITH_suc
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_ACTION_INVALID, result.code);
+}
+
+void test_METHOD_checkCommand_SHOULD_validate_command_WITHOUT_sending_it(void)
+{
+  Result result = controllerTest.checkCommand(1, "up");
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_ACTION_INVALID, controllerTest.checkCommand(1, "foo").code);
+  TEST_ASSERT_EQUAL(RESULT_ACTION_MISSING, controllerTest.checkCommand(1, "").code);
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, controllerTest.checkCommand(0, "up").code);
+
+  FakeDatabase::shouldReturnEmptyRemote = true;
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_FOUND, controllerTest.checkCommand(1, "up").code);
 }
 
 void test_METHOD_operateRemote_WITH_valide_remote_AND_up_action_SHOULD_return_result_WITH_success_to_true(
@@ -438,10 +948,14 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_up_action_SHOULD_return_re
 {
   Result result = controllerTest.operateRemote(1, "up");
 
-  TEST_ASSERT_EQUAL_STRING("Command UP sent.", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_UP_SENT, result.code);
+  TEST_ASSERT_EQUAL_STRING("Command UP sent.", String(getResultMessage(result.code)).c_str());
   TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  // Queued, then transmitted.
+  TEST_ASSERT_EQUAL(2, FakeEventPublisher::publishCount);
+  TEST_ASSERT_EQUAL(EVENT_COMMAND_TRANSMITTED, FakeEventPublisher::lastType);
 }
 
 void test_METHOD_operateRemote_WITH_valide_remote_AND_stop_action_SHOULD_return_result_WITH_success_to_true(
@@ -449,9 +963,10 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_stop_action_SHOULD_return_
 {
   Result result = controllerTest.operateRemote(1, "stop");
 
-  TEST_ASSERT_EQUAL_STRING("Command STOP sent.", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, result.code);
+  TEST_ASSERT_EQUAL_STRING("Command STOP sent.", String(getResultMessage(result.code)).c_str());
   TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
 }
 
@@ -460,9 +975,10 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_down_action_SHOULD_return_
 {
   Result result = controllerTest.operateRemote(1, "down");
 
-  TEST_ASSERT_EQUAL_STRING("Command DOWN sent.", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DOWN_SENT, result.code);
+  TEST_ASSERT_EQUAL_STRING("Command DOWN sent.", String(getResultMessage(result.code)).c_str());
   TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
 }
 
@@ -471,9 +987,10 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_pair_action_SHOULD_return_
 {
   Result result = controllerTest.operateRemote(1, "pair");
 
-  TEST_ASSERT_EQUAL_STRING("Command PAIR sent.", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_PAIR_SENT, result.code);
+  TEST_ASSERT_EQUAL_STRING("Command PAIR sent.", String(getResultMessage(result.code)).c_str());
   TEST_ASSERT_TRUE(FakeTransmitter::sendPROGCommandCalled);
 }
 
@@ -482,9 +999,20 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return
 {
   Result result = controllerTest.operateRemote(1, "reset");
 
-  TEST_ASSERT_EQUAL_STRING("Rolling code reseted.", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_ROLLING_CODE_RESET, result.code);
+  TEST_ASSERT_EQUAL_STRING("Rolling code reseted.", String(getResultMessage(result.code)).c_str());
+  TEST_ASSERT_EQUAL(EVENT_ROLLING_CODE_RESET, FakeEventPublisher::lastType);
+}
+
+void test_METHOD_fetchRemoteChanges_SHOULD_return_result_WITH_success_to_true(void)
+{
+  Result result = controllerTest.fetchRemoteChanges(0);
+
+  TEST_ASSERT_EQUAL_STRING("ChangeFeed serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true(void)
@@ -493,7 +1021,7 @@ void test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_
 
   TEST_ASSERT_EQUAL_STRING("NetworkConfiguration serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
 }
 
 void test_METHOD_updateNetworkConfiguration_WITH_valid_data_SHOULD_return_result_WITH_success_to_true(
@@ -501,9 +1029,10 @@ void test_METHOD_updateNetworkConfiguration_WITH_valid_data_SHOULD_return_result
 {
   Result result = controllerTest.updateNetworkConfiguration("foo", "bar");
 
-  TEST_ASSERT_EQUAL_STRING("NetworkConfiguration serialized", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING("SwitchoverStatus serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_NETWORK_SWITCHOVER_STARTED, result.code);
+  TEST_ASSERT_TRUE(FakeNetworkSwitchover::beginCalled);
 }
 
 void test_METHOD_updateNetworkConfiguration_WITH_valid_data_AND_empty_password_SHOULD_return_result_WITH_success_to_true(
@@ -511,9 +1040,10 @@ void test_METHOD_updateNetworkConfiguration_WITH_valid_data_AND_empty_password_S
 {
   Result result = controllerTest.updateNetworkConfiguration("foo", nullptr);
 
-  TEST_ASSERT_EQUAL_STRING("NetworkConfiguration serialized", result.data.c_str());
+  TEST_ASSERT_EQUAL_STRING("SwitchoverStatus serialized", result.data.c_str());
   TEST_ASSERT_TRUE(result.isSuccess);
-  TEST_ASSERT_EQUAL_STRING_LEN("", result.error.c_str(), 0);
+  TEST_ASSERT_EQUAL(RESULT_NETWORK_SWITCHOVER_STARTED, result.code);
+  TEST_ASSERT_TRUE(FakeNetworkSwitchover::beginCalled);
 }
 
 void test_METHOD_updateNetworkConfiguration_WITH_null_SSID_SHOULD_return_result_WITH_success_to_false(
@@ -523,7 +1053,7 @@ void test_METHOD_updateNetworkConfiguration_WITH_null_SSID_SHOULD_return_result_
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_SSID_MISSING, result.code);
 }
 
 void test_METHOD_updateNetworkConfiguration_WITH_empty_SSID_SHOULD_return_result_WITH_success_to_false(
@@ -533,17 +1063,212 @@ void test_METHOD_updateNetworkConfiguration_WITH_empty_SSID_SHOULD_return_result
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_SSID_EMPTY, result.code);
 }
 
-void test_METHOD_updateNetworkConfiguration_WITH_update_fail_SHOULD_return_result_WITH_success_to_false(
+void test_METHOD_updateNetworkConfiguration_WITH_switchover_running_SHOULD_return_result_WITH_success_to_false(
     void)
 {
-  FakeDatabase::shouldFailUpdateNetworkConfiguration = true;
+  FakeNetworkSwitchover::isRunning = true;
 
   Result result = controllerTest.updateNetworkConfiguration("foo", nullptr);
 
   TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
   TEST_ASSERT_FALSE(result.isSuccess);
-  TEST_ASSERT_GREATER_OR_EQUAL(1, result.error.length());
+  TEST_ASSERT_EQUAL(RESULT_NETWORK_SWITCHOVER_RUNNING, result.code);
 }
+
+
+void test_METHOD_updateNetworkConfigurations_WITH_two_networks_SHOULD_return_result_WITH_success_to_true(
+    void)
+{
+  const char* ssids[] = { "foo", "baz" };
+  const char* passwords[] = { "bar", nullptr };
+
+  Result result = controllerTest.updateNetworkConfigurations(ssids, passwords, 2);
+
+  TEST_ASSERT_EQUAL_STRING("SwitchoverStatus serialized", result.data.c_str());
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_NETWORK_SWITCHOVER_STARTED, result.code);
+  TEST_ASSERT_TRUE(FakeNetworkSwitchover::beginCalled);
+}
+
+void test_METHOD_updateNetworkConfigurations_WITH_too_many_networks_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  const char* ssids[] = { "a", "b", "c", "d", "e" };
+  const char* passwords[] = { "", "", "", "", "" };
+
+  Result result = controllerTest.updateNetworkConfigurations(ssids, passwords, 5);
+
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_TOO_MANY_NETWORKS, result.code);
+}
+
+void test_METHOD_fetchNetworkSwitchover_SHOULD_return_result_WITH_success_to_true(void)
+{
+  Result result = controllerTest.fetchNetworkSwitchover();
+
+  TEST_ASSERT_EQUAL_STRING("SwitchoverStatus serialized", result.data.c_str());
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_OK, result.code);
+}
+
+void test_METHOD_createSchedule_WITH_valid_schedule_SHOULD_return_result_WITH_success_to_true(void)
+{
+  Result result = controllerTest.createSchedule(1, "down", "sunset", -15, 0x7F);
+
+  TEST_ASSERT_EQUAL_STRING("Schedule serialized", result.data.c_str());
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(1, FakeDatabase::schedules[0].id);
+  TEST_ASSERT_EQUAL(SCHEDULE_AT_SUNSET, FakeDatabase::schedules[0].event);
+  TEST_ASSERT_EQUAL(SCHEDULE_DOWN, FakeDatabase::schedules[0].action);
+  TEST_ASSERT_EQUAL(-15, FakeDatabase::schedules[0].minutes);
+}
+
+void test_METHOD_createSchedule_WITH_invalid_minutes_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result result = controllerTest.createSchedule(1, "up", "time", 24 * 60, 0x7F);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCHEDULE_INVALID, result.code);
+  TEST_ASSERT_EQUAL(0, FakeDatabase::schedules[0].id);
+}
+
+void test_METHOD_createSchedule_WITH_unknown_event_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result result = controllerTest.createSchedule(1, "up", "noon", 0, 0x7F);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCHEDULE_INVALID, result.code);
+}
+
+void test_METHOD_createSchedule_WITH_no_space_left_SHOULD_return_result_WITH_success_to_false(void)
+{
+  for (int i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    TEST_ASSERT_TRUE(controllerTest.createSchedule(1, "up", "time", i, 0x7F).isSuccess);
+  }
+
+  Result result = controllerTest.createSchedule(1, "up", "time", 0, 0x7F);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_TOO_MANY_SCHEDULES, result.code);
+}
+
+void test_METHOD_deleteSchedule_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result result = controllerTest.deleteSchedule(3);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCHEDULE_NOT_FOUND, result.code);
+}
+
+void test_METHOD_calibrateRemote_WITH_valid_times_SHOULD_return_result_WITH_success_to_true(void)
+{
+  Result result = controllerTest.calibrateRemote(1, 20000, 16000);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_CALIBRATED, result.code);
+  TEST_ASSERT_EQUAL(20000, FakeDatabase::calibration.upTime);
+  TEST_ASSERT_EQUAL(16000, FakeDatabase::calibration.downTime);
+}
+
+void test_METHOD_calibrateRemote_WITH_too_long_time_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result result = controllerTest.calibrateRemote(1, 20000, MAX_TRAVEL_TIME + 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_CALIBRATION_INVALID, result.code);
+  TEST_ASSERT_EQUAL(0, FakeDatabase::calibration.downTime);
+}
+
+void test_METHOD_createGroup_WITH_valid_remotes_SHOULD_return_result_WITH_success_to_true(void)
+{
+  const unsigned long remoteIds[] = { 1, 2 };
+  Result result = controllerTest.createGroup("ground floor", remoteIds, 2);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_STRING("Group serialized", result.data.c_str());
+  TEST_ASSERT_EQUAL(1, FakeDatabase::groups[0].id);
+  TEST_ASSERT_EQUAL(2, FakeDatabase::groups[0].size);
+  TEST_ASSERT_EQUAL(2, FakeDatabase::groups[0].remoteIds[1]);
+}
+
+void test_METHOD_createGroup_WITH_remote_given_twice_SHOULD_return_result_WITH_success_to_false(void)
+{
+  const unsigned long remoteIds[] = { 1, 2, 1 };
+  Result result = controllerTest.createGroup("ground floor", remoteIds, 3);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_GROUP_INVALID, result.code);
+  TEST_ASSERT_EQUAL(0, FakeDatabase::groups[0].id);
+}
+
+void test_METHOD_createScene_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true(void)
+{
+  const unsigned long remoteIds[] = { 1, 2 };
+  const char* actions[] = { "down", "stop" };
+  const unsigned long delays[] = { 0, 1500 };
+  Result result = controllerTest.createScene("evening", remoteIds, actions, delays, 2);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_STRING("Scene serialized", result.data.c_str());
+  TEST_ASSERT_EQUAL(SCHEDULE_STOP, FakeDatabase::scenes[0].steps[1].action);
+  TEST_ASSERT_EQUAL(1500, FakeDatabase::scenes[0].steps[1].delay);
+}
+
+void test_METHOD_createScene_WITH_invalid_action_SHOULD_return_result_WITH_success_to_false(void)
+{
+  const unsigned long remoteIds[] = { 1 };
+  const char* actions[] = { "pair" };
+  const unsigned long delays[] = { 0 };
+  Result result = controllerTest.createScene("evening", remoteIds, actions, delays, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_INVALID, result.code);
+}
+
+void test_METHOD_createScene_WITH_too_long_delay_SHOULD_return_result_WITH_success_to_false(void)
+{
+  const unsigned long remoteIds[] = { 1 };
+  const char* actions[] = { "up" };
+  const unsigned long delays[] = { SCENE_MAX_DELAY + 1 };
+  Result result = controllerTest.createScene("evening", remoteIds, actions, delays, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_INVALID, result.code);
+  TEST_ASSERT_EQUAL(0, FakeDatabase::scenes[0].id);
+}
+
+void test_METHOD_deleteScene_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result result = controllerTest.deleteScene(2);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_NOT_FOUND, result.code);
+}
+
+void test_METHOD_createMacro_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true(void)
+{
+  const char* actions[] = { "down", "stop" };
+  const unsigned long waits[] = { 1200, 0 };
+  Result result = controllerTest.createMacro("tilt", actions, waits, 2);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_STRING("Macro serialized", result.data.c_str());
+  TEST_ASSERT_EQUAL(SCHEDULE_DOWN, FakeDatabase::macros[0].steps[0].action);
+  TEST_ASSERT_EQUAL(1200, FakeDatabase::macros[0].steps[0].wait);
+}
+
+void test_METHOD_createMacro_WITH_too_long_wait_SHOULD_return_result_WITH_success_to_false(void)
+{
+  const char* actions[] = { "down", "stop" };
+  const unsigned long waits[] = { MACRO_MAX_WAIT + 1, 0 };
+  Result result = controllerTest.createMacro("tilt", actions, waits, 2);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_MACRO_INVALID, result.code);
+  TEST_ASSERT_EQUAL(0, FakeDatabase::macros[0].id);
+}
\ No newline at end of file
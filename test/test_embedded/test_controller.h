@@ -4,7 +4,12 @@
 #include <databaseAbs.h>
 #include <serializerAbs.h>
 #include <transmitterAbs.h>
+#include <config.h>
+#include <accessPointAbs.h>
+#include <mqttClientAbs.h>
 #include <networkClientAbs.h>
+#include <eventPublisherAbs.h>
+#include <networkSwitchoverAbs.h>
 
 class FakeDatabase : public DatabaseAbstract
 {
@@ -15,15 +20,33 @@ class FakeDatabase : public DatabaseAbstract
   static bool shouldReturnEmptyRemote;
   static bool shouldFailCreateRemote;
   static bool shouldFailUpdateNetworkConfiguration;
+  static bool shouldReturnEmptyNetworkConfiguration;
+  static bool hasSeveralNetworkConfigurations;
+  static bool hasNetworkHints;
+  static bool setNetworkHintsCalled;
+  static bool setNetworkConfigurationsCalled;
+  static NetworkHints savedHints;
+  static Schedule schedules[MAX_SCHEDULES];
+  static Calibration calibration;
+  static unsigned long nonceMarks[MAX_REMOTES + 1]; // By remote id.
+  static unsigned char nonceMarkWrites;
+  static Group groups[MAX_GROUPS];
+  static Scene scenes[MAX_SCENES];
+  static Macro macros[MAX_MACROS];
+  static bool isBatching;
+  static unsigned char batchCount;
 
   void init();
   bool migrate();
 
   SystemInfos getSystemInfos();
 
-  NetworkConfiguration getNetworkConfiguration();
-  bool setNetworkConfiguration(const NetworkConfiguration& networkConfig);
-  void resetNetworkConfiguration();
+  unsigned char getNetworkConfigurations(NetworkConfiguration networkConfigs[]);
+  bool setNetworkConfigurations(
+      const NetworkConfiguration networkConfigs[], const unsigned char size);
+  void resetNetworkConfigurations();
+  bool getNetworkHints(NetworkHints& hints);
+  bool setNetworkHints(const NetworkHints& hints);
 
   // CRUD
   Remote createRemote(const char* name);
@@ -31,6 +54,33 @@ class FakeDatabase : public DatabaseAbstract
   Remote getRemote(const unsigned long& id);
   bool updateRemote(const Remote& remote);
   bool deleteRemote(const unsigned long& id);
+
+  bool getCalibration(const unsigned long& id, Calibration& calibration);
+  bool setCalibration(const unsigned long& id, const Calibration& calibration);
+  bool getNonceMark(const unsigned long& id, unsigned long& mark);
+  bool setNonceMark(const unsigned long& id, const unsigned long mark);
+
+  void getAllSchedules(Schedule schedules[]);
+  Schedule createSchedule(const Schedule& schedule);
+  bool deleteSchedule(const unsigned char id);
+
+  void getAllGroups(Group groups[]);
+  Group getGroup(const unsigned char id);
+  Group createGroup(const Group& group);
+  bool deleteGroup(const unsigned char id);
+  void getAllScenes(Scene scenes[]);
+  Scene getScene(const unsigned char id);
+  Scene createScene(const Scene& scene);
+  bool deleteScene(const unsigned char id);
+  void getAllMacros(Macro macros[]);
+  Macro getMacro(const unsigned char id);
+  Macro createMacro(const Macro& macro);
+  bool deleteMacro(const unsigned char id);
+
+  void beginBatch();
+  bool endBatch();
+
+  void getChangesSince(const unsigned long& sequence, ChangeFeed& feed);
 };
 
 class FakeSerializer : public SerializerAbstract
@@ -38,9 +88,23 @@ class FakeSerializer : public SerializerAbstract
   public:
   String serializeRemote(const Remote& remote);
   String serializeRemotes(const Remote remotes[], int size);
-  String serializeNetworkConfig(const NetworkConfiguration& networkConfig);
+  String serializeNetworkConfigs(const NetworkConfiguration networkConfigs[], int size);
   String serializeNetworks(const Network networks[], int size);
   String serializeSystemInfos(const SystemInfos& infos);
+  String serializeChangeFeed(const ChangeFeed& feed);
+  String serializeAdmissionMetrics(const AdmissionMetrics& metrics);
+  String serializeBootProfile(const BootProfile& profile);
+  String serializeSwitchoverStatus(const SwitchoverStatus& status);
+  String serializeSchedule(const Schedule& schedule);
+  String serializeSchedules(const Schedule schedules[], int size);
+  String serializeRemotePosition(const RemotePosition& position);
+  String serializeGroup(const Group& group);
+  String serializeGroups(const Group groups[], int size);
+  String serializeScene(const Scene& scene);
+  String serializeScenes(const Scene scenes[], int size);
+  String serializeSceneReport(const SceneReport& report);
+  String serializeMacro(const Macro& macro);
+  String serializeMacros(const Macro macros[], int size);
 };
 
 class FakeTransmitter : public TransmitterAbstract
@@ -60,11 +124,76 @@ class FakeTransmitter : public TransmitterAbstract
 class FakeNetworkClient : public NetworkClientAbstract
 {
   public:
-  bool connect(const NetworkConfiguration& conf);
-  bool connect(const char* ssid, const char* password);
+  static bool isConnectedToNetwork;
+  static bool beginConnectCalled;
+  static bool beginConnectWithHints;
+  static int beginConnectCount;
+  static char connectedSsid[33];
+  static bool reportsSsid;
+  static bool disconnectCalled;
+  static bool shouldFailStartScan;
+  static bool startScanCalled;
+  static int scanStatus;
+  static Network scanResults[8];
+
+  bool beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints = NULL);
+  bool getConnectionHints(NetworkHints& hints);
+  void disconnect();
+  String getIP();
+  bool isConnected();
+  bool startScan();
+  int getScanStatus();
+  bool getScanResult(const int index, Network& network);
+  void deleteScanResults();
+};
+
+class FakeAccessPoint : public AccessPointAbstract
+{
+  public:
+  static bool startAccessPointCalled;
+  static bool stopAccessPointCalled;
+  static bool running;
+
+  void startAccessPoint(const char* ssid, const char* password = NULL);
+  void stopAccessPoint();
+  bool isRunning();
   String getIP();
+};
+class FakeNetworkSwitchover : public NetworkSwitchoverAbstract
+{
+  public:
+  static bool isRunning;
+  static bool beginCalled;
+
+  bool begin(const NetworkConfiguration networkConfigs[], const unsigned char size);
+  SwitchoverStatus getStatus();
+};
+
+class FakeEventPublisher : public EventPublisherAbstract
+{
+  public:
+  static int publishCount;
+  static EventType lastType;
+
+  void publish(const EventType type, const Remote& remote, const char* action = nullptr);
+};
+
+class FakeMqttClient : public MqttClientAbstract
+{
+  public:
+  static bool connected;
+  static int beginConnectCount;
+  static char subscribedTopic[MQTT_TOPIC_LENGTH];
+  static int publishCount;
+  static int acceptedPublishes; // Negative for no limit.
+  static char lastTopic[MQTT_TOPIC_LENGTH];
+  static char lastPayload[MQTT_DOCUMENT_LENGTH];
+  static bool lastRetain;
+
+  void beginConnect(const char* clientId, const char* willTopic, const char* willPayload);
   bool isConnected();
-  void getNetworks(Network networks[]);
+  bool subscribe(const char* topic);
+  bool publish(const char* topic, const char* payload, const bool retain);
 };
 
 // TEST controller
@@ -98,6 +227,7 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_null_name_SHOULD_return_resu
     void);
 void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_name_SHOULD_return_result_WITH_success_to_true(
     void);
+void test_METHOD_updateRemote_WITH_valid_remote_AND_new_name_SHOULD_publish_renamed_event(void);
 void test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD_return_result_WITH_success_to_true(
     void);
 void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail_SHOULD_return_result_WITH_success_to_false(
@@ -110,6 +240,7 @@ void test_METHOD_operateRemote_WITH_empty_action_SHOULD_return_result_WITH_succe
 void test_METHOD_operateRemote_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
     void);
 void test_METHOD_operateRemote_WITH_unknown_action_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_checkCommand_SHOULD_validate_command_WITHOUT_sending_it(void);
 void test_METHOD_operateRemote_WITH_valide_remote_AND_up_action_SHOULD_return_result_WITH_success_to_true(
     void);
 void test_METHOD_operateRemote_WITH_valide_remote_AND_stop_action_SHOULD_return_result_WITH_success_to_true(
@@ -121,10 +252,30 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_pair_action_SHOULD_return_
 void test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return_result_WITH_success_to_true(
     void);
 
+void test_METHOD_fetchRemoteChanges_SHOULD_return_result_WITH_success_to_true(void);
+
 void test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true(void);
 
 void test_METHOD_updateNetworkConfiguration_WITH_valid_data_SHOULD_return_result_WITH_success_to_true(void);
 void test_METHOD_updateNetworkConfiguration_WITH_valid_data_AND_empty_password_SHOULD_return_result_WITH_success_to_true(void);
 void test_METHOD_updateNetworkConfiguration_WITH_null_SSID_SHOULD_return_result_WITH_success_to_false(void);
 void test_METHOD_updateNetworkConfiguration_WITH_empty_SSID_SHOULD_return_result_WITH_success_to_false(void);
-void test_METHOD_updateNetworkConfiguration_WITH_update_fail_SHOULD_return_result_WITH_success_to_false(void);
\ No newline at end of file
+void test_METHOD_updateNetworkConfiguration_WITH_switchover_running_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_updateNetworkConfigurations_WITH_two_networks_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_updateNetworkConfigurations_WITH_too_many_networks_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_fetchNetworkSwitchover_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_createSchedule_WITH_valid_schedule_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_createSchedule_WITH_invalid_minutes_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createSchedule_WITH_unknown_event_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createSchedule_WITH_no_space_left_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_deleteSchedule_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_calibrateRemote_WITH_valid_times_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_calibrateRemote_WITH_too_long_time_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createGroup_WITH_valid_remotes_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_createGroup_WITH_remote_given_twice_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createScene_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_createScene_WITH_invalid_action_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createScene_WITH_too_long_delay_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_deleteScene_WITH_unknown_id_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createMacro_WITH_valid_steps_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_createMacro_WITH_too_long_wait_SHOULD_return_result_WITH_success_to_false(void);
\ No newline at end of file
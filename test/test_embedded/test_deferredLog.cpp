@@ -0,0 +1,174 @@
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <unity.h>
+
+#include <config.h>
+#include <deferredLog.h>
+
+#include "./test_deferredLog.h"
+
+class FakeOutput : public Print
+{
+  public:
+  String written;
+  int space = 1024;
+
+  size_t write(uint8_t c)
+  {
+    this->written += (char)c;
+    this->space--;
+    return 1;
+  }
+  int availableForWrite() { return this->space; }
+};
+
+String renderLogs(DeferredLog& log)
+{
+  String output;
+  RenderCursor cursor = { 0, 0, 0 };
+  char line[RENDER_LINE_LENGTH];
+  while (log.renderLine(cursor, line, sizeof(line)) > 0)
+  {
+    output += line;
+  }
+  return output;
+}
+
+void RUN_DEFERREDLOG_TESTS(void)
+{
+  RUN_TEST(test_METHOD_renderLine_WITH_records_SHOULD_format_arguments);
+  RUN_TEST(test_METHOD_renderLine_WITH_records_between_lines_SHOULD_render_first_window_once);
+  RUN_TEST(test_METHOD_flush_SHOULD_write_records_once);
+  RUN_TEST(test_METHOD_flush_WITH_full_output_SHOULD_keep_records);
+  RUN_TEST(test_METHOD_flush_WITH_overwritten_records_SHOULD_count_dropped);
+  RUN_TEST(test_METHOD_DLOG_DEBUG_WITH_info_level_SHOULD_not_record);
+  RUN_TEST(test_METHOD_DLOG_INFO_SHOULD_report_its_time_AND_the_one_of_DebugLog);
+}
+
+void test_METHOD_renderLine_WITH_records_SHOULD_format_arguments(void)
+{
+  DeferredLog log;
+  log.record(DEFERRED_LOG_LEVEL_INFO, PSTR("Command sent through the remote %lu, rolling code %lu."),
+      1048576UL, 42);
+  log.record(DEFERRED_LOG_LEVEL_ERROR, PSTR("The remote id should be specified."));
+
+  String output = renderLogs(log);
+
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), " [I] Command sent through the remote 1048576, rolling code 42.\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), " [E] The remote id should be specified.\n"));
+  TEST_ASSERT_TRUE(strstr(output.c_str(), "[I]") < strstr(output.c_str(), "[E]"));
+}
+
+void test_METHOD_renderLine_WITH_records_between_lines_SHOULD_render_first_window_once(void)
+{
+  DeferredLog log;
+  for (unsigned long i = 0; i < DEFERRED_LOG_SIZE; ++i)
+  {
+    log.record(DEFERRED_LOG_LEVEL_INFO, PSTR("record %lu."), i);
+  }
+  RenderCursor cursor = { 0, 0, 0 };
+  char line[RENDER_LINE_LENGTH];
+  String output;
+
+  log.renderLine(cursor, line, sizeof(line));
+  output += line;
+  log.renderLine(cursor, line, sizeof(line));
+  output += line;
+  // Overwrites the records 0 to 2, the third one was not rendered yet.
+  for (unsigned long i = DEFERRED_LOG_SIZE; i < DEFERRED_LOG_SIZE + 3; ++i)
+  {
+    log.record(DEFERRED_LOG_LEVEL_INFO, PSTR("record %lu."), i);
+  }
+  unsigned short lines = 2;
+  while (log.renderLine(cursor, line, sizeof(line)) > 0)
+  {
+    output += line;
+    lines++;
+  }
+
+  TEST_ASSERT_EQUAL(DEFERRED_LOG_SIZE - 1, lines);
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "record 1.\n"));
+  TEST_ASSERT_NULL(strstr(output.c_str(), "record 2.\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "record 3.\n"));
+  TEST_ASSERT_NULL(strstr(output.c_str(), "record 32.\n"));
+  TEST_ASSERT_TRUE(strstr(output.c_str(), "record 1.") < strstr(output.c_str(), "record 3."));
+}
+
+void test_METHOD_flush_SHOULD_write_records_once(void)
+{
+  DeferredLog log;
+  FakeOutput output;
+  log.record(DEFERRED_LOG_LEVEL_WARN, PSTR("foo %ld"), -1);
+  log.record(DEFERRED_LOG_LEVEL_WARN, PSTR("bar"));
+
+  TEST_ASSERT_EQUAL(1, log.flush(output, 1));
+  TEST_ASSERT_EQUAL(1, log.flush(output, 4));
+  TEST_ASSERT_EQUAL(0, log.flush(output, 4));
+  TEST_ASSERT_NOT_NULL(strstr(output.written.c_str(), " [W] foo -1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.written.c_str(), " [W] bar\n"));
+}
+
+void test_METHOD_flush_WITH_full_output_SHOULD_keep_records(void)
+{
+  DeferredLog log;
+  FakeOutput output;
+  output.space = 4;
+  log.record(DEFERRED_LOG_LEVEL_INFO, PSTR("foo"));
+
+  TEST_ASSERT_EQUAL(0, log.flush(output, 4));
+  output.space = 1024;
+  TEST_ASSERT_EQUAL(1, log.flush(output, 4));
+}
+
+void test_METHOD_flush_WITH_overwritten_records_SHOULD_count_dropped(void)
+{
+  DeferredLog log;
+  FakeOutput output;
+  for (unsigned long i = 0; i < DEFERRED_LOG_SIZE + 3; ++i)
+  {
+    log.record(DEFERRED_LOG_LEVEL_INFO, PSTR("record %lu"), i);
+  }
+
+  TEST_ASSERT_EQUAL(DEFERRED_LOG_SIZE, log.flush(output, DEFERRED_LOG_SIZE + 3));
+  TEST_ASSERT_EQUAL(3, log.getDropped());
+  TEST_ASSERT_NULL(strstr(output.written.c_str(), "record 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.written.c_str(), "record 3\n"));
+}
+
+void test_METHOD_DLOG_DEBUG_WITH_info_level_SHOULD_not_record(void)
+{
+  DLOG_DEBUG("Removed at compile time %lu.", 42UL);
+
+  TEST_ASSERT_NULL(strstr(renderLogs(deferredLog).c_str(), "Removed at compile time"));
+}
+
+void test_METHOD_DLOG_INFO_SHOULD_report_its_time_AND_the_one_of_DebugLog(void)
+{
+  static const unsigned short DLOG_CALLS = 1000;
+  // Each one waits for Serial once its FIFO is full, a few are enough.
+  static const unsigned char DEBUGLOG_CALLS = 20;
+
+  unsigned long start = micros();
+  for (unsigned long i = 0; i < DLOG_CALLS; ++i)
+  {
+    DLOG_INFO("Operating a command with the remote %lu.", i);
+  }
+  const unsigned long deferred = micros() - start;
+
+  // The call the controller made before, to the Serial at 115200 bauds, from an empty FIFO.
+  Serial.flush();
+  start = micros();
+  for (unsigned long i = 0; i < DEBUGLOG_CALLS; ++i)
+  {
+    LOG_INFO("Operating a command with the remote", i);
+  }
+  const unsigned long debugLog = micros() - start;
+
+  char message[96];
+  snprintf(message, sizeof(message), "Per call: DLOG_INFO %lu ns, LOG_INFO of DebugLog %lu us",
+      deferred * 1000 / DLOG_CALLS, debugLog / DEBUGLOG_CALLS);
+  // Only reported: the times depend on the clock of the board and on its load.
+  TEST_MESSAGE(message);
+  TEST_ASSERT_NOT_NULL(strstr(renderLogs(deferredLog).c_str(), "remote 999.\n"));
+}
\ No newline at end of file
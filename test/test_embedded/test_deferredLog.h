@@ -0,0 +1,11 @@
+#pragma once
+
+void RUN_DEFERREDLOG_TESTS(void);
+
+void test_METHOD_renderLine_WITH_records_SHOULD_format_arguments(void);
+void test_METHOD_renderLine_WITH_records_between_lines_SHOULD_render_first_window_once(void);
+void test_METHOD_flush_SHOULD_write_records_once(void);
+void test_METHOD_flush_WITH_full_output_SHOULD_keep_records(void);
+void test_METHOD_flush_WITH_overwritten_records_SHOULD_count_dropped(void);
+void test_METHOD_DLOG_DEBUG_WITH_info_level_SHOULD_not_record(void);
+void test_METHOD_DLOG_INFO_SHOULD_report_its_time_AND_the_one_of_DebugLog(void);
\ No newline at end of file
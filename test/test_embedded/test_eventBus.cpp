@@ -0,0 +1,187 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <event.h>
+#include <remote.h>
+#include <eventBus.h>
+
+#include "./test_eventBus.h"
+
+static Remote eventRemote = { 1, 42, "foo" };
+
+void RUN_EVENTBUS_TESTS(void)
+{
+  RUN_TEST(test_METHOD_read_WITH_published_event_SHOULD_write_frame);
+  RUN_TEST(test_METHOD_read_WITH_deleted_remote_SHOULD_only_write_its_id);
+  RUN_TEST(test_METHOD_read_WITH_small_buffer_SHOULD_write_frame_in_parts);
+  RUN_TEST(test_METHOD_subscribe_WITH_all_places_taken_SHOULD_return_minus_one);
+  RUN_TEST(test_METHOD_subscribe_WITH_last_event_id_SHOULD_resume_after_it);
+  RUN_TEST(test_METHOD_subscribe_WITH_last_event_id_out_of_ring_SHOULD_ask_resync);
+  RUN_TEST(test_METHOD_read_WITH_subscriber_behind_ring_SHOULD_drop_it);
+  RUN_TEST(test_METHOD_read_WITH_idle_stream_SHOULD_write_heartbeat);
+  RUN_TEST(test_METHOD_readEvent_WITH_reader_behind_ring_SHOULD_report_missed_events);
+}
+
+void test_METHOD_read_WITH_published_event_SHOULD_write_frame(void)
+{
+  EventBus bus;
+  short subscriber = bus.subscribe(0, 0);
+  uint8_t buffer[256] = {};
+
+  bus.publish(EVENT_COMMAND_TRANSMITTED, eventRemote, "up");
+  size_t length = bus.read(subscriber, buffer, sizeof(buffer) - 1, 0);
+
+  TEST_ASSERT_EQUAL_STRING("id: 1\nevent: command_transmitted\n"
+                           "data: {\"remote_id\":1,\"name\":\"foo\",\"rolling_code\":42,"
+                           "\"action\":\"up\"}\n\n",
+      (const char*)buffer);
+  TEST_ASSERT_EQUAL(strlen((const char*)buffer), length);
+  // Nothing more to send.
+  TEST_ASSERT_EQUAL(0, bus.read(subscriber, buffer, sizeof(buffer) - 1, 0));
+  TEST_ASSERT_FALSE(bus.isDropped(subscriber));
+}
+
+void test_METHOD_read_WITH_deleted_remote_SHOULD_only_write_its_id(void)
+{
+  EventBus bus;
+  short subscriber = bus.subscribe(0, 0);
+  uint8_t buffer[256] = {};
+  Remote deleted = { 7, 0, "" };
+
+  bus.publish(EVENT_REMOTE_DELETED, deleted);
+  bus.read(subscriber, buffer, sizeof(buffer) - 1, 0);
+
+  TEST_ASSERT_EQUAL_STRING(
+      "id: 1\nevent: remote_deleted\ndata: {\"remote_id\":7}\n\n", (const char*)buffer);
+}
+
+void test_METHOD_read_WITH_small_buffer_SHOULD_write_frame_in_parts(void)
+{
+  EventBus bus;
+  short subscriber = bus.subscribe(0, 0);
+  char stream[256] = {};
+  uint8_t buffer[8];
+  size_t total = 0;
+  size_t length = 0;
+
+  bus.publish(EVENT_REMOTE_CREATED, eventRemote);
+  bus.publish(EVENT_REMOTE_RENAMED, eventRemote);
+  while ((length = bus.read(subscriber, buffer, sizeof(buffer), 0)) > 0)
+  {
+    TEST_ASSERT_TRUE(length <= sizeof(buffer));
+    memcpy(stream + total, buffer, length);
+    total += length;
+  }
+
+  TEST_ASSERT_EQUAL_STRING(
+      "id: 1\nevent: remote_created\ndata: {\"remote_id\":1,\"name\":\"foo\",\"rolling_code\":42}"
+      "\n\n"
+      "id: 2\nevent: remote_renamed\ndata: {\"remote_id\":1,\"name\":\"foo\",\"rolling_code\":42}"
+      "\n\n",
+      stream);
+}
+
+void test_METHOD_subscribe_WITH_all_places_taken_SHOULD_return_minus_one(void)
+{
+  EventBus bus;
+  for (unsigned short i = 0; i < MAX_EVENT_SUBSCRIBERS; ++i)
+  {
+    TEST_ASSERT_EQUAL(i, bus.subscribe(0, 0));
+  }
+
+  TEST_ASSERT_EQUAL(-1, bus.subscribe(0, 0));
+
+  // A place freed is taken again.
+  bus.unsubscribe(1);
+  TEST_ASSERT_EQUAL(MAX_EVENT_SUBSCRIBERS - 1, bus.getSubscriberCount());
+  TEST_ASSERT_EQUAL(1, bus.subscribe(0, 0));
+}
+
+void test_METHOD_subscribe_WITH_last_event_id_SHOULD_resume_after_it(void)
+{
+  EventBus bus;
+  uint8_t buffer[256] = {};
+  bus.publish(EVENT_REMOTE_CREATED, eventRemote);
+  bus.publish(EVENT_COMMAND_QUEUED, eventRemote, "down");
+  bus.publish(EVENT_COMMAND_TRANSMITTED, eventRemote, "down");
+
+  short subscriber = bus.subscribe(2, 0);
+  bus.read(subscriber, buffer, sizeof(buffer) - 1, 0);
+
+  TEST_ASSERT_EQUAL_STRING("id: 3\nevent: command_transmitted\n"
+                           "data: {\"remote_id\":1,\"name\":\"foo\",\"rolling_code\":42,"
+                           "\"action\":\"down\"}\n\n",
+      (const char*)buffer);
+}
+
+void test_METHOD_subscribe_WITH_last_event_id_out_of_ring_SHOULD_ask_resync(void)
+{
+  EventBus bus;
+  uint8_t buffer[256] = {};
+  for (unsigned short i = 0; i < EVENT_BUFFER_SIZE + 2; ++i)
+  {
+    bus.publish(EVENT_COMMAND_QUEUED, eventRemote, "stop");
+  }
+
+  short subscriber = bus.subscribe(1, 0);
+  size_t length = bus.read(subscriber, buffer, sizeof(buffer) - 1, 0);
+
+  TEST_ASSERT_EQUAL_STRING("id: 18\nevent: resync\ndata: {}\n\n", (const char*)buffer);
+  TEST_ASSERT_EQUAL(strlen((const char*)buffer), length);
+  // An id from another boot of the controller is also too far.
+  TEST_ASSERT_EQUAL(1, bus.subscribe(1000, 0));
+  bus.read(1, buffer, sizeof(buffer) - 1, 0);
+  TEST_ASSERT_EQUAL_STRING("id: 18\nevent: resync\ndata: {}\n\n", (const char*)buffer);
+}
+
+void test_METHOD_read_WITH_subscriber_behind_ring_SHOULD_drop_it(void)
+{
+  EventBus bus;
+  uint8_t buffer[256];
+  short subscriber = bus.subscribe(0, 0);
+
+  for (unsigned short i = 0; i < EVENT_BUFFER_SIZE + 1; ++i)
+  {
+    bus.publish(EVENT_COMMAND_QUEUED, eventRemote, "stop");
+  }
+
+  TEST_ASSERT_EQUAL(0, bus.read(subscriber, buffer, sizeof(buffer), 0));
+  TEST_ASSERT_TRUE(bus.isDropped(subscriber));
+}
+
+void test_METHOD_read_WITH_idle_stream_SHOULD_write_heartbeat(void)
+{
+  EventBus bus;
+  uint8_t buffer[64] = {};
+  const unsigned long start = 1000;
+  short subscriber = bus.subscribe(0, start);
+
+  TEST_ASSERT_EQUAL(
+      0, bus.read(subscriber, buffer, sizeof(buffer) - 1, start + EVENT_HEARTBEAT_INTERVAL - 1));
+  bus.read(subscriber, buffer, sizeof(buffer) - 1, start + EVENT_HEARTBEAT_INTERVAL);
+
+  TEST_ASSERT_EQUAL_STRING(": heartbeat\n\n", (const char*)buffer);
+}
+
+void test_METHOD_readEvent_WITH_reader_behind_ring_SHOULD_report_missed_events(void)
+{
+  EventBus bus;
+  Event event;
+  unsigned long sequence = 0;
+
+  bus.publish(EVENT_REMOTE_RENAMED, eventRemote);
+  TEST_ASSERT_TRUE(bus.readEvent(sequence, event));
+  TEST_ASSERT_EQUAL(1, sequence);
+  TEST_ASSERT_EQUAL(EVENT_REMOTE_RENAMED, event.type);
+  TEST_ASSERT_EQUAL_STRING("foo", event.name);
+  TEST_ASSERT_FALSE(bus.readEvent(sequence, event));
+
+  for (unsigned short i = 0; i < EVENT_BUFFER_SIZE + 1; ++i)
+  {
+    bus.publish(EVENT_COMMAND_QUEUED, eventRemote, "up");
+  }
+  TEST_ASSERT_TRUE(bus.hasMissed(sequence));
+  TEST_ASSERT_FALSE(bus.readEvent(sequence, event));
+  TEST_ASSERT_EQUAL(1, sequence);
+}
\ No newline at end of file
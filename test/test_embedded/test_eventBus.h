@@ -0,0 +1,13 @@
+#pragma once
+
+void RUN_EVENTBUS_TESTS(void);
+
+void test_METHOD_read_WITH_published_event_SHOULD_write_frame(void);
+void test_METHOD_read_WITH_deleted_remote_SHOULD_only_write_its_id(void);
+void test_METHOD_read_WITH_small_buffer_SHOULD_write_frame_in_parts(void);
+void test_METHOD_subscribe_WITH_all_places_taken_SHOULD_return_minus_one(void);
+void test_METHOD_subscribe_WITH_last_event_id_SHOULD_resume_after_it(void);
+void test_METHOD_subscribe_WITH_last_event_id_out_of_ring_SHOULD_ask_resync(void);
+void test_METHOD_read_WITH_subscriber_behind_ring_SHOULD_drop_it(void);
+void test_METHOD_read_WITH_idle_stream_SHOULD_write_heartbeat(void);
+void test_METHOD_readEvent_WITH_reader_behind_ring_SHOULD_report_missed_events(void);
\ No newline at end of file
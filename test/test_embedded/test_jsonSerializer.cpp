@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include <unity.h>
 
+#include <change.h>
 #include <remote.h>
 #include <networks.h>
 #include <systemInfos.h>
@@ -15,10 +16,15 @@ void RUN_JSONSERIALIZER_TESTS(void)
   RUN_TEST(test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeRemotes_WITH_two_remotes_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string);
-  RUN_TEST(test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeNetworkConfigs_WITH_two_configs_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeSystemInfos_WITH_info_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeNetworks_WITH_one_network_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeChangeFeed_WITH_changes_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeChangeFeed_WITH_resync_required_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeAdmissionMetrics_WITH_metrics_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeBootProfile_WITH_profile_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeSwitchoverStatus_WITH_status_SHOULD_return_string);
 }
 
 void test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string(void)
@@ -62,12 +68,13 @@ void test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string(void)
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
 
-void test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string(void)
+void test_METHOD_serializeNetworkConfigs_WITH_two_configs_SHOULD_return_string(void)
 {
-  NetworkConfiguration config = { "foo", "bar" };
+  NetworkConfiguration configs[] = { { "foo", "bar" }, { "baz", "" } };
 
-  String serialized = serializerTest.serializeNetworkConfig(config);
-  String expected = "{\"ssid\":\"foo\",\"password\":\"bar\"}";
+  String serialized = serializerTest.serializeNetworkConfigs(configs, 2);
+  String expected
+      = "[{\"ssid\":\"foo\",\"password\":\"bar\"},{\"ssid\":\"baz\",\"password\":\"\"}]";
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
@@ -106,3 +113,84 @@ void test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string(void)
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
+
+void test_METHOD_serializeChangeFeed_WITH_changes_SHOULD_return_string(void)
+{
+  ChangeFeed feed;
+  feed.changes[0] = { 4, CHANGE_REMOTE_CREATED, 1048576, 0, "foo" };
+  feed.changes[1] = { 5, CHANGE_REMOTE_DELETED, 1048576, 0, "foo" };
+  feed.size = 2;
+  feed.lastSequence = 5;
+  feed.resyncRequired = false;
+
+  String serialized = serializerTest.serializeChangeFeed(feed);
+  String expected = "{\"sequence\":5,\"resync_required\":false,\"changes\":[{\"sequence\":4,\"type\":"
+                    "\"created\",\"id\":1048576,\"rolling_code\":0,\"name\":\"foo\"},{\"sequence\":5,"
+                    "\"type\":\"deleted\",\"id\":1048576,\"rolling_code\":0,\"name\":\"foo\"}]}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeChangeFeed_WITH_resync_required_SHOULD_return_string(void)
+{
+  ChangeFeed feed;
+  feed.size = 0;
+  feed.lastSequence = 42;
+  feed.resyncRequired = true;
+
+  String serialized = serializerTest.serializeChangeFeed(feed);
+  String expected = "{\"sequence\":42,\"resync_required\":true,\"changes\":[]}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+
+void test_METHOD_serializeAdmissionMetrics_WITH_metrics_SHOULD_return_string(void)
+{
+  AdmissionMetrics metrics = {
+    { { 12288, 6144, 2 }, { 8192, 4096, 4 }, { 4096, 2048, 6 } },
+    { 10, 5, 2 },
+    { 3, 1, 0 },
+    { 0, 1, 0 },
+    1,
+    4,
+    20000,
+    9000,
+    7000,
+  };
+
+  String serialized = serializerTest.serializeAdmissionMetrics(metrics);
+  String expected
+      = "{\"active_requests\":1,\"peak_active_requests\":4,\"free_heap\":20000,\"max_free_block\":"
+        "9000,\"lowest_free_heap\":7000,\"priorities\":{\"static\":{\"admitted\":10,\"shed\":3,"
+        "\"active_requests\":0,\"min_free_heap\":12288,\"min_free_block\":6144,"
+        "\"max_active_requests\":2},\"api\":{\"admitted\":5,\"shed\":1,\"active_requests\":1,"
+        "\"min_free_heap\":8192,\"min_free_block\":4096,\"max_active_requests\":4},\"action\":{"
+        "\"admitted\":2,\"shed\":0,\"active_requests\":0,\"min_free_heap\":4096,"
+        "\"min_free_block\":2048,\"max_active_requests\":6}}}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeBootProfile_WITH_profile_SHOULD_return_string(void)
+{
+  BootProfile profile = { BOOT_DONE, { 1, 12, 40, 3, 2800, 0, 2100 }, 56, 2856, 4100 };
+
+  String serialized = serializerTest.serializeBootProfile(profile);
+  String expected = "{\"phase\":\"done\",\"server_ready_at\":56,\"network_ready_at\":2856,"
+                    "\"first_command_at\":4100,\"durations\":{\"transmitter\":1,\"database\":12,"
+                    "\"filesystem\":40,\"server\":3,\"wifi_connect\":2800,\"access_point\":0,"
+                    "\"wifi_scan\":2100}}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeSwitchoverStatus_WITH_status_SHOULD_return_string(void)
+{
+  SwitchoverStatus status = { SWITCHOVER_SUCCEEDED, 2500, "foo" };
+
+  String serialized = serializerTest.serializeSwitchoverStatus(status);
+  String expected = "{\"state\":\"succeeded\",\"duration\":2500,\"ssid\":\"foo\"}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
\ No newline at end of file
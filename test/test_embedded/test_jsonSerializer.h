@@ -5,7 +5,12 @@ void RUN_JSONSERIALIZER_TESTS(void);
 void test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string(void);
 void test_METHOD_serializeRemotes_WITH_two_remotes_SHOULD_return_string(void);
 void test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string(void);
-void test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string(void);
+void test_METHOD_serializeNetworkConfigs_WITH_two_configs_SHOULD_return_string(void);
 void test_METHOD_serializeSystemInfos_WITH_info_SHOULD_return_string(void);
 void test_METHOD_serializeNetworks_WITH_one_network_SHOULD_return_string(void);
-void test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string(void);
\ No newline at end of file
+void test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string(void);
+void test_METHOD_serializeChangeFeed_WITH_changes_SHOULD_return_string(void);
+void test_METHOD_serializeChangeFeed_WITH_resync_required_SHOULD_return_string(void);
+void test_METHOD_serializeAdmissionMetrics_WITH_metrics_SHOULD_return_string(void);
+void test_METHOD_serializeBootProfile_WITH_profile_SHOULD_return_string(void);
+void test_METHOD_serializeSwitchoverStatus_WITH_status_SHOULD_return_string(void);
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <macro.h>
+#include <result.h>
+#include <schedule.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <macroRunner.h>
+
+#include "./test_controller.h"
+#include "./test_macroRunner.h"
+
+FakeDatabase macroDatabaseFake;
+FakeNetworkClient macroNetworkClientFake;
+FakeSerializer macroSerializerFake;
+FakeTransmitter macroTransmitterFake;
+FakeNetworkSwitchover macroNetworkSwitchoverFake;
+
+// Period of the main loop in the virtual clock, in milliseconds.
+static const unsigned long LOOP_PERIOD = 7;
+
+void RUN_MACRORUNNER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_run_WITH_unknown_macro_SHOULD_return_error);
+  RUN_TEST(test_METHOD_loop_WITH_virtual_clock_SHOULD_send_each_action_on_time);
+  RUN_TEST(test_METHOD_loop_WITH_stop_in_macro_SHOULD_not_cancel_it);
+  RUN_TEST(test_METHOD_loop_WITH_stop_from_other_client_SHOULD_cancel_macro);
+  RUN_TEST(test_METHOD_run_WITH_stop_for_other_remote_before_loop_SHOULD_cancel_its_macro);
+  RUN_TEST(test_METHOD_run_WITH_all_places_taken_SHOULD_return_error);
+}
+
+void test_METHOD_run_WITH_unknown_macro_SHOULD_return_error(void)
+{
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  Result result = runner.run(1, 1, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_MACRO_NOT_FOUND, result.code);
+  TEST_ASSERT_FALSE(runner.isRunning(1));
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_ID_MISSING, runner.run(0, 1, 0).code);
+}
+
+void test_METHOD_loop_WITH_virtual_clock_SHOULD_send_each_action_on_time(void)
+{
+  FakeDatabase::macros[0] = { 1, "tilt", 2, { { 1200, SCHEDULE_DOWN }, { 0, SCHEDULE_STOP } } };
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  Result result = runner.run(1, 1, 1000);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_MACRO_STARTED, result.code);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_TRUE(runner.isRunning(1));
+
+  unsigned long stoppedAt = 0;
+  for (unsigned long now = 1001; now < 3000 && stoppedAt == 0; now += LOOP_PERIOD)
+  {
+    runner.loop(now);
+    stoppedAt = FakeTransmitter::sendSTOPCommandCalled ? now : 0;
+  }
+
+  // Sent at the first loop after the wait, never before.
+  TEST_ASSERT_GREATER_OR_EQUAL(2200, stoppedAt);
+  TEST_ASSERT_LESS_THAN(2200 + LOOP_PERIOD, stoppedAt);
+  TEST_ASSERT_FALSE(runner.isRunning(1));
+}
+
+void test_METHOD_loop_WITH_stop_in_macro_SHOULD_not_cancel_it(void)
+{
+  FakeDatabase::macros[0]
+      = { 1, "my", 3, { { 500, SCHEDULE_DOWN }, { 300, SCHEDULE_STOP }, { 0, SCHEDULE_UP } } };
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  runner.run(1, 1, 0);
+  runner.loop(499);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  runner.loop(500);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_TRUE(runner.isRunning(1));
+
+  runner.loop(799);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  runner.loop(800);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_FALSE(runner.isRunning(1));
+}
+
+void test_METHOD_loop_WITH_stop_from_other_client_SHOULD_cancel_macro(void)
+{
+  FakeDatabase::macros[0] = { 1, "tilt", 2, { { 1200, SCHEDULE_DOWN }, { 0, SCHEDULE_UP } } };
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  runner.run(1, 1, 0);
+  runner.loop(100);
+  // Another client, between two loops.
+  controller.operateRemote(1, "stop");
+  runner.loop(200);
+  TEST_ASSERT_FALSE(runner.isRunning(1));
+
+  runner.loop(1200);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+}
+
+void test_METHOD_run_WITH_stop_for_other_remote_before_loop_SHOULD_cancel_its_macro(void)
+{
+  FakeDatabase::macros[0] = { 1, "tilt", 2, { { 1200, SCHEDULE_DOWN }, { 0, SCHEDULE_UP } } };
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  runner.run(1, 1, 0);
+  // A STOP for the remote 1 by UDP, then a macro started on the remote 2 by the command queue,
+  // in the same pass of the tasks, before the loop of the macros.
+  controller.operateRemote(1, "stop");
+  TEST_ASSERT_TRUE(runner.run(2, 1, 100).isSuccess);
+
+  TEST_ASSERT_FALSE(runner.isRunning(1));
+  TEST_ASSERT_TRUE(runner.isRunning(2));
+  FakeTransmitter::sendUPCommandCalled = false;
+  runner.loop(1300);
+  // Only the macro of the remote 2 goes on.
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_FALSE(runner.isRunning(2));
+}
+
+void test_METHOD_run_WITH_all_places_taken_SHOULD_return_error(void)
+{
+  FakeDatabase::macros[0] = { 1, "tilt", 2, { { 1200, SCHEDULE_DOWN }, { 0, SCHEDULE_STOP } } };
+  EventBus bus;
+  Controller controller(&macroDatabaseFake, &macroNetworkClientFake, &macroSerializerFake,
+      &macroTransmitterFake, &macroNetworkSwitchoverFake, &bus);
+  MacroRunner runner(&controller, &macroDatabaseFake, &bus);
+
+  for (unsigned long remoteId = 1; remoteId <= MAX_RUNNING_MACROS; ++remoteId)
+  {
+    TEST_ASSERT_TRUE(runner.run(remoteId, 1, 0).isSuccess);
+  }
+  Result result = runner.run(MAX_RUNNING_MACROS + 1, 1, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_TOO_MANY_RUNNING_MACROS, result.code);
+  // A remote running a macro gets the new one in its place.
+  TEST_ASSERT_TRUE(runner.run(1, 1, 100).isSuccess);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+void RUN_MACRORUNNER_TESTS(void);
+
+void test_METHOD_run_WITH_unknown_macro_SHOULD_return_error(void);
+void test_METHOD_loop_WITH_virtual_clock_SHOULD_send_each_action_on_time(void);
+void test_METHOD_loop_WITH_stop_in_macro_SHOULD_not_cancel_it(void);
+void test_METHOD_loop_WITH_stop_from_other_client_SHOULD_cancel_macro(void);
+void test_METHOD_run_WITH_stop_for_other_remote_before_loop_SHOULD_cancel_its_macro(void);
+void test_METHOD_run_WITH_all_places_taken_SHOULD_return_error(void);
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <lineStream.h>
+
+#include "./test_metrics.h"
+
+String renderMetrics(MetricsRegistry& registry)
+{
+  String output;
+  RenderCursor cursor = { 0, 0, 0 };
+  char line[RENDER_LINE_LENGTH];
+  while (registry.renderLine(cursor, line, sizeof(line)) > 0)
+  {
+    output += line;
+  }
+  return output;
+}
+
+void RUN_METRICS_TESTS(void)
+{
+  RUN_TEST(test_METHOD_renderLine_WITH_no_record_SHOULD_render_system_metrics);
+  RUN_TEST(test_METHOD_observeRouteLatency_SHOULD_render_cumulative_histogram);
+  RUN_TEST(test_METHOD_observeRouteLatency_WITH_full_table_SHOULD_ignore_route);
+  RUN_TEST(test_METHOD_recordTransmission_SHOULD_render_count_per_remote);
+  RUN_TEST(test_METHOD_recordEepromCommit_SHOULD_render_count_AND_duration);
+  RUN_TEST(test_METHOD_recordWifiConnect_SHOULD_render_duration_per_hints);
+  RUN_TEST(test_METHOD_recordSuppressedCommand_SHOULD_render_count_per_reason);
+  RUN_TEST(test_METHOD_recordAdmission_SHOULD_render_admitted_AND_shed_per_priority);
+  RUN_TEST(test_METHOD_recordAirtimeDelay_SHOULD_render_airtime_AND_delays);
+  RUN_TEST(test_METHOD_recordTask_SHOULD_render_runs_AND_latency_per_task);
+  RUN_TEST(test_METHOD_read_WITH_small_buffer_SHOULD_render_every_line);
+}
+
+void test_METHOD_renderLine_WITH_no_record_SHOULD_render_system_metrics(void)
+{
+  MetricsRegistry registry;
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "# TYPE somfy_uptime_seconds gauge\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_heap_free_bytes "));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_heap_fragmentation_percent "));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_reset_info{reason=\""));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_eeprom_commits_total 0\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_radio_busy_seconds_total 0.000000\n"));
+  TEST_ASSERT_NULL(strstr(output.c_str(), "somfy_http_handler_seconds_bucket"));
+}
+
+void test_METHOD_observeRouteLatency_SHOULD_render_cumulative_histogram(void)
+{
+  MetricsRegistry registry;
+  registry.observeRouteLatency(3, "/api/v1/remotes/{id}", HTTP_GET | HTTP_PATCH, 400);
+  registry.observeRouteLatency(3, "/api/v1/remotes/{id}", HTTP_GET | HTTP_PATCH, 3000);
+  registry.observeRouteLatency(3, "/api/v1/remotes/{id}", HTTP_GET | HTTP_PATCH, 2000000);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "somfy_http_handler_seconds_bucket{route=\"/api/v1/remotes/{id}\",method=\"GET,PATCH\","
+      "le=\"0.0005\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "somfy_http_handler_seconds_bucket{route=\"/api/v1/remotes/{id}\",method=\"GET,PATCH\","
+      "le=\"0.005\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "somfy_http_handler_seconds_bucket{route=\"/api/v1/remotes/{id}\",method=\"GET,PATCH\","
+      "le=\"+Inf\"} 3\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "somfy_http_handler_seconds_sum{route=\"/api/v1/remotes/{id}\",method=\"GET,PATCH\"} "
+      "2.003400\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "somfy_http_handler_seconds_count{route=\"/api/v1/remotes/{id}\",method=\"GET,PATCH\"} 3\n"));
+}
+
+void test_METHOD_observeRouteLatency_WITH_full_table_SHOULD_ignore_route(void)
+{
+  MetricsRegistry registry;
+  for (short route = 0; route < METRICS_MAX_ROUTES; ++route)
+  {
+    registry.observeRouteLatency(route, "/foo", HTTP_GET, 100);
+  }
+  registry.observeRouteLatency(METRICS_MAX_ROUTES, "/bar", HTTP_GET, 100);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "route=\"/foo\""));
+  TEST_ASSERT_NULL(strstr(output.c_str(), "route=\"/bar\""));
+}
+
+void test_METHOD_recordTransmission_SHOULD_render_count_per_remote(void)
+{
+  MetricsRegistry registry;
+  registry.recordTransmission(1048576, 250000);
+  registry.recordTransmission(1048577, 250000);
+  registry.recordTransmission(1048576, 250000);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_rts_transmissions_total{remote=\"1048576\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_rts_transmissions_total{remote=\"1048577\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_radio_busy_seconds_total 0.750000\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_rts_airtime_seconds_total{remote=\"1048576\"} 0.500000\n"));
+}
+
+void test_METHOD_recordEepromCommit_SHOULD_render_count_AND_duration(void)
+{
+  MetricsRegistry registry;
+  registry.recordEepromCommit(12000);
+  registry.recordEepromCommit(8000);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_eeprom_commits_total 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_eeprom_commit_seconds_total 0.020000\n"));
+}
+
+void test_METHOD_recordSuppressedCommand_SHOULD_render_count_per_reason(void)
+{
+  MetricsRegistry registry;
+  registry.recordSuppressedCommand(false);
+  registry.recordSuppressedCommand(false);
+  registry.recordSuppressedCommand(true);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "# TYPE somfy_suppressed_commands_total counter\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_suppressed_commands_total{reason=\"window\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_suppressed_commands_total{reason=\"key\"} 1\n"));
+}
+
+void test_METHOD_recordAdmission_SHOULD_render_admitted_AND_shed_per_priority(void)
+{
+  MetricsRegistry registry;
+  registry.recordAdmission(ADMISSION_STATIC, true);
+  registry.recordAdmission(ADMISSION_STATIC, false);
+  registry.recordAdmission(ADMISSION_STATIC, false);
+  registry.recordAdmission(ADMISSION_ACTION, true);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "# TYPE somfy_http_requests_admitted_total counter\n"));
+  TEST_ASSERT_NOT_NULL(strstr(
+      output.c_str(), "\nsomfy_http_requests_admitted_total{priority=\"static\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(
+      output.c_str(), "\nsomfy_http_requests_admitted_total{priority=\"action\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_http_requests_shed_total{priority=\"static\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_http_requests_shed_total{priority=\"api\"} 0\n"));
+}
+
+void test_METHOD_recordAirtimeDelay_SHOULD_render_airtime_AND_delays(void)
+{
+  MetricsRegistry registry;
+  registry.observeAirtime(1400, 2);
+  registry.recordAirtimeDelay(30000);
+  registry.recordAirtimeDelay(1500);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_airtime_window_seconds 1.400000\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_airtime_queued_commands 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_airtime_delayed_commands_total 2\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_airtime_delay_seconds_total 31.500000\n"));
+}
+
+void test_METHOD_recordTask_SHOULD_render_runs_AND_latency_per_task(void)
+{
+  MetricsRegistry registry;
+  registry.recordTask(0, "boot", 120, 0);
+  registry.recordTask(2, "commands", 350000, 4);
+  registry.recordTask(2, "commands", 150000, 16);
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_task_runs_total{task=\"boot\"} 1\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_task_runs_total{task=\"commands\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_task_run_seconds_total{task=\"commands\"} 0.500000\n"));
+  TEST_ASSERT_NOT_NULL(
+      strstr(output.c_str(), "\nsomfy_task_run_seconds_max{task=\"commands\"} 0.350000\n"));
+  TEST_ASSERT_NOT_NULL(strstr(
+      output.c_str(), "\nsomfy_task_latency_seconds_total{task=\"commands\"} 0.020000\n"));
+}
+
+void test_METHOD_recordWifiConnect_SHOULD_render_duration_per_hints(void)
+{
+  MetricsRegistry registry;
+  registry.recordWifiConnect(false, 3200);
+  registry.recordWifiConnect(true, 450);
+  registry.recordWifiConnect(true, 550);
+  registry.recordWifiHintMiss();
+
+  String output = renderMetrics(registry);
+
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(),
+      "# TYPE somfy_wifi_connect_seconds summary\n"
+      "somfy_wifi_connect_seconds_sum{hints=\"false\"} 3.200000\n"
+      "somfy_wifi_connect_seconds_count{hints=\"false\"} 1\n"
+      "somfy_wifi_connect_seconds_sum{hints=\"true\"} 1.000000\n"
+      "somfy_wifi_connect_seconds_count{hints=\"true\"} 2\n"));
+  TEST_ASSERT_NOT_NULL(strstr(output.c_str(), "\nsomfy_wifi_hint_misses_total 1\n"));
+}
+
+void test_METHOD_read_WITH_small_buffer_SHOULD_render_every_line(void)
+{
+  MetricsRegistry registry;
+  registry.observeRouteLatency(0, "/api/v1/remotes", HTTP_GET, 1500);
+  registry.recordTransmission(1048576, 250000);
+  LineStream stream(&registry);
+
+  String output;
+  uint8_t buffer[8];
+  size_t length;
+  while ((length = stream.read(buffer, sizeof(buffer))) > 0)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      output += (char)buffer[i];
+    }
+  }
+
+  TEST_ASSERT_EQUAL_STRING(renderMetrics(registry).c_str(), output.c_str());
+}
\ No newline at end of file
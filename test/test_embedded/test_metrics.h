@@ -0,0 +1,15 @@
+#pragma once
+
+void RUN_METRICS_TESTS(void);
+
+void test_METHOD_renderLine_WITH_no_record_SHOULD_render_system_metrics(void);
+void test_METHOD_observeRouteLatency_SHOULD_render_cumulative_histogram(void);
+void test_METHOD_observeRouteLatency_WITH_full_table_SHOULD_ignore_route(void);
+void test_METHOD_recordTransmission_SHOULD_render_count_per_remote(void);
+void test_METHOD_recordEepromCommit_SHOULD_render_count_AND_duration(void);
+void test_METHOD_recordWifiConnect_SHOULD_render_duration_per_hints(void);
+void test_METHOD_recordSuppressedCommand_SHOULD_render_count_per_reason(void);
+void test_METHOD_recordAdmission_SHOULD_render_admitted_AND_shed_per_priority(void);
+void test_METHOD_recordAirtimeDelay_SHOULD_render_airtime_AND_delays(void);
+void test_METHOD_recordTask_SHOULD_render_runs_AND_latency_per_task(void);
+void test_METHOD_read_WITH_small_buffer_SHOULD_render_every_line(void);
\ No newline at end of file
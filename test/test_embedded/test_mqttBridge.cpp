@@ -0,0 +1,212 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <remote.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <mqttBridge.h>
+
+#include "./test_controller.h"
+#include "./test_mqttBridge.h"
+
+FakeDatabase mqttDatabaseFake;
+FakeNetworkClient mqttNetworkClientFake;
+FakeSerializer mqttSerializerFake;
+FakeTransmitter mqttTransmitterFake;
+FakeNetworkSwitchover mqttNetworkSwitchoverFake;
+FakeMqttClient mqttClientFake;
+
+void RUN_MQTTBRIDGE_TESTS(void)
+{
+  RUN_TEST(test_METHOD_loop_WITH_broker_unreachable_SHOULD_retry_with_backoff);
+  RUN_TEST(test_METHOD_loop_WITH_new_connection_SHOULD_subscribe_AND_announce_remotes);
+  RUN_TEST(test_METHOD_receive_WITH_open_command_SHOULD_operate_remote_AND_publish_state);
+  RUN_TEST(test_METHOD_receive_WITH_other_topics_SHOULD_ignore_them);
+  RUN_TEST(test_METHOD_loop_WITH_commands_to_many_remotes_SHOULD_publish_by_batches);
+  RUN_TEST(test_METHOD_loop_WITH_client_buffers_full_SHOULD_publish_on_next_loop);
+  RUN_TEST(test_METHOD_loop_WITH_remote_deleted_SHOULD_clear_its_retained_messages);
+  RUN_TEST(test_METHOD_loop_WITH_connection_back_SHOULD_publish_known_states_again);
+}
+
+void test_METHOD_loop_WITH_broker_unreachable_SHOULD_retry_with_backoff(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+
+  bridge.loop(0);
+  TEST_ASSERT_EQUAL(1, FakeMqttClient::beginConnectCount);
+
+  // The second attempt is between 1 and 2 seconds later.
+  bridge.loop(MQTT_RECONNECT_MIN_DELAY - 1);
+  TEST_ASSERT_EQUAL(1, FakeMqttClient::beginConnectCount);
+  bridge.loop(2 * MQTT_RECONNECT_MIN_DELAY);
+  TEST_ASSERT_EQUAL(2, FakeMqttClient::beginConnectCount);
+  TEST_ASSERT_EQUAL(2, bridge.getAttempts());
+  TEST_ASSERT_FALSE(bridge.isConnected());
+}
+
+void test_METHOD_loop_WITH_new_connection_SHOULD_subscribe_AND_announce_remotes(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+
+  bridge.loop(0);
+
+  TEST_ASSERT_TRUE(bridge.isConnected());
+  TEST_ASSERT_EQUAL_STRING("somfy/abc/remotes/+/set", FakeMqttClient::subscribedTopic);
+  // Online, then the discovery of the only remote.
+  TEST_ASSERT_EQUAL(2, FakeMqttClient::publishCount);
+  TEST_ASSERT_EQUAL_STRING("homeassistant/cover/somfy_abc_1/config", FakeMqttClient::lastTopic);
+  TEST_ASSERT_TRUE(FakeMqttClient::lastRetain);
+  TEST_ASSERT_NOT_NULL(strstr(FakeMqttClient::lastPayload, "\"name\":\"foo\""));
+  TEST_ASSERT_NOT_NULL(
+      strstr(FakeMqttClient::lastPayload, "\"command_topic\":\"somfy/abc/remotes/1/set\""));
+  TEST_ASSERT_NOT_NULL(
+      strstr(FakeMqttClient::lastPayload, "\"availability_topic\":\"somfy/abc/status\""));
+}
+
+void test_METHOD_receive_WITH_open_command_SHOULD_operate_remote_AND_publish_state(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+  bridge.loop(0);
+
+  TEST_ASSERT_TRUE(bridge.receive("somfy/abc/remotes/1/set", "OPEN", 4));
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  bridge.loop(1);
+
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL_STRING("somfy/abc/remotes/1/state", FakeMqttClient::lastTopic);
+  TEST_ASSERT_EQUAL_STRING("open", FakeMqttClient::lastPayload);
+  TEST_ASSERT_TRUE(FakeMqttClient::lastRetain);
+}
+
+void test_METHOD_receive_WITH_other_topics_SHOULD_ignore_them(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+
+  TEST_ASSERT_FALSE(bridge.receive("somfy/abd/remotes/1/set", "OPEN", 4));
+  TEST_ASSERT_FALSE(bridge.receive("somfy/abc/remotes/1/state", "open", 4));
+  TEST_ASSERT_FALSE(bridge.receive("somfy/abc/remotes//set", "OPEN", 4));
+  TEST_ASSERT_FALSE(bridge.receive("somfy/abc/remotes/1/set", "UNKNOWN", 7));
+  TEST_ASSERT_FALSE(bridge.receive("somfy/abc/remotes/1/set", "", 0));
+  // The actions of the API are accepted too.
+  TEST_ASSERT_TRUE(bridge.receive("somfy/abc/remotes/1/set", "pair", 4));
+}
+
+void test_METHOD_loop_WITH_commands_to_many_remotes_SHOULD_publish_by_batches(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+  bridge.loop(0);
+  FakeMqttClient::publishCount = 0;
+
+  // 12 remotes operated, the first one three times: only its last state is published.
+  for (unsigned long id = 1; id <= 12; ++id)
+  {
+    Remote remote = { id, 0, "" };
+    bus.publish(EVENT_COMMAND_TRANSMITTED, remote, "up");
+  }
+  Remote first = { 1, 0, "" };
+  bus.publish(EVENT_COMMAND_TRANSMITTED, first, "stop");
+  bus.publish(EVENT_COMMAND_TRANSMITTED, first, "down");
+
+  bridge.loop(1);
+  TEST_ASSERT_EQUAL(MQTT_PUBLISH_BATCH, FakeMqttClient::publishCount);
+  bridge.loop(2);
+  TEST_ASSERT_EQUAL(12, FakeMqttClient::publishCount);
+  bridge.loop(3);
+  TEST_ASSERT_EQUAL(12, FakeMqttClient::publishCount);
+}
+
+void test_METHOD_loop_WITH_client_buffers_full_SHOULD_publish_on_next_loop(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+  bridge.loop(0);
+  Remote remote = { 1, 0, "" };
+  bus.publish(EVENT_COMMAND_TRANSMITTED, remote, "down");
+  FakeMqttClient::publishCount = 0;
+  FakeMqttClient::acceptedPublishes = 0;
+
+  bridge.loop(1);
+  TEST_ASSERT_EQUAL(0, FakeMqttClient::publishCount);
+
+  FakeMqttClient::acceptedPublishes = -1;
+  bridge.loop(2);
+  TEST_ASSERT_EQUAL(1, FakeMqttClient::publishCount);
+  TEST_ASSERT_EQUAL_STRING("closed", FakeMqttClient::lastPayload);
+}
+
+void test_METHOD_loop_WITH_remote_deleted_SHOULD_clear_its_retained_messages(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+  bridge.loop(0);
+  FakeMqttClient::publishCount = 0;
+
+  controller.deleteRemote(1);
+  bridge.loop(1);
+
+  TEST_ASSERT_EQUAL(2, FakeMqttClient::publishCount);
+  TEST_ASSERT_EQUAL_STRING("somfy/abc/remotes/1/state", FakeMqttClient::lastTopic);
+  TEST_ASSERT_EQUAL_STRING("", FakeMqttClient::lastPayload);
+  TEST_ASSERT_TRUE(FakeMqttClient::lastRetain);
+}
+
+void test_METHOD_loop_WITH_connection_back_SHOULD_publish_known_states_again(void)
+{
+  EventBus bus;
+  Controller controller(&mqttDatabaseFake, &mqttNetworkClientFake, &mqttSerializerFake,
+      &mqttTransmitterFake, &mqttNetworkSwitchoverFake, &bus);
+  MqttBridge bridge(&controller, &mqttDatabaseFake, &bus, &mqttClientFake);
+  bridge.begin("abc");
+  FakeMqttClient::connected = true;
+  bridge.loop(0);
+  controller.operateRemote(1, "down");
+  bridge.loop(1);
+
+  FakeMqttClient::connected = false;
+  bridge.loop(2);
+  TEST_ASSERT_FALSE(bridge.isConnected());
+  TEST_ASSERT_EQUAL(0, FakeMqttClient::beginConnectCount);
+
+  bridge.loop(2 + MQTT_RECONNECT_MIN_DELAY);
+  TEST_ASSERT_EQUAL(1, FakeMqttClient::beginConnectCount);
+  FakeMqttClient::connected = true;
+  FakeMqttClient::publishCount = 0;
+  bridge.loop(3 + MQTT_RECONNECT_MIN_DELAY);
+
+  // Online, discovery and state.
+  TEST_ASSERT_EQUAL(3, FakeMqttClient::publishCount);
+  TEST_ASSERT_EQUAL_STRING("somfy/abc/remotes/1/state", FakeMqttClient::lastTopic);
+  TEST_ASSERT_EQUAL_STRING("closed", FakeMqttClient::lastPayload);
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+void RUN_MQTTBRIDGE_TESTS(void);
+
+void test_METHOD_loop_WITH_broker_unreachable_SHOULD_retry_with_backoff(void);
+void test_METHOD_loop_WITH_new_connection_SHOULD_subscribe_AND_announce_remotes(void);
+void test_METHOD_receive_WITH_open_command_SHOULD_operate_remote_AND_publish_state(void);
+void test_METHOD_receive_WITH_other_topics_SHOULD_ignore_them(void);
+void test_METHOD_loop_WITH_commands_to_many_remotes_SHOULD_publish_by_batches(void);
+void test_METHOD_loop_WITH_client_buffers_full_SHOULD_publish_on_next_loop(void);
+void test_METHOD_loop_WITH_remote_deleted_SHOULD_clear_its_retained_messages(void);
+void test_METHOD_loop_WITH_connection_back_SHOULD_publish_known_states_again(void);
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+
+#include "./test_controller.h"
+#include "./test_networkScanner.h"
+#include "./test_networkConnector.h"
+
+FakeDatabase connectorDatabaseFake;
+FakeNetworkClient connectorNetworkClientFake;
+
+void RUN_NETWORKCONNECTOR_TESTS(void)
+{
+  RUN_TEST(test_METHOD_connect_WITHOUT_configuration_SHOULD_return_false);
+  RUN_TEST(test_METHOD_connect_WITH_hints_of_known_network_SHOULD_connect_with_hints);
+  RUN_TEST(test_METHOD_connect_WITH_one_configuration_SHOULD_connect_without_scan);
+  RUN_TEST(test_METHOD_connect_WITH_several_configurations_SHOULD_connect_to_strongest_after_scan);
+  RUN_TEST(test_METHOD_connect_WITH_several_configurations_AND_none_visible_SHOULD_connect_to_first);
+}
+
+void test_METHOD_connect_WITHOUT_configuration_SHOULD_return_false(void)
+{
+  NetworkScanner scanner(&connectorNetworkClientFake);
+  NetworkConnector connector(&connectorDatabaseFake, &connectorNetworkClientFake, &scanner);
+  FakeDatabase::shouldReturnEmptyNetworkConfiguration = true;
+
+  TEST_ASSERT_FALSE(connector.connect(100, true));
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectCalled);
+}
+
+void test_METHOD_connect_WITH_hints_of_known_network_SHOULD_connect_with_hints(void)
+{
+  NetworkScanner scanner(&connectorNetworkClientFake);
+  NetworkConnector connector(&connectorDatabaseFake, &connectorNetworkClientFake, &scanner);
+  FakeDatabase::hasNetworkHints = true;
+  FakeDatabase::hasSeveralNetworkConfigurations = true;
+
+  TEST_ASSERT_TRUE(connector.connect(100, true));
+
+  TEST_ASSERT_TRUE(connector.isHinted());
+  TEST_ASSERT_TRUE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_FALSE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_EQUAL_STRING("foo", FakeNetworkClient::connectedSsid);
+}
+
+void test_METHOD_connect_WITH_one_configuration_SHOULD_connect_without_scan(void)
+{
+  NetworkScanner scanner(&connectorNetworkClientFake);
+  NetworkConnector connector(&connectorDatabaseFake, &connectorNetworkClientFake, &scanner);
+  FakeDatabase::hasNetworkHints = true;
+
+  TEST_ASSERT_TRUE(connector.connect(100, false));
+
+  TEST_ASSERT_FALSE(connector.isHinted());
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_FALSE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_EQUAL_STRING("foo", FakeNetworkClient::connectedSsid);
+}
+
+void test_METHOD_connect_WITH_several_configurations_SHOULD_connect_to_strongest_after_scan(void)
+{
+  NetworkScanner scanner(&connectorNetworkClientFake);
+  NetworkConnector connector(&connectorDatabaseFake, &connectorNetworkClientFake, &scanner);
+  FakeDatabase::hasSeveralNetworkConfigurations = true;
+  Network networks[] = { { "foo", -85 }, { "baz", -55 } };
+
+  TEST_ASSERT_TRUE(connector.connect(100, true));
+  TEST_ASSERT_TRUE(connector.isSelecting());
+  TEST_ASSERT_TRUE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_TRUE(connector.loop(500));
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectCalled);
+
+  completeScan(networks, 2);
+  scanner.loop(2100);
+  TEST_ASSERT_TRUE(connector.loop(2100));
+
+  TEST_ASSERT_FALSE(connector.isSelecting());
+  TEST_ASSERT_EQUAL_STRING("baz", FakeNetworkClient::connectedSsid);
+  TEST_ASSERT_EQUAL(100, connector.getStartedAt());
+}
+
+void test_METHOD_connect_WITH_several_configurations_AND_none_visible_SHOULD_connect_to_first(void)
+{
+  NetworkScanner scanner(&connectorNetworkClientFake);
+  NetworkConnector connector(&connectorDatabaseFake, &connectorNetworkClientFake, &scanner);
+  FakeDatabase::hasSeveralNetworkConfigurations = true;
+  Network networks[] = { { "neighbour", -40 } };
+
+  connector.connect(100, false);
+  completeScan(networks, 1);
+  scanner.loop(2100);
+  connector.loop(2100);
+
+  TEST_ASSERT_EQUAL_STRING("foo", FakeNetworkClient::connectedSsid);
+}
\ No newline at end of file
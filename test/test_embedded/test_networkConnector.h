@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_NETWORKCONNECTOR_TESTS(void);
+
+void test_METHOD_connect_WITHOUT_configuration_SHOULD_return_false(void);
+void test_METHOD_connect_WITH_hints_of_known_network_SHOULD_connect_with_hints(void);
+void test_METHOD_connect_WITH_one_configuration_SHOULD_connect_without_scan(void);
+void test_METHOD_connect_WITH_several_configurations_SHOULD_connect_to_strongest_after_scan(void);
+void test_METHOD_connect_WITH_several_configurations_AND_none_visible_SHOULD_connect_to_first(void);
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <networkScanner.h>
+
+#include "./test_controller.h"
+#include "./test_networkScanner.h"
+
+FakeNetworkClient scannerNetworkClientFake;
+
+void completeScan(const Network networks[], const int size)
+{
+  for (int i = 0; i < size; ++i)
+  {
+    FakeNetworkClient::scanResults[i] = networks[i];
+  }
+  FakeNetworkClient::scanStatus = size;
+}
+
+void RUN_NETWORKSCANNER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_refresh_SHOULD_start_scan);
+  RUN_TEST(test_METHOD_refresh_WITH_failing_client_SHOULD_return_false);
+  RUN_TEST(test_METHOD_loop_WITH_scan_done_SHOULD_sort_AND_deduplicate_networks);
+  RUN_TEST(test_METHOD_loop_WITH_scan_running_too_long_SHOULD_stop_scanning);
+  RUN_TEST(test_METHOD_refreshIfStale_WITH_fresh_results_SHOULD_not_scan);
+  RUN_TEST(test_METHOD_refreshIfStale_WITH_expired_results_SHOULD_keep_cache_AND_scan);
+  RUN_TEST(test_METHOD_selectNetwork_WITH_known_networks_SHOULD_return_strongest);
+  RUN_TEST(test_METHOD_selectNetwork_WITHOUT_known_network_SHOULD_return_minus_one);
+}
+
+void test_METHOD_refresh_SHOULD_start_scan(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+
+  TEST_ASSERT_TRUE(scanner.refresh(0));
+  TEST_ASSERT_TRUE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_TRUE(scanner.isScanning());
+  TEST_ASSERT_FALSE(scanner.hasResults());
+}
+
+void test_METHOD_refresh_WITH_failing_client_SHOULD_return_false(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  FakeNetworkClient::shouldFailStartScan = true;
+
+  TEST_ASSERT_FALSE(scanner.refresh(0));
+  TEST_ASSERT_FALSE(scanner.isScanning());
+}
+
+void test_METHOD_loop_WITH_scan_done_SHOULD_sort_AND_deduplicate_networks(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  Network networks[] = {
+    { "foo", -80 },
+    { "bar", -50 },
+    { "", -40 },
+    { "foo", -60 },
+    { "baz", -70 },
+    { "bar", -90 },
+  };
+  scanner.refresh(0);
+  scanner.loop(100);
+  TEST_ASSERT_TRUE(scanner.isScanning());
+
+  completeScan(networks, 6);
+  scanner.loop(2000);
+
+  TEST_ASSERT_FALSE(scanner.isScanning());
+  TEST_ASSERT_TRUE(scanner.hasResults());
+  TEST_ASSERT_EQUAL(3, scanner.getSize());
+  TEST_ASSERT_EQUAL_STRING("bar", scanner.getNetworks()[0].SSID);
+  TEST_ASSERT_EQUAL(-50, scanner.getNetworks()[0].RSSI);
+  TEST_ASSERT_EQUAL_STRING("foo", scanner.getNetworks()[1].SSID);
+  TEST_ASSERT_EQUAL(-60, scanner.getNetworks()[1].RSSI);
+  TEST_ASSERT_EQUAL_STRING("baz", scanner.getNetworks()[2].SSID);
+  TEST_ASSERT_EQUAL(500, scanner.getAge(2500));
+}
+
+void test_METHOD_loop_WITH_scan_running_too_long_SHOULD_stop_scanning(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  scanner.refresh(1000);
+
+  scanner.loop(1000 + NETWORK_SCAN_TIMEOUT);
+
+  TEST_ASSERT_FALSE(scanner.isScanning());
+  TEST_ASSERT_FALSE(scanner.hasResults());
+}
+
+void test_METHOD_refreshIfStale_WITH_fresh_results_SHOULD_not_scan(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  Network networks[] = { { "foo", -80 } };
+  scanner.refresh(0);
+  completeScan(networks, 1);
+  scanner.loop(1000);
+  FakeNetworkClient::startScanCalled = false;
+
+  TEST_ASSERT_FALSE(scanner.refreshIfStale(1000 + NETWORK_SCAN_TTL - 1));
+  TEST_ASSERT_FALSE(FakeNetworkClient::startScanCalled);
+}
+
+void test_METHOD_refreshIfStale_WITH_expired_results_SHOULD_keep_cache_AND_scan(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  Network networks[] = { { "foo", -80 } };
+  scanner.refresh(0);
+  completeScan(networks, 1);
+  scanner.loop(1000);
+  FakeNetworkClient::startScanCalled = false;
+
+  TEST_ASSERT_TRUE(scanner.refreshIfStale(1000 + NETWORK_SCAN_TTL));
+  TEST_ASSERT_TRUE(FakeNetworkClient::startScanCalled);
+  TEST_ASSERT_EQUAL(1, scanner.getSize());
+  TEST_ASSERT_EQUAL_STRING("foo", scanner.getNetworks()[0].SSID);
+}
+
+void test_METHOD_selectNetwork_WITH_known_networks_SHOULD_return_strongest(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  Network networks[] = { { "foo", -80 }, { "neighbour", -40 }, { "baz", -60 } };
+  NetworkConfiguration configs[] = { { "foo", "bar" }, { "baz", "qux" } };
+  scanner.refresh(0);
+  completeScan(networks, 3);
+  scanner.loop(2000);
+
+  TEST_ASSERT_EQUAL(1, scanner.selectNetwork(configs, 2));
+}
+
+void test_METHOD_selectNetwork_WITHOUT_known_network_SHOULD_return_minus_one(void)
+{
+  NetworkScanner scanner(&scannerNetworkClientFake);
+  Network networks[] = { { "neighbour", -40 } };
+  NetworkConfiguration configs[] = { { "foo", "bar" } };
+  scanner.refresh(0);
+  completeScan(networks, 1);
+  scanner.loop(2000);
+
+  TEST_ASSERT_EQUAL(-1, scanner.selectNetwork(configs, 1));
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <networks.h>
+
+void completeScan(const Network networks[], const int size);
+
+void RUN_NETWORKSCANNER_TESTS(void);
+
+void test_METHOD_refresh_SHOULD_start_scan(void);
+void test_METHOD_refresh_WITH_failing_client_SHOULD_return_false(void);
+void test_METHOD_loop_WITH_scan_done_SHOULD_sort_AND_deduplicate_networks(void);
+void test_METHOD_loop_WITH_scan_running_too_long_SHOULD_stop_scanning(void);
+void test_METHOD_refreshIfStale_WITH_fresh_results_SHOULD_not_scan(void);
+void test_METHOD_refreshIfStale_WITH_expired_results_SHOULD_keep_cache_AND_scan(void);
+void test_METHOD_selectNetwork_WITH_known_networks_SHOULD_return_strongest(void);
+void test_METHOD_selectNetwork_WITHOUT_known_network_SHOULD_return_minus_one(void);
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <networks.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+#include <networkSwitchover.h>
+
+#include "./test_controller.h"
+#include "./test_networkSwitchover.h"
+
+FakeDatabase switchoverDatabaseFake;
+FakeNetworkClient switchoverNetworkClientFake;
+FakeAccessPoint switchoverAccessPointFake;
+
+NetworkConfiguration newNetworkConfig = { "new", "secret" };
+
+void RUN_NETWORKSWITCHOVER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_begin_WITH_switchover_running_SHOULD_return_false);
+  RUN_TEST(test_METHOD_loop_WITH_new_network_joined_SHOULD_save_configuration);
+  RUN_TEST(test_METHOD_loop_WITH_client_not_reporting_ssid_SHOULD_succeed);
+  RUN_TEST(test_METHOD_loop_WITH_access_point_running_SHOULD_keep_it);
+  RUN_TEST(test_METHOD_loop_WITH_new_network_unreachable_SHOULD_roll_back);
+}
+
+void test_METHOD_begin_WITH_switchover_running_SHOULD_return_false(void)
+{
+  NetworkScanner scanner(&switchoverNetworkClientFake);
+  NetworkConnector connector(&switchoverDatabaseFake, &switchoverNetworkClientFake, &scanner);
+  NetworkSwitchover switchover(&switchoverDatabaseFake, &connector, &switchoverNetworkClientFake,
+      &switchoverAccessPointFake);
+
+  TEST_ASSERT_TRUE(switchover.begin(&newNetworkConfig, 1));
+  TEST_ASSERT_FALSE(switchover.begin(&newNetworkConfig, 1));
+  TEST_ASSERT_EQUAL(SWITCHOVER_PENDING, switchover.getStatus().state);
+  // Nothing is touched before the loop.
+  TEST_ASSERT_FALSE(FakeNetworkClient::disconnectCalled);
+}
+
+void test_METHOD_loop_WITH_new_network_joined_SHOULD_save_configuration(void)
+{
+  NetworkScanner scanner(&switchoverNetworkClientFake);
+  NetworkConnector connector(&switchoverDatabaseFake, &switchoverNetworkClientFake, &scanner);
+  NetworkSwitchover switchover(&switchoverDatabaseFake, &connector, &switchoverNetworkClientFake,
+      &switchoverAccessPointFake);
+  strcpy(FakeNetworkClient::connectedSsid, "foo");
+  switchover.begin(&newNetworkConfig, 1);
+
+  FakeNetworkClient::isConnectedToNetwork = false;
+  switchover.loop(1000);
+  TEST_ASSERT_EQUAL(SWITCHOVER_CONNECTING, switchover.getStatus().state);
+  TEST_ASSERT_TRUE(FakeNetworkClient::disconnectCalled);
+  TEST_ASSERT_EQUAL_STRING("new", FakeNetworkClient::connectedSsid);
+  // The device stays reachable meanwhile.
+  TEST_ASSERT_TRUE(FakeAccessPoint::startAccessPointCalled);
+  TEST_ASSERT_FALSE(FakeDatabase::setNetworkConfigurationsCalled);
+
+  FakeNetworkClient::isConnectedToNetwork = true;
+  switchover.loop(3500);
+
+  SwitchoverStatus status = switchover.getStatus();
+  TEST_ASSERT_EQUAL(SWITCHOVER_SUCCEEDED, status.state);
+  TEST_ASSERT_EQUAL(2500, status.duration);
+  TEST_ASSERT_EQUAL_STRING("new", status.ssid);
+  TEST_ASSERT_TRUE(FakeDatabase::setNetworkConfigurationsCalled);
+  TEST_ASSERT_TRUE(FakeDatabase::setNetworkHintsCalled);
+  TEST_ASSERT_TRUE(FakeAccessPoint::stopAccessPointCalled);
+  TEST_ASSERT_FALSE(switchover.isRunning());
+}
+
+void test_METHOD_loop_WITH_client_not_reporting_ssid_SHOULD_succeed(void)
+{
+  NetworkScanner scanner(&switchoverNetworkClientFake);
+  NetworkConnector connector(&switchoverDatabaseFake, &switchoverNetworkClientFake, &scanner);
+  NetworkSwitchover switchover(&switchoverDatabaseFake, &connector, &switchoverNetworkClientFake,
+      &switchoverAccessPointFake);
+  // The hints of the client come without SSID, the switchover does not depend on them.
+  FakeNetworkClient::reportsSsid = false;
+  switchover.begin(&newNetworkConfig, 1);
+
+  switchover.loop(1000);
+  switchover.loop(2000);
+
+  SwitchoverStatus status = switchover.getStatus();
+  TEST_ASSERT_EQUAL(SWITCHOVER_SUCCEEDED, status.state);
+  TEST_ASSERT_EQUAL_STRING("new", status.ssid);
+  // Saved for the new network, the next boot joins it with its hints.
+  TEST_ASSERT_EQUAL_STRING("new", FakeDatabase::savedHints.ssid);
+  TEST_ASSERT_EQUAL(11, FakeDatabase::savedHints.channel);
+}
+
+void test_METHOD_loop_WITH_access_point_running_SHOULD_keep_it(void)
+{
+  NetworkScanner scanner(&switchoverNetworkClientFake);
+  NetworkConnector connector(&switchoverDatabaseFake, &switchoverNetworkClientFake, &scanner);
+  NetworkSwitchover switchover(&switchoverDatabaseFake, &connector, &switchoverNetworkClientFake,
+      &switchoverAccessPointFake);
+  FakeAccessPoint::running = true;
+  switchover.begin(&newNetworkConfig, 1);
+
+  switchover.loop(1000);
+  switchover.loop(2000);
+
+  TEST_ASSERT_EQUAL(SWITCHOVER_SUCCEEDED, switchover.getStatus().state);
+  TEST_ASSERT_FALSE(FakeAccessPoint::startAccessPointCalled);
+  TEST_ASSERT_FALSE(FakeAccessPoint::stopAccessPointCalled);
+}
+
+void test_METHOD_loop_WITH_new_network_unreachable_SHOULD_roll_back(void)
+{
+  NetworkScanner scanner(&switchoverNetworkClientFake);
+  NetworkConnector connector(&switchoverDatabaseFake, &switchoverNetworkClientFake, &scanner);
+  NetworkSwitchover switchover(&switchoverDatabaseFake, &connector, &switchoverNetworkClientFake,
+      &switchoverAccessPointFake);
+  FakeNetworkClient::isConnectedToNetwork = false;
+  switchover.begin(&newNetworkConfig, 1);
+
+  switchover.loop(1000);
+  switchover.loop(1000 + WIFI_SWITCHOVER_TIMEOUT - 1);
+  TEST_ASSERT_TRUE(switchover.isRunning());
+  switchover.loop(1000 + WIFI_SWITCHOVER_TIMEOUT);
+
+  SwitchoverStatus status = switchover.getStatus();
+  TEST_ASSERT_EQUAL(SWITCHOVER_ROLLED_BACK, status.state);
+  TEST_ASSERT_EQUAL(WIFI_SWITCHOVER_TIMEOUT, status.duration);
+  TEST_ASSERT_EQUAL_STRING("", status.ssid);
+  TEST_ASSERT_FALSE(FakeDatabase::setNetworkConfigurationsCalled);
+  // A new switchover can be asked.
+  TEST_ASSERT_TRUE(switchover.begin(&newNetworkConfig, 1));
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_NETWORKSWITCHOVER_TESTS(void);
+
+void test_METHOD_begin_WITH_switchover_running_SHOULD_return_false(void);
+void test_METHOD_loop_WITH_new_network_joined_SHOULD_save_configuration(void);
+void test_METHOD_loop_WITH_client_not_reporting_ssid_SHOULD_succeed(void);
+void test_METHOD_loop_WITH_access_point_running_SHOULD_keep_it(void);
+void test_METHOD_loop_WITH_new_network_unreachable_SHOULD_roll_back(void);
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <result.h>
+#include <position.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <positionTracker.h>
+
+#include "./test_controller.h"
+#include "./test_positionTracker.h"
+
+FakeDatabase positionDatabaseFake;
+FakeNetworkClient positionNetworkClientFake;
+FakeSerializer positionSerializerFake;
+FakeTransmitter positionTransmitterFake;
+FakeNetworkSwitchover positionNetworkSwitchoverFake;
+
+static const Calibration positionCalibration = { 20000, 16000 };
+
+// Closes the remote fully, its position is then known.
+static void closeFully(PositionTracker& tracker, const unsigned long now)
+{
+  tracker.moveTo(1, 0, now);
+  tracker.loop(now + positionCalibration.downTime);
+  FakeTransmitter::sendDOWNCommandCalled = false;
+}
+
+void RUN_POSITIONTRACKER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_moveTo_WITH_remote_not_calibrated_SHOULD_return_error);
+  RUN_TEST(test_METHOD_moveTo_WITH_unknown_position_SHOULD_return_error);
+  RUN_TEST(test_METHOD_moveTo_WITH_fully_open_SHOULD_make_position_known);
+  RUN_TEST(test_METHOD_loop_WITH_position_reached_SHOULD_send_stop_on_time);
+  RUN_TEST(test_METHOD_moveTo_WITH_remote_moving_same_way_SHOULD_only_move_the_stop);
+  RUN_TEST(test_METHOD_loop_WITH_commands_of_other_clients_SHOULD_follow_position);
+  RUN_TEST(test_METHOD_loop_WITH_stop_to_stopped_remote_SHOULD_make_position_unknown);
+}
+
+void test_METHOD_moveTo_WITH_remote_not_calibrated_SHOULD_return_error(void)
+{
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+
+  Result result = tracker.moveTo(1, 100, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_REMOTE_NOT_CALIBRATED, result.code);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+}
+
+void test_METHOD_moveTo_WITH_unknown_position_SHOULD_return_error(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+
+  Result result = tracker.moveTo(1, 40, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_POSITION_UNKNOWN, result.code);
+  TEST_ASSERT_EQUAL(RESULT_POSITION_INVALID, tracker.moveTo(1, 101, 0).code);
+}
+
+void test_METHOD_moveTo_WITH_fully_open_SHOULD_make_position_known(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+  RemotePosition position;
+
+  Result result = tracker.moveTo(1, 100, 1000);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+
+  // Unknown until the end of the travel, the remote stops by itself.
+  tracker.loop(11000);
+  TEST_ASSERT_TRUE(tracker.getPosition(1, 11000, position));
+  TEST_ASSERT_EQUAL(-1, position.position);
+  TEST_ASSERT_EQUAL(MOTION_UP, position.motion);
+  tracker.loop(21000);
+  TEST_ASSERT_TRUE(tracker.getPosition(1, 21000, position));
+  TEST_ASSERT_EQUAL(100, position.position);
+  TEST_ASSERT_EQUAL(MOTION_IDLE, position.motion);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+}
+
+void test_METHOD_loop_WITH_position_reached_SHOULD_send_stop_on_time(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+  RemotePosition position;
+  closeFully(tracker, 0);
+
+  // 40% of 20 s up: stopped 8 s later.
+  Result result = tracker.moveTo(1, 40, 30000);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_MOVING_TO_POSITION, result.code);
+  tracker.getPosition(1, 34000, position);
+  TEST_ASSERT_EQUAL(20, position.position);
+  TEST_ASSERT_EQUAL(40, position.target);
+
+  tracker.loop(37999);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  tracker.loop(38000);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+
+  // The STOP sent is not taken for a STOP to a stopped remote.
+  tracker.loop(38010);
+  tracker.getPosition(1, 60000, position);
+  TEST_ASSERT_EQUAL(40, position.position);
+  TEST_ASSERT_EQUAL(-1, position.target);
+  TEST_ASSERT_EQUAL(MOTION_IDLE, position.motion);
+}
+
+void test_METHOD_moveTo_WITH_remote_moving_same_way_SHOULD_only_move_the_stop(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+  RemotePosition position;
+  closeFully(tracker, 0);
+
+  tracker.moveTo(1, 40, 30000);
+  FakeTransmitter::sendUPCommandCalled = false;
+  // At 20%, now to 60%: 8 s more.
+  tracker.moveTo(1, 60, 34000);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+
+  tracker.loop(38000);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  tracker.loop(42000);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  tracker.getPosition(1, 42000, position);
+  TEST_ASSERT_EQUAL(60, position.position);
+
+  // Down to 30%: half of the 16 s down, for 30%.
+  tracker.moveTo(1, 30, 50000);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  FakeTransmitter::sendSTOPCommandCalled = false;
+  tracker.loop(54799);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  tracker.loop(54800);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  tracker.getPosition(1, 54800, position);
+  TEST_ASSERT_EQUAL(30, position.position);
+}
+
+void test_METHOD_loop_WITH_commands_of_other_clients_SHOULD_follow_position(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+  RemotePosition position;
+
+  // Fully closed by another client.
+  controller.operateRemote(1, "down");
+  tracker.loop(0);
+  tracker.loop(16000);
+  // Then opened for 5 s of 20.
+  controller.operateRemote(1, "up");
+  tracker.loop(20000);
+  controller.operateRemote(1, "stop");
+  tracker.loop(25000);
+
+  tracker.getPosition(1, 30000, position);
+  TEST_ASSERT_EQUAL(25, position.position);
+  TEST_ASSERT_EQUAL(MOTION_IDLE, position.motion);
+  TEST_ASSERT_EQUAL(20000, position.calibration.upTime);
+}
+
+void test_METHOD_loop_WITH_stop_to_stopped_remote_SHOULD_make_position_unknown(void)
+{
+  FakeDatabase::calibration = positionCalibration;
+  EventBus bus;
+  Controller controller(&positionDatabaseFake, &positionNetworkClientFake,
+      &positionSerializerFake, &positionTransmitterFake, &positionNetworkSwitchoverFake, &bus);
+  PositionTracker tracker(&controller, &positionDatabaseFake, &bus);
+  RemotePosition position;
+  closeFully(tracker, 0);
+
+  // Favourite position of the remote.
+  controller.operateRemote(1, "stop");
+  tracker.loop(30000);
+
+  tracker.getPosition(1, 30000, position);
+  TEST_ASSERT_EQUAL(-1, position.position);
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+void RUN_POSITIONTRACKER_TESTS(void);
+
+void test_METHOD_moveTo_WITH_remote_not_calibrated_SHOULD_return_error(void);
+void test_METHOD_moveTo_WITH_unknown_position_SHOULD_return_error(void);
+void test_METHOD_moveTo_WITH_fully_open_SHOULD_make_position_known(void);
+void test_METHOD_loop_WITH_position_reached_SHOULD_send_stop_on_time(void);
+void test_METHOD_moveTo_WITH_remote_moving_same_way_SHOULD_only_move_the_stop(void);
+void test_METHOD_loop_WITH_commands_of_other_clients_SHOULD_follow_position(void);
+void test_METHOD_loop_WITH_stop_to_stopped_remote_SHOULD_make_position_unknown(void);
\ No newline at end of file
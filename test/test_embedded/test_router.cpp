@@ -0,0 +1,173 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <ESPAsyncWebServer.h>
+
+#include <router.h>
+
+#include "./test_router.h"
+
+void fakeRemotesHandler(AsyncWebServerRequest* request, const RouteParams& params) { }
+void fakeRemoteHandler(AsyncWebServerRequest* request, const RouteParams& params) { }
+void fakeRemoteUpdateHandler(AsyncWebServerRequest* request, const RouteParams& params) { }
+void fakeRemoteActionHandler(AsyncWebServerRequest* request, const RouteParams& params) { }
+void fakeChangesHandler(AsyncWebServerRequest* request, const RouteParams& params) { }
+
+void initRouter(Router& router)
+{
+  router.on("/api/v1/remotes", HTTP_GET | HTTP_POST, fakeRemotesHandler);
+  router.on("/api/v1/remotes/changes", HTTP_GET, fakeChangesHandler);
+  router.on("/api/v1/remotes/{id}", HTTP_GET, fakeRemoteHandler);
+  router.on("/api/v1/remotes/{id}", HTTP_PATCH, fakeRemoteUpdateHandler);
+  router.on("/api/v1/remotes/{id}/action", HTTP_POST, fakeRemoteActionHandler, "Idempotency-Key");
+}
+
+void RUN_ROUTER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_match_WITH_literal_path_SHOULD_return_handler);
+  RUN_TEST(test_METHOD_match_WITH_integer_param_SHOULD_return_handler_AND_param);
+  RUN_TEST(test_METHOD_match_WITH_literal_AND_param_siblings_SHOULD_prefer_literal);
+  RUN_TEST(test_METHOD_match_WITH_non_integer_param_SHOULD_return_null);
+  RUN_TEST(test_METHOD_match_WITH_wrong_method_SHOULD_return_null);
+  RUN_TEST(test_METHOD_match_WITH_unknown_path_SHOULD_return_null);
+  RUN_TEST(test_METHOD_match_WITH_doubled_OR_trailing_slash_SHOULD_return_null);
+  RUN_TEST(test_METHOD_match_WITH_segment_longer_than_literals_SHOULD_return_null);
+  RUN_TEST(test_METHOD_on_WITH_full_tables_SHOULD_return_false);
+  RUN_TEST(test_METHOD_matchRoute_SHOULD_return_route_WITH_path_AND_methods);
+}
+
+void test_METHOD_match_WITH_literal_path_SHOULD_return_handler(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes", HTTP_GET, params) == fakeRemotesHandler);
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes", HTTP_POST, params) == fakeRemotesHandler);
+  TEST_ASSERT_EQUAL(0, params.size);
+}
+
+void test_METHOD_match_WITH_integer_param_SHOULD_return_handler_AND_param(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes/1048577", HTTP_GET, params) == fakeRemoteHandler);
+  TEST_ASSERT_EQUAL(1, params.size);
+  TEST_ASSERT_EQUAL(1048577, params.values[0]);
+
+  TEST_ASSERT_TRUE(
+      router.match("/api/v1/remotes/1048577", HTTP_PATCH, params) == fakeRemoteUpdateHandler);
+  TEST_ASSERT_TRUE(
+      router.match("/api/v1/remotes/42/action", HTTP_POST, params) == fakeRemoteActionHandler);
+  TEST_ASSERT_EQUAL(1, params.size);
+  TEST_ASSERT_EQUAL(42, params.values[0]);
+}
+
+void test_METHOD_match_WITH_literal_AND_param_siblings_SHOULD_prefer_literal(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes/changes", HTTP_GET, params) == fakeChangesHandler);
+  TEST_ASSERT_EQUAL(0, params.size);
+}
+
+void test_METHOD_match_WITH_non_integer_param_SHOULD_return_null(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/12a", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/-1", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/12345678901234", HTTP_GET, params));
+}
+
+void test_METHOD_match_WITH_wrong_method_SHOULD_return_null(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/42/action", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes", HTTP_DELETE, params));
+}
+
+void test_METHOD_match_WITH_unknown_path_SHOULD_return_null(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_NULL(router.match("/", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/42/foo", HTTP_POST, params));
+  TEST_ASSERT_NULL(router.match("/index.html", HTTP_GET, params));
+}
+
+void test_METHOD_match_WITH_doubled_OR_trailing_slash_SHOULD_return_null(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api//v1/remotes", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("//api/v1/remotes", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/42//action", HTTP_POST, params));
+  TEST_ASSERT_NULL(router.match("api/v1/remotes", HTTP_GET, params));
+}
+
+void test_METHOD_match_WITH_segment_longer_than_literals_SHOULD_return_null(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+  // 256 junk bytes after a literal, and after a parameter: a length kept on 8 bits wraps to 7.
+  char url[300];
+  strcpy(url, "/api/v1/remotes/changes");
+  memset(url + strlen(url), 'x', 256);
+  url[23 + 256] = '\0';
+  TEST_ASSERT_NULL(router.match(url, HTTP_GET, params));
+
+  strcpy(url, "/api/v1/remotes/123");
+  memset(url + strlen(url), '0', 256);
+  strcpy(url + 19 + 256, "/action");
+  TEST_ASSERT_NULL(router.match(url, HTTP_POST, params));
+
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/changesx", HTTP_GET, params));
+  TEST_ASSERT_NULL(router.match("/api/v1/remotes/1234567890", HTTP_GET, params));
+}
+
+void test_METHOD_on_WITH_full_tables_SHOULD_return_false(void)
+{
+  Router router;
+  bool registered = true;
+  for (int i = 0; i <= MAX_ROUTES && registered; i++)
+  {
+    registered = router.on("/api/v1/remotes", HTTP_GET, fakeRemotesHandler);
+  }
+
+  TEST_ASSERT_FALSE(registered);
+}
+
+void test_METHOD_matchRoute_SHOULD_return_route_WITH_path_AND_methods(void)
+{
+  Router router;
+  initRouter(router);
+  RouteParams params;
+
+  short route = router.matchRoute("/api/v1/remotes/42", HTTP_PATCH, params);
+
+  TEST_ASSERT_TRUE(route >= 0);
+  TEST_ASSERT_TRUE(router.getHandler(route) == fakeRemoteUpdateHandler);
+  TEST_ASSERT_EQUAL_STRING("/api/v1/remotes/{id}", router.getPath(route));
+  TEST_ASSERT_EQUAL(HTTP_PATCH, router.getMethods(route));
+  TEST_ASSERT_NULL(router.getHeader(route));
+  TEST_ASSERT_EQUAL(-1, router.matchRoute("/api/v1/foo", HTTP_GET, params));
+
+  route = router.matchRoute("/api/v1/remotes/42/action", HTTP_POST, params);
+  TEST_ASSERT_EQUAL_STRING("Idempotency-Key", router.getHeader(route));
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+void RUN_ROUTER_TESTS(void);
+
+void test_METHOD_match_WITH_literal_path_SHOULD_return_handler(void);
+void test_METHOD_match_WITH_integer_param_SHOULD_return_handler_AND_param(void);
+void test_METHOD_match_WITH_literal_AND_param_siblings_SHOULD_prefer_literal(void);
+void test_METHOD_match_WITH_non_integer_param_SHOULD_return_null(void);
+void test_METHOD_match_WITH_wrong_method_SHOULD_return_null(void);
+void test_METHOD_match_WITH_unknown_path_SHOULD_return_null(void);
+void test_METHOD_match_WITH_doubled_OR_trailing_slash_SHOULD_return_null(void);
+void test_METHOD_match_WITH_segment_longer_than_literals_SHOULD_return_null(void);
+void test_METHOD_on_WITH_full_tables_SHOULD_return_false(void);
+void test_METHOD_matchRoute_SHOULD_return_route_WITH_path_AND_methods(void);
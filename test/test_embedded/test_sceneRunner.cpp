@@ -0,0 +1,164 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <scene.h>
+#include <result.h>
+#include <schedule.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <sceneRunner.h>
+
+#include "./test_controller.h"
+#include "./test_sceneRunner.h"
+
+FakeDatabase sceneDatabaseFake;
+FakeNetworkClient sceneNetworkClientFake;
+FakeSerializer sceneSerializerFake;
+FakeTransmitter sceneTransmitterFake;
+FakeNetworkSwitchover sceneNetworkSwitchoverFake;
+
+void RUN_SCENERUNNER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_runScene_WITH_unknown_scene_SHOULD_return_error);
+  RUN_TEST(test_METHOD_loop_WITH_group_SHOULD_space_transmissions_by_stagger_gap);
+  RUN_TEST(test_METHOD_loop_WITH_scene_delays_SHOULD_send_each_step_after_its_delay);
+  RUN_TEST(test_METHOD_loop_WITH_run_SHOULD_commit_rolling_codes_once);
+  RUN_TEST(test_METHOD_runGroup_WITH_run_in_progress_SHOULD_return_error);
+  RUN_TEST(test_METHOD_loop_WITH_run_over_SHOULD_report_each_step);
+}
+
+void test_METHOD_runScene_WITH_unknown_scene_SHOULD_return_error(void)
+{
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  Result result = runner.runScene(1, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_NOT_FOUND, result.code);
+  TEST_ASSERT_FALSE(runner.isRunning());
+  TEST_ASSERT_EQUAL(RESULT_SCENE_NOT_FOUND, runner.runScene(MAX_SCENES + 1, 0).code);
+}
+
+void test_METHOD_loop_WITH_group_SHOULD_space_transmissions_by_stagger_gap(void)
+{
+  FakeDatabase::groups[0] = { 1, "all", 3, { 1, 2, 3 } };
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  TEST_ASSERT_TRUE(runner.runGroup(1, "down", 1000).isSuccess);
+  TEST_ASSERT_FALSE(runner.loop(1000));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(1, runner.getReport().size);
+
+  // The transmission blocked up to 1150, the gap starts then.
+  TEST_ASSERT_FALSE(runner.loop(1150));
+  TEST_ASSERT_FALSE(runner.loop(1150 + SCENE_STAGGER_GAP - 1));
+  TEST_ASSERT_EQUAL(1, runner.getReport().size);
+  TEST_ASSERT_FALSE(runner.loop(1150 + SCENE_STAGGER_GAP));
+  TEST_ASSERT_EQUAL(2, runner.getReport().size);
+
+  TEST_ASSERT_FALSE(runner.loop(1300));
+  TEST_ASSERT_TRUE(runner.loop(1300 + SCENE_STAGGER_GAP));
+  TEST_ASSERT_FALSE(runner.isRunning());
+  TEST_ASSERT_EQUAL(3, runner.getReport().size);
+}
+
+void test_METHOD_loop_WITH_scene_delays_SHOULD_send_each_step_after_its_delay(void)
+{
+  FakeDatabase::scenes[0]
+      = { 1, "evening", 2, { { 1, 500, SCHEDULE_UP }, { 2, 20, SCHEDULE_STOP } } };
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  TEST_ASSERT_TRUE(runner.runScene(1, 0).isSuccess);
+  TEST_ASSERT_FALSE(runner.loop(499));
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_FALSE(runner.loop(500));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+
+  // A delay shorter than the gap is raised to it.
+  TEST_ASSERT_FALSE(runner.loop(600));
+  TEST_ASSERT_FALSE(runner.loop(600 + 20));
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_TRUE(runner.loop(600 + SCENE_STAGGER_GAP));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+}
+
+void test_METHOD_loop_WITH_run_SHOULD_commit_rolling_codes_once(void)
+{
+  FakeDatabase::groups[0] = { 1, "all", 3, { 1, 2, 3 } };
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  runner.runGroup(1, "up", 0);
+  unsigned long now = 0;
+  while (!runner.loop(now))
+  {
+    TEST_ASSERT_TRUE(FakeDatabase::isBatching);
+    TEST_ASSERT_EQUAL(0, FakeDatabase::batchCount);
+    now += 10;
+  }
+
+  TEST_ASSERT_FALSE(FakeDatabase::isBatching);
+  TEST_ASSERT_EQUAL(1, FakeDatabase::batchCount);
+}
+
+void test_METHOD_runGroup_WITH_run_in_progress_SHOULD_return_error(void)
+{
+  FakeDatabase::groups[0] = { 1, "all", 2, { 1, 2 } };
+  FakeDatabase::scenes[0] = { 1, "evening", 1, { { 1, 0, SCHEDULE_UP } } };
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  TEST_ASSERT_EQUAL(RESULT_ACTION_INVALID, runner.runGroup(1, "pair", 0).code);
+  TEST_ASSERT_TRUE(runner.runGroup(1, "up", 0).isSuccess);
+  const unsigned long runId = runner.getRunId();
+
+  Result result = runner.runScene(1, 0);
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_RUNNING, result.code);
+  TEST_ASSERT_EQUAL(RESULT_SCENE_RUNNING, runner.runGroup(1, "up", 0).code);
+  TEST_ASSERT_FALSE(runner.isFinished(runId));
+  TEST_ASSERT_EQUAL(runId, runner.getRunId());
+}
+
+void test_METHOD_loop_WITH_run_over_SHOULD_report_each_step(void)
+{
+  FakeDatabase::scenes[0]
+      = { 1, "evening", 2, { { 1, 0, SCHEDULE_DOWN }, { 2, 300, SCHEDULE_DOWN } } };
+  EventBus bus;
+  Controller controller(&sceneDatabaseFake, &sceneNetworkClientFake, &sceneSerializerFake,
+      &sceneTransmitterFake, &sceneNetworkSwitchoverFake, &bus);
+  SceneRunner runner(&controller, &sceneDatabaseFake);
+
+  runner.runScene(1, 5000);
+  const unsigned long runId = runner.getRunId();
+  runner.loop(5000);
+  runner.loop(5100);
+  TEST_ASSERT_TRUE(runner.loop(5400));
+
+  const SceneReport& report = runner.getReport();
+  TEST_ASSERT_TRUE(runner.isFinished(runId));
+  TEST_ASSERT_EQUAL(runId, report.runId);
+  TEST_ASSERT_EQUAL(1, report.sceneId);
+  TEST_ASSERT_EQUAL(0, report.groupId);
+  TEST_ASSERT_EQUAL(2, report.size);
+  TEST_ASSERT_EQUAL(400, report.duration);
+  TEST_ASSERT_EQUAL(1, report.steps[0].remoteId);
+  TEST_ASSERT_EQUAL(0, report.steps[0].sentAt);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_DOWN_SENT, report.steps[0].code);
+  TEST_ASSERT_EQUAL(2, report.steps[1].remoteId);
+  TEST_ASSERT_EQUAL(400, report.steps[1].sentAt);
+}
\ No newline at end of file
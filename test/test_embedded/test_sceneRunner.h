@@ -0,0 +1,10 @@
+#pragma once
+
+void RUN_SCENERUNNER_TESTS(void);
+
+void test_METHOD_runScene_WITH_unknown_scene_SHOULD_return_error(void);
+void test_METHOD_loop_WITH_group_SHOULD_space_transmissions_by_stagger_gap(void);
+void test_METHOD_loop_WITH_scene_delays_SHOULD_send_each_step_after_its_delay(void);
+void test_METHOD_loop_WITH_run_SHOULD_commit_rolling_codes_once(void);
+void test_METHOD_runGroup_WITH_run_in_progress_SHOULD_return_error(void);
+void test_METHOD_loop_WITH_run_over_SHOULD_report_each_step(void);
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <time.h>
+
+#include <sun.h>
+#include <config.h>
+#include <schedule.h>
+#include <scheduler.h>
+#include <eventBus.h>
+#include <controller.h>
+#include <airtimeBudget.h>
+#include <airtimeScheduler.h>
+
+#include "./test_controller.h"
+#include "./test_scheduler.h"
+
+FakeDatabase schedulerDatabaseFake;
+FakeNetworkClient schedulerNetworkClientFake;
+FakeSerializer schedulerSerializerFake;
+FakeTransmitter schedulerTransmitterFake;
+FakeNetworkSwitchover schedulerNetworkSwitchoverFake;
+FakeEventPublisher schedulerEventPublisherFake;
+Controller schedulerController(&schedulerDatabaseFake, &schedulerNetworkClientFake,
+    &schedulerSerializerFake, &schedulerTransmitterFake, &schedulerNetworkSwitchoverFake,
+    &schedulerEventPublisherFake);
+AirtimeBudget schedulerAirtimeBudget;
+AirtimeScheduler schedulerAirtimeScheduler(&schedulerController, &schedulerAirtimeBudget);
+
+// Times UTC. 2026-01-14 is a wednesday.
+static const time_t WINTER_NOON = 1768392000;
+static const time_t SUMMER_NOON = 1784116800;
+
+static void addSchedule(const ScheduleEvent event, const ScheduleAction action, const int minutes,
+    const unsigned char days)
+{
+  Schedule schedule = {};
+  schedule.remoteId = 1;
+  schedule.event = event;
+  schedule.action = action;
+  schedule.minutes = minutes;
+  schedule.days = days;
+  schedulerDatabaseFake.createSchedule(schedule);
+}
+
+void RUN_SCHEDULER_TESTS(void)
+{
+  setenv("TZ", TIME_ZONE, 1);
+  tzset();
+  RUN_TEST(test_METHOD_getNextRun_WITH_time_in_winter_AND_summer_SHOULD_follow_local_time);
+  RUN_TEST(test_METHOD_getNextRun_WITH_time_skipped_by_summer_time_SHOULD_run_one_hour_later);
+  RUN_TEST(test_METHOD_loop_WITH_time_repeated_by_winter_time_SHOULD_run_once);
+  RUN_TEST(test_METHOD_getNextRun_WITH_days_SHOULD_skip_other_days);
+  RUN_TEST(test_METHOD_getNextRun_WITH_sunrise_offset_SHOULD_run_after_sunrise);
+  RUN_TEST(test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false);
+  RUN_TEST(test_METHOD_loop_WITH_due_schedule_SHOULD_operate_remote_once);
+  RUN_TEST(test_METHOD_loop_WITH_clock_jump_SHOULD_not_run_missed_schedules);
+  RUN_TEST(test_METHOD_loop_WITH_clock_not_set_SHOULD_do_nothing);
+}
+
+void test_METHOD_getNextRun_WITH_time_in_winter_AND_summer_SHOULD_follow_local_time(void)
+{
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_UP, 7 * 60 + 30, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+
+  // 07:30 CET, then 07:30 CEST.
+  scheduler.loop(WINTER_NOON);
+  TEST_ASSERT_EQUAL(1768458600, scheduler.getNextRun(1));
+  scheduler.loop(SUMMER_NOON);
+  TEST_ASSERT_EQUAL(1784179800, scheduler.getNextRun(1));
+}
+
+void test_METHOD_getNextRun_WITH_time_skipped_by_summer_time_SHOULD_run_one_hour_later(void)
+{
+  // 02:30 does not exist on 2026-03-29, it runs at 03:30 CEST.
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_UP, 2 * 60 + 30, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+
+  scheduler.loop(1774699200);
+
+  TEST_ASSERT_EQUAL(1774747800, scheduler.getNextRun(1));
+}
+
+void test_METHOD_loop_WITH_time_repeated_by_winter_time_SHOULD_run_once(void)
+{
+  // 02:30 happens twice on 2026-10-25, at 00:30 and at 01:30 UTC.
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_DOWN, 2 * 60 + 30, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+  const time_t start = 1792843200;
+  unsigned short runs = 0;
+
+  for (time_t now = start; now < start + 24 * 3600; now += 10)
+  {
+    if (scheduler.loop(now))
+    {
+      TEST_ASSERT_TRUE(now >= 1792888200 && now < 1792888200 + 10);
+      runs++;
+    }
+  }
+
+  TEST_ASSERT_EQUAL(1, runs);
+}
+
+void test_METHOD_getNextRun_WITH_days_SHOULD_skip_other_days(void)
+{
+  // Mondays only, 2026-01-19 is the next one.
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_UP, 7 * 60 + 30, 1 << 1);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+
+  scheduler.loop(WINTER_NOON);
+
+  TEST_ASSERT_EQUAL(1768804200, scheduler.getNextRun(1));
+}
+
+void test_METHOD_getNextRun_WITH_sunrise_offset_SHOULD_run_after_sunrise(void)
+{
+  // Sunrise at 03:46:47 UTC in Paris on 2026-06-21, 10 minutes later.
+  addSchedule(SCHEDULE_AT_SUNRISE, SCHEDULE_UP, 10, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+
+  scheduler.loop(1781956800);
+
+  TEST_ASSERT_INT_WITHIN(120, 1782014207, scheduler.getNextRun(1));
+}
+
+void test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false(void)
+{
+  time_t sunrise = 0;
+
+  // Tromsø in June, and in December.
+  TEST_ASSERT_FALSE(computeSunEvent(2026, 6, 21, 69.65, 18.96, true, sunrise));
+  TEST_ASSERT_FALSE(computeSunEvent(2026, 12, 21, 69.65, 18.96, true, sunrise));
+  TEST_ASSERT_TRUE(computeSunEvent(2026, 3, 21, 69.65, 18.96, true, sunrise));
+}
+
+void test_METHOD_loop_WITH_due_schedule_SHOULD_operate_remote_once(void)
+{
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_DOWN, 7 * 60 + 30, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+  // 07:00 CET.
+  const time_t start = 1768370400;
+
+  TEST_ASSERT_FALSE(scheduler.loop(start));
+  TEST_ASSERT_FALSE(scheduler.loop(start + 30 * 60 - 1));
+  TEST_ASSERT_TRUE(scheduler.loop(start + 30 * 60));
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_FALSE(scheduler.loop(start + 30 * 60 + 1));
+  // Planned again for the next day.
+  TEST_ASSERT_EQUAL(start + 30 * 60 + 24 * 3600, scheduler.getNextRun(1));
+}
+
+void test_METHOD_loop_WITH_clock_jump_SHOULD_not_run_missed_schedules(void)
+{
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_DOWN, 7 * 60 + 30, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+  const time_t start = 1768370400;
+
+  scheduler.loop(start);
+  // Two hours later, after a correction of the clock.
+  TEST_ASSERT_FALSE(scheduler.loop(start + 2 * 3600));
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(start + 30 * 60 + 24 * 3600, scheduler.getNextRun(1));
+
+  // Back in time: planned again from there.
+  TEST_ASSERT_FALSE(scheduler.loop(start));
+  TEST_ASSERT_EQUAL(start + 30 * 60, scheduler.getNextRun(1));
+}
+
+void test_METHOD_loop_WITH_clock_not_set_SHOULD_do_nothing(void)
+{
+  addSchedule(SCHEDULE_AT_TIME, SCHEDULE_UP, 0, 0x7F);
+  Scheduler scheduler(&schedulerDatabaseFake, &schedulerAirtimeScheduler);
+
+  // Seconds since boot, before the first NTP answer.
+  TEST_ASSERT_FALSE(scheduler.loop(12));
+  TEST_ASSERT_EQUAL(0, scheduler.getNextRun(1));
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+void RUN_SCHEDULER_TESTS(void);
+
+void test_METHOD_getNextRun_WITH_time_in_winter_AND_summer_SHOULD_follow_local_time(void);
+void test_METHOD_getNextRun_WITH_time_skipped_by_summer_time_SHOULD_run_one_hour_later(void);
+void test_METHOD_loop_WITH_time_repeated_by_winter_time_SHOULD_run_once(void);
+void test_METHOD_getNextRun_WITH_days_SHOULD_skip_other_days(void);
+void test_METHOD_getNextRun_WITH_sunrise_offset_SHOULD_run_after_sunrise(void);
+void test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false(void);
+void test_METHOD_loop_WITH_due_schedule_SHOULD_operate_remote_once(void);
+void test_METHOD_loop_WITH_clock_jump_SHOULD_not_run_missed_schedules(void);
+void test_METHOD_loop_WITH_clock_not_set_SHOULD_do_nothing(void);
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <LittleFS.h>
+#include <StreamString.h>
+
+#include <staticAssetHandler.h>
+
+#include "./test_staticAssetHandler.h"
+
+void RUN_STATICASSETHANDLER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_addAsset_WITH_valid_line_SHOULD_return_true);
+  RUN_TEST(test_METHOD_addAsset_WITH_invalid_line_SHOULD_return_false);
+  RUN_TEST(test_METHOD_addAsset_WITH_full_table_SHOULD_return_false);
+  RUN_TEST(test_METHOD_findAsset_WITH_root_url_SHOULD_return_index_page);
+  RUN_TEST(test_METHOD_loadManifest_WITH_too_long_line_SHOULD_skip_it_whole);
+}
+
+void test_METHOD_addAsset_WITH_valid_line_SHOULD_return_true(void)
+{
+  StaticAssetHandler handler(LittleFS);
+
+  TEST_ASSERT_TRUE(handler.addAsset("/static/js/esprtsomfy.f5571e0d.js f5571e0d 1"));
+  TEST_ASSERT_TRUE(handler.addAsset("/api.html 0a1b2c3d 0"));
+  TEST_ASSERT_EQUAL(0, handler.findAsset("/static/js/esprtsomfy.f5571e0d.js"));
+  TEST_ASSERT_EQUAL(1, handler.findAsset("/api.html"));
+  TEST_ASSERT_EQUAL(-1, handler.findAsset("/static/js/esprtsomfy.js"));
+}
+
+void test_METHOD_addAsset_WITH_invalid_line_SHOULD_return_false(void)
+{
+  StaticAssetHandler handler(LittleFS);
+
+  TEST_ASSERT_FALSE(handler.addAsset(""));
+  TEST_ASSERT_FALSE(handler.addAsset("/index.html"));
+  TEST_ASSERT_FALSE(handler.addAsset("index.html c9805a2c 0"));
+  TEST_ASSERT_FALSE(handler.addAsset("/index.html c9805a 0"));
+  TEST_ASSERT_FALSE(
+      handler.addAsset("/static/js/a_very_long_name_for_an_asset_path.f5571e0d.js f5571e0d 1"));
+  TEST_ASSERT_EQUAL(-1, handler.findAsset("/index.html"));
+}
+
+void test_METHOD_addAsset_WITH_full_table_SHOULD_return_false(void)
+{
+  StaticAssetHandler handler(LittleFS);
+
+  for (int i = 0; i < MAX_ASSETS; ++i)
+  {
+    TEST_ASSERT_TRUE(handler.addAsset("/index.html c9805a2c 0"));
+  }
+  TEST_ASSERT_FALSE(handler.addAsset("/index.html c9805a2c 0"));
+}
+
+void test_METHOD_findAsset_WITH_root_url_SHOULD_return_index_page(void)
+{
+  StaticAssetHandler handler(LittleFS);
+  handler.addAsset("/api.html 0a1b2c3d 0");
+  handler.addAsset("/index.html c9805a2c 0");
+
+  TEST_ASSERT_EQUAL(1, handler.findAsset("/"));
+  TEST_ASSERT_EQUAL(1, handler.findAsset("/index.html"));
+}
+
+void test_METHOD_loadManifest_WITH_too_long_line_SHOULD_skip_it_whole(void)
+{
+  StaticAssetHandler handler(LittleFS);
+  StreamString manifest;
+  // Fills the line buffer exactly, what follows looks like an asset of its own.
+  manifest.print("/");
+  for (int i = 1; i < MAX_ASSET_PATH_LENGTH + 15; ++i)
+  {
+    manifest.print("a");
+  }
+  manifest.print("/hidden.html 0a1b2c3d 0\n");
+  manifest.print("/index.html c9805a2c 0\n");
+  manifest.print("/api.html 0a1b2c3d 0");
+
+  TEST_ASSERT_TRUE(handler.loadManifest(manifest));
+
+  TEST_ASSERT_EQUAL(-1, handler.findAsset("/hidden.html"));
+  TEST_ASSERT_EQUAL(0, handler.findAsset("/index.html"));
+  TEST_ASSERT_EQUAL(1, handler.findAsset("/api.html"));
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_STATICASSETHANDLER_TESTS(void);
+
+void test_METHOD_addAsset_WITH_valid_line_SHOULD_return_true(void);
+void test_METHOD_addAsset_WITH_invalid_line_SHOULD_return_false(void);
+void test_METHOD_addAsset_WITH_full_table_SHOULD_return_false(void);
+void test_METHOD_findAsset_WITH_root_url_SHOULD_return_index_page(void);
+void test_METHOD_loadManifest_WITH_too_long_line_SHOULD_skip_it_whole(void);
\ No newline at end of file
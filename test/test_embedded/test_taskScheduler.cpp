@@ -0,0 +1,118 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <taskScheduler.h>
+
+#include "./test_taskScheduler.h"
+
+static unsigned short runs = 0;
+static unsigned long lastRun = 0;
+static TaskScheduler* wokenScheduler = nullptr;
+static short wokenTask = -1;
+
+static void countRun(const unsigned long now)
+{
+  runs++;
+  lastRun = now;
+}
+
+static void wakeItself(const unsigned long now)
+{
+  runs++;
+  if (runs < 2)
+  {
+    wokenScheduler->wake(wokenTask, now);
+  }
+}
+
+void RUN_TASKSCHEDULER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_loop_WITH_period_zero_SHOULD_run_task_each_loop);
+  RUN_TEST(test_METHOD_loop_WITH_period_SHOULD_run_task_once_per_period);
+  RUN_TEST(test_METHOD_wake_WITH_task_on_wake_SHOULD_run_it_once);
+  RUN_TEST(test_METHOD_wake_WITH_wake_during_run_SHOULD_run_again_next_loop);
+  RUN_TEST(test_METHOD_add_WITH_too_many_tasks_SHOULD_return_minus_one);
+}
+
+void test_METHOD_loop_WITH_period_zero_SHOULD_run_task_each_loop(void)
+{
+  TaskScheduler scheduler;
+  runs = 0;
+  TEST_ASSERT_EQUAL(0, scheduler.add("test", countRun, 0));
+
+  scheduler.loop(1000);
+  scheduler.loop(1000);
+  scheduler.loop(1007);
+
+  TEST_ASSERT_EQUAL(3, runs);
+  TEST_ASSERT_EQUAL_UINT32(1007, lastRun);
+}
+
+void test_METHOD_loop_WITH_period_SHOULD_run_task_once_per_period(void)
+{
+  TaskScheduler scheduler;
+  runs = 0;
+  scheduler.add("test", countRun, 100);
+
+  scheduler.loop(1000);
+  TEST_ASSERT_EQUAL(1, runs);
+  scheduler.loop(1099);
+  TEST_ASSERT_EQUAL(1, runs);
+  scheduler.loop(1100);
+  TEST_ASSERT_EQUAL(2, runs);
+
+  // Late by more than a period: run once, then a period after.
+  scheduler.loop(1350);
+  TEST_ASSERT_EQUAL(3, runs);
+  scheduler.loop(1400);
+  TEST_ASSERT_EQUAL(3, runs);
+  scheduler.loop(1450);
+  TEST_ASSERT_EQUAL(4, runs);
+}
+
+void test_METHOD_wake_WITH_task_on_wake_SHOULD_run_it_once(void)
+{
+  TaskScheduler scheduler;
+  runs = 0;
+  const short task = scheduler.add("test", countRun, TASK_ON_WAKE);
+
+  scheduler.loop(1000);
+  TEST_ASSERT_EQUAL(0, runs);
+
+  scheduler.wake(task, 1010);
+  scheduler.wake(task, 1020);
+  scheduler.loop(1030);
+  TEST_ASSERT_EQUAL(1, runs);
+
+  scheduler.loop(1040);
+  TEST_ASSERT_EQUAL(1, runs);
+}
+
+void test_METHOD_wake_WITH_wake_during_run_SHOULD_run_again_next_loop(void)
+{
+  TaskScheduler scheduler;
+  runs = 0;
+  wokenScheduler = &scheduler;
+  wokenTask = scheduler.add("test", wakeItself, TASK_ON_WAKE);
+
+  scheduler.wake(wokenTask, 1000);
+  scheduler.loop(1000);
+  TEST_ASSERT_EQUAL(1, runs);
+  scheduler.loop(1001);
+  TEST_ASSERT_EQUAL(2, runs);
+  scheduler.loop(1002);
+  TEST_ASSERT_EQUAL(2, runs);
+}
+
+void test_METHOD_add_WITH_too_many_tasks_SHOULD_return_minus_one(void)
+{
+  TaskScheduler scheduler;
+  for (unsigned short i = 0; i < MAX_TASKS; ++i)
+  {
+    TEST_ASSERT_EQUAL(i, scheduler.add("test", countRun, 0));
+  }
+
+  TEST_ASSERT_EQUAL(-1, scheduler.add("test", countRun, 0));
+  TEST_ASSERT_EQUAL(MAX_TASKS, scheduler.getSize());
+}
\ No newline at end of file
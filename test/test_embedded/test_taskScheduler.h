@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_TASKSCHEDULER_TESTS(void);
+
+void test_METHOD_loop_WITH_period_zero_SHOULD_run_task_each_loop(void);
+void test_METHOD_loop_WITH_period_SHOULD_run_task_once_per_period(void);
+void test_METHOD_wake_WITH_task_on_wake_SHOULD_run_it_once(void);
+void test_METHOD_wake_WITH_wake_during_run_SHOULD_run_again_next_loop(void);
+void test_METHOD_add_WITH_too_many_tasks_SHOULD_return_minus_one(void);
\ No newline at end of file
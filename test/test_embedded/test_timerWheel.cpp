@@ -0,0 +1,89 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <timerWheel.h>
+
+#include "./test_timerWheel.h"
+
+static const unsigned short WHEEL_TIMERS = 512;
+static TimerNode wheelNodes[WHEEL_TIMERS];
+
+void RUN_TIMERWHEEL_TESTS(void)
+{
+  RUN_TEST(test_METHOD_advance_WITH_random_timers_SHOULD_expire_each_once_in_order);
+  RUN_TEST(test_METHOD_advance_WITH_timer_beyond_wheel_SHOULD_expire_on_time);
+  RUN_TEST(test_METHOD_schedule_WITH_past_expiry_SHOULD_expire_at_once);
+}
+
+void test_METHOD_advance_WITH_random_timers_SHOULD_expire_each_once_in_order(void)
+{
+  // Starts close to a wrap of the last level, the timers cross all of them.
+  const unsigned long start = (1UL << 20) - 100;
+  TimerWheel wheel(wheelNodes, WHEEL_TIMERS);
+  wheel.reset(start);
+  unsigned long expiries[WHEEL_TIMERS];
+  unsigned char expiredCount[WHEEL_TIMERS] = {};
+  // Deterministic pseudo random expiries, from 1 second to about 11 hours.
+  unsigned long seed = 42;
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    seed = seed * 1103515245UL + 12345UL;
+    expiries[i] = start + 1 + (seed >> 8) % 40000;
+    wheel.schedule(i, expiries[i]);
+  }
+
+  unsigned long lastExpiry = start;
+  unsigned short total = 0;
+  // By irregular steps, as the main loop does.
+  for (unsigned long now = start; now <= start + 40001; now += 1 + now % 7)
+  {
+    wheel.advance(now);
+    int timer;
+    while ((timer = wheel.popExpired()) >= 0)
+    {
+      TEST_ASSERT_TRUE(expiries[timer] <= now);
+      TEST_ASSERT_TRUE(expiries[timer] >= lastExpiry);
+      // Never late by more than the step of the loop.
+      TEST_ASSERT_TRUE(now - expiries[timer] < 7);
+      lastExpiry = expiries[timer];
+      expiredCount[timer]++;
+      total++;
+    }
+  }
+
+  TEST_ASSERT_EQUAL(WHEEL_TIMERS, total);
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    TEST_ASSERT_EQUAL(1, expiredCount[i]);
+  }
+}
+
+void test_METHOD_advance_WITH_timer_beyond_wheel_SHOULD_expire_on_time(void)
+{
+  TimerWheel wheel(wheelNodes, WHEEL_TIMERS);
+  wheel.reset(1000);
+  // About 24 days, twice the span of the wheel.
+  const unsigned long expires = 1000 + (1UL << 21) + 5;
+  wheel.schedule(0, expires);
+
+  wheel.advance(expires - 1);
+  TEST_ASSERT_EQUAL(-1, wheel.popExpired());
+
+  wheel.advance(expires);
+  TEST_ASSERT_EQUAL(0, wheel.popExpired());
+  TEST_ASSERT_EQUAL(-1, wheel.popExpired());
+}
+
+void test_METHOD_schedule_WITH_past_expiry_SHOULD_expire_at_once(void)
+{
+  TimerWheel wheel(wheelNodes, WHEEL_TIMERS);
+  wheel.reset(1000);
+
+  wheel.schedule(3, 1000);
+  wheel.schedule(4, 10);
+
+  TEST_ASSERT_EQUAL(3, wheel.popExpired());
+  TEST_ASSERT_EQUAL(4, wheel.popExpired());
+  TEST_ASSERT_EQUAL(-1, wheel.popExpired());
+  TEST_ASSERT_EQUAL(1000, wheel.getTime());
+}
\ No newline at end of file
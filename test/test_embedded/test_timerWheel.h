@@ -0,0 +1,7 @@
+#pragma once
+
+void RUN_TIMERWHEEL_TESTS(void);
+
+void test_METHOD_advance_WITH_random_timers_SHOULD_expire_each_once_in_order(void);
+void test_METHOD_advance_WITH_timer_beyond_wheel_SHOULD_expire_on_time(void);
+void test_METHOD_schedule_WITH_past_expiry_SHOULD_expire_at_once(void);
\ No newline at end of file
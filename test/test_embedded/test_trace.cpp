@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <trace.h>
+
+#include "./test_trace.h"
+
+String renderTraces(TraceBuffer& buffer)
+{
+  String output;
+  RenderCursor cursor = { 0, 0, 0 };
+  char line[RENDER_LINE_LENGTH];
+  while (buffer.renderLine(cursor, line, sizeof(line)) > 0)
+  {
+    output += line;
+  }
+  return output;
+}
+
+void RUN_TRACE_TESTS(void)
+{
+  RUN_TEST(test_METHOD_renderLine_WITH_no_span_SHOULD_render_empty_trace);
+  RUN_TEST(test_METHOD_renderLine_WITH_spans_SHOULD_render_chrome_trace_events);
+  RUN_TEST(test_METHOD_renderLine_WITH_spans_between_lines_SHOULD_render_first_window_once);
+  RUN_TEST(test_METHOD_record_WITH_full_buffer_SHOULD_drop_oldest_span);
+  RUN_TEST(test_METHOD_clear_SHOULD_drop_all_spans);
+}
+
+void test_METHOD_renderLine_WITH_no_span_SHOULD_render_empty_trace(void)
+{
+  TraceBuffer buffer;
+
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n", renderTraces(buffer).c_str());
+}
+
+void test_METHOD_renderLine_WITH_spans_SHOULD_render_chrome_trace_events(void)
+{
+  TraceBuffer buffer;
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  buffer.record("rts.buildFrame", 1000 * mhz, 1002 * mhz + mhz / 2);
+  buffer.record("eeprom.commit", 2000 * mhz, 14000 * mhz);
+
+  String expected = "{\"traceEvents\":[\n"
+                    "{\"name\":\"rts.buildFrame\",\"ph\":\"X\",\"ts\":1000.000,\"dur\":2.500,"
+                    "\"pid\":1,\"tid\":1}\n"
+                    ",{\"name\":\"eeprom.commit\",\"ph\":\"X\",\"ts\":2000.000,\"dur\":12000.000,"
+                    "\"pid\":1,\"tid\":1}\n"
+                    "],\"displayTimeUnit\":\"ms\"}\n";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), renderTraces(buffer).c_str());
+}
+
+void test_METHOD_renderLine_WITH_spans_between_lines_SHOULD_render_first_window_once(void)
+{
+  TraceBuffer buffer;
+  buffer.record("first", 0, 0);
+  buffer.record("second", 0, 0);
+  buffer.record("third", 0, 0);
+  RenderCursor cursor = { 0, 0, 0 };
+  char line[RENDER_LINE_LENGTH];
+  String output;
+
+  buffer.renderLine(cursor, line, sizeof(line));
+  output += line;
+  buffer.renderLine(cursor, line, sizeof(line));
+  output += line;
+  // Drops the first and the second spans, the second one was not rendered yet.
+  for (int i = 0; i < TRACE_BUFFER_SIZE - 1; ++i)
+  {
+    buffer.record("recorded during the rendering", 0, 0);
+  }
+  while (buffer.renderLine(cursor, line, sizeof(line)) > 0)
+  {
+    output += line;
+  }
+
+  String expected = "{\"traceEvents\":[\n"
+                    "{\"name\":\"first\",\"ph\":\"X\",\"ts\":0.000,\"dur\":0.000,"
+                    "\"pid\":1,\"tid\":1}\n"
+                    ",{\"name\":\"third\",\"ph\":\"X\",\"ts\":0.000,\"dur\":0.000,"
+                    "\"pid\":1,\"tid\":1}\n"
+                    "],\"displayTimeUnit\":\"ms\"}\n";
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+}
+
+void test_METHOD_record_WITH_full_buffer_SHOULD_drop_oldest_span(void)
+{
+  TraceBuffer buffer;
+  buffer.record("oldest", 0, 1);
+  for (int i = 0; i < TRACE_BUFFER_SIZE; ++i)
+  {
+    buffer.record("span", 0, 1);
+  }
+
+  TEST_ASSERT_EQUAL(TRACE_BUFFER_SIZE, buffer.getSize());
+  TEST_ASSERT_NULL(strstr(renderTraces(buffer).c_str(), "oldest"));
+}
+
+void test_METHOD_clear_SHOULD_drop_all_spans(void)
+{
+  TraceBuffer buffer;
+  buffer.record("span", 0, 1);
+
+  buffer.clear();
+
+  TEST_ASSERT_EQUAL(0, buffer.getSize());
+  TEST_ASSERT_NULL(strstr(renderTraces(buffer).c_str(), "span"));
+}
\ No newline at end of file
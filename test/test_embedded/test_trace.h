@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_TRACE_TESTS(void);
+
+void test_METHOD_renderLine_WITH_no_span_SHOULD_render_empty_trace(void);
+void test_METHOD_renderLine_WITH_spans_SHOULD_render_chrome_trace_events(void);
+void test_METHOD_renderLine_WITH_spans_between_lines_SHOULD_render_first_window_once(void);
+void test_METHOD_record_WITH_full_buffer_SHOULD_drop_oldest_span(void);
+void test_METHOD_clear_SHOULD_drop_all_spans(void);
\ No newline at end of file
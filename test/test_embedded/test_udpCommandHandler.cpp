@@ -0,0 +1,274 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <result.h>
+#include <controller.h>
+#include <udpCommandHandler.h>
+
+#include "./test_controller.h"
+#include "./test_udpCommandHandler.h"
+
+FakeDatabase udpDatabaseFake;
+FakeNetworkClient udpNetworkClientFake;
+FakeSerializer udpSerializerFake;
+FakeTransmitter udpTransmitterFake;
+FakeNetworkSwitchover udpNetworkSwitchoverFake;
+FakeEventPublisher udpEventPublisherFake;
+
+Controller udpController(&udpDatabaseFake, &udpNetworkClientFake, &udpSerializerFake,
+    &udpTransmitterFake, &udpNetworkSwitchoverFake, &udpEventPublisherFake);
+
+static void makeSignedStop(UdpCommandHandler& handler, const uint8_t remoteId,
+    const uint8_t nonce, uint8_t packet[UDP_MAX_PACKET_SIZE])
+{
+  const uint8_t command[] = { 'S', UDP_FLAG_NONCE | UDP_FLAG_HMAC, 0x00, 0x00, 0x00, remoteId,
+    UDP_ACTION_STOP, 0x00, 0x00, 0x00, nonce };
+  memcpy(packet, command, sizeof(command));
+  handler.sign(packet, sizeof(command), packet + sizeof(command));
+}
+
+void RUN_UDPCOMMANDHANDLER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_handle_WITH_unknown_packet_SHOULD_not_ack);
+  RUN_TEST(test_METHOD_handle_WITH_up_command_SHOULD_send_it_AND_ack);
+  RUN_TEST(test_METHOD_handle_WITH_truncated_command_SHOULD_ack_invalid);
+  RUN_TEST(test_METHOD_handle_WITH_unknown_action_SHOULD_ack_invalid);
+  RUN_TEST(test_METHOD_handle_WITH_retransmitted_nonce_SHOULD_send_once);
+  RUN_TEST(test_METHOD_handle_WITH_valid_signature_SHOULD_send_it);
+  RUN_TEST(test_METHOD_handle_WITH_wrong_signature_SHOULD_ack_unauthorized);
+  RUN_TEST(test_METHOD_handle_WITH_key_AND_unsigned_command_SHOULD_ack_unauthorized);
+  RUN_TEST(test_METHOD_handle_WITH_key_AND_no_nonce_SHOULD_ack_replayed);
+  RUN_TEST(test_METHOD_handle_WITH_key_AND_older_nonce_SHOULD_ack_replayed);
+  RUN_TEST(test_METHOD_handle_WITH_key_AND_restart_SHOULD_refuse_replay);
+  RUN_TEST(test_METHOD_handle_WITH_key_SHOULD_save_nonce_mark_once_per_block);
+}
+
+void test_METHOD_handle_WITH_unknown_packet_SHOULD_not_ack(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "");
+  const uint8_t packet[] = { 'G', 'E', 'T', ' ', '/', ' ', 'H' };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 1;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, ackLength);
+}
+
+void test_METHOD_handle_WITH_up_command_SHOULD_send_it_AND_ack(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "");
+  const uint8_t packet[] = { 'S', 0x00, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_UP };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  const uint8_t expected[] = { 'S', UDP_FLAG_ACK, 0x00, 0x00, 0x00, 0x01, RESULT_COMMAND_UP_SENT };
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(sizeof(expected), ackLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, ack, sizeof(expected));
+}
+
+void test_METHOD_handle_WITH_truncated_command_SHOULD_ack_invalid(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "");
+  // The nonce flag is set, the nonce is missing.
+  const uint8_t packet[] = { 'S', UDP_FLAG_NONCE, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_UP };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(UDP_HEADER_SIZE + UDP_NONCE_SIZE, ackLength);
+  TEST_ASSERT_EQUAL(RESULT_PACKET_INVALID, ack[6]);
+}
+
+void test_METHOD_handle_WITH_unknown_action_SHOULD_ack_invalid(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "");
+  const uint8_t packet[] = { 'S', 0x00, 0x00, 0x00, 0x00, 0x01, 42 };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(RESULT_ACTION_INVALID, ack[6]);
+}
+
+void test_METHOD_handle_WITH_retransmitted_nonce_SHOULD_send_once(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "");
+  const uint8_t packet[]
+      = { 'S', UDP_FLAG_NONCE, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_DOWN, 0xCA, 0xFE, 0x00, 0x01 };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  handler.handle(packet, sizeof(packet), ack, ackLength);
+  FakeTransmitter::sendDOWNCommandCalled = false;
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  const uint8_t expected[] = { 'S', UDP_FLAG_ACK | UDP_FLAG_NONCE, 0x00, 0x00, 0x00, 0x01,
+    RESULT_COMMAND_DOWN_SENT, 0xCA, 0xFE, 0x00, 0x01 };
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(sizeof(expected), ackLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, ack, sizeof(expected));
+}
+
+void test_METHOD_handle_WITH_valid_signature_SHOULD_send_it(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  uint8_t packet[UDP_MAX_PACKET_SIZE]
+      = { 'S', UDP_FLAG_NONCE | UDP_FLAG_HMAC, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_STOP, 0x00,
+          0x00, 0x00, 0x07 };
+  handler.sign(packet, UDP_HEADER_SIZE + UDP_NONCE_SIZE, packet + UDP_HEADER_SIZE + UDP_NONCE_SIZE);
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, ack[6]);
+}
+
+void test_METHOD_handle_WITH_wrong_signature_SHOULD_ack_unauthorized(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  uint8_t packet[UDP_MAX_PACKET_SIZE]
+      = { 'S', UDP_FLAG_NONCE | UDP_FLAG_HMAC, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_STOP, 0x00,
+          0x00, 0x00, 0x07 };
+  handler.sign(packet, UDP_HEADER_SIZE + UDP_NONCE_SIZE, packet + UDP_HEADER_SIZE + UDP_NONCE_SIZE);
+  // Another action with the signature of the first one.
+  packet[6] = UDP_ACTION_UP;
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_PACKET_UNAUTHORIZED, ack[6]);
+}
+
+void test_METHOD_handle_WITH_key_AND_unsigned_command_SHOULD_ack_unauthorized(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  const uint8_t packet[] = { 'S', 0x00, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_UP };
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_PACKET_UNAUTHORIZED, ack[6]);
+}
+
+void test_METHOD_handle_WITH_key_AND_no_nonce_SHOULD_ack_replayed(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  uint8_t packet[UDP_HEADER_SIZE + UDP_HMAC_SIZE]
+      = { 'S', UDP_FLAG_HMAC, 0x00, 0x00, 0x00, 0x01, UDP_ACTION_STOP };
+  handler.sign(packet, UDP_HEADER_SIZE, packet + UDP_HEADER_SIZE);
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_PACKET_REPLAYED, ack[6]);
+}
+
+void test_METHOD_handle_WITH_key_AND_older_nonce_SHOULD_ack_replayed(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  uint8_t first[UDP_MAX_PACKET_SIZE];
+  uint8_t second[UDP_MAX_PACKET_SIZE];
+  makeSignedStop(handler, 1, 7, first);
+  makeSignedStop(handler, 1, 8, second);
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+  handler.handle(first, sizeof(first), ack, ackLength);
+  handler.handle(second, sizeof(second), ack, ackLength);
+
+  // Retransmitted: acked again, not sent.
+  FakeTransmitter::sendSTOPCommandCalled = false;
+  Result result = handler.handle(second, sizeof(second), ack, ackLength);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, ack[6]);
+
+  // Replayed, however many commands came in between.
+  uint8_t other[UDP_MAX_PACKET_SIZE];
+  for (unsigned char i = 0; i < UDP_DEDUPE_SIZE + 1; ++i)
+  {
+    makeSignedStop(handler, 2, i, other);
+    handler.handle(other, sizeof(other), ack, ackLength);
+    TEST_ASSERT_EQUAL(RESULT_COMMAND_STOP_SENT, ack[6]);
+  }
+  FakeTransmitter::sendSTOPCommandCalled = false;
+  result = handler.handle(first, sizeof(first), ack, ackLength);
+
+  const uint8_t expected[] = { 'S', UDP_FLAG_ACK | UDP_FLAG_NONCE, 0x00, 0x00, 0x00, 0x01,
+    RESULT_PACKET_REPLAYED, 0x00, 0x00, 0x00, 0x08 };
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(sizeof(expected), ackLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, ack, sizeof(expected));
+}
+
+void test_METHOD_handle_WITH_key_AND_restart_SHOULD_refuse_replay(void)
+{
+  uint8_t packet[UDP_MAX_PACKET_SIZE];
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+  {
+    UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+    makeSignedStop(handler, 1, 7, packet);
+    TEST_ASSERT_TRUE(handler.handle(packet, sizeof(packet), ack, ackLength).isSuccess);
+  }
+
+  // The device restarts, the captured packet is sent again.
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  FakeTransmitter::sendSTOPCommandCalled = false;
+  Result result = handler.handle(packet, sizeof(packet), ack, ackLength);
+
+  const uint8_t expected[] = { 'S', UDP_FLAG_ACK | UDP_FLAG_NONCE, 0x00, 0x00, 0x00, 0x01,
+    RESULT_PACKET_REPLAYED, 0x00, 0x00, 0x00, 7 + UDP_NONCE_BLOCK };
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_EQUAL(sizeof(expected), ackLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, ack, sizeof(expected));
+
+  // The client goes on after the mark.
+  makeSignedStop(handler, 1, 7 + UDP_NONCE_BLOCK + 1, packet);
+  result = handler.handle(packet, sizeof(packet), ack, ackLength);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+}
+
+void test_METHOD_handle_WITH_key_SHOULD_save_nonce_mark_once_per_block(void)
+{
+  UdpCommandHandler handler(&udpController, &udpDatabaseFake, "secret");
+  uint8_t packet[UDP_MAX_PACKET_SIZE];
+  uint8_t ack[UDP_MAX_ACK_SIZE];
+  size_t ackLength = 0;
+
+  for (unsigned char nonce = 1; nonce <= UDP_NONCE_BLOCK + 2; ++nonce)
+  {
+    makeSignedStop(handler, 1, nonce, packet);
+    TEST_ASSERT_TRUE(handler.handle(packet, sizeof(packet), ack, ackLength).isSuccess);
+  }
+
+  // Saved before the first one, and once the block is used up.
+  TEST_ASSERT_EQUAL(2, FakeDatabase::nonceMarkWrites);
+  TEST_ASSERT_EQUAL(UDP_NONCE_BLOCK + 2 + UDP_NONCE_BLOCK, FakeDatabase::nonceMarks[1]);
+}
\ No newline at end of file
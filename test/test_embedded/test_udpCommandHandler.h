@@ -0,0 +1,16 @@
+#pragma once
+
+void RUN_UDPCOMMANDHANDLER_TESTS(void);
+
+void test_METHOD_handle_WITH_unknown_packet_SHOULD_not_ack(void);
+void test_METHOD_handle_WITH_up_command_SHOULD_send_it_AND_ack(void);
+void test_METHOD_handle_WITH_truncated_command_SHOULD_ack_invalid(void);
+void test_METHOD_handle_WITH_unknown_action_SHOULD_ack_invalid(void);
+void test_METHOD_handle_WITH_retransmitted_nonce_SHOULD_send_once(void);
+void test_METHOD_handle_WITH_valid_signature_SHOULD_send_it(void);
+void test_METHOD_handle_WITH_wrong_signature_SHOULD_ack_unauthorized(void);
+void test_METHOD_handle_WITH_key_AND_unsigned_command_SHOULD_ack_unauthorized(void);
+void test_METHOD_handle_WITH_key_AND_no_nonce_SHOULD_ack_replayed(void);
+void test_METHOD_handle_WITH_key_AND_older_nonce_SHOULD_ack_replayed(void);
+void test_METHOD_handle_WITH_key_AND_restart_SHOULD_refuse_replay(void);
+void test_METHOD_handle_WITH_key_SHOULD_save_nonce_mark_once_per_block(void);
\ No newline at end of file
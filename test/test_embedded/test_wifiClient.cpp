@@ -0,0 +1,47 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <networks.h>
+#include <wifiClient.h>
+
+#include "./test_wifiClient.h"
+
+static const unsigned char clientBssid[6] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC };
+
+void RUN_WIFICLIENT_TESTS(void)
+{
+  RUN_TEST(test_METHOD_fillHints_SHOULD_record_ssid);
+  RUN_TEST(test_METHOD_fillHints_WITH_too_long_ssid_SHOULD_truncate_it);
+}
+
+void test_METHOD_fillHints_SHOULD_record_ssid(void)
+{
+  NetworkHints hints;
+  memset(&hints, 0xFF, sizeof(NetworkHints));
+
+  WifiClient::fillHints(hints, "foo", clientBssid, 6, 0x2A01A8C0, 0x0101A8C0, 0x00FFFFFF,
+      0x0101A8C0);
+
+  // The connector looks the hints up by this SSID on the next connection.
+  TEST_ASSERT_EQUAL_STRING("foo", hints.ssid);
+  TEST_ASSERT_EQUAL_MEMORY(clientBssid, hints.bssid, sizeof(clientBssid));
+  TEST_ASSERT_EQUAL(6, hints.channel);
+  TEST_ASSERT_EQUAL(0x2A01A8C0, hints.ip);
+  TEST_ASSERT_EQUAL(0x0101A8C0, hints.gateway);
+  TEST_ASSERT_EQUAL(0x00FFFFFF, hints.subnet);
+  TEST_ASSERT_EQUAL(0x0101A8C0, hints.dns);
+}
+
+void test_METHOD_fillHints_WITH_too_long_ssid_SHOULD_truncate_it(void)
+{
+  NetworkHints hints;
+  memset(&hints, 0xFF, sizeof(NetworkHints));
+  char ssid[41];
+  memset(ssid, 'a', sizeof(ssid) - 1);
+  ssid[sizeof(ssid) - 1] = '\0';
+
+  WifiClient::fillHints(hints, ssid, clientBssid, 1, 0, 0, 0, 0);
+
+  TEST_ASSERT_EQUAL(sizeof(hints.ssid) - 1, strlen(hints.ssid));
+  TEST_ASSERT_EQUAL_STRING_LEN(ssid, hints.ssid, sizeof(hints.ssid) - 1);
+}
\ No newline at end of file
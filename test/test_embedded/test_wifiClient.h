@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_WIFICLIENT_TESTS(void);
+
+void test_METHOD_fillHints_SHOULD_record_ssid(void);
+void test_METHOD_fillHints_WITH_too_long_ssid_SHOULD_truncate_it(void);
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <config.h>
+#include <wifiSupervisor.h>
+#include <networkScanner.h>
+#include <networkConnector.h>
+
+#include "./test_controller.h"
+#include "./test_wifiSupervisor.h"
+
+FakeDatabase supervisorDatabaseFake;
+FakeNetworkClient supervisorNetworkClientFake;
+FakeAccessPoint supervisorAccessPointFake;
+
+void RUN_WIFISUPERVISOR_TESTS(void)
+{
+  RUN_TEST(test_METHOD_loop_WITHOUT_configuration_SHOULD_disable_supervision);
+  RUN_TEST(test_METHOD_loop_WITH_link_lost_SHOULD_reconnect_with_backoff);
+  RUN_TEST(test_METHOD_loop_WITH_long_outage_SHOULD_start_access_point);
+  RUN_TEST(test_METHOD_loop_WITH_link_recovered_SHOULD_stop_access_point);
+  RUN_TEST(test_METHOD_loop_WITH_boot_without_wifi_SHOULD_keep_reconnecting);
+}
+
+void test_METHOD_loop_WITHOUT_configuration_SHOULD_disable_supervision(void)
+{
+  NetworkScanner scanner(&supervisorNetworkClientFake);
+  NetworkConnector connector(&supervisorDatabaseFake, &supervisorNetworkClientFake, &scanner);
+  WifiSupervisor supervisor(&connector, &supervisorNetworkClientFake, &supervisorAccessPointFake);
+  FakeDatabase::shouldReturnEmptyNetworkConfiguration = true;
+  FakeNetworkClient::isConnectedToNetwork = false;
+
+  supervisor.loop(1000);
+  supervisor.loop(1000 + WIFI_OUTAGE_AP_DELAY);
+
+  TEST_ASSERT_EQUAL(LINK_DISABLED, supervisor.getState());
+  TEST_ASSERT_EQUAL(0, FakeNetworkClient::beginConnectCount);
+}
+
+void test_METHOD_loop_WITH_link_lost_SHOULD_reconnect_with_backoff(void)
+{
+  NetworkScanner scanner(&supervisorNetworkClientFake);
+  NetworkConnector connector(&supervisorDatabaseFake, &supervisorNetworkClientFake, &scanner);
+  WifiSupervisor supervisor(&connector, &supervisorNetworkClientFake, &supervisorAccessPointFake);
+  FakeDatabase::hasNetworkHints = true;
+
+  supervisor.loop(500);
+  TEST_ASSERT_EQUAL(LINK_UP, supervisor.getState());
+
+  // Scripted outage.
+  FakeNetworkClient::isConnectedToNetwork = false;
+  supervisor.loop(1000);
+  TEST_ASSERT_EQUAL(LINK_DOWN, supervisor.getState());
+
+  // First attempt between half the minimum delay and the minimum delay, with hints.
+  supervisor.loop(1000 + WIFI_RECONNECT_MIN_DELAY / 2 - 1);
+  TEST_ASSERT_EQUAL(0, FakeNetworkClient::beginConnectCount);
+  supervisor.loop(1000 + WIFI_RECONNECT_MIN_DELAY);
+  TEST_ASSERT_EQUAL(1, FakeNetworkClient::beginConnectCount);
+  TEST_ASSERT_TRUE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_FALSE(FakeNetworkClient::disconnectCalled);
+
+  // Second attempt after a doubled delay, without hints.
+  const unsigned long firstAttemptAt = 1000 + WIFI_RECONNECT_MIN_DELAY;
+  supervisor.loop(firstAttemptAt + WIFI_RECONNECT_MIN_DELAY - 1);
+  TEST_ASSERT_EQUAL(1, FakeNetworkClient::beginConnectCount);
+  supervisor.loop(firstAttemptAt + WIFI_RECONNECT_MIN_DELAY * 2);
+  TEST_ASSERT_EQUAL(2, FakeNetworkClient::beginConnectCount);
+  TEST_ASSERT_FALSE(FakeNetworkClient::beginConnectWithHints);
+  TEST_ASSERT_EQUAL(2, supervisor.getAttempts());
+}
+
+void test_METHOD_loop_WITH_long_outage_SHOULD_start_access_point(void)
+{
+  NetworkScanner scanner(&supervisorNetworkClientFake);
+  NetworkConnector connector(&supervisorDatabaseFake, &supervisorNetworkClientFake, &scanner);
+  WifiSupervisor supervisor(&connector, &supervisorNetworkClientFake, &supervisorAccessPointFake);
+  supervisor.loop(500);
+  FakeNetworkClient::isConnectedToNetwork = false;
+  supervisor.loop(1000);
+
+  supervisor.loop(1000 + WIFI_OUTAGE_AP_DELAY - 1);
+  TEST_ASSERT_FALSE(FakeAccessPoint::startAccessPointCalled);
+  supervisor.loop(1000 + WIFI_OUTAGE_AP_DELAY);
+  TEST_ASSERT_TRUE(FakeAccessPoint::startAccessPointCalled);
+  TEST_ASSERT_EQUAL(LINK_DOWN, supervisor.getState());
+}
+
+void test_METHOD_loop_WITH_link_recovered_SHOULD_stop_access_point(void)
+{
+  NetworkScanner scanner(&supervisorNetworkClientFake);
+  NetworkConnector connector(&supervisorDatabaseFake, &supervisorNetworkClientFake, &scanner);
+  WifiSupervisor supervisor(&connector, &supervisorNetworkClientFake, &supervisorAccessPointFake);
+  supervisor.loop(500);
+  FakeNetworkClient::isConnectedToNetwork = false;
+  supervisor.loop(1000);
+  supervisor.loop(1000 + WIFI_OUTAGE_AP_DELAY);
+
+  FakeNetworkClient::isConnectedToNetwork = true;
+  supervisor.loop(2000 + WIFI_OUTAGE_AP_DELAY);
+
+  TEST_ASSERT_EQUAL(LINK_UP, supervisor.getState());
+  TEST_ASSERT_EQUAL(0, supervisor.getAttempts());
+  TEST_ASSERT_TRUE(FakeAccessPoint::stopAccessPointCalled);
+}
+
+void test_METHOD_loop_WITH_boot_without_wifi_SHOULD_keep_reconnecting(void)
+{
+  NetworkScanner scanner(&supervisorNetworkClientFake);
+  NetworkConnector connector(&supervisorDatabaseFake, &supervisorNetworkClientFake, &scanner);
+  WifiSupervisor supervisor(&connector, &supervisorNetworkClientFake, &supervisorAccessPointFake);
+  FakeNetworkClient::isConnectedToNetwork = false;
+  FakeAccessPoint::running = true;
+
+  supervisor.loop(20000);
+  TEST_ASSERT_EQUAL(LINK_DOWN, supervisor.getState());
+  supervisor.loop(20000 + WIFI_RECONNECT_MIN_DELAY);
+
+  TEST_ASSERT_EQUAL(1, FakeNetworkClient::beginConnectCount);
+  TEST_ASSERT_FALSE(FakeAccessPoint::startAccessPointCalled);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+void RUN_WIFISUPERVISOR_TESTS(void);
+
+void test_METHOD_loop_WITHOUT_configuration_SHOULD_disable_supervision(void);
+void test_METHOD_loop_WITH_link_lost_SHOULD_reconnect_with_backoff(void);
+void test_METHOD_loop_WITH_long_outage_SHOULD_start_access_point(void);
+void test_METHOD_loop_WITH_link_recovered_SHOULD_stop_access_point(void);
+void test_METHOD_loop_WITH_boot_without_wifi_SHOULD_keep_reconnecting(void);
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include <unity.h>
+
+#include "./test_controller.h"
+#include "./test_remoteTable.h"
+#include "./test_result.h"
+#include "./test_router.h"
+#include "./test_timerWheel.h"
+
+void setUp(void)
+{
+  // set stuff up here
+}
+
+void tearDown(void)
+{
+  // clean stuff up here
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  // Controller tests
+  RUN_CONTROLLER_TESTS();
+  // RemoteTable tests
+  RUN_REMOTETABLE_TESTS();
+  // Result tests
+  RUN_RESULT_TESTS();
+  // Router tests
+  RUN_ROUTER_TESTS();
+  // TimerWheel tests
+  RUN_TIMERWHEEL_TESTS();
+  return UNITY_END();
+}
\ No newline at end of file
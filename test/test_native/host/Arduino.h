@@ -0,0 +1,156 @@
+#pragma once
+
+// The part of the Arduino core used by the sources built on the host (see build_src_filter of
+// the native env). Flash is plain memory here.
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+#define F(s) FPSTR(PSTR(s))
+
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_ptr(address) (*reinterpret_cast<const void* const*>(address))
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+#define snprintf_P snprintf
+
+inline unsigned long micros()
+{
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+
+/**
+ * @brief A Print of the core, reduced to what the deferred logs need.
+ */
+class Print
+{
+  public:
+  virtual ~Print() { }
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      this->write(buffer[i]);
+    }
+    return size;
+  }
+  virtual int availableForWrite() { return 0; }
+};
+
+/**
+ * @brief A String of the core, reduced to what the data transfer objects and the controller need.
+ * Like the one of the core, each copy of a text allocates, here with new[]. A concatenation
+ * allocates once for the text it builds or grows, as the realloc() of the core.
+ */
+class String
+{
+  public:
+  String() { }
+  String(const char* text) { this->assign(text); }
+  String(const String& other) { this->assign(other.m_buffer); }
+  explicit String(const int value)
+  {
+    char digits[12];
+    snprintf(digits, sizeof(digits), "%d", value);
+    this->assign(digits);
+  }
+  String(String&& other)
+      : m_buffer(other.m_buffer)
+      , m_length(other.m_length)
+  {
+    other.m_buffer = nullptr;
+    other.m_length = 0;
+  }
+  ~String() { delete[] this->m_buffer; }
+
+  String& operator=(const char* text)
+  {
+    this->assign(text);
+    return *this;
+  }
+  String& operator=(const String& other)
+  {
+    if (this != &other)
+    {
+      this->assign(other.m_buffer);
+    }
+    return *this;
+  }
+  String& operator=(String&& other)
+  {
+    if (this != &other)
+    {
+      delete[] this->m_buffer;
+      this->m_buffer = other.m_buffer;
+      this->m_length = other.m_length;
+      other.m_buffer = nullptr;
+      other.m_length = 0;
+    }
+    return *this;
+  }
+  bool operator==(const char* text) const { return strcmp(this->c_str(), text) == 0; }
+
+  friend String operator+(const char* left, const String& right)
+  {
+    String sum(left);
+    sum.concat(right.c_str());
+    return sum;
+  }
+  friend String operator+(String&& left, const char* right)
+  {
+    left.concat(right);
+    return std::move(left);
+  }
+
+  const char* c_str() const { return this->m_buffer == nullptr ? "" : this->m_buffer; }
+  size_t length() const { return this->m_length; }
+
+  private:
+  char* m_buffer = nullptr;
+  size_t m_length = 0;
+
+  void concat(const char* text)
+  {
+    const size_t length = strlen(text);
+    if (length == 0)
+    {
+      return;
+    }
+    char* buffer = new char[this->m_length + length + 1];
+    memcpy(buffer, this->c_str(), this->m_length);
+    memcpy(buffer + this->m_length, text, length + 1);
+    delete[] this->m_buffer;
+    this->m_buffer = buffer;
+    this->m_length += length;
+  }
+
+  void assign(const char* text)
+  {
+    delete[] this->m_buffer;
+    this->m_buffer = nullptr;
+    this->m_length = text == nullptr ? 0 : strlen(text);
+    if (this->m_length > 0)
+    {
+      this->m_buffer = new char[this->m_length + 1];
+      memcpy(this->m_buffer, text, this->m_length + 1);
+    }
+  }
+};
\ No newline at end of file
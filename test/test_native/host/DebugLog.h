@@ -0,0 +1,9 @@
+#pragma once
+
+// The logs of the sources built on the host are dropped.
+
+#define LOG_ERROR(...) do {} while (0)
+#define LOG_WARN(...) do {} while (0)
+#define LOG_INFO(...) do {} while (0)
+#define LOG_DEBUG(...) do {} while (0)
+#define LOG_TRACE(...) do {} while (0)
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <unity.h>
+
+#include <config.h>
+#include <controller.h>
+
+#include "./test_controller.h"
+#include "./test_result.h"
+
+// The controller with a database of one remote. The fakes do not allocate, only the serializer
+// returns its payload in a String, as the JSON serializer does.
+
+static const char REMOTE_PAYLOAD[] = "{\"id\":1,\"name\":\"Living room\",\"rollingCode\":42}";
+
+class FakeDatabase : public DatabaseAbstract
+{
+  public:
+  void init() { }
+  bool migrate() { return true; }
+  SystemInfos getSystemInfos() { return {}; }
+  unsigned char getNetworkConfigurations(NetworkConfiguration networkConfigs[]) { return 0; }
+  bool setNetworkConfigurations(
+      const NetworkConfiguration networkConfigs[], const unsigned char size)
+  {
+    return false;
+  }
+  void resetNetworkConfigurations() { }
+  bool getNetworkHints(NetworkHints& hints) { return false; }
+  bool setNetworkHints(const NetworkHints& hints) { return false; }
+  Remote createRemote(const char* name) { return {}; }
+  void getAllRemotes(Remote remotes[]) { }
+  Remote getRemote(const unsigned long& id)
+  {
+    if (id != 1)
+    {
+      return {};
+    }
+    return { 1, 42, "Living room" };
+  }
+  bool updateRemote(const Remote& remote) { return false; }
+  bool deleteRemote(const unsigned long& id) { return false; }
+  bool getCalibration(const unsigned long& id, Calibration& calibration) { return false; }
+  bool setCalibration(const unsigned long& id, const Calibration& calibration) { return false; }
+  bool getNonceMark(const unsigned long& id, unsigned long& mark) { return false; }
+  bool setNonceMark(const unsigned long& id, const unsigned long mark) { return false; }
+  void getAllSchedules(Schedule schedules[]) { }
+  Schedule createSchedule(const Schedule& schedule) { return {}; }
+  bool deleteSchedule(const unsigned char id) { return false; }
+  void getAllGroups(Group groups[]) { }
+  Group getGroup(const unsigned char id) { return {}; }
+  Group createGroup(const Group& group) { return {}; }
+  bool deleteGroup(const unsigned char id) { return false; }
+  void getAllScenes(Scene scenes[]) { }
+  Scene getScene(const unsigned char id) { return {}; }
+  Scene createScene(const Scene& scene) { return {}; }
+  bool deleteScene(const unsigned char id) { return false; }
+  void getAllMacros(Macro macros[]) { }
+  Macro getMacro(const unsigned char id) { return {}; }
+  Macro createMacro(const Macro& macro) { return {}; }
+  bool deleteMacro(const unsigned char id) { return false; }
+  void beginBatch() { }
+  bool endBatch() { return true; }
+  void getChangesSince(const unsigned long& sequence, ChangeFeed& feed) { }
+};
+
+class FakeSerializer : public SerializerAbstract
+{
+  public:
+  String serializeRemote(const Remote& remote) { return String(REMOTE_PAYLOAD); }
+  String serializeRemotes(const Remote remotes[], int size) { return String(); }
+  String serializeNetworkConfigs(const NetworkConfiguration networkConfigs[], int size)
+  {
+    return String();
+  }
+  String serializeNetworks(const Network networks[], int size) { return String(); }
+  String serializeSystemInfos(const SystemInfos& infos) { return String(); }
+  String serializeChangeFeed(const ChangeFeed& feed) { return String(); }
+  String serializeAdmissionMetrics(const AdmissionMetrics& metrics) { return String(); }
+  String serializeBootProfile(const BootProfile& profile) { return String(); }
+  String serializeSwitchoverStatus(const SwitchoverStatus& status) { return String(); }
+  String serializeSchedule(const Schedule& schedule) { return String(); }
+  String serializeSchedules(const Schedule schedules[], int size) { return String(); }
+  String serializeRemotePosition(const RemotePosition& position) { return String(); }
+  String serializeGroup(const Group& group) { return String(); }
+  String serializeGroups(const Group groups[], int size) { return String(); }
+  String serializeScene(const Scene& scene) { return String(); }
+  String serializeScenes(const Scene scenes[], int size) { return String(); }
+  String serializeSceneReport(const SceneReport& report) { return String(); }
+  String serializeMacro(const Macro& macro) { return String(); }
+  String serializeMacros(const Macro macros[], int size) { return String(); }
+};
+
+class FakeTransmitter : public TransmitterAbstract
+{
+  public:
+  bool sendUpCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendStopCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendDownCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendProgCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+};
+
+class FakeNetworkClient : public NetworkClientAbstract
+{
+  public:
+  bool beginConnect(const NetworkConfiguration& conf, const NetworkHints* hints = NULL)
+  {
+    return false;
+  }
+  bool getConnectionHints(NetworkHints& hints) { return false; }
+  void disconnect() { }
+  String getIP() { return String(); }
+  bool isConnected() { return false; }
+  bool startScan() { return false; }
+  int getScanStatus() { return 0; }
+  bool getScanResult(const int index, Network& network) { return false; }
+  void deleteScanResults() { }
+};
+
+class FakeNetworkSwitchover : public NetworkSwitchoverAbstract
+{
+  public:
+  bool begin(const NetworkConfiguration networkConfigs[], const unsigned char size)
+  {
+    return false;
+  }
+  SwitchoverStatus getStatus() { return {}; }
+};
+
+class FakeEventPublisher : public EventPublisherAbstract
+{
+  public:
+  void publish(const EventType type, const Remote& remote, const char* action = nullptr) { }
+};
+
+// The same calls before the result codes, as the controller and main.cpp wrote them.
+namespace baseline
+{
+struct Result
+{
+  String data = "";
+  String error = "";
+  bool isSuccess = false;
+};
+
+Result createRemote(DatabaseAbstract* database, SerializerAbstract* serializer, const char* name)
+{
+  LOG_DEBUG("Creating a new Remote...");
+  Result result;
+  if (name == nullptr)
+  {
+    LOG_ERROR("The name of the remote should be specified.");
+    result.error = "The name of the remote should be specified.";
+    return result;
+  }
+
+  if (strlen(name) == 0)
+  {
+    LOG_ERROR("The name of the remote cannot be empty.");
+    result.error = "The name of the remote cannot be empty.";
+    return result;
+  }
+
+  if (strlen(name) > MAX_REMOTE_NAME_LENGTH)
+  {
+    LOG_ERROR("The name is too long.");
+    String error = "The name is too long. It can contain only " + String(MAX_REMOTE_NAME_LENGTH - 1)
+        + " chars.";
+    result.error = error;
+    return result;
+  }
+
+  Remote remote = database->createRemote(name);
+
+  if (remote.id == 0)
+  {
+    LOG_ERROR(
+        "The created remote is an empty remote. No space left on the device for a new remote.");
+    result.error = "No space left on the device for a new remote.";
+    return result;
+  }
+
+  result.isSuccess = true;
+  String serialized = serializer->serializeRemote(remote);
+  result.data = serialized;
+  LOG_DEBUG("Remote created.");
+  return result;
+}
+
+Result fetchRemote(DatabaseAbstract* database, SerializerAbstract* serializer, const unsigned long id)
+{
+  LOG_DEBUG("Fetching Remote...");
+  Result result;
+  if (id == 0)
+  {
+    LOG_ERROR("The remote id is not specified.");
+    result.error = "The remote id is not specified.";
+    return result;
+  }
+
+  Remote remote = database->getRemote(id);
+
+  if (remote.id == 0)
+  {
+    LOG_ERROR("This remote doesn't exists.");
+    result.error = "This remote doesn't exists.";
+    return result;
+  }
+
+  result.isSuccess = true;
+  String serialized = serializer->serializeRemote(remote);
+  result.data = serialized;
+  LOG_DEBUG("Remote fetched.");
+  return result;
+}
+
+// The body of the answer to an error.
+String errorBody(const Result& result) { return "{\"message\":\"" + result.error + "\"}"; }
+}
+
+static FakeDatabase database;
+static FakeSerializer serializer;
+static FakeTransmitter transmitter;
+static FakeNetworkClient networkClient;
+static FakeNetworkSwitchover networkSwitchover;
+static FakeEventPublisher eventPublisher;
+
+void RUN_CONTROLLER_TESTS(void)
+{
+  RUN_TEST(
+      test_METHOD_createRemote_WITH_too_long_name_SHOULD_report_its_allocations_AND_the_baseline_ones);
+  RUN_TEST(test_METHOD_fetchRemote_SHOULD_report_its_allocations_AND_the_baseline_ones);
+}
+
+void test_METHOD_createRemote_WITH_too_long_name_SHOULD_report_its_allocations_AND_the_baseline_ones(
+    void)
+{
+  Controller controller(
+      &database, &networkClient, &serializer, &transmitter, &networkSwitchover, &eventPublisher);
+  const char* name = "A name longer than 16 chars";
+  char body[160];
+  uint8_t buffer[64];
+
+  unsigned long start = allocations.load();
+  {
+    Result result = controller.createRemote(name);
+    size_t index = 0;
+    size_t read;
+    while ((read = readResultBody(result.code, buffer, sizeof(buffer), index)) > 0)
+    {
+      memcpy(body + index, buffer, read);
+      index += read;
+    }
+    body[index] = '\0';
+  }
+  const unsigned long current = allocations.load() - start;
+
+  start = allocations.load();
+  {
+    baseline::Result result = baseline::createRemote(&database, &serializer, name);
+    String baselineBody = baseline::errorBody(result);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"message\":\"The name is too long. It can contain only 16 chars.\"}",
+        baselineBody.c_str());
+  }
+  const unsigned long before = allocations.load() - start;
+
+  char message[96];
+  snprintf(message, sizeof(message), "createRemote error and its body: %lu allocations, %lu before",
+      current, before);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_STRING("{\"message\":\"The name of the remote is too long.\"}", body);
+  TEST_ASSERT_EQUAL_UINT32(0, current);
+  TEST_ASSERT_TRUE(current < before);
+}
+
+void test_METHOD_fetchRemote_SHOULD_report_its_allocations_AND_the_baseline_ones(void)
+{
+  Controller controller(
+      &database, &networkClient, &serializer, &transmitter, &networkSwitchover, &eventPublisher);
+
+  unsigned long start = allocations.load();
+  {
+    Result result = controller.fetchRemote(1);
+    TEST_ASSERT_TRUE(result.isSuccess);
+    TEST_ASSERT_EQUAL_STRING(REMOTE_PAYLOAD, result.data.c_str());
+  }
+  const unsigned long current = allocations.load() - start;
+
+  start = allocations.load();
+  {
+    baseline::Result result = baseline::fetchRemote(&database, &serializer, 1);
+    TEST_ASSERT_TRUE(result.isSuccess);
+    TEST_ASSERT_EQUAL_STRING(REMOTE_PAYLOAD, result.data.c_str());
+  }
+  const unsigned long before = allocations.load() - start;
+
+  char message[96];
+  snprintf(message, sizeof(message), "fetchRemote success: %lu allocations, %lu before", current,
+      before);
+  TEST_MESSAGE(message);
+  // Only the payload of the serializer.
+  TEST_ASSERT_EQUAL_UINT32(1, current);
+  TEST_ASSERT_TRUE(current < before);
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_CONTROLLER_TESTS(void);
+
+void test_METHOD_createRemote_WITH_too_long_name_SHOULD_report_its_allocations_AND_the_baseline_ones(void);
+void test_METHOD_fetchRemote_SHOULD_report_its_allocations_AND_the_baseline_ones(void);
\ No newline at end of file
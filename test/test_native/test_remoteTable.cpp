@@ -0,0 +1,97 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <string.h>
+
+#include <config.h>
+#include <remote.h>
+#include <remoteTable.h>
+
+#include "./test_remoteTable.h"
+
+// Threads of the stress test. On the device, the readers are the network callbacks.
+static const unsigned char READERS = 4;
+static const unsigned long WRITES = 2000000;
+
+// Every field of the remote is made from the same counter, a torn read mixes two of them.
+static Remote makeRemote(const unsigned long counter)
+{
+  Remote remote;
+  memset(&remote, 0, sizeof(Remote));
+  remote.id = REMOTE_BASE_ADDRESS + counter % 3;
+  remote.rollingCode = counter;
+  memset(remote.name, 'a' + counter % 26, MAX_REMOTE_NAME_LENGTH - 1);
+  return remote;
+}
+
+static bool isConsistent(const Remote& remote)
+{
+  const Remote expected = makeRemote(remote.rollingCode);
+  return memcmp(&remote, &expected, sizeof(Remote)) == 0;
+}
+
+void RUN_REMOTETABLE_TESTS(void)
+{
+  RUN_TEST(test_METHOD_read_WITH_written_remote_SHOULD_return_it);
+  RUN_TEST(test_METHOD_read_WITH_concurrent_writer_SHOULD_never_return_torn_remote);
+}
+
+void test_METHOD_read_WITH_written_remote_SHOULD_return_it(void)
+{
+  RemoteTable table;
+  Remote remote = makeRemote(42);
+  Remote read;
+
+  table.write(3, remote);
+  table.read(3, read);
+
+  TEST_ASSERT_EQUAL_MEMORY(&remote, &read, sizeof(Remote));
+  TEST_ASSERT_EQUAL(3, table.find(remote.id));
+  TEST_ASSERT_EQUAL(0, table.find(0));
+  TEST_ASSERT_EQUAL(-1, table.find(REMOTE_BASE_ADDRESS + 100));
+}
+
+void test_METHOD_read_WITH_concurrent_writer_SHOULD_never_return_torn_remote(void)
+{
+  RemoteTable table;
+  table.write(0, makeRemote(0));
+  std::atomic<bool> isWriting(true);
+  std::atomic<unsigned long> torn(0);
+  std::atomic<unsigned long> reads(0);
+
+  std::thread readers[READERS];
+  for (unsigned char i = 0; i < READERS; ++i)
+  {
+    readers[i] = std::thread(
+        [&]()
+        {
+          Remote remote;
+          unsigned int last = 0;
+          while (isWriting.load())
+          {
+            table.read(0, remote);
+            if (!isConsistent(remote) || remote.rollingCode < last)
+            {
+              torn++;
+            }
+            last = remote.rollingCode;
+            reads++;
+          }
+        });
+  }
+  for (unsigned long counter = 1; counter <= WRITES; ++counter)
+  {
+    table.write(0, makeRemote(counter));
+  }
+  isWriting.store(false);
+  for (unsigned char i = 0; i < READERS; ++i)
+  {
+    readers[i].join();
+  }
+
+  TEST_ASSERT_TRUE(reads.load() > 0);
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+  Remote remote;
+  table.read(0, remote);
+  TEST_ASSERT_EQUAL_UINT32(WRITES, remote.rollingCode);
+}
\ No newline at end of file
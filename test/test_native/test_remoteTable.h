@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_REMOTETABLE_TESTS(void);
+
+void test_METHOD_read_WITH_written_remote_SHOULD_return_it(void);
+void test_METHOD_read_WITH_concurrent_writer_SHOULD_never_return_torn_remote(void);
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <atomic>
+#include <new>
+
+#include <result.h>
+
+#include "./test_result.h"
+
+// Every allocation of the test program goes through these, the String of the host included.
+// Not inlined: GCC would pair the malloc() of one with the delete of the other.
+std::atomic<unsigned long> allocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size)
+{
+  allocations++;
+  void* pointer = malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) { return operator new(size); }
+
+__attribute__((noinline)) void operator delete(void* pointer) noexcept { free(pointer); }
+
+__attribute__((noinline)) void operator delete[](void* pointer) noexcept { free(pointer); }
+
+__attribute__((noinline)) void operator delete(void* pointer, size_t size) noexcept
+{
+  free(pointer);
+}
+
+__attribute__((noinline)) void operator delete[](void* pointer, size_t size) noexcept
+{
+  free(pointer);
+}
+
+void RUN_RESULT_TESTS(void)
+{
+  RUN_TEST(test_METHOD_String_SHOULD_be_counted_as_allocation);
+  RUN_TEST(test_METHOD_getResultMessage_WITH_every_code_SHOULD_not_allocate);
+  RUN_TEST(test_METHOD_readResultBody_WITH_small_buffer_SHOULD_fill_body_AND_not_allocate);
+}
+
+void test_METHOD_String_SHOULD_be_counted_as_allocation(void)
+{
+  const unsigned long before = allocations.load();
+
+  String message = "{\"message\":\"OK.\"}";
+
+  TEST_ASSERT_EQUAL_UINT32(before + 1, allocations.load());
+}
+
+void test_METHOD_getResultMessage_WITH_every_code_SHOULD_not_allocate(void)
+{
+  const unsigned long before = allocations.load();
+
+  for (unsigned char code = 0; code < RESULT_CODES; ++code)
+  {
+    const char* message = reinterpret_cast<const char*>(getResultMessage(ResultCode(code)));
+    TEST_ASSERT_TRUE(strlen_P(message) > 0);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(before, allocations.load());
+  TEST_ASSERT_EQUAL_STRING("Command UP sent.",
+      reinterpret_cast<const char*>(getResultMessage(RESULT_COMMAND_UP_SENT)));
+  TEST_ASSERT_EQUAL_STRING("OK.", reinterpret_cast<const char*>(getResultMessage(RESULT_CODES)));
+}
+
+void test_METHOD_readResultBody_WITH_small_buffer_SHOULD_fill_body_AND_not_allocate(void)
+{
+  // Smaller than a body, as the TCP buffer can be: the body is read in several chunks.
+  uint8_t buffer[7];
+  char body[160];
+  const unsigned long before = allocations.load();
+
+  for (unsigned char code = 0; code < RESULT_CODES; ++code)
+  {
+    const size_t length = getResultBodyLength(ResultCode(code));
+    TEST_ASSERT_TRUE(length < sizeof(body));
+    size_t index = 0;
+    size_t read;
+    while ((read = readResultBody(ResultCode(code), buffer, sizeof(buffer), index)) > 0)
+    {
+      memcpy(body + index, buffer, read);
+      index += read;
+    }
+    body[index] = '\0';
+    TEST_ASSERT_EQUAL(length, index);
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"message\":\"", body, 12);
+    TEST_ASSERT_EQUAL_STRING("\"}", body + length - 2);
+    if (code == RESULT_COMMAND_STOP_SENT)
+    {
+      TEST_ASSERT_EQUAL_STRING("{\"message\":\"Command STOP sent.\"}", body);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(before, allocations.load());
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <atomic>
+
+// Number of allocations made by the test program since it started.
+extern std::atomic<unsigned long> allocations;
+
+void RUN_RESULT_TESTS(void);
+
+void test_METHOD_String_SHOULD_be_counted_as_allocation(void);
+void test_METHOD_getResultMessage_WITH_every_code_SHOULD_not_allocate(void);
+void test_METHOD_readResultBody_WITH_small_buffer_SHOULD_fill_body_AND_not_allocate(void);
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_ROUTER_TESTS(void);
+
+void test_METHOD_matchRoute_SHOULD_match_as_the_regex_routes(void);
+void test_METHOD_matchRoute_SHOULD_report_its_time_AND_the_one_of_the_regex_routes(void);
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include <timerWheel.h>
+
+#include "./test_timerWheel.h"
+
+// Far more than MAX_SCHEDULES, the wheel does not depend on the number of timers.
+static const unsigned short WHEEL_TIMERS = 8192;
+static const unsigned long DAY = 86400; // In seconds
+static TimerNode wheelNodes[WHEEL_TIMERS];
+static unsigned long expiries[WHEEL_TIMERS];
+static unsigned short expiredCount[WHEEL_TIMERS];
+
+void RUN_TIMERWHEEL_TESTS(void)
+{
+  RUN_TEST(test_METHOD_advance_WITH_thousands_of_timers_SHOULD_expire_each_once_in_order);
+  RUN_TEST(test_METHOD_advance_WITH_thousands_of_daily_timers_SHOULD_run_each_every_day);
+}
+
+void test_METHOD_advance_WITH_thousands_of_timers_SHOULD_expire_each_once_in_order(void)
+{
+  // Starts close to a wrap of the last level, the timers cross all of them.
+  const unsigned long start = (1UL << 20) - 100;
+  // Up to about 24 days, twice the span of the wheel.
+  const unsigned long span = 2 * (1UL << 20);
+  TimerWheel wheel(wheelNodes, WHEEL_TIMERS);
+  wheel.reset(start);
+  // Deterministic pseudo random expiries.
+  unsigned long seed = 42;
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    seed = seed * 1103515245UL + 12345UL;
+    expiries[i] = start + 1 + (seed >> 4) % span;
+    expiredCount[i] = 0;
+    wheel.schedule(i, expiries[i]);
+  }
+
+  unsigned long lastExpiry = start;
+  unsigned long total = 0;
+  // The virtual clock goes by irregular steps, as the main loop does.
+  for (unsigned long now = start; now <= start + span + 7; now += 1 + now % 7)
+  {
+    wheel.advance(now);
+    int timer;
+    while ((timer = wheel.popExpired()) >= 0)
+    {
+      TEST_ASSERT_TRUE(expiries[timer] <= now);
+      TEST_ASSERT_TRUE(expiries[timer] >= lastExpiry);
+      // Never late by more than the step of the loop.
+      TEST_ASSERT_TRUE(now - expiries[timer] < 7);
+      lastExpiry = expiries[timer];
+      expiredCount[timer]++;
+      total++;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(WHEEL_TIMERS, total);
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    TEST_ASSERT_EQUAL(1, expiredCount[i]);
+  }
+}
+
+void test_METHOD_advance_WITH_thousands_of_daily_timers_SHOULD_run_each_every_day(void)
+{
+  // As the scheduler does: each timer is set again to the same time on the next day when it
+  // expires, for a week.
+  static const unsigned char DAYS = 7;
+  const unsigned long start = 1700000000UL;
+  TimerWheel wheel(wheelNodes, WHEEL_TIMERS);
+  wheel.reset(start);
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    // Spread over the day, several timers share the same second.
+    expiries[i] = start + 1 + (i * 7919UL) % DAY;
+    expiredCount[i] = 0;
+    wheel.schedule(i, expiries[i]);
+  }
+
+  const unsigned long end = start + DAYS * DAY;
+  for (unsigned long now = start; now <= end; now += 1 + now % 5)
+  {
+    wheel.advance(now);
+    int timer;
+    while ((timer = wheel.popExpired()) >= 0)
+    {
+      TEST_ASSERT_TRUE(expiries[timer] <= now);
+      TEST_ASSERT_TRUE(now - expiries[timer] < 5);
+      expiredCount[timer]++;
+      expiries[timer] += DAY;
+      wheel.schedule(timer, expiries[timer]);
+    }
+  }
+
+  for (unsigned short i = 0; i < WHEEL_TIMERS; ++i)
+  {
+    TEST_ASSERT_EQUAL(DAYS, expiredCount[i]);
+    // The next run is still pending.
+    TEST_ASSERT_TRUE(expiries[i] > end);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_TIMERWHEEL_TESTS(void);
+
+void test_METHOD_advance_WITH_thousands_of_timers_SHOULD_expire_each_once_in_order(void);
+void test_METHOD_advance_WITH_thousands_of_daily_timers_SHOULD_run_each_every_day(void);
\ No newline at end of file